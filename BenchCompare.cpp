@@ -0,0 +1,423 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   BenchCompare: summarize Google Benchmark runs and compare them against a baseline.
+
+      BenchCompare summarize run.json [run.json ...] > baseline.json
+         Groups the per-repetition results of one or more runs (written with
+         --benchmark_format=json) by name, and writes the median and the
+         median absolute deviation of the CPU time, in nanoseconds.
+
+      BenchCompare compare baseline.json current.json [threshold [k]]
+         Reports every kernel, and exits with 1 if any kernel got slower by
+         more than threshold (a fraction, default 0.05) AND by more than k
+         (default 3) scaled MADs of the noisier of the two runs. Requiring both
+         keeps noisy kernels from failing on jitter, and quiet kernels from
+         failing on differences too small to matter.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+   // Just enough JSON to read what Google Benchmark and we write.
+struct Json
+ {
+   enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+   double number = 0.0;
+   std::string string;
+   std::vector<Json> array;
+   std::vector<std::pair<std::string, Json> > object;
+
+   const Json* get(const std::string& key) const
+    {
+      for (const auto& member : object)
+         if (member.first == key)
+            return &member.second;
+      return nullptr;
+    }
+ };
+
+class Parser
+ {
+public:
+   explicit Parser(const std::string& text) : text(text), pos(0U) { }
+
+   Json parse()
+    {
+      Json result = value();
+      skip();
+      if (pos != text.size())
+         fail("trailing characters");
+      return result;
+    }
+
+private:
+   const std::string& text;
+   size_t pos;
+
+   [[noreturn]] void fail(const char* what)
+    {
+      std::fprintf(stderr, "JSON error at offset %zu: %s\n", pos, what);
+      std::exit(2);
+    }
+
+   void skip()
+    {
+      while ((pos < text.size()) && std::isspace(static_cast<unsigned char>(text[pos])))
+         ++pos;
+    }
+
+   void expect(char c)
+    {
+      skip();
+      if ((pos >= text.size()) || (text[pos] != c))
+         fail("unexpected character");
+      ++pos;
+    }
+
+   bool literal(const char* word)
+    {
+      size_t length = std::char_traits<char>::length(word);
+      if (0 == text.compare(pos, length, word))
+       {
+         pos += length;
+         return true;
+       }
+      return false;
+    }
+
+   std::string str()
+    {
+      std::string result;
+      expect('"');
+      while ((pos < text.size()) && ('"' != text[pos]))
+       {
+         if ('\\' == text[pos])
+          {
+            ++pos;
+            if (pos >= text.size())
+               fail("bad escape");
+            switch (text[pos])
+             {
+               case 'n': result += '\n'; break;
+               case 't': result += '\t'; break;
+               case 'r': result += '\r'; break;
+               case 'b': result += '\b'; break;
+               case 'f': result += '\f'; break;
+               case 'u': result += '?'; pos += 4U; break; // Benchmark names are ASCII.
+               default: result += text[pos]; break;
+             }
+          }
+         else
+            result += text[pos];
+         ++pos;
+       }
+      if (pos >= text.size())
+         fail("unterminated string");
+      ++pos;
+      return result;
+    }
+
+   Json value()
+    {
+      Json result;
+      skip();
+      if (pos >= text.size())
+         fail("unexpected end");
+      char c = text[pos];
+      if ('{' == c)
+       {
+         ++pos;
+         result.type = Json::Object;
+         skip();
+         if ((pos < text.size()) && ('}' == text[pos]))
+          {
+            ++pos;
+            return result;
+          }
+         for (;;)
+          {
+            std::string key = str();
+            expect(':');
+            result.object.emplace_back(key, value());
+            skip();
+            if ((pos < text.size()) && (',' == text[pos]))
+               ++pos;
+            else
+               break;
+          }
+         expect('}');
+       }
+      else if ('[' == c)
+       {
+         ++pos;
+         result.type = Json::Array;
+         skip();
+         if ((pos < text.size()) && (']' == text[pos]))
+          {
+            ++pos;
+            return result;
+          }
+         for (;;)
+          {
+            result.array.push_back(value());
+            skip();
+            if ((pos < text.size()) && (',' == text[pos]))
+               ++pos;
+            else
+               break;
+          }
+         expect(']');
+       }
+      else if ('"' == c)
+       {
+         result.type = Json::String;
+         result.string = str();
+       }
+      else if (literal("true"))
+       {
+         result.type = Json::Bool;
+         result.number = 1.0;
+       }
+      else if (literal("false"))
+       {
+         result.type = Json::Bool;
+       }
+      else if (literal("null"))
+       {
+         // Already Null
+       }
+      else
+       {
+         const char* start = text.c_str() + pos;
+         char* end;
+         result.type = Json::Number;
+         result.number = std::strtod(start, &end);
+         if (end == start)
+            fail("bad value");
+         pos += end - start;
+       }
+      return result;
+    }
+ };
+
+static Json load(const char* name)
+ {
+   std::ifstream file (name);
+   if (!file)
+    {
+      std::fprintf(stderr, "Cannot open %s\n", name);
+      std::exit(2);
+    }
+   std::stringstream buffer;
+   buffer << file.rdbuf();
+   std::string text = buffer.str();
+   return Parser(text).parse();
+ }
+
+static double median(std::vector<double> values)
+ {
+   std::sort(values.begin(), values.end());
+   size_t half = values.size() / 2U;
+   if (values.size() & 1U)
+      return values[half];
+   return (values[half - 1U] + values[half]) / 2.0;
+ }
+
+static double toNanoseconds(double value, const Json* unit)
+ {
+   if (nullptr != unit)
+    {
+      if ("us" == unit->string) return value * 1e3;
+      if ("ms" == unit->string) return value * 1e6;
+      if ("s" == unit->string) return value * 1e9;
+    }
+   return value;
+ }
+
+struct Summary
+ {
+   double median;
+   double mad;
+   size_t samples;
+ };
+
+   // A string as a JSON literal: the inverse of Parser::str, for the escapes that it knows.
+static std::string quote(const std::string& text)
+ {
+   std::string result = "\"";
+   for (char c : text)
+    {
+      switch (c)
+       {
+         case '"': result += "\\\""; break;
+         case '\\': result += "\\\\"; break;
+         case '\n': result += "\\n"; break;
+         case '\t': result += "\\t"; break;
+         case '\r': result += "\\r"; break;
+         case '\b': result += "\\b"; break;
+         case '\f': result += "\\f"; break;
+         default: result += c; break;
+       }
+    }
+   return result + "\"";
+ }
+
+   // Runs are kept in the order they first appear, so that reports follow the benchmark's own order.
+static int summarize(int argc, char** argv)
+ {
+   std::vector<std::string> order;
+   std::map<std::string, std::vector<double> > samples;
+   for (int i = 0; i < argc; ++i)
+    {
+      Json run = load(argv[i]);
+      const Json* benchmarks = run.get("benchmarks");
+      if (nullptr == benchmarks)
+         continue;
+      for (const Json& entry : benchmarks->array)
+       {
+         const Json* type = entry.get("run_type");
+         const Json* name = entry.get("run_name");
+         const Json* time = entry.get("cpu_time");
+         if ((nullptr != type) && ("iteration" != type->string)) // Skip Google's own aggregates: we want the raw samples.
+            continue;
+         if (nullptr == name)
+            name = entry.get("name");
+         if ((nullptr == name) || (nullptr == time))
+            continue;
+         if (samples.find(name->string) == samples.end())
+            order.push_back(name->string);
+         samples[name->string].push_back(toNanoseconds(time->number, entry.get("time_unit")));
+       }
+    }
+
+   std::printf("{\n  \"benchmarks\": [");
+   const char* separator = "\n";
+   for (const std::string& name : order)
+    {
+      const std::vector<double>& values = samples[name];
+      double mid = median(values);
+      std::vector<double> deviations;
+      for (double value : values)
+         deviations.push_back(std::fabs(value - mid));
+      std::printf("%s    { \"name\": %s, \"median\": %.6g, \"mad\": %.6g, \"samples\": %zu }", separator, quote(name).c_str(), mid, median(deviations), values.size());
+      separator = ",\n";
+    }
+   std::printf("\n  ]\n}\n");
+   return 0;
+ }
+
+static std::map<std::string, Summary> readSummary(const char* name, std::vector<std::string>& order)
+ {
+   std::map<std::string, Summary> result;
+   Json summary = load(name);
+   const Json* benchmarks = summary.get("benchmarks");
+   if (nullptr != benchmarks)
+    {
+      for (const Json& entry : benchmarks->array)
+       {
+         const Json* key = entry.get("name");
+         const Json* mid = entry.get("median");
+         const Json* mad = entry.get("mad");
+         const Json* count = entry.get("samples");
+         if ((nullptr == key) || (nullptr == mid) || (nullptr == mad))
+            continue;
+         order.push_back(key->string);
+         result[key->string] = Summary { mid->number, mad->number, (nullptr != count) ? static_cast<size_t>(count->number) : 1U };
+       }
+    }
+   return result;
+ }
+
+static int compare(int argc, char** argv)
+ {
+   double threshold = (argc > 2) ? std::atof(argv[2]) : 0.05;
+   double k = (argc > 3) ? std::atof(argv[3]) : 3.0;
+   const double MAD_TO_SIGMA = 1.4826; // Scales the MAD to a standard deviation for normal noise.
+
+   std::vector<std::string> order, baselineOrder;
+   std::map<std::string, Summary> baseline = readSummary(argv[0], baselineOrder);
+   std::map<std::string, Summary> current = readSummary(argv[1], order);
+
+   int regressions = 0;
+   std::printf("%-48s %12s %12s %8s %10s\n", "Benchmark", "Base (ns)", "New (ns)", "Change", "Noise (ns)");
+   for (const std::string& name : order)
+    {
+      auto base = baseline.find(name);
+      const Summary& now = current[name];
+      if (base == baseline.end())
+       {
+         std::printf("%-48s %12s %12.1f %8s %10s  new\n", name.c_str(), "-", now.median, "-", "-");
+         continue;
+       }
+      double noise = k * MAD_TO_SIGMA * std::max(base->second.mad, now.mad);
+      double delta = now.median - base->second.median;
+      double change = (base->second.median > 0.0) ? (delta / base->second.median) : 0.0;
+      const char* verdict = "";
+      if ((change > threshold) && (delta > noise))
+       {
+         verdict = "  REGRESSION";
+         ++regressions;
+       }
+      else if ((-change > threshold) && (-delta > noise))
+       {
+         verdict = "  faster";
+       }
+      std::printf("%-48s %12.1f %12.1f %+7.1f%% %10.1f%s\n", name.c_str(), base->second.median, now.median, change * 100.0, noise, verdict);
+    }
+   for (const std::string& name : baselineOrder)
+      if (current.find(name) == current.end())
+         std::printf("%-48s %12.1f %12s %8s %10s  missing\n", name.c_str(), baseline[name].median, "-", "-", "-");
+
+   std::printf("%d regression%s beyond %.1f%% and %.1f MADs\n", regressions, (1 == regressions) ? "" : "s", threshold * 100.0, k);
+   return (0 != regressions) ? 1 : 0;
+ }
+
+int main(int argc, char** argv)
+ {
+   if ((argc >= 3) && (std::string("summarize") == argv[1]))
+      return summarize(argc - 2, argv + 2);
+   if ((argc >= 4) && (std::string("compare") == argv[1]))
+      return compare(argc - 2, argv + 2);
+   std::fprintf(stderr, "Usage: %s summarize run.json [run.json ...]\n       %s compare baseline.json current.json [threshold [k]]\n", argv[0], argv[0]);
+   return 2;
+ }
@@ -0,0 +1,48 @@
+#!/bin/bash
+
+   # Capture a benchmark baseline, or compare a new run against one.
+   #    BenchCompare.sh baseline ./DoubleBench-dm_double.exe [baseline.json]
+   #    BenchCompare.sh compare  ./DoubleBench-dm_double.exe [baseline.json]
+   # The benchmark is run RUNS times, with REPETITIONS repetitions each, and every repetition is a sample.
+   # FILTER is passed to --benchmark_filter. THRESHOLD and K are passed to the comparator.
+   # compare exits non-zero if any kernel regressed.
+
+RUNS=${RUNS:-3}
+REPETITIONS=${REPETITIONS:-5}
+FILTER=${FILTER:-.}
+THRESHOLD=${THRESHOLD:-0.05}
+K=${K:-3}
+
+if [ "$#" -lt 2 ]; then
+   echo "Usage: $0 baseline|compare BENCHMARK [BASELINE]"
+   exit 2
+fi
+
+MODE=$1
+BENCH=$2
+BASELINE=${3:-$(basename $BENCH .exe).baseline.json}
+
+if [ BenchCompare.cpp -nt BenchCompare ]; then   # Also true if it was never built.
+   g++ -o BenchCompare -Wall -Wextra -Wpedantic -O2 BenchCompare.cpp || exit 2
+fi
+
+WORK=$(mktemp -d)
+trap "rm -rf $WORK" EXIT
+
+RUN_FILES=""
+for RUN in $(seq 1 $RUNS)
+do
+   $BENCH --benchmark_filter="$FILTER" --benchmark_repetitions=$REPETITIONS --benchmark_format=json --benchmark_out_format=json --benchmark_out=$WORK/run$RUN.json > /dev/null || exit 2
+   RUN_FILES="$RUN_FILES $WORK/run$RUN.json"
+done
+
+if [ "$MODE" == "baseline" ]; then
+   ./BenchCompare summarize $RUN_FILES > $BASELINE || exit 2
+   echo "Wrote $BASELINE"
+elif [ "$MODE" == "compare" ]; then
+   ./BenchCompare summarize $RUN_FILES > $WORK/current.json || exit 2
+   ./BenchCompare compare $BASELINE $WORK/current.json $THRESHOLD $K
+else
+   echo "Unknown mode $MODE"
+   exit 2
+fi
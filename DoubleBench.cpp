@@ -0,0 +1,1034 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "benchmark/benchmark.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef MISRAbleC
+#include "dm_double.h"
+#else /* The MISRAbleC version */
+#include "dm_double_m.h"
+#endif /* MISRAbleC */
+
+#include "dm_double_pretty.h"
+#include "dm_double_batch.h"
+#include "dm_single.h"
+#include "dm_quad.h"
+#include "dm_decimal64.h"
+#include "dm_double_layout.h"
+#include "dm_double_column.h"
+#include "dm_double_codec.h"
+
+   // Everything is built through dm_double_fromstring, so that the benchmarks don't care which version they are linked against.
+static const size_t COUNT = 1024U; // A power of two, so that the latency chains can mask their index.
+static const int CUTOFF = 16;
+
+enum Operands
+ {
+   EqualExponents, // The common case: no alignment is needed.
+   ExponentGap,    // The exponents differ by more than CUTOFF + 1: the degenerate path.
+   Cancellation,   // Opposite signs and nearly equal: most of the digits cancel in an add.
+   CancellationSub,// Same sign and nearly equal: most of the digits cancel in a subtract.
+   Specials,       // Zeros, infinities, and NaNs mixed in with normal numbers.
+   Fractions       // Exponents from -2 to 15, for the rounding functions.
+ };
+
+static dm_double makeNumber(std::mt19937_64& gen, int sign, int exponent)
+ {
+   char buffer [32];
+   std::uniform_int_distribution<uint64_t> significand (1000000000000000ULL, 9999999999999999ULL);
+   std::snprintf(buffer, sizeof(buffer), "%s%llue%d", sign ? "-" : "", static_cast<unsigned long long>(significand(gen)), exponent - (CUTOFF - 1));
+   return dm_double_fromstring(buffer);
+ }
+
+static dm_double makeSpecial(std::mt19937_64& gen)
+ {
+   static const char * const specials [] = { "0", "-0", "Inf", "-Inf", "NaN", "1", "-2.5" };
+   std::uniform_int_distribution<size_t> which (0U, (sizeof(specials) / sizeof(specials[0])) - 1U);
+   return dm_double_fromstring(specials[which(gen)]);
+ }
+
+   // Change the last few digits of a number, keeping its exponent.
+static dm_double nudge(std::mt19937_64& gen, dm_double value, int negate)
+ {
+   char buffer [32];
+   std::uniform_int_distribution<int> last (1, 999);
+   int exponent;
+   dm_double significand = dm_double_fabs(dm_double_frexp(value, &exponent));
+   std::snprintf(buffer, sizeof(buffer), "%de-15", last(gen));
+   dm_double delta = dm_double_fromstring(buffer);
+   significand = dm_double_ldexp(dm_double_add(significand, delta), exponent);
+   if (dm_double_signbit(value) != negate)
+      significand = dm_double_neg(significand);
+   return significand;
+ }
+
+static void makeOperands(Operands kind, std::vector<dm_double>& lhs, std::vector<dm_double>& rhs)
+ {
+   std::mt19937_64 gen (kind);
+   std::uniform_int_distribution<int> sign (0, 1);
+   std::uniform_int_distribution<int> exponent (-20, 20);
+   std::uniform_int_distribution<int> gap (CUTOFF + 2, CUTOFF + 40);
+   std::uniform_int_distribution<int> fraction (-2, 15);
+   std::uniform_int_distribution<int> special (0, 3);
+   lhs.resize(COUNT);
+   rhs.resize(COUNT);
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      int e = exponent(gen);
+      switch (kind)
+       {
+         case EqualExponents:
+            lhs[i] = makeNumber(gen, sign(gen), e);
+            rhs[i] = makeNumber(gen, sign(gen), e);
+            break;
+         case ExponentGap:
+            lhs[i] = makeNumber(gen, sign(gen), e);
+            rhs[i] = makeNumber(gen, sign(gen), e - gap(gen));
+            if (sign(gen)) std::swap(lhs[i], rhs[i]);
+            break;
+         case Cancellation:
+            lhs[i] = makeNumber(gen, sign(gen), e);
+            rhs[i] = nudge(gen, lhs[i], 1);
+            break;
+         case CancellationSub:
+            lhs[i] = makeNumber(gen, sign(gen), e);
+            rhs[i] = nudge(gen, lhs[i], 0);
+            break;
+         case Specials: // One in four is special, on either side.
+            lhs[i] = (0 == special(gen)) ? makeSpecial(gen) : makeNumber(gen, sign(gen), e);
+            rhs[i] = (0 == special(gen)) ? makeSpecial(gen) : makeNumber(gen, sign(gen), e);
+            break;
+         case Fractions:
+            lhs[i] = makeNumber(gen, sign(gen), fraction(gen));
+            rhs[i] = makeNumber(gen, sign(gen), fraction(gen));
+            break;
+       }
+    }
+ }
+
+   // The third operand for fma: for Cancellation, it nearly cancels the product, which is fma's pathological case.
+static void makeAddend(Operands kind, const std::vector<dm_double>& lhs, const std::vector<dm_double>& rhs, std::vector<dm_double>& ths)
+ {
+   std::vector<dm_double> other;
+   makeOperands(kind, ths, other);
+   if ((Cancellation == kind) || (CancellationSub == kind))
+    {
+      std::mt19937_64 gen (kind + 100);
+      for (size_t i = 0U; i < COUNT; ++i)
+         ths[i] = nudge(gen, dm_double_mul(lhs[i], rhs[i]), 1);
+    }
+ }
+
+typedef dm_double (*BinaryOp) (dm_double, dm_double);
+typedef dm_double (*UnaryOp) (dm_double);
+typedef int (*CompareOp) (dm_double, dm_double);
+
+static void BM_Binary(benchmark::State& state, BinaryOp op, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(op(lhs[i], rhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Each result picks the next operands, so the calls can't overlap.
+static void BM_BinaryLatency(benchmark::State& state, BinaryOp op, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   dm_double result = 0U;
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         size_t j = (i + (result & 1U)) & (COUNT - 1U);
+         result = op(lhs[j], rhs[j]);
+       }
+    }
+   benchmark::DoNotOptimize(result);
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_Fma(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, ths;
+   makeOperands(kind, lhs, rhs);
+   makeAddend(kind, lhs, rhs, ths);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fma(lhs[i], rhs[i], ths[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FmaLatency(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, ths;
+   makeOperands(kind, lhs, rhs);
+   makeAddend(kind, lhs, rhs, ths);
+   dm_double result = 0U;
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         size_t j = (i + (result & 1U)) & (COUNT - 1U);
+         result = dm_double_fma(lhs[j], rhs[j], ths[j]);
+       }
+    }
+   benchmark::DoNotOptimize(result);
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_Unary(benchmark::State& state, UnaryOp op, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(op(lhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Square roots of the magnitudes of the operands, so that none of them is NaN.
+static void BM_Sqrt(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (size_t i = 0U; i < COUNT; ++i)
+      lhs[i] = dm_double_fabs(lhs[i]);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_sqrt(lhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Bases from 0.001 to 10000, and exponents between -10 and 10, so that every result is finite and normal.
+static void makeMathOperands(std::vector<dm_double>& lhs, std::vector<dm_double>& rhs)
+ {
+   std::mt19937_64 gen (42U);
+   std::uniform_int_distribution<int> sign (0, 1);
+   std::uniform_int_distribution<int> base (-3, 3);
+   std::uniform_int_distribution<int> power (-2, 0);
+   lhs.resize(COUNT);
+   rhs.resize(COUNT);
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      lhs[i] = makeNumber(gen, 0, base(gen));
+      rhs[i] = makeNumber(gen, sign(gen), power(gen));
+    }
+ }
+
+   // exp and expm1 of the exponents, and the logarithms of the bases.
+static void BM_Math(benchmark::State& state, UnaryOp op, bool logarithm)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   const std::vector<dm_double>& args = logarithm ? lhs : rhs;
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(op(args[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_Pow(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_pow(lhs[i], rhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Thirty years of monthly compounding, by binary exponentiation and by repeated multiplication.
+static void BM_Powi(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_powi_r(lhs[i], 360, DM_FE_TONEAREST));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_PowiViaMul(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         dm_double result = lhs[i];
+         for (int j = 1; j < 360; ++j)
+            result = dm_double_mul(result, lhs[i]);
+         benchmark::DoNotOptimize(result);
+       }
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_Compare(benchmark::State& state, CompareOp op, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(op(lhs[i], rhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToString(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   char buffer [25];
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         dm_double_tostring(lhs[i], buffer);
+         benchmark::DoNotOptimize(buffer);
+       }
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToPrettyString(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   char buffer [25];
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         dm_double_toprettystring(lhs[i], buffer);
+         benchmark::DoNotOptimize(buffer);
+       }
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromString(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   std::vector<std::string> strings (COUNT);
+   char buffer [25];
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      dm_double_tostring(lhs[i], buffer);
+      strings[i] = buffer;
+    }
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromstring(strings[i].c_str()));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+#ifndef DM_NO_DOUBLE_MATH
+static void BM_ToDouble(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_todouble(lhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromDouble(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   std::vector<double> doubles (COUNT);
+   for (size_t i = 0U; i < COUNT; ++i)
+      doubles[i] = dm_double_todouble(lhs[i]);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromdouble(doubles[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // The round trip through double that dm_double_sqrt replaces, for comparison.
+static void BM_SqrtViaDouble(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (size_t i = 0U; i < COUNT; ++i)
+      lhs[i] = dm_double_fabs(lhs[i]);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromdouble(std::sqrt(dm_double_todouble(lhs[i]))));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // The same, through double: faster, but rounded in binary, and off in the last digit or two.
+static void BM_ExpViaDouble(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromdouble(std::exp(dm_double_todouble(rhs[i]))));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_LogViaDouble(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromdouble(std::log(dm_double_todouble(lhs[i]))));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_PowViaDouble(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromdouble(std::pow(dm_double_todouble(lhs[i]), dm_double_todouble(rhs[i]))));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+static void BM_AddArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_add_array(lhs.data(), rhs.data(), dest.data(), COUNT, DM_FE_TONEAREST);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_SqrtArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (size_t i = 0U; i < COUNT; ++i)
+      lhs[i] = dm_double_fabs(lhs[i]);
+   for (auto _ : state)
+    {
+      dm_double_sqrt_array(lhs.data(), dest.data(), COUNT, DM_FE_TONEAREST);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_PowArray(benchmark::State& state)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   makeMathOperands(lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_pow_array(lhs.data(), rhs.data(), dest.data(), COUNT);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Running sums of a column big enough to split: the serial loop, and the exact scan on one thread and on all of them.
+static void BM_InclusiveScan(benchmark::State& state, Operands kind, int method, int threads)
+ {
+   const size_t size = COUNT * 256U;
+   std::vector<dm_double> lhs, rhs, src, dest (size);
+   makeOperands(kind, lhs, rhs);
+   for (size_t i = 0U; i < size; ++i)
+      src.push_back(lhs[i % COUNT]);
+   int saved = dm_double_batch_getthreads();
+   dm_double_batch_setthreads(threads);
+   for (auto _ : state)
+    {
+      dm_double_inclusive_scan(src.data(), dest.data(), size, DM_FE_TONEAREST, method);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   dm_double_batch_setthreads(saved);
+   state.SetItemsProcessed(state.iterations() * size);
+ }
+
+   // Rounding a column to cents, in one call.
+static void BM_QuantizeArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_quantize_array(lhs.data(), dest.data(), COUNT, -2, DM_FE_TONEARESTFROMZERO);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Narrowing a column to dm_single, and widening it back for a scan.
+static void BM_ToSingleArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   std::vector<dm_single> dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_tosingle_array(lhs.data(), dest.data(), COUNT, DM_FE_TONEAREST);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromSingleArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   std::vector<dm_single> singles (COUNT);
+   makeOperands(kind, lhs, rhs);
+   dm_double_tosingle_array(lhs.data(), singles.data(), COUNT, DM_FE_TONEAREST);
+   for (auto _ : state)
+    {
+      dm_double_fromsingle_array(singles.data(), dest.data(), COUNT);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Counts and IDs in and out of a column, in place of a string round trip. The fraction operands round.
+static void BM_FromInt64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   std::vector<int64_t> integers (COUNT);
+   makeOperands(kind, lhs, rhs);
+   dm_double_toint64_array(lhs.data(), integers.data(), COUNT, DM_FE_TONEAREST);
+   for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(dm_double_fromint64_array(integers.data(), dest.data(), COUNT, DM_FE_TONEAREST));
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToInt64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   std::vector<int64_t> dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(dm_double_toint64_array(lhs.data(), dest.data(), COUNT, DM_FE_TONEAREST));
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Ledger rows in cents, in and out of a column: the operands in cents, cut to fourteen digits, so that they convert exactly.
+static void makeCents(Operands kind, std::vector<int64_t>& cents)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   cents.resize(COUNT);
+   dm_double_to_scaled_array(lhs.data(), cents.data(), COUNT, 2, DM_FE_TONEAREST);
+   for (size_t i = 0U; i < COUNT; ++i)
+      cents[i] %= 100000000000000LL;
+ }
+
+static void BM_FromScaledArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> dest (COUNT);
+   std::vector<int64_t> cents;
+   makeCents(kind, cents);
+   for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(dm_double_from_scaled_array(cents.data(), dest.data(), COUNT, 2, DM_FE_TONEAREST));
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToScaledArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> amounts (COUNT);
+   std::vector<int64_t> cents;
+   makeCents(kind, cents);
+   dm_double_from_scaled_array(cents.data(), amounts.data(), COUNT, 2, DM_FE_TONEAREST);
+   for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(dm_double_to_scaled_array(amounts.data(), cents.data(), COUNT, 2, DM_FE_TONEAREST));
+      benchmark::DoNotOptimize(cents.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Exporting a column to decimal64, and importing it back. The specials go through the second, scalar pass.
+static void BM_ToBid64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   std::vector<uint64_t> dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_to_bid64_array(lhs.data(), dest.data(), COUNT, DM_FE_TONEAREST);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromBid64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   std::vector<uint64_t> bids (COUNT);
+   makeOperands(kind, lhs, rhs);
+   dm_double_to_bid64_array(lhs.data(), bids.data(), COUNT, DM_FE_TONEAREST);
+   for (auto _ : state)
+    {
+      dm_double_from_bid64_array(bids.data(), dest.data(), COUNT);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToDpd64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   std::vector<uint64_t> dest (COUNT);
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_to_dpd64_array(lhs.data(), dest.data(), COUNT, DM_FE_TONEAREST);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromDpd64Array(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs, dest (COUNT);
+   std::vector<uint64_t> dpds (COUNT);
+   makeOperands(kind, lhs, rhs);
+   dm_double_to_dpd64_array(lhs.data(), dpds.data(), COUNT, DM_FE_TONEAREST);
+   for (auto _ : state)
+    {
+      dm_double_from_dpd64_array(dpds.data(), dest.data(), COUNT);
+      benchmark::DoNotOptimize(dest.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // Moving a stored column from the legacy layout to the MISRA one, in place.
+static void BM_LegacyToMArray(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      dm_double_legacy_to_m_array(lhs.data(), lhs.data(), COUNT);
+      benchmark::DoNotOptimize(lhs.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // A range scan over a mapped column of running totals, which a narrow range finds in a few blocks, with and without the zone maps.
+static void BM_ColumnSelect(benchmark::State& state, bool zones)
+ {
+   const size_t size = COUNT * 256U;
+   std::vector<dm_double> lhs, rhs, values;
+   std::vector<size_t> rows (size);
+   makeOperands(Fractions, lhs, rhs);
+   dm_double total = dm_double_fromstring("0");
+   for (size_t i = 0U; i < size; ++i)
+    {
+      total = dm_double_add(total, dm_double_fabs(lhs[i % COUNT]));
+      values.push_back(total);
+    }
+   dm_double_column column;
+   if ((DM_COLUMN_OK != dm_double_column_write("DoubleBench.column", values.data(), size, 0U)) || (DM_COLUMN_OK != dm_double_column_open("DoubleBench.column", &column)))
+    {
+      state.SkipWithError("Can't write DoubleBench.column");
+      return;
+    }
+   dm_double low = values[size / 2U], high = values[size / 2U + size / 100U];
+   for (auto _ : state)
+    {
+      size_t found = 0U;
+      if (zones)
+         found = dm_double_column_select(&column, low, high, rows.data());
+      else
+         for (size_t i = 0U; i < size; ++i)
+          {
+            rows[found] = i;
+            found += (size_t)(dm_double_islessequal(low, column.values[i]) & dm_double_islessequal(column.values[i], high));
+          }
+      benchmark::DoNotOptimize(found);
+    }
+   dm_double_column_close(&column);
+   std::remove("DoubleBench.column");
+   state.SetItemsProcessed(state.iterations() * size);
+ }
+
+   // Prices in cents, up to 10000.00, a block of COUNT at a time. The counter is the size of the encoded block against the raw one.
+static void makeCents(std::vector<dm_double>& values)
+ {
+   std::mt19937_64 gen (42);
+   std::uniform_int_distribution<int64_t> cents (0, 1000000);
+   values.resize(COUNT);
+   for (size_t i = 0U; i < COUNT; ++i)
+      dm_double_from_scaled_r(cents(gen), 2, DM_FE_TONEAREST, &values[i]);
+ }
+
+static void BM_BlockEncode(benchmark::State& state)
+ {
+   std::vector<dm_double> values;
+   std::vector<unsigned char> encoded (DM_CODEC_MAX_ENCODED(COUNT));
+   makeCents(values);
+   size_t size = 0U;
+   for (auto _ : state)
+    {
+      size = dm_double_block_encode(values.data(), COUNT, encoded.data());
+      benchmark::DoNotOptimize(encoded.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+   state.counters["ratio"] = static_cast<double>(COUNT * sizeof(dm_double)) / static_cast<double>(size);
+ }
+
+static void BM_BlockDecode(benchmark::State& state)
+ {
+   std::vector<dm_double> values, decoded (COUNT);
+   std::vector<unsigned char> encoded (DM_CODEC_MAX_ENCODED(COUNT));
+   makeCents(values);
+   dm_double_block_encode(values.data(), COUNT, encoded.data());
+   for (auto _ : state)
+    {
+      dm_double_block_decode(encoded.data(), decoded.data());
+      benchmark::DoNotOptimize(decoded.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // A stream of varints, from prices in cents or from full sixteen digit significands. The counter is the bytes per value.
+static void BM_VarintEncode(benchmark::State& state, bool cents)
+ {
+   std::vector<dm_double> values, rhs;
+   std::vector<unsigned char> stream (COUNT * DM_VARINT_MAX_BYTES);
+   if (cents)
+      makeCents(values);
+   else
+      makeOperands(EqualExponents, values, rhs);
+   size_t written = 0U;
+   for (auto _ : state)
+    {
+      dm_double_to_varint_array(values.data(), COUNT, stream.data(), stream.size(), &written);
+      benchmark::DoNotOptimize(stream.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+   state.counters["bytes"] = static_cast<double>(written) / COUNT;
+ }
+
+static void BM_VarintDecode(benchmark::State& state, bool cents)
+ {
+   std::vector<dm_double> values, rhs, decoded (COUNT);
+   std::vector<unsigned char> stream (COUNT * DM_VARINT_MAX_BYTES);
+   if (cents)
+      makeCents(values);
+   else
+      makeOperands(EqualExponents, values, rhs);
+   size_t written = 0U, read = 0U;
+   dm_double_to_varint_array(values.data(), COUNT, stream.data(), stream.size(), &written);
+   for (auto _ : state)
+    {
+      dm_double_from_varint_array(stream.data(), written, decoded.data(), COUNT, &read);
+      benchmark::DoNotOptimize(decoded.data());
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+   // The dm_quad operands are the dm_double operands times a thirty-four-digit number, so that every digit is in use.
+static void makeQuads(Operands kind, std::vector<dm_quad>& lhs, std::vector<dm_quad>& rhs, std::vector<dm_quad>& ths)
+ {
+   std::vector<dm_double> left, right, third;
+   makeOperands(kind, left, right);
+   makeAddend(kind, left, right, third);
+   const dm_quad digits = dm_quad_fromstring("1.234567890123456789012345678901234");
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      lhs.push_back(dm_quad_mul(dm_double_toquad(left[i]), digits));
+      rhs.push_back(dm_quad_mul(dm_double_toquad(right[i]), digits));
+      ths.push_back(dm_quad_mul(dm_double_toquad(third[i]), digits));
+    }
+ }
+
+typedef dm_quad (*QuadBinaryOp) (dm_quad, dm_quad);
+
+static void BM_QuadBinary(benchmark::State& state, QuadBinaryOp op, Operands kind)
+ {
+   std::vector<dm_quad> lhs, rhs, ths;
+   makeQuads(kind, lhs, rhs, ths);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(op(lhs[i], rhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_QuadFma(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_quad> lhs, rhs, ths;
+   makeQuads(kind, lhs, rhs, ths);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_quad_fma(lhs[i], rhs[i], ths[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_QuadToString(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_quad> lhs, rhs, ths;
+   char buffer [43];
+   makeQuads(kind, lhs, rhs, ths);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+       {
+         dm_quad_tostring(lhs[i], buffer);
+         benchmark::DoNotOptimize(buffer);
+       }
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_QuadFromString(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_quad> lhs, rhs, ths;
+   std::vector<std::string> strings;
+   char buffer [43];
+   makeQuads(kind, lhs, rhs, ths);
+   for (size_t i = 0U; i < COUNT; ++i)
+    {
+      dm_quad_tostring(lhs[i], buffer);
+      strings.push_back(buffer);
+    }
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_quad_fromstring(strings[i].c_str()));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_ToQuad(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_double> lhs, rhs;
+   makeOperands(kind, lhs, rhs);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_toquad(lhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+static void BM_FromQuad(benchmark::State& state, Operands kind)
+ {
+   std::vector<dm_quad> lhs, rhs, ths;
+   makeQuads(kind, lhs, rhs, ths);
+   for (auto _ : state)
+    {
+      for (size_t i = 0U; i < COUNT; ++i)
+         benchmark::DoNotOptimize(dm_double_fromquad(lhs[i]));
+    }
+   state.SetItemsProcessed(state.iterations() * COUNT);
+ }
+
+#define DM_BENCH_BINARY(op) \
+   BENCHMARK_CAPTURE(BM_Binary, op##_equal, dm_double_##op, EqualExponents); \
+   BENCHMARK_CAPTURE(BM_Binary, op##_gap, dm_double_##op, ExponentGap); \
+   BENCHMARK_CAPTURE(BM_Binary, op##_cancel, dm_double_##op, Cancellation); \
+   BENCHMARK_CAPTURE(BM_Binary, op##_cancelsub, dm_double_##op, CancellationSub); \
+   BENCHMARK_CAPTURE(BM_Binary, op##_special, dm_double_##op, Specials); \
+   BENCHMARK_CAPTURE(BM_BinaryLatency, op##_equal, dm_double_##op, EqualExponents); \
+   BENCHMARK_CAPTURE(BM_BinaryLatency, op##_gap, dm_double_##op, ExponentGap)
+
+DM_BENCH_BINARY(add);
+DM_BENCH_BINARY(sub);
+DM_BENCH_BINARY(mul);
+DM_BENCH_BINARY(div);
+DM_BENCH_BINARY(fmod);
+
+BENCHMARK_CAPTURE(BM_Fma, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_Fma, gap, ExponentGap);
+BENCHMARK_CAPTURE(BM_Fma, cancel, Cancellation);
+BENCHMARK_CAPTURE(BM_Fma, special, Specials);
+BENCHMARK_CAPTURE(BM_FmaLatency, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FmaLatency, cancel, Cancellation);
+
+#define DM_BENCH_UNARY(op) \
+   BENCHMARK_CAPTURE(BM_Unary, op##_fraction, dm_double_##op, Fractions); \
+   BENCHMARK_CAPTURE(BM_Unary, op##_special, dm_double_##op, Specials)
+
+DM_BENCH_UNARY(ceil);
+DM_BENCH_UNARY(floor);
+DM_BENCH_UNARY(trunc);
+DM_BENCH_UNARY(nearbyint);
+DM_BENCH_UNARY(round);
+DM_BENCH_UNARY(roundeven);
+
+#define DM_BENCH_COMPARE(op) \
+   BENCHMARK_CAPTURE(BM_Compare, op##_equal, dm_double_##op, EqualExponents); \
+   BENCHMARK_CAPTURE(BM_Compare, op##_special, dm_double_##op, Specials)
+
+BENCHMARK_CAPTURE(BM_Sqrt, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_Sqrt, special, Specials);
+BENCHMARK_CAPTURE(BM_Math, exp, dm_double_exp, false);
+BENCHMARK_CAPTURE(BM_Math, expm1, dm_double_expm1, false);
+BENCHMARK_CAPTURE(BM_Math, log, dm_double_log, true);
+BENCHMARK_CAPTURE(BM_Math, log10, dm_double_log10, true);
+BENCHMARK(BM_Pow);
+BENCHMARK(BM_Powi);
+BENCHMARK(BM_PowiViaMul);
+
+DM_BENCH_COMPARE(isless);
+DM_BENCH_COMPARE(islessequal);
+DM_BENCH_COMPARE(isgreater);
+DM_BENCH_COMPARE(isequal);
+DM_BENCH_COMPARE(isunordered);
+
+BENCHMARK_CAPTURE(BM_ToString, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToString, special, Specials);
+BENCHMARK_CAPTURE(BM_ToPrettyString, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToPrettyString, fraction, Fractions);
+BENCHMARK_CAPTURE(BM_ToPrettyString, special, Specials);
+BENCHMARK_CAPTURE(BM_FromString, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromString, fraction, Fractions);
+
+#ifndef DM_NO_DOUBLE_MATH
+BENCHMARK_CAPTURE(BM_ToDouble, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToDouble, special, Specials);
+BENCHMARK_CAPTURE(BM_FromDouble, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromDouble, special, Specials);
+BENCHMARK_CAPTURE(BM_SqrtViaDouble, equal, EqualExponents);
+BENCHMARK(BM_ExpViaDouble);
+BENCHMARK(BM_LogViaDouble);
+BENCHMARK(BM_PowViaDouble);
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+BENCHMARK_CAPTURE(BM_AddArray, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_SqrtArray, equal, EqualExponents);
+BENCHMARK(BM_PowArray);
+BENCHMARK_CAPTURE(BM_InclusiveScan, serial, Fractions, DM_SCAN_SERIAL, 1);
+BENCHMARK_CAPTURE(BM_InclusiveScan, exact_1_thread, Fractions, DM_SCAN_EXACT, 1);
+BENCHMARK_CAPTURE(BM_InclusiveScan, exact, Fractions, DM_SCAN_EXACT, 0);
+BENCHMARK_CAPTURE(BM_InclusiveScan, exact_gap, ExponentGap, DM_SCAN_EXACT, 0);
+BENCHMARK_CAPTURE(BM_QuantizeArray, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_QuantizeArray, fraction, Fractions);
+BENCHMARK_CAPTURE(BM_ToSingleArray, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToSingleArray, special, Specials);
+BENCHMARK_CAPTURE(BM_FromSingleArray, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromSingleArray, special, Specials);
+BENCHMARK_CAPTURE(BM_FromInt64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToInt64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToInt64Array, fraction, Fractions);
+BENCHMARK_CAPTURE(BM_FromScaledArray, fraction, Fractions);
+BENCHMARK_CAPTURE(BM_ToScaledArray, fraction, Fractions);
+BENCHMARK_CAPTURE(BM_ToBid64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToBid64Array, special, Specials);
+BENCHMARK_CAPTURE(BM_FromBid64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromBid64Array, special, Specials);
+BENCHMARK_CAPTURE(BM_ToDpd64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromDpd64Array, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_LegacyToMArray, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ColumnSelect, full_scan, false);
+BENCHMARK_CAPTURE(BM_ColumnSelect, zone_maps, true);
+BENCHMARK(BM_BlockEncode);
+BENCHMARK(BM_BlockDecode);
+BENCHMARK_CAPTURE(BM_VarintEncode, cents, true);
+BENCHMARK_CAPTURE(BM_VarintEncode, full, false);
+BENCHMARK_CAPTURE(BM_VarintDecode, cents, true);
+BENCHMARK_CAPTURE(BM_VarintDecode, full, false);
+
+#define DM_BENCH_QUAD(op) \
+   BENCHMARK_CAPTURE(BM_QuadBinary, op##_equal, dm_quad_##op, EqualExponents); \
+   BENCHMARK_CAPTURE(BM_QuadBinary, op##_gap, dm_quad_##op, ExponentGap); \
+   BENCHMARK_CAPTURE(BM_QuadBinary, op##_cancel, dm_quad_##op, Cancellation); \
+   BENCHMARK_CAPTURE(BM_QuadBinary, op##_special, dm_quad_##op, Specials)
+
+DM_BENCH_QUAD(add);
+DM_BENCH_QUAD(sub);
+DM_BENCH_QUAD(mul);
+DM_BENCH_QUAD(div);
+
+BENCHMARK_CAPTURE(BM_QuadFma, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_QuadFma, cancel, Cancellation);
+BENCHMARK_CAPTURE(BM_QuadToString, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_QuadFromString, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_ToQuad, equal, EqualExponents);
+BENCHMARK_CAPTURE(BM_FromQuad, equal, EqualExponents);
+
+BENCHMARK_MAIN();
@@ -32,6 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "gtest/gtest.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 
 #ifndef MISRAbleC
 
@@ -58,6 +60,22 @@ const uint64_t MIN_SIGNIFICAND = 1000000000000000ULL;
 #endif /* MISRAbleC */
 
 #include "dm_double_pretty.h"
+#include "dm_double_batch.h"
+#include "dm_single.h"
+#include "dm_quad.h"
+#include "dm_decimal64.h"
+#include "dm_double_layout.h"
+#include "dm_double_column.h"
+#include "dm_double_codec.h"
+#include "dm_double.hpp"
+
+   // Marsaglia's xorshift64, for the tests that try many values: each test gets the same values on every run.
+struct TestRandom
+ {
+   uint64_t state;
+   explicit TestRandom(uint64_t seed = 88172645463325252ULL) : state(seed) { }
+   uint64_t operator()() { state ^= state << 13; state ^= state >> 7; state ^= state << 17; return state; }
+ };
 
 TEST(DMDoubleTest, testComparisons) // It was super easy to copy and modify this code from the SlowFloat tests
  {
@@ -1536,6 +1554,11 @@ TEST(DMDoubleTest, testVarious)
    EXPECT_EQ(DM_DOUBLE_PACK(1, 500, 1234567890123456ULL), dm_double_ldexp(DM_DOUBLE_PACK(1, -12, 1234567890123456ULL), 512));
    EXPECT_EQ(DM_DOUBLE_PACK(0, -500, 1234567890123456ULL), dm_double_ldexp(DM_DOUBLE_PACK(0, 12, 1234567890123456ULL), -512));
    EXPECT_EQ(DM_DOUBLE_PACK(1, -500, 1234567890123456ULL), dm_double_ldexp(DM_DOUBLE_PACK(1, 12, 1234567890123456ULL), -512));
+   EXPECT_EQ(positiveZero, dm_double_ldexp(positiveZero, 1200));
+   EXPECT_EQ(negativeZero, dm_double_ldexp(negativeZero, -1200));
+   EXPECT_EQ(positiveInf, dm_double_ldexp(positiveInf, -1200));
+   EXPECT_EQ(negativeInf, dm_double_ldexp(negativeInf, 1));
+   EXPECT_EQ(nan, dm_double_ldexp(nan, -1));
 
    dm_double temp;
    EXPECT_EQ(positiveZero, dm_double_modf(positiveInf, &temp));
@@ -1551,6 +1574,20 @@ TEST(DMDoubleTest, testVarious)
    EXPECT_EQ(positiveOne, temp);
    EXPECT_EQ(DM_DOUBLE_PACK(1, -1, 5000000000000000ULL), dm_double_modf(DM_DOUBLE_PACK(1, 0, 1500000000000000ULL), &temp));
    EXPECT_EQ(negativeOne, temp);
+
+   EXPECT_EQ(1, dm_double_digits(positiveOne));
+   EXPECT_EQ(15, dm_double_trailing_zeros(negativeOne));
+   EXPECT_EQ(16, dm_double_digits(DM_DOUBLE_PACK(0, 12, 1234567890123456ULL)));
+   EXPECT_EQ(0, dm_double_trailing_zeros(DM_DOUBLE_PACK(1, 12, 1234567890123456ULL)));
+   EXPECT_EQ(9, dm_double_digits(DM_DOUBLE_PACK(1, -500, 1234567890000000ULL)));
+   EXPECT_EQ(7, dm_double_trailing_zeros(DM_DOUBLE_PACK(0, 500, 1234567890000000ULL)));
+   EXPECT_EQ(15, dm_double_digits(DM_DOUBLE_PACK(0, 0, 9999999999999990ULL)));
+   EXPECT_EQ(1, dm_double_trailing_zeros(DM_DOUBLE_PACK(0, 0, 9999999999999990ULL)));
+   for (dm_double special : { positiveZero, negativeZero, positiveInf, negativeInf, nan })
+    {
+      EXPECT_EQ(0, dm_double_digits(special));
+      EXPECT_EQ(0, dm_double_trailing_zeros(special));
+    }
  }
 
 TEST(DMDoubleTest, testRounds)
@@ -2782,4 +2819,1982 @@ TEST(DMDoubleTest, testPrettyPrint)
    EXPECT_STREQ("1e+20", dest);
    dm_double_toprettystring(DM_DOUBLE_PACK(1, 20, 1000000000000000ULL), dest);
    EXPECT_STREQ("-1e+20", dest);
+
+      // The length comes back, and the longest strings fit.
+   EXPECT_EQ(4, dm_double_toprettystring(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dest));
+   EXPECT_EQ(3, dm_double_toprettystring(DM_DOUBLE_PACK(1, 90, 10000000123456789ULL), dest));
+   EXPECT_EQ(2, dm_double_toprettystring(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dest));
+   EXPECT_EQ(23, dm_double_toprettystring(DM_DOUBLE_PACK(1, -511, 1234567890123456ULL), dest));
+   EXPECT_EQ(23, dm_double_toprettystring(DM_DOUBLE_PACK(1, -9, 1234567890120000ULL), dest));
+   EXPECT_STREQ("-0.00000000123456789012", dest);
+   EXPECT_EQ(4, dm_double_toprettystring(DM_DOUBLE_PACK(0, 3, 1200000000000000ULL), dest));
+   EXPECT_STREQ("1200", dest);
+   EXPECT_EQ(17, dm_double_toprettystring(DM_DOUBLE_PACK(0, 2, 1000000000000001ULL), dest));
+   EXPECT_STREQ("100.0000000000001", dest);
+
+      // Every pretty string reads back as the same number.
+   TestRandom next(0x9E3779B97F4A7C15ULL);
+   for (int i = 0; i < 100000; ++i)
+    {
+      uint64_t significand = 1000000000000000ULL + next() % 9000000000000000ULL;
+      significand -= significand % (uint64_t)std::pow(10.0, (double)(next() % 16U));
+      dm_double value = DM_DOUBLE_PACK(next() & 1U, (int)(next() % 41U) - 20, significand);
+      int length = dm_double_toprettystring(value, dest);
+      EXPECT_EQ(strlen(dest), (size_t)length);
+      EXPECT_EQ(value, dm_double_fromstring(dest)) << dest;
+    }
+ }
+
+TEST(DMDoubleTest, testBatch)
+ {
+   const dm_double lhs [] =
+    {
+      DM_DOUBLE_PACK(0, 0, 1000000000000000ULL), DM_DOUBLE_PACK(1, 3, 1234567890123456ULL), DM_DOUBLE_PACK(0, -20, 9999999999999999ULL),
+      DM_DOUBLE_PACK(0, 511, 5000000000000000ULL), DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY),
+      DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1U)
+    };
+   const dm_double rhs [] =
+    {
+      DM_DOUBLE_PACK(0, 0, 1000000000000000ULL), DM_DOUBLE_PACK(0, 1, 7000000000000001ULL), DM_DOUBLE_PACK(1, -3, 3333333333333333ULL),
+      DM_DOUBLE_PACK(0, 511, 5000000000000000ULL), DM_DOUBLE_PACK(1, 2, 2000000000000000ULL), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY),
+      DM_DOUBLE_PACK(0, 0, 1000000000000000ULL)
+    };
+   const size_t count = sizeof(lhs) / sizeof(lhs[0]);
+   const char * strings [] = { "1", "-1234.567890123456", "9.999999999999999e-20", "5e511", "0", "-Inf", "NaN" };
+   dm_double dest [count];
+   int cmp [count];
+
+   int hardware = dm_double_batch_setisa(DM_ISA_AVX512);
+   EXPECT_EQ(hardware, dm_double_batch_getisa());
+   EXPECT_EQ(DM_ISA_SCALAR, dm_double_batch_setisa(-1));
+
+   for (int level = DM_ISA_SCALAR; level <= hardware; ++level)
+    {
+      EXPECT_EQ(level, dm_double_batch_setisa(level));
+
+      dm_double_add_array(lhs, rhs, dest, count, DM_FE_UPWARD);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_add_r(lhs[i], rhs[i], DM_FE_UPWARD), dest[i]);
+      dm_double_sub_array(lhs, rhs, dest, count, DM_FE_DOWNWARD);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_sub_r(lhs[i], rhs[i], DM_FE_DOWNWARD), dest[i]);
+      dm_double_mul_array(lhs, rhs, dest, count, DM_FE_TONEAREST);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_mul_r(lhs[i], rhs[i], DM_FE_TONEAREST), dest[i]);
+      dm_double_div_array(lhs, rhs, dest, count, DM_FE_TOWARDZERO);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_div_r(lhs[i], rhs[i], DM_FE_TOWARDZERO), dest[i]);
+      dm_double_sqrt_array(lhs, dest, count, DM_FE_UPWARD);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_sqrt_r(lhs[i], DM_FE_UPWARD), dest[i]);
+      dm_double_fma_array(lhs, rhs, lhs, dest, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_fma(lhs[i], rhs[i], lhs[i]), dest[i]);
+
+      dm_double_isless_array(lhs, rhs, cmp, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_isless(lhs[i], rhs[i]), cmp[i]);
+      dm_double_islessequal_array(lhs, rhs, cmp, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_islessequal(lhs[i], rhs[i]), cmp[i]);
+      dm_double_isgreater_array(lhs, rhs, cmp, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_isgreater(lhs[i], rhs[i]), cmp[i]);
+      dm_double_isgreaterequal_array(lhs, rhs, cmp, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_isgreaterequal(lhs[i], rhs[i]), cmp[i]);
+      dm_double_isequal_array(lhs, rhs, cmp, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_isequal(lhs[i], rhs[i]), cmp[i]);
+
+      dm_double_fromstring_array(strings, dest, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_fromstring(strings[i]), dest[i]);
+
+#ifndef DM_NO_DOUBLE_MATH
+      double temp [count];
+      dm_double_todouble_array(lhs, temp, count);
+      for (size_t i = 0U; i < 6U; ++i) EXPECT_EQ(dm_double_todouble(lhs[i]), temp[i]); // NaN isn't equal to itself
+      dm_double_fromdouble_array(temp, dest, count);
+      for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_fromdouble(temp[i]), dest[i]);
+#endif /* ! DM_NO_DOUBLE_MATH */
+    }
+ }
+
+TEST(DMDoubleTest, testSingle)
+ {
+   const dm_single zero = DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, 0U);
+   const dm_single inf  = DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, DM_SINGLE_INFINITY);
+   const dm_single one  = DM_SINGLE_PACK(0, 0, 1000000U);
+   EXPECT_EQ(0U, zero); // A zero-filled column is positive zeros.
+   EXPECT_EQ(zero, dm_single_Zero);
+   EXPECT_EQ(inf, dm_single_Inf);
+   EXPECT_TRUE(dm_single_isnan(dm_single_NaN));
+   EXPECT_TRUE(dm_single_isnormal(one));
+   EXPECT_TRUE(dm_single_signbit(dm_single_neg(zero)));
+   EXPECT_EQ(one, dm_single_fabs(dm_single_neg(one)));
+   EXPECT_TRUE(dm_single_isless(dm_single_neg(one), zero));
+   EXPECT_TRUE(dm_single_isequal(zero, dm_single_neg(zero)));
+   EXPECT_TRUE(dm_single_isunordered(one, dm_single_NaN));
+
+      // Widening is exact, and keeps the special values.
+   EXPECT_EQ(DM_DOUBLE_PACK(1, -3, 1234567000000000ULL), dm_double_fromsingle(DM_SINGLE_PACK(1, -3, 1234567U)));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 63, 9999999000000000ULL), dm_double_fromsingle(DM_SINGLE_PACK(0, 63, 9999999U)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dm_double_fromsingle(dm_single_neg(zero)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_fromsingle(dm_single_neg(inf)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U), dm_double_fromsingle(DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, 1234U)));
+
+      // Narrowing rounds once, and flushes to the narrower range.
+   EXPECT_EQ(DM_SINGLE_PACK(0, 0, 1000000U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, 0, 1000000499999999ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, 0, 1000000U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, 0, 1000000500000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, 0, 1000002U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, 0, 1000001500000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, 0, 1000001U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, 0, 1000000000000001ULL), DM_FE_UPWARD));
+   EXPECT_EQ(DM_SINGLE_PACK(1, 0, 1000000U), dm_double_tosingle_r(DM_DOUBLE_PACK(1, 0, 1000000000000001ULL), DM_FE_UPWARD));
+   EXPECT_EQ(DM_SINGLE_PACK(1, 1, 1000000U), dm_double_tosingle_r(DM_DOUBLE_PACK(1, 0, 9999999500000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_single_neg(inf), dm_double_tosingle_r(DM_DOUBLE_PACK(1, 63, 9999999500000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, 63, 9999999U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, 63, 9999999500000000ULL), DM_FE_TOWARDZERO));
+   EXPECT_EQ(inf, dm_double_tosingle_r(DM_DOUBLE_PACK(0, 64, 1000000000000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_single_neg(zero), dm_double_tosingle_r(DM_DOUBLE_PACK(1, -64, 9999999000000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, -63, 1000000U), dm_double_tosingle_r(DM_DOUBLE_PACK(0, -64, 9999999500000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, 1234U), dm_double_tosingle_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U), DM_FE_TONEAREST));
+   EXPECT_TRUE(dm_single_isnan(dm_double_tosingle_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY - 1U), DM_FE_TONEAREST)));
+   EXPECT_EQ(dm_single_neg(inf), dm_double_tosingle(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY)));
+
+      // The arithmetic rounds once, even where rounding to sixteen digits and then to seven would not.
+   const dm_single tiny = DM_SINGLE_PACK(0, -20, 1000000U);
+   EXPECT_EQ(DM_SINGLE_PACK(0, 1, 1000001U), dm_single_fma(DM_SINGLE_PACK(0, 0, 2000001U), DM_SINGLE_PACK(0, 0, 5000000U), tiny)); // 10.000005 + 1e-20
+   EXPECT_EQ(DM_SINGLE_PACK(0, 0, 1000001U), dm_single_add_r(one, tiny, DM_FE_UPWARD));
+   EXPECT_EQ(one, dm_single_add_r(one, tiny, DM_FE_TONEAREST));
+   EXPECT_EQ(DM_SINGLE_PACK(0, -1, 9999999U), dm_single_sub_r(one, tiny, DM_FE_DOWNWARD));
+   EXPECT_EQ(DM_SINGLE_PACK(0, -1, 3333334U), dm_single_div_r(one, DM_SINGLE_PACK(0, 0, 3000000U), DM_FE_FROMZERO));
+   EXPECT_EQ(dm_single_neg(zero), dm_single_sub_r(one, one, DM_FE_DOWNWARD));
+   EXPECT_EQ(zero, dm_single_sub_r(one, one, DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_single_mul_r(DM_SINGLE_PACK(0, 63, 1000000U), DM_SINGLE_PACK(0, 1, 1000000U), DM_FE_TONEAREST));
+   EXPECT_EQ(zero, dm_single_mul_r(DM_SINGLE_PACK(0, -63, 1000000U), DM_SINGLE_PACK(0, -1, 1000000U), DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_single_div_r(one, zero, DM_FE_TONEAREST));
+   EXPECT_TRUE(dm_single_isnan(dm_single_mul_r(inf, zero, DM_FE_TONEAREST)));
+   EXPECT_TRUE(dm_single_isnan(dm_single_add_r(inf, dm_single_neg(inf), DM_FE_TONEAREST)));
+
+      // Where the sixteen-digit result is exact, narrowing it is the correctly rounded result.
+   TestRandom next;
+   auto make = [&next](int exponent) -> dm_single
+    {
+      return DM_SINGLE_PACK(next() & 1U, exponent, DM_SINGLE_MIN_SIGNIFICAND + next() % 9000000U);
+    };
+   for (int i = 0; i < 100000; ++i)
+    {
+      int mode = i % 8;
+      int lhsExponent = static_cast<int>(next() % 9U) - 4, rhsExponent = static_cast<int>(next() % 9U) - 4;
+      dm_single lhs = make(lhsExponent), rhs = make(rhsExponent);
+      dm_single ths = make(lhsExponent + rhsExponent - 6 + static_cast<int>(next() % 8U));
+      dm_double wideLhs = dm_double_fromsingle(lhs), wideRhs = dm_double_fromsingle(rhs), wideThs = dm_double_fromsingle(ths);
+      EXPECT_EQ(dm_double_tosingle_r(dm_double_add_r(wideLhs, wideRhs, mode), mode), dm_single_add_r(lhs, rhs, mode));
+      EXPECT_EQ(dm_double_tosingle_r(dm_double_sub_r(wideLhs, wideRhs, mode), mode), dm_single_sub_r(lhs, rhs, mode));
+      EXPECT_EQ(dm_double_tosingle_r(dm_double_mul_r(wideLhs, wideRhs, mode), mode), dm_single_mul_r(lhs, rhs, mode));
+      dm_fesetround(mode);
+      EXPECT_EQ(dm_double_tosingle(dm_double_fma(wideLhs, wideRhs, wideThs)), dm_single_fma(lhs, rhs, ths));
+         // A quotient of seven-digit numbers is never within a sixteen-digit rounding of a seven-digit tie.
+      EXPECT_EQ(dm_double_tosingle_r(dm_double_div_r(wideLhs, wideRhs, DM_FE_TONEAREST), mode), dm_single_div_r(lhs, rhs, mode));
+    }
+   dm_fesetround(DM_FE_TONEAREST);
+
+      // The arrays match the scalar conversions.
+   const dm_double wide [] =
+    {
+      DM_DOUBLE_PACK(0, 0, 1234567500000000ULL), DM_DOUBLE_PACK(1, -70, 1000000000000000ULL), DM_DOUBLE_PACK(0, 100, 1000000000000000ULL),
+      DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), DM_DOUBLE_PACK(1, 5, 9999999999999999ULL)
+    };
+   const size_t count = sizeof(wide) / sizeof(wide[0]);
+   dm_single narrow [count];
+   dm_double back [count];
+   dm_double_tosingle_array(wide, narrow, count, DM_FE_UPWARD);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_tosingle_r(wide[i], DM_FE_UPWARD), narrow[i]);
+   dm_double_fromsingle_array(narrow, back, count);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_fromsingle(narrow[i]), back[i]);
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_single_mul_r(one, one, DM_FE_TONEAREST);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_single_add_r(one, tiny, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_single_div_r(one, zero, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT | DM_FE_DIVBYZERO, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_tosingle_r(DM_DOUBLE_PACK(0, 64, 1000000000000000ULL), DM_FE_TONEAREST);
+   EXPECT_TRUE(dm_fetestexcept(DM_FE_OVERFLOW));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testQuad)
+ {
+   auto str = [](dm_quad arg) { char buffer [43]; dm_quad_tostring(arg, buffer); return std::string(buffer); };
+   auto same = [](dm_quad lhs, dm_quad rhs) { return (lhs.high == rhs.high) && (lhs.low == rhs.low); };
+   const dm_quad one = dm_quad_fromstring("1");
+   const dm_quad three = dm_quad_fromstring("3");
+   const dm_quad zero = dm_quad_Zero;
+
+   EXPECT_EQ(0U, zero.high); // A zero-filled column is positive zeros.
+   EXPECT_EQ(0U, zero.low);
+   EXPECT_TRUE(dm_quad_iszero(zero));
+   EXPECT_TRUE(dm_quad_isinf(dm_quad_Inf));
+   EXPECT_TRUE(dm_quad_isnan(dm_quad_NaN));
+   EXPECT_TRUE(dm_quad_isnormal(one));
+   EXPECT_TRUE(dm_quad_signbit(dm_quad_neg(zero)));
+   EXPECT_TRUE(same(one, dm_quad_fabs(dm_quad_neg(one))));
+   EXPECT_TRUE(dm_quad_isless(dm_quad_neg(one), zero));
+   EXPECT_TRUE(dm_quad_isless(one, three));
+   EXPECT_TRUE(dm_quad_isless(dm_quad_neg(three), dm_quad_neg(one)));
+   EXPECT_TRUE(dm_quad_isless(three, dm_quad_Inf));
+   EXPECT_TRUE(dm_quad_isgreater(dm_quad_fromstring("1e-8000"), zero));
+   EXPECT_TRUE(dm_quad_isequal(zero, dm_quad_neg(zero)));
+   EXPECT_TRUE(dm_quad_isunordered(one, dm_quad_NaN));
+   EXPECT_FALSE(dm_quad_isgreaterequal(dm_quad_NaN, dm_quad_NaN));
+
+      // Strings
+   EXPECT_EQ("1.000000000000000000000000000000000e+0", str(one));
+   EXPECT_EQ("-0.000000000000000000000000000000000e+0", str(dm_quad_neg(zero)));
+   EXPECT_EQ("-Inf", str(dm_quad_neg(dm_quad_Inf)));
+   EXPECT_EQ("NaN", str(dm_quad_NaN));
+   EXPECT_EQ("-9.999999999999999999999999999999999e-8191", str(dm_quad_fromstring("-9999999999999999999999999999999999e-8224")));
+   EXPECT_EQ("1.234567890123456789012345678901234e+100", str(dm_quad_fromstring("12345678901234567890.12345678901234e81")));
+   EXPECT_EQ("1.234567890123456789012345678901234e-5", str(dm_quad_fromstring("0.00001234567890123456789012345678901234499")));
+   EXPECT_EQ("1.234567890123456789012345678901234e-5", str(dm_quad_fromstring("0.000012345678901234567890123456789012345")));
+   EXPECT_EQ("1.234567890123456789012345678901236e-5", str(dm_quad_fromstring("0.000012345678901234567890123456789012355")));
+   EXPECT_EQ("1.000000000000000000000000000000000e+1", str(dm_quad_fromstring("9.9999999999999999999999999999999999")));
+   EXPECT_TRUE(dm_quad_isinf(dm_quad_fromstring("1e8192")));
+   EXPECT_TRUE(dm_quad_iszero(dm_quad_fromstring("1e-8192")));
+
+      // Arithmetic
+   EXPECT_EQ("3.333333333333333333333333333333333e-1", str(dm_quad_div(one, three)));
+   EXPECT_EQ("6.666666666666666666666666666666667e-1", str(dm_quad_div_r(dm_quad_fromstring("2"), three, DM_FE_FROMZERO)));
+   EXPECT_EQ("6.666666666666666666666666666666666e-1", str(dm_quad_div_r(dm_quad_fromstring("2"), three, DM_FE_TOWARDZERO)));
+   EXPECT_EQ("1.000000000000000000000000000000001e+0", str(dm_quad_add_r(one, dm_quad_fromstring("1e-40"), DM_FE_UPWARD)));
+   EXPECT_EQ("9.999999999999999999999999999999999e-1", str(dm_quad_sub_r(one, dm_quad_fromstring("1e-40"), DM_FE_DOWNWARD)));
+   EXPECT_EQ("1.000000000000000000000000000000000e+0", str(dm_quad_sub_r(one, dm_quad_fromstring("1e-40"), DM_FE_TONEAREST)));
+   EXPECT_EQ("1.000000000000000000000000000000000e-33", str(dm_quad_sub(dm_quad_fromstring("1.000000000000000000000000000000001"), one)));
+   EXPECT_EQ("-0.000000000000000000000000000000000e+0", str(dm_quad_sub_r(three, three, DM_FE_DOWNWARD)));
+   EXPECT_EQ("0.000000000000000000000000000000000e+0", str(dm_quad_sub_r(three, three, DM_FE_TONEAREST)));
+   EXPECT_EQ("1.219326311370217952261850327338667e+1", str(dm_quad_mul(dm_quad_fromstring("1.234567890123456789012345678901234"), dm_quad_fromstring("9.876543210987654321098765432109876"))));
+   EXPECT_EQ("2.580028964404791648155158039986984e-33", str(dm_quad_fma(dm_quad_fromstring("1.234567890123456789012345678901234"), dm_quad_fromstring("9.876543210987654321098765432109876"), dm_quad_fromstring("-12.19326311370217952261850327338667"))));
+   EXPECT_TRUE(dm_quad_isinf(dm_quad_mul(dm_quad_fromstring("9e8191"), dm_quad_fromstring("10"))));
+   EXPECT_TRUE(dm_quad_iszero(dm_quad_div(dm_quad_fromstring("1e-8191"), dm_quad_fromstring("10"))));
+   EXPECT_TRUE(dm_quad_isinf(dm_quad_div(one, zero)));
+   EXPECT_TRUE(dm_quad_isnan(dm_quad_mul(dm_quad_Inf, zero)));
+   EXPECT_TRUE(dm_quad_isnan(dm_quad_add(dm_quad_Inf, dm_quad_neg(dm_quad_Inf))));
+
+      // A year of daily interest at 5%, rounded at every step.
+   dm_quad factor = dm_quad_add(one, dm_quad_div(dm_quad_fromstring("0.05"), dm_quad_fromstring("365")));
+   dm_quad balance = one;
+   for (int i = 0; i < 365; ++i)
+    {
+      balance = dm_quad_mul(balance, factor);
+    }
+   EXPECT_EQ("1.051267496467462550454968149773680e+0", str(balance));
+
+      // Widening is exact, and keeps the special values.
+   EXPECT_EQ("-1.234567890123456000000000000000000e-300", str(dm_double_toquad(DM_DOUBLE_PACK(1, -300, 1234567890123456ULL))));
+   EXPECT_TRUE(same(dm_quad_neg(zero), dm_double_toquad(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U))));
+   EXPECT_TRUE(same(dm_quad_Inf, dm_double_toquad(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY))));
+   EXPECT_TRUE(same(dm_quad_NaN, dm_double_toquad(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U))));
+
+      // Narrowing rounds once, and flushes to the narrower range.
+   EXPECT_EQ(DM_DOUBLE_PACK(0, -1, 3333333333333333ULL), dm_double_fromquad_r(dm_quad_div(one, three), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, -1, 3333333333333334ULL), dm_double_fromquad_r(dm_quad_div(one, three), DM_FE_UPWARD));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 0, 1000000000000000ULL), dm_double_fromquad_r(dm_quad_fromstring("1.00000000000000049999"), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 1, 1000000000000000ULL), dm_double_fromquad_r(dm_quad_fromstring("9.99999999999999950000"), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_fromquad_r(dm_quad_fromstring("-1e512"), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_fromquad_r(dm_quad_fromstring("1e-600"), DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_fromquad(dm_quad_neg(dm_quad_Inf)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), dm_double_fromquad(dm_quad_NaN));
+
+      // Sums and products of dm_doubles are exact in a dm_quad, so narrowing them is the correctly rounded result.
+   TestRandom next;
+   auto make = [&next](int exponent) -> dm_double
+    {
+      return DM_DOUBLE_PACK(next() & 1U, exponent, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+    };
+   for (int i = 0; i < 20000; ++i)
+    {
+      int mode = i % 8;
+      dm_double lhs = make(static_cast<int>(next() % 17U) - 8), rhs = make(static_cast<int>(next() % 17U) - 8);
+      dm_quad wideLhs = dm_double_toquad(lhs), wideRhs = dm_double_toquad(rhs);
+      EXPECT_EQ(dm_double_add_r(lhs, rhs, mode), dm_double_fromquad_r(dm_quad_add_r(wideLhs, wideRhs, mode), mode));
+      EXPECT_EQ(dm_double_mul_r(lhs, rhs, mode), dm_double_fromquad_r(dm_quad_mul_r(wideLhs, wideRhs, mode), mode));
+    }
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_quad_mul_r(three, three, DM_FE_TONEAREST);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_quad_div_r(one, three, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_quad_div_r(one, zero, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT | DM_FE_DIVBYZERO, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_quad_mul_r(dm_quad_fromstring("9e8191"), dm_quad_fromstring("10"), DM_FE_TONEAREST);
+   EXPECT_TRUE(dm_fetestexcept(DM_FE_OVERFLOW));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testBid64)
+ {
+   const dm_double one = DM_DOUBLE_PACK(0, 0, 1000000000000000ULL);
+
+      // From decimal64: every cohort of a value reads as the same dm_double.
+   EXPECT_EQ(one, dm_double_from_bid64(0x31C0000000000001ULL)); // 1
+   EXPECT_EQ(one, dm_double_from_bid64(0x31A000000000000AULL)); // 1.0
+   EXPECT_EQ(one, dm_double_from_bid64(0x2FE38D7EA4C68000ULL)); // 1.000000000000000
+   EXPECT_EQ(DM_DOUBLE_PACK(1, 384, 9999999999999999ULL), dm_double_from_bid64(0xF7FB86F26FC0FFFFULL)); // The largest, with the implied 100
+   EXPECT_EQ(DM_DOUBLE_PACK(0, -398, 1000000000000000ULL), dm_double_from_bid64(0x0000000000000001ULL)); // The smallest
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dm_double_from_bid64(0xB1C0000000000000ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_from_bid64(0x5FE0000000000000ULL)); // Zero with a large exponent
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_from_bid64(0x6C7386F26FC10000ULL)); // Non-canonical: 10 ^ 16
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_from_bid64(0xF800000000000000ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), dm_double_from_bid64(0x7BFFFFFFFFFFFFFFULL)); // Infinity ignores the rest
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U), dm_double_from_bid64(0x7C000000000004D2ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U), dm_double_from_bid64(0x7E000000000004D2ULL)); // Signaling reads as quiet
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), dm_double_from_bid64(0x7C00000000000000ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), dm_double_from_bid64(0x7C03FFFFFFFFFFFFULL)); // Non-canonical payload
+
+      // To decimal64: a dm_double is always in the cohort with sixteen digits, until it is subnormal.
+   EXPECT_EQ(0x2FE38D7EA4C68000ULL, dm_double_to_bid64(one));
+   EXPECT_EQ(0x77FB86F26FC0FFFFULL, dm_double_to_bid64(DM_DOUBLE_PACK(0, 384, 9999999999999999ULL)));
+   EXPECT_EQ(0xF800000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK(1, 385, 1000000000000000ULL)));
+   EXPECT_EQ(0x7800000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK(0, 511, 9999999999999999ULL)));
+   EXPECT_EQ(0x31C0000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U)));
+   EXPECT_EQ(0xB1C0000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U)));
+   EXPECT_EQ(0xF800000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY)));
+   EXPECT_EQ(0x7C000000000004D2ULL, dm_double_to_bid64(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U)));
+   EXPECT_EQ(0x7C00000000000000ULL, dm_double_to_bid64(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1000000000000000ULL)));
+   EXPECT_EQ(0x0000000000000001ULL, dm_double_to_bid64(DM_DOUBLE_PACK(0, -398, 1000000000000000ULL)));
+   EXPECT_EQ(0x0000000000000002ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(0, -398, 1500000000000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(0x0000000000000001ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(0, -398, 1500000000000000ULL), DM_FE_TOWARDZERO));
+   EXPECT_EQ(0x00038D7EA4C68000ULL, dm_double_to_bid64(DM_DOUBLE_PACK(0, -383, 1000000000000000ULL))); // The smallest normal
+   EXPECT_EQ(0x0000000000000000ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(0, -399, 4000000000000000ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(0x0000000000000001ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(0, -399, 4000000000000000ULL), DM_FE_UPWARD));
+   EXPECT_EQ(0x8000000000000001ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(1, -511, 1000000000000000ULL), DM_FE_DOWNWARD));
+   EXPECT_EQ(0x8000000000000000ULL, dm_double_to_bid64_r(DM_DOUBLE_PACK(1, -511, 1000000000000000ULL), DM_FE_UPWARD));
+
+      // Random values, against the string conversion.
+   TestRandom next;
+   const size_t count = 20000U;
+   static uint64_t bids [count], narrow [count];
+   static dm_double values [count], wide [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      uint64_t sign = next() & 1U;
+      uint64_t coefficient = next() % (1ULL << (1U + next() % 54U)) % 10000000000000000ULL;
+      int64_t exponent = static_cast<int64_t>(next() % 768U) + DM_BID64_MIN_EXPONENT;
+      std::string text = (sign ? "-" : "") + std::to_string(coefficient) + "e" + std::to_string(exponent);
+      bids[i] = dm_bid64_pack(sign, exponent, coefficient);
+      dm_double value = dm_double_from_bid64(bids[i]);
+      EXPECT_EQ(dm_double_fromstring(text.c_str()), value) << text;
+      EXPECT_EQ(value, dm_double_from_bid64(dm_double_to_bid64(value))) << text;
+      values[i] = DM_DOUBLE_PACK(next() & 1U, static_cast<int>(next() % 1023U) - 511, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+    }
+   bids[0] = 0x7C000000000004D2ULL;
+   bids[1] = 0x6C7386F26FC10000ULL;
+   values[0] = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+   values[1] = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+
+      // The arrays match the scalar conversions.
+   dm_double_from_bid64_array(bids, wide, count);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_from_bid64(bids[i]), wide[i]);
+   dm_double_to_bid64_array(values, narrow, count, DM_FE_UPWARD);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_to_bid64_r(values[i], DM_FE_UPWARD), narrow[i]);
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_to_bid64(DM_DOUBLE_PACK(0, -390, 1000000000000000ULL));
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT)); // Subnormal, but exact
+   dm_double_to_bid64(DM_DOUBLE_PACK(0, -390, 1000000000000001ULL));
+   EXPECT_EQ(DM_FE_UNDERFLOW | DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_to_bid64(DM_DOUBLE_PACK(0, 385, 1000000000000000ULL));
+   EXPECT_EQ(DM_FE_OVERFLOW | DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testDpd64)
+ {
+   const dm_double one = DM_DOUBLE_PACK(0, 0, 1000000000000000ULL);
+   const dm_double largest = DM_DOUBLE_PACK(0, 384, 9999999999999999ULL);
+
+   EXPECT_EQ(one, dm_double_from_dpd64(0x2238000000000001ULL)); // 1
+   EXPECT_EQ(one, dm_double_from_dpd64(0x25FC000000000000ULL)); // 1.000000000000000
+   EXPECT_EQ(0x25FC000000000000ULL, dm_double_to_dpd64(one));
+   EXPECT_EQ(0x77FCFF3FCFF3FCFFULL, dm_double_to_dpd64(largest)); // The leading 9 is in the combination field.
+   EXPECT_EQ(largest, dm_double_from_dpd64(0x77FCFF3FCFF3FCFFULL));
+   EXPECT_EQ(DM_DOUBLE_PACK(1, -398, 1000000000000000ULL), dm_double_from_dpd64(0x8000000000000001ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 2, 9990000000000000ULL), dm_double_from_dpd64(0x22380000000003FFULL)); // A non-canonical declet for 999
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 2, 1230000000000000ULL), dm_double_from_dpd64(0x22380000000000A3ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dm_double_from_dpd64(0xA238000000000000ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_from_dpd64(0xF800000000000000ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U), dm_double_from_dpd64(0x7C00000000000534ULL));
+   EXPECT_EQ(0x7C00000000000534ULL, dm_double_to_dpd64(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1234U)));
+   EXPECT_EQ(0xF800000000000000ULL, dm_double_to_dpd64(DM_DOUBLE_PACK(1, 385, 1000000000000000ULL)));
+   EXPECT_EQ(0x0000000000000002ULL, dm_double_to_dpd64_r(DM_DOUBLE_PACK(0, -398, 1500000000000000ULL), DM_FE_TONEAREST));
+
+      // The DPD and BID encodings of the same number.
+   EXPECT_EQ(0x2238000000000001ULL, dm_bid64_to_dpd64(0x31C0000000000001ULL));
+   EXPECT_EQ(0x31C0000000000001ULL, dm_dpd64_to_bid64(0x2238000000000001ULL));
+   EXPECT_EQ(0x2238000000000000ULL, dm_bid64_to_dpd64(0x6C7386F26FC10000ULL)); // Non-canonical BID: zero in the same cohort
+   EXPECT_EQ(0x7E000000000004D2ULL, dm_dpd64_to_bid64(dm_bid64_to_dpd64(0x7E000000000004D2ULL))); // Signaling NaN
+
+   TestRandom next;
+   const size_t count = 20000U; // Several blocks, and a partial one.
+   static uint64_t dpds [count], narrow [count];
+   static dm_double values [count], wide [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      uint64_t sign = next() & 1U;
+      uint64_t coefficient = next() % (1ULL << (1U + next() % 54U)) % 10000000000000000ULL;
+      uint64_t bid = dm_bid64_pack(sign, static_cast<int64_t>(next() % 768U) + DM_BID64_MIN_EXPONENT, coefficient);
+      EXPECT_EQ(bid, dm_dpd64_to_bid64(dm_bid64_to_dpd64(bid)));
+      dpds[i] = dm_bid64_to_dpd64(bid);
+      EXPECT_EQ(dm_double_from_bid64(bid), dm_double_from_dpd64(dpds[i]));
+      values[i] = DM_DOUBLE_PACK(next() & 1U, static_cast<int>(next() % 1023U) - 511, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+      EXPECT_EQ(dm_double_to_bid64_r(values[i], DM_FE_DOWNWARD), dm_dpd64_to_bid64(dm_double_to_dpd64_r(values[i], DM_FE_DOWNWARD)));
+    }
+   values[count - 1U] = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+
+      // The arrays match the scalar conversions.
+   dm_double_from_dpd64_array(dpds, wide, count);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_from_dpd64(dpds[i]), wide[i]);
+   dm_double_to_dpd64_array(values, narrow, count, DM_FE_DOWNWARD);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(dm_double_to_dpd64_r(values[i], DM_FE_DOWNWARD), narrow[i]);
+ }
+
+TEST(DMDoubleTest, testLayoutConversion)
+ {
+   auto legacy = [](uint64_t sign, int exponent, uint64_t field) { return (static_cast<uint64_t>(exponent) << 54) | field | (sign << 53); };
+   auto misra = [](uint64_t sign, int exponent, uint64_t field) { return (static_cast<uint64_t>(exponent + 512) << 53) | field | (sign << 63); };
+   struct { uint64_t sign; int exponent; uint64_t field; } cases [] =
+    {
+      { 0, 0, 0U }, { 1, 0, 0U }, { 1, -3, 234567890123456ULL }, { 0, 511, 8999999999999999ULL }, { 1, -511, 0U }, { 0, -1, 1U },
+      { 0, -512, 0U }, { 1, -512, 0U }, { 0, -512, 0x1FFFFFFFFFFFFFULL }, { 1, -512, 0x1FFFFFFFFFFFFFULL }, { 0, -512, 255U },
+      { 1, 7, 0x1FFFFFFFFFFFFFULL } // Non-canonical: moved bit for bit
+    };
+   const size_t count = sizeof(cases) / sizeof(cases[0]);
+   uint64_t column [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      uint64_t old = legacy(cases[i].sign, cases[i].exponent, cases[i].field), now = misra(cases[i].sign, cases[i].exponent, cases[i].field);
+      EXPECT_EQ(now, dm_double_legacy_to_m(old));
+      EXPECT_EQ(old, dm_double_m_to_legacy(now));
+      column[i] = old;
+    }
+   EXPECT_EQ(0x4000000000000000ULL, dm_double_legacy_to_m(0U)); // One
+
+      // In place, as a stored column would be.
+   dm_double_legacy_to_m_array(column, column, count);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(misra(cases[i].sign, cases[i].exponent, cases[i].field), column[i]);
+   dm_double_m_to_legacy_array(column, column, count);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(legacy(cases[i].sign, cases[i].exponent, cases[i].field), column[i]);
+
+      // Positive numbers in the MISRA layout sort as integers.
+   TestRandom next;
+   for (int i = 0; i < 10000; ++i)
+    {
+      dm_double lhs = DM_DOUBLE_PACK(0, static_cast<int>(next() % 21U) - 10, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+      dm_double rhs = DM_DOUBLE_PACK(0, static_cast<int>(next() % 21U) - 10, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+#ifndef MISRAbleC
+      EXPECT_EQ(dm_double_isless(lhs, rhs), dm_double_legacy_to_m(lhs) < dm_double_legacy_to_m(rhs));
+      EXPECT_EQ(lhs, dm_double_m_to_legacy(dm_double_legacy_to_m(lhs)));
+#else
+      EXPECT_EQ(dm_double_isless(lhs, rhs), lhs < rhs);
+      EXPECT_EQ(lhs, dm_double_legacy_to_m(dm_double_m_to_legacy(lhs)));
+#endif /* MISRAbleC */
+    }
+ }
+
+TEST(DMDoubleTest, testColumn)
+ {
+   const dm_double nan = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1U);
+   const dm_double inf = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   const char* path = "DoubleTests.column";
+
+      // Clustered, like a timestamp or a running total: most ranges are in a few blocks.
+   TestRandom next(0xC01C01C01C01ULL);
+   const size_t count = 10500U, block = 1000U;
+   static dm_double values [count];
+   static size_t rows [count];
+   for (size_t i = 0U; i < count; ++i)
+      values[i] = dm_double_add(dm_double_fromstring("1000"), DM_DOUBLE_PACK(0, 0, MIN_SIGNIFICAND + (i * 100000000000ULL) + next() % 1000000000000ULL));
+   values[1500] = nan;
+   values[1700] = dm_double_neg(inf);
+   values[2999] = nan;
+   for (size_t i = 3000U; i < 4000U; ++i) values[i] = nan; // All nulls
+   values[5000] = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U);
+
+   ASSERT_EQ(DM_COLUMN_OK, dm_double_column_write(path, values, count, block));
+   dm_double_column column;
+   ASSERT_EQ(DM_COLUMN_OK, dm_double_column_open(path, &column));
+   EXPECT_EQ(count, column.count);
+   EXPECT_EQ(block, column.block_size);
+   EXPECT_EQ(11U, column.blocks);
+   EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(column.values) % sizeof(dm_double));
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(values[i], column.values[i]);
+   size_t length = 0U;
+   EXPECT_EQ(column.values + 10000, dm_double_column_block(&column, 10U, &length));
+   EXPECT_EQ(500U, length);
+
+   for (size_t b = 0U; b < column.blocks; ++b)
+    {
+      const dm_double* first = dm_double_column_block(&column, b, &length);
+      uint64_t nulls = 0U;
+      for (size_t i = 0U; i < length; ++i)
+       {
+         nulls += dm_double_isnan(first[i]);
+         if (!dm_double_isnan(first[i]))
+          {
+            EXPECT_TRUE(dm_double_islessequal(column.zones[b].min, first[i])) << b << " " << i;
+            EXPECT_TRUE(dm_double_islessequal(first[i], column.zones[b].max)) << b << " " << i;
+          }
+       }
+      EXPECT_EQ(nulls, column.zones[b].nulls) << b;
+    }
+   EXPECT_EQ(dm_double_neg(inf), column.zones[1].min);
+   EXPECT_EQ(1U, column.zones[1].nulls);
+   EXPECT_TRUE(dm_double_isnan(column.zones[3].min));
+   EXPECT_TRUE(dm_double_column_skip(&column.zones[3], dm_double_neg(inf), inf));
+
+      // A range scan finds what a full scan finds, and skips the blocks that can't hold any of it.
+   const char* ranges [][2] = { { "1001", "1002" }, { "1002.04", "1002.15" }, { "-inf", "1001.5" }, { "1005", "2000" }, { "0", "0" }, { "1003", "1002" } };
+   for (const auto& range : ranges)
+    {
+      dm_double low = (0 == strcmp(range[0], "-inf")) ? dm_double_neg(inf) : dm_double_fromstring(range[0]);
+      dm_double high = dm_double_fromstring(range[1]);
+      size_t found = dm_double_column_select(&column, low, high, rows), expected = 0U;
+      for (size_t i = 0U; i < count; ++i)
+         if (dm_double_islessequal(low, values[i]) && dm_double_islessequal(values[i], high))
+          {
+            ASSERT_LT(expected, found) << range[0];
+            EXPECT_EQ(i, rows[expected]) << range[0];
+            ++expected;
+          }
+      EXPECT_EQ(expected, found) << range[0];
+
+         // Nothing is written past the matches, so rows only needs room for them.
+      rows[found] = count;
+      EXPECT_EQ(found, dm_double_column_select(&column, low, high, rows));
+      EXPECT_EQ(count, rows[found]) << range[0];
+    }
+   size_t skipped = 0U;
+   for (size_t b = 0U; b < column.blocks; ++b)
+      skipped += dm_double_column_skip(&column.zones[b], dm_double_fromstring("1002.04"), dm_double_fromstring("1002.15"));
+   EXPECT_EQ(10U, skipped);
+   EXPECT_EQ(1U, dm_double_column_select(&column, dm_double_fromstring("-0"), dm_double_fromstring("0"), rows)); // -0 is 0
+   EXPECT_EQ(5000U, rows[0]);
+   EXPECT_EQ(0U, dm_double_column_select(&column, nan, inf, rows));
+   dm_double_column_close(&column);
+   EXPECT_EQ(nullptr, column.values);
+
+      // A file from the other implementation reads as the same numbers.
+   FILE* file = fopen(path, "r+b");
+   ASSERT_NE(nullptr, file);
+   static unsigned char bytes [65536 + count * sizeof(dm_double)];
+   size_t size = fread(bytes, 1U, sizeof(bytes), file);
+   uint32_t layout;
+   memcpy(&layout, bytes + 12, sizeof(layout));
+#ifndef MISRAbleC
+   EXPECT_EQ(static_cast<uint32_t>(DM_COLUMN_LEGACY), layout);
+   layout = DM_COLUMN_MISRA;
+   auto convert = dm_double_legacy_to_m_array;
+#else
+   EXPECT_EQ(static_cast<uint32_t>(DM_COLUMN_MISRA), layout);
+   layout = DM_COLUMN_LEGACY;
+   auto convert = dm_double_m_to_legacy_array;
+#endif /* MISRAbleC */
+   memcpy(bytes + 12, &layout, sizeof(layout));
+   uint64_t data;
+   memcpy(&data, bytes + 48, sizeof(data));
+   EXPECT_EQ(size, data + count * sizeof(dm_double));
+   for (size_t i = 64U; i < 64U + 11U * sizeof(dm_double_column_zone); i += sizeof(dm_double_column_zone))
+    {
+      uint64_t bounds [2];
+      memcpy(bounds, bytes + i, sizeof(bounds));
+      convert(bounds, bounds, 2U);
+      memcpy(bytes + i, bounds, sizeof(bounds));
+    }
+   for (size_t i = data; i < size; i += sizeof(dm_double))
+    {
+      uint64_t value;
+      memcpy(&value, bytes + i, sizeof(value));
+      convert(&value, &value, 1U);
+      memcpy(bytes + i, &value, sizeof(value));
+    }
+   rewind(file);
+   EXPECT_EQ(size, fwrite(bytes, 1U, size, file));
+   fclose(file);
+   ASSERT_EQ(DM_COLUMN_OK, dm_double_column_open(path, &column));
+   EXPECT_EQ(static_cast<int>(layout), column.layout);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(values[i], column.values[i]);
+   EXPECT_EQ(dm_double_neg(inf), column.zones[1].min);
+   dm_double_column_close(&column);
+
+      // Damaged files.
+   file = fopen(path, "wb");
+   ASSERT_NE(nullptr, file);
+   EXPECT_EQ(size - 8U, fwrite(bytes, 1U, size - 8U, file)); // One value short
+   fclose(file);
+   EXPECT_EQ(DM_COLUMN_FORMAT, dm_double_column_open(path, &column));
+   EXPECT_EQ(nullptr, column.values);
+   bytes[0] = 'd';
+   file = fopen(path, "wb");
+   ASSERT_NE(nullptr, file);
+   EXPECT_EQ(size, fwrite(bytes, 1U, size, file));
+   fclose(file);
+   EXPECT_EQ(DM_COLUMN_FORMAT, dm_double_column_open(path, &column));
+   EXPECT_EQ(DM_COLUMN_IO, dm_double_column_open("DoubleTests.missing", &column));
+
+      // Headers whose zone map doesn't fit between the header and the values.
+   bytes[0] = 'D';
+   auto openDamaged = [&](uint64_t blockSize, uint64_t blocks, uint64_t dataOffset)
+    {
+      unsigned char header [64];
+      memcpy(header, bytes, sizeof(header));
+      memcpy(header + 24, &blockSize, sizeof(blockSize));
+      memcpy(header + 32, &blocks, sizeof(blocks));
+      memcpy(header + 48, &dataOffset, sizeof(dataOffset));
+      FILE* damaged = fopen(path, "wb");
+      EXPECT_NE(nullptr, damaged);
+      EXPECT_EQ(sizeof(header), fwrite(header, 1U, sizeof(header), damaged));
+      EXPECT_EQ(size - sizeof(header), fwrite(bytes + sizeof(header), 1U, size - sizeof(header), damaged));
+      fclose(damaged);
+      dm_double_column opened;
+      int result = dm_double_column_open(path, &opened);
+      if (DM_COLUMN_OK == result)
+         dm_double_column_close(&opened);
+      return result;
+    };
+   EXPECT_EQ(DM_COLUMN_OK, openDamaged(block, 11U, data));
+   EXPECT_EQ(DM_COLUMN_FORMAT, openDamaged(1U, count, 0U));     // The values in the header, and the zones past the end of the file
+   EXPECT_EQ(DM_COLUMN_FORMAT, openDamaged(block, 11U, 0U));
+   EXPECT_EQ(DM_COLUMN_FORMAT, openDamaged(block, 11U, 64U));   // No room for the zones
+   EXPECT_EQ(DM_COLUMN_FORMAT, openDamaged(block, 11U, 256U));  // The last zone overlaps the values
+   EXPECT_EQ(DM_COLUMN_FORMAT, openDamaged(1U, count, data));
+
+      // Empty, and the default block size.
+   ASSERT_EQ(DM_COLUMN_OK, dm_double_column_write(path, values, 0U, 0U));
+   ASSERT_EQ(DM_COLUMN_OK, dm_double_column_open(path, &column));
+   EXPECT_EQ(0U, column.count);
+   EXPECT_EQ(0U, column.blocks);
+   EXPECT_EQ(static_cast<size_t>(DM_COLUMN_DEFAULT_BLOCK), column.block_size);
+   EXPECT_EQ(0U, dm_double_column_select(&column, dm_double_neg(inf), inf, rows));
+   dm_double_column_close(&column);
+   remove(path);
+ }
+
+TEST(DMDoubleTest, testBlockCodec)
+ {
+   const dm_double nan = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 7U);
+   const dm_double inf = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double zero = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+   const size_t count = 1003U; // Not a whole number of rows
+   static dm_double values [count], decoded [count + 1U];
+   static unsigned char encoded [DM_CODEC_MAX_ENCODED(count) + 1U];
+   TestRandom next(0xC0DEC0DEC0DEULL);
+   auto roundTrip = [&](size_t length, size_t offset) // The offset tests unaligned blocks.
+    {
+      size_t size = dm_double_block_encode(values, length, encoded + offset);
+      EXPECT_GE(DM_CODEC_MAX_ENCODED(length), size);
+      EXPECT_EQ(length, dm_double_block_count(encoded + offset));
+      decoded[length] = nan;
+      EXPECT_EQ(size, dm_double_block_decode(encoded + offset, decoded));
+      for (size_t i = 0U; i < length; ++i) EXPECT_EQ(values[i], decoded[i]) << i;
+      EXPECT_EQ(nan, decoded[length]);
+      return size;
+    };
+
+      // Cents between zero and ten thousand: twenty bits.
+   for (size_t i = 0U; i < count; ++i)
+      dm_double_from_scaled_r(static_cast<int64_t>(next() % 1000001U), 2, DM_FE_TONEAREST, &values[i]);
+   size_t size = roundTrip(count, 0U);
+   EXPECT_EQ(DM_CODEC_PACKED, encoded[4]);
+   EXPECT_EQ(20U, encoded[5]);
+   EXPECT_EQ(DM_CODEC_HEADER_SIZE + 8U * ((126U * 20U + 63U) / 64U) * DM_CODEC_LANES, size);
+   EXPECT_LT(3U * size, DM_CODEC_MAX_ENCODED(count));
+   roundTrip(count, 1U);
+   for (size_t length : { 0U, 1U, 7U, 8U, 9U, 64U, 65U })
+      roundTrip(length, 3U);
+
+      // Negative prices around a level, with different numbers of decimals: the lowest digit sets the scale.
+   for (size_t i = 0U; i < count; ++i)
+      values[i] = dm_double_sub(dm_double_fromstring("-1234.5"), DM_DOUBLE_PACK(next() & 1U, -static_cast<int>(next() % 4U), MIN_SIGNIFICAND + (next() % 9U) * MIN_SIGNIFICAND));
+   values[500] = dm_double_fromstring("-1234.5678");
+   values[600] = zero;
+   roundTrip(count, 0U);
+   EXPECT_EQ(DM_CODEC_PACKED, encoded[4]);
+   int16_t scale;
+   memcpy(&scale, encoded + 6, sizeof(scale));
+   EXPECT_EQ(4, scale);
+
+      // All the same: no bits at all. Large and small exponents too.
+   for (const char* same : { "0", "1e500", "-7e-500", "123456789012345.6" })
+    {
+      for (size_t i = 0U; i < count; ++i) values[i] = dm_double_fromstring(same);
+      EXPECT_EQ(DM_CODEC_HEADER_SIZE, roundTrip(count, 0U)) << same;
+      EXPECT_EQ(0U, encoded[5]) << same;
+    }
+
+      // Raw: special values, negative zero, integers past int64_t, and full significands at every exponent.
+   for (size_t i = 0U; i < count; ++i)
+      dm_double_from_scaled_r(static_cast<int64_t>(next() % 1000001U), 2, DM_FE_TONEAREST, &values[i]);
+   for (dm_double special : { nan, inf, dm_double_neg(inf), dm_double_neg(zero), dm_double_fromstring("1e300") })
+    {
+      dm_double saved = values[count - 1U];
+      values[count - 1U] = special;
+#ifdef DM_FENV_FLAGS
+      dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+      EXPECT_EQ(DM_CODEC_MAX_ENCODED(count), roundTrip(count, 0U));
+#ifdef DM_FENV_FLAGS
+      EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+#endif /* DM_FENV_FLAGS */
+      EXPECT_EQ(DM_CODEC_RAW, encoded[4]);
+      values[count - 1U] = saved;
+    }
+   for (size_t i = 0U; i < count; ++i)
+      values[i] = DM_DOUBLE_PACK(next() & 1U, (int)(next() % 1023U) - 511, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+   EXPECT_EQ(DM_CODEC_MAX_ENCODED(count), roundTrip(count, 5U));
+
+      // The widest packed values: differences of 63 bits. At 64, nothing is saved.
+   values[0] = dm_double_fromstring("1");
+   for (size_t i = 1U; i < count; ++i)
+      values[i] = dm_double_fromstring("9223372036854775000");
+   roundTrip(count, 0U);
+   EXPECT_EQ(DM_CODEC_PACKED, encoded[4]);
+   EXPECT_EQ(63U, encoded[5]);
+   values[0] = dm_double_fromstring("-9223372036854775000");
+   values[1] = dm_double_fromstring("1");
+   EXPECT_EQ(DM_CODEC_MAX_ENCODED(count), roundTrip(count, 0U));
+ }
+
+TEST(DMDoubleTest, testVarint)
+ {
+   unsigned char bytes [DM_VARINT_MAX_BYTES * 4U];
+   dm_double value;
+
+      // The trailing zeros go, so short numbers are short.
+   struct { const char* number; size_t length; } lengths [] =
+    {
+      { "123.45", 4U }, { "-123.45", 4U }, { "1", 2U }, { "1e63", 2U }, { "1e64", 3U }, { "-64", 2U }, { "-65", 3U },
+      { "9999999999999999", 9U }, { "-9.999999999999999e-511", 10U }, { "1e511", 3U }, { "0", 2U }, { "-0", 2U }
+    };
+   for (const auto& test : lengths)
+    {
+      dm_double number = dm_double_fromstring(test.number);
+      EXPECT_EQ(test.length, dm_double_to_varint(number, bytes)) << test.number;
+      EXPECT_EQ(test.length, dm_double_from_varint(bytes, test.length, &value)) << test.number;
+      EXPECT_EQ(number, value) << test.number;
+      EXPECT_EQ(0U, dm_double_from_varint(bytes, test.length - 1U, &value)) << test.number; // Cut off
+    }
+   EXPECT_EQ(4U, dm_double_to_varint(dm_double_fromstring("123.45"), bytes));
+   EXPECT_EQ(0xF2U, bytes[0]); // 24690, the zigzag of 12345
+   EXPECT_EQ(0xC0U, bytes[1]);
+   EXPECT_EQ(0x01U, bytes[2]);
+   EXPECT_EQ(0x03U, bytes[3]); // -2
+
+      // Special values keep their payloads.
+   const dm_double specials [] =
+    {
+      DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY),
+      DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1U), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 123456789U)
+    };
+   for (dm_double special : specials)
+    {
+      size_t length = dm_double_to_varint(special, bytes);
+      EXPECT_EQ(length, dm_double_from_varint(bytes, sizeof(bytes), &value));
+      EXPECT_EQ(special, value);
+    }
+
+      // Invalid: too long, too many digits, out of range, a payload past infinity.
+   const unsigned char invalid [][DM_VARINT_MAX_BYTES] =
+    {
+      { 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x01U, 0x00U },
+      { 0x80U, 0x80U, 0xB4U, 0xC4U, 0xD8U, 0xA3U, 0xE3U, 0x23U, 0x00U }, // 10 ^ 16
+      { 0x02U, 0x80U, 0x08U }, // 1e512
+      { 0x02U, 0xFFU, 0x07U }, // 1e-512
+      { 0x00U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x80U, 0x40U }
+    };
+   for (const auto& test : invalid)
+      EXPECT_EQ(0U, dm_double_from_varint(test, sizeof(test), &value));
+   const unsigned char edges [] = { 0x02U, 0xFEU, 0x07U, 0x02U, 0xFDU, 0x07U };
+   EXPECT_EQ(3U, dm_double_from_varint(edges, 3U, &value));
+   EXPECT_EQ(dm_double_fromstring("1e511"), value);
+   EXPECT_EQ(3U, dm_double_from_varint(edges + 3, 3U, &value));
+   EXPECT_EQ(dm_double_fromstring("1e-511"), value);
+
+      // Streams through small buffers, with values cut off at the ends of them.
+   TestRandom next(0x7A1E7A1E7A1EULL);
+   const size_t count = 10000U;
+   static dm_double values [count], decoded [count];
+   static unsigned char stream [count * DM_VARINT_MAX_BYTES];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      switch (next() % 4U)
+       {
+         case 0U:
+            values[i] = DM_DOUBLE_PACK(next() & 1U, static_cast<int>(next() % 1023U) - 511, MIN_SIGNIFICAND + next() % 9000000000000000ULL);
+            break;
+         case 1U:
+            dm_double_from_scaled_r(static_cast<int64_t>(next() % 2000001U) - 1000000, 2, DM_FE_TONEAREST, &values[i]);
+            break;
+         case 2U:
+            values[i] = specials[next() % 4U];
+            break;
+         default:
+            values[i] = DM_DOUBLE_PACK_ALT(next() & 1U, SPECIAL_EXPONENT, 0U);
+            break;
+       }
+    }
+   size_t written = 0U;
+   EXPECT_EQ(count, dm_double_to_varint_array(values, count, stream, sizeof(stream), &written));
+   size_t read = 0U;
+   EXPECT_EQ(count, dm_double_from_varint_array(stream, written, decoded, count, &read));
+   EXPECT_EQ(written, read);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(values[i], decoded[i]) << i;
+
+   unsigned char small [13];
+   dm_varint_writer writer = { small, sizeof(small), 0U };
+   size_t done = 0U, total = 0U;
+   while (done < count)
+    {
+      size_t appended = dm_varint_write(&writer, values + done, count - done);
+      done += appended;
+      ASSERT_TRUE((0U != appended) || (0U != writer.length));
+      for (size_t i = 0U; i < writer.length; ++i) ASSERT_EQ(stream[total + i], small[i]) << total;
+      total += writer.length;
+      writer.length = 0U; // Flushed
+    }
+   EXPECT_EQ(written, total);
+
+   dm_varint_reader reader = { stream, 0U, 0U };
+   done = 0U;
+   while (reader.length < written)
+    {
+      reader.length = (reader.length + 7U < written) ? (reader.length + 7U) : written; // Bytes arrive seven at a time.
+      done += dm_varint_read(&reader, decoded + done, count - done);
+      ASSERT_GT(DM_VARINT_MAX_BYTES, reader.length - reader.position);
+    }
+   EXPECT_EQ(count, done);
+   EXPECT_EQ(written, reader.position);
+   for (size_t i = 0U; i < count; ++i) EXPECT_EQ(values[i], decoded[i]) << i;
+
+   stream[written - 1U] |= 0x80U; // The last value never ends.
+   reader.position = 0U;
+   EXPECT_EQ(count - 1U, dm_varint_read(&reader, decoded, count));
+   EXPECT_GT(DM_VARINT_MAX_BYTES, reader.length - reader.position);
+   EXPECT_EQ(0U, dm_double_to_varint_array(values, count, stream, 1U, &written)); // No room
+   EXPECT_EQ(0U, written);
+ }
+
+TEST(DMDoubleTest, testIntegerConversions)
+ {
+   dm_double result;
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_fromint64_r(0, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), result);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_fromint64_r(-1, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(1, 0, 1000000000000000ULL), result);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_fromint64_r(10000000000000000LL, DM_FE_TONEAREST, &result)); // Seventeen digits, but exact
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 16, 1000000000000000ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromint64_r(INT64_MAX, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 18, 9223372036854776ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromint64_r(INT64_MAX, DM_FE_TOWARDZERO, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 18, 9223372036854775ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromint64_r(INT64_MIN, DM_FE_DOWNWARD, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(1, 18, 9223372036854776ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromuint64_r(UINT64_MAX, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 19, 1844674407370955ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromuint64_r(UINT64_MAX, DM_FE_UPWARD, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 19, 1844674407370956ULL), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromuint64_r(99999999999999999ULL, DM_FE_TONEAREST, &result)); // Carries into another digit
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 17, 1000000000000000ULL), result);
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 15, 9999999999999999ULL), dm_double_fromuint64(9999999999999999ULL));
+   EXPECT_EQ(DM_DOUBLE_PACK(1, 2, 1230000000000000ULL), dm_double_fromint64(-123));
+
+   int64_t integer;
+   uint64_t unsignedInteger;
+   const dm_double twoAndAHalf = DM_DOUBLE_PACK(0, 0, 2500000000000000ULL);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(twoAndAHalf, DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(2, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(twoAndAHalf, DM_FE_TONEARESTFROMZERO, &integer));
+   EXPECT_EQ(3, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(dm_double_neg(twoAndAHalf), DM_FE_DOWNWARD, &integer));
+   EXPECT_EQ(-3, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(dm_double_neg(twoAndAHalf), DM_FE_TOWARDZERO, &integer));
+   EXPECT_EQ(-2, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(DM_DOUBLE_PACK(0, -1, 4000000000000000ULL), DM_FE_UPWARD, &integer));
+   EXPECT_EQ(1, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(DM_DOUBLE_PACK(0, -300, 1000000000000000ULL), DM_FE_UPWARD, &integer));
+   EXPECT_EQ(1, integer);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_toint64_r(DM_DOUBLE_PACK(0, -300, 1000000000000000ULL), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(0, integer);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_toint64_r(DM_DOUBLE_PACK(1, 18, 9223372036854775ULL), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(-9223372036854775000LL, integer);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_toint64_r(DM_DOUBLE_PACK(0, 18, 9223372036854776ULL), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(INT64_MAX, integer);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_toint64_r(DM_DOUBLE_PACK(1, 18, 9223372036854776ULL), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(INT64_MIN, integer);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_toint64_r(DM_DOUBLE_PACK(0, 300, 1000000000000000ULL), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(INT64_MAX, integer);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_toint64_r(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(INT64_MIN, integer);
+   EXPECT_EQ(DM_CONVERT_INVALID, dm_double_toint64_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(0, integer);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_toint64_r(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), DM_FE_TONEAREST, &integer));
+   EXPECT_EQ(0, integer);
+
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_touint64_r(DM_DOUBLE_PACK(0, 19, 1844674407370955ULL), DM_FE_TONEAREST, &unsignedInteger));
+   EXPECT_EQ(18446744073709550000ULL, unsignedInteger);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_touint64_r(DM_DOUBLE_PACK(0, 19, 1844674407370956ULL), DM_FE_TONEAREST, &unsignedInteger));
+   EXPECT_EQ(UINT64_MAX, unsignedInteger);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_touint64_r(DM_DOUBLE_PACK(1, 0, 1000000000000000ULL), DM_FE_TONEAREST, &unsignedInteger));
+   EXPECT_EQ(0U, unsignedInteger);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_touint64_r(DM_DOUBLE_PACK(1, -1, 3000000000000000ULL), DM_FE_TONEAREST, &unsignedInteger));
+   EXPECT_EQ(0U, unsignedInteger);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_touint64_r(DM_DOUBLE_PACK(1, -1, 7000000000000000ULL), DM_FE_TONEAREST, &unsignedInteger));
+   EXPECT_EQ(0U, unsignedInteger);
+
+      // Random integers, against the string conversion, and back.
+   TestRandom next;
+   const size_t count = 10000U;
+   static int64_t integers [count], back [count];
+   static dm_double values [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      integers[i] = static_cast<int64_t>(next() >> (next() % 64U));
+      if (0U != (i & 1U)) integers[i] = -(integers[i] >> 1);
+      std::string text = std::to_string(integers[i]);
+      EXPECT_EQ(dm_double_fromstring(text.c_str()), dm_double_fromint64(integers[i])) << text;
+      if ((integers[i] < 10000000000000000LL) && (integers[i] > -10000000000000000LL))
+       {
+         EXPECT_EQ(DM_CONVERT_EXACT, dm_double_toint64_r(dm_double_fromint64(integers[i]), DM_FE_TONEAREST, &integer));
+         EXPECT_EQ(integers[i], integer);
+       }
+    }
+
+      // The arrays match the scalar conversions, and or their statuses together.
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromint64_array(integers, values, count, DM_FE_UPWARD));
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dm_double_fromint64_r(integers[i], DM_FE_UPWARD, &result);
+      EXPECT_EQ(result, values[i]);
+    }
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_toint64_array(values, back, count, DM_FE_UPWARD));
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dm_double_toint64_r(values[i], DM_FE_UPWARD, &integer);
+      EXPECT_EQ(integer, back[i]);
+    }
+   static uint64_t unsignedIntegers [count];
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_touint64_array(values, unsignedIntegers, count, DM_FE_UPWARD)); // The negative ones
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_fromuint64_array(unsignedIntegers, values, count, DM_FE_TOWARDZERO) | DM_CONVERT_INEXACT);
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_toint64_r(twoAndAHalf, DM_FE_TONEAREST, &integer);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_toint64_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), DM_FE_TONEAREST, &integer);
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_fromint64_r(1234, DM_FE_TONEAREST, &result);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testScaledConversions)
+ {
+   dm_double result;
+   EXPECT_EQ(dm_double_fromstring("123.45"), dm_double_from_scaled(12345, 2));
+   EXPECT_EQ(dm_double_fromstring("-0.00000001"), dm_double_from_scaled(-1, 8));
+   EXPECT_EQ(dm_double_fromstring("12300"), dm_double_from_scaled(123, -2));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_from_scaled(0, 4));
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_from_scaled_r(INT64_MAX, 4, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 14, 9223372036854776ULL), result);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_from_scaled_r(5, -511, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK(0, 511, 5000000000000000ULL), result);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_from_scaled_r(-5, -512, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), result);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_from_scaled_r(5, 512, DM_FE_TONEAREST, &result));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), result);
+
+   int64_t scaled;
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_to_scaled_r(dm_double_fromstring("123.45"), 2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(12345, scaled);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_to_scaled_r(dm_double_fromstring("123.456"), 2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(12346, scaled);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_to_scaled_r(dm_double_fromstring("123.456"), 2, DM_FE_TOWARDZERO, &scaled));
+   EXPECT_EQ(12345, scaled);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_to_scaled_r(dm_double_fromstring("-0.005"), 2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(0, scaled);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_to_scaled_r(dm_double_fromstring("-0.005"), 2, DM_FE_TONEARESTFROMZERO, &scaled));
+   EXPECT_EQ(-1, scaled);
+   EXPECT_EQ(DM_CONVERT_INEXACT, dm_double_to_scaled_r(dm_double_fromstring("12345"), -2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(123, scaled);
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_to_scaled_r(DM_DOUBLE_PACK(1, 16, 9223372036854775ULL), 2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(-9223372036854775000LL, scaled);
+   EXPECT_EQ(DM_CONVERT_SATURATED, dm_double_to_scaled_r(dm_double_fromstring("1e17"), 2, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(INT64_MAX, scaled);
+   EXPECT_EQ(DM_CONVERT_INVALID, dm_double_to_scaled_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), 8, DM_FE_TONEAREST, &scaled));
+   EXPECT_EQ(0, scaled);
+
+      // The arrays, with and without their own kernels, match the scalar conversions, and or their statuses together.
+   TestRandom next;
+   const size_t count = 4096U;
+   static int64_t integers [count], back [count];
+   static dm_double values [count];
+   const dm_double specials [] = { DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U),
+      DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 255U),
+      DM_DOUBLE_PACK(0, 300, 1000000000000000ULL), DM_DOUBLE_PACK(1, -300, 1000000000000000ULL) };
+   const int scales [] = { 2, 4, 8, 0, 3, -3, 400, -600 };
+   for (int scale : scales)
+    {
+      int expected = DM_CONVERT_EXACT;
+      for (size_t i = 0U; i < count; ++i)
+       {
+         integers[i] = static_cast<int64_t>(next() >> (next() % 64U));
+         if (0U != (i & 1U)) integers[i] = -(integers[i] >> 1);
+         if (0U == (i % 5U)) integers[i] = 0;
+         expected |= dm_double_from_scaled_r(integers[i], scale, DM_FE_UPWARD, &result);
+       }
+      EXPECT_EQ(expected, dm_double_from_scaled_array(integers, values, count, scale, DM_FE_UPWARD)) << scale;
+      for (size_t i = 0U; i < count; ++i)
+       {
+         dm_double_from_scaled_r(integers[i], scale, DM_FE_UPWARD, &result);
+         EXPECT_EQ(result, values[i]) << scale << " " << integers[i];
+       }
+
+      for (size_t i = 0U; i < count; ++i)
+       {
+         if (0U == (i % 7U)) values[i] = specials[next() % (sizeof(specials) / sizeof(specials[0]))];
+         else if (0U == (i % 3U)) values[i] = dm_double_ldexp(values[i], static_cast<int>(next() % 9U) - 4);
+       }
+      expected = DM_CONVERT_EXACT;
+      for (size_t i = 0U; i < count; ++i)
+         expected |= dm_double_to_scaled_r(values[i], scale, DM_FE_DOWNWARD, &scaled);
+      EXPECT_EQ(expected, dm_double_to_scaled_array(values, back, count, scale, DM_FE_DOWNWARD)) << scale;
+      for (size_t i = 0U; i < count; ++i)
+       {
+         dm_double_to_scaled_r(values[i], scale, DM_FE_DOWNWARD, &scaled);
+         EXPECT_EQ(scaled, back[i]) << scale << " " << values[i];
+       }
+    }
+
+      // Up to sixteen digits, cents go in and out exactly.
+   for (size_t i = 0U; i < count; ++i)
+      integers[i] = static_cast<int64_t>(next() % 20000000000000000ULL) - 10000000000000000LL + 1;
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_from_scaled_array(integers, values, count, 2, DM_FE_TONEAREST));
+   EXPECT_EQ(DM_CONVERT_EXACT, dm_double_to_scaled_array(values, back, count, 2, DM_FE_TONEAREST));
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(integers[i], back[i]);
+ }
+
+TEST(DMDoubleTest, testQuantize)
+ {
+   EXPECT_EQ(dm_double_fromstring("123.46"), dm_double_quantize_r(dm_double_fromstring("123.456"), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("123.45"), dm_double_quantize_r(dm_double_fromstring("123.456"), -2, DM_FE_TOWARDZERO));
+   EXPECT_EQ(dm_double_fromstring("-123.46"), dm_double_quantize_r(dm_double_fromstring("-123.451"), -2, DM_FE_DOWNWARD));
+   EXPECT_EQ(dm_double_fromstring("0.12"), dm_double_quantize_r(dm_double_fromstring("0.125"), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("0.13"), dm_double_quantize_r(dm_double_fromstring("0.125"), -2, DM_FE_TONEARESTFROMZERO));
+   EXPECT_EQ(dm_double_fromstring("1000"), dm_double_quantize_r(dm_double_fromstring("999.995"), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("123500"), dm_double_quantize_r(dm_double_fromstring("123456.7"), 2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("123.4"), dm_double_quantize_r(dm_double_fromstring("123.4"), -2, DM_FE_UPWARD)); // Already a multiple
+   EXPECT_EQ(dm_double_fromstring("1.000000000000001e300"), dm_double_quantize_r(dm_double_fromstring("1.000000000000001e300"), 0, DM_FE_UPWARD));
+
+      // Below the quantum, the result is zero or the quantum.
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_quantize_r(dm_double_fromstring("0.005"), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("0.01"), dm_double_quantize_r(dm_double_fromstring("0.005"), -2, DM_FE_TONEARESTFROMZERO));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dm_double_quantize_r(dm_double_fromstring("-0.004"), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("0.01"), dm_double_quantize_r(dm_double_fromstring("0.004"), -2, DM_FE_UPWARD));
+   EXPECT_EQ(dm_double_fromstring("-0.01"), dm_double_quantize_r(dm_double_fromstring("-1e-300"), -2, DM_FE_FROMZERO));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_quantize_r(dm_double_fromstring("1e-300"), -2, DM_FE_DOWNWARD));
+
+      // Rounding up past the largest number overflows.
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), dm_double_quantize_r(DM_DOUBLE_PACK(0, 511, 9999999999999999ULL), 497, DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), dm_double_quantize_r(dm_double_fromstring("5"), 600, DM_FE_UPWARD));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_quantize_r(dm_double_fromstring("5"), 600, DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), dm_double_quantize_r(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY), -2, DM_FE_TONEAREST));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), dm_double_quantize_r(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 255U), -2, DM_FE_TONEAREST));
+
+      // Quantizing to zero is rounding to an integer.
+   dm_double three = dm_double_fromstring("2.5");
+   EXPECT_EQ(dm_double_roundeven(three), dm_double_quantize_r(three, 0, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_round(three), dm_double_quantize_r(three, 0, DM_FE_TONEARESTFROMZERO));
+
+      // The array, with and without its own kernels, and in place, matches the scalar version.
+   TestRandom next;
+   const size_t count = 4096U;
+   static dm_double values [count], expected [count], quantized [count];
+   const dm_double specials [] = { DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY),
+      DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 255U), DM_DOUBLE_PACK(0, 511, 9999999999999999ULL), DM_DOUBLE_PACK(1, -300, 1000000000000000ULL) };
+   for (size_t i = 0U; i < count; ++i)
+    {
+      if (0U == (i % 11U))
+         values[i] = specials[next() % (sizeof(specials) / sizeof(specials[0]))];
+      else
+         values[i] = DM_DOUBLE_PACK(next() & 1U, static_cast<int>(next() % 41U) - 20, 1000000000000000ULL + next() % 9000000000000000ULL);
+    }
+   const int exponents [] = { -2, 3, -20, 497 };
+   const int modes [] = { DM_FE_TONEAREST, DM_FE_TONEARESTFROMZERO, DM_FE_UPWARD, DM_FE_TOWARDZERO, DM_FE_TONEARESTODD };
+   for (int exponent : exponents)
+    {
+      for (int mode : modes)
+       {
+         for (size_t i = 0U; i < count; ++i)
+            expected[i] = dm_double_quantize_r(values[i], exponent, mode);
+         dm_double_quantize_array(values, quantized, count, exponent, mode);
+         for (size_t i = 0U; i < count; ++i)
+            EXPECT_EQ(expected[i], quantized[i]) << exponent << " " << mode << " " << values[i];
+         for (size_t i = 0U; i < count; ++i)
+            quantized[i] = values[i];
+         dm_double_quantize_array(quantized, quantized, count, exponent, mode);
+         for (size_t i = 0U; i < count; ++i)
+            EXPECT_EQ(expected[i], quantized[i]) << exponent << " " << mode << " " << values[i];
+       }
+    }
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_quantize_r(dm_double_fromstring("123.45"), -2, DM_FE_TONEAREST);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_quantize_r(dm_double_fromstring("123.456"), -2, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_quantize_array(values, quantized, count, -2, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+
+#ifdef DM_STATS
+      // The array counts each rounding once, like the scalar calls: one element on the fast path, and one below the quantum.
+   const dm_double pair [] = { dm_double_fromstring("123.456"), dm_double_fromstring("0.004") };
+   dm_stats scalarStats, arrayStats;
+   dm_stats_reset();
+   dm_double_quantize_r(pair[0], -2, DM_FE_TONEAREST);
+   dm_double_quantize_r(pair[1], -2, DM_FE_TONEAREST);
+   dm_stats_snapshot(&scalarStats);
+   EXPECT_EQ(2U, scalarStats.round_inexact);
+   dm_stats_reset();
+   dm_double_quantize_array(pair, quantized, 2U, -2, DM_FE_TONEAREST);
+   dm_stats_snapshot(&arrayStats);
+   EXPECT_EQ(scalarStats.round_inexact, arrayStats.round_inexact);
+   EXPECT_EQ(scalarStats.round_increment, arrayStats.round_increment);
+
+   dm_stats_reset();
+   for (size_t i = 0U; i < count; ++i)
+      dm_double_quantize_r(values[i], 3, DM_FE_UPWARD);
+   dm_stats_snapshot(&scalarStats);
+   dm_stats_reset();
+   dm_double_quantize_array(values, quantized, count, 3, DM_FE_UPWARD);
+   dm_stats_snapshot(&arrayStats);
+   EXPECT_EQ(scalarStats.round_inexact, arrayStats.round_inexact);
+   EXPECT_EQ(scalarStats.round_increment, arrayStats.round_increment);
+   EXPECT_EQ(scalarStats.flush_to_infinity, arrayStats.flush_to_infinity);
+   dm_stats_reset();
+#endif /* DM_STATS */
+ }
+
+TEST(DMDoubleTest, testSqrt)
+ {
+   EXPECT_EQ(dm_double_fromstring("1.414213562373095"), dm_double_sqrt_r(dm_double_fromstring("2"), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("1.414213562373096"), dm_double_sqrt_r(dm_double_fromstring("2"), DM_FE_UPWARD));
+   EXPECT_EQ(dm_double_fromstring("1.5"), dm_double_sqrt_r(dm_double_fromstring("2.25"), DM_FE_UPWARD));
+   EXPECT_EQ(dm_double_fromstring("0.02"), dm_double_sqrt_r(dm_double_fromstring("0.0004"), DM_FE_DOWNWARD));
+   EXPECT_EQ(dm_double_fromstring("11111.11106055556"), dm_double_sqrt_r(dm_double_fromstring("123456789"), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("3.162277660168379e-256"), dm_double_sqrt_r(dm_double_fromstring("1e-511"), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("3.16227766016838e-256"), dm_double_sqrt_r(dm_double_fromstring("1e-511"), DM_FE_UPWARD));
+
+      // Just below halfway, and just below the next power of ten.
+   EXPECT_EQ(dm_double_fromstring("1"), dm_double_sqrt_r(dm_double_fromstring("1.000000000000001"), DM_FE_TONEARESTFROMZERO));
+   EXPECT_EQ(dm_double_fromstring("1.000000000000001"), dm_double_sqrt_r(dm_double_fromstring("1.000000000000001"), DM_FE_FROMZERO));
+   EXPECT_EQ(dm_double_fromstring("1"), dm_double_sqrt_r(dm_double_fromstring("0.9999999999999999"), DM_FE_UPWARD));
+   EXPECT_EQ(dm_double_fromstring("9.999999999999999e255"), dm_double_sqrt_r(DM_DOUBLE_PACK(0, 511, 9999999999999999ULL), DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("1e256"), dm_double_sqrt_r(DM_DOUBLE_PACK(0, 511, 9999999999999999ULL), DM_FE_UPWARD));
+
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U), dm_double_sqrt(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U), dm_double_sqrt(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY), dm_double_sqrt(DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY)));
+   EXPECT_EQ(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 42U), dm_double_sqrt(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 42U)));
+   EXPECT_TRUE(dm_double_isnan(dm_double_sqrt(DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY))));
+   EXPECT_TRUE(dm_double_isnan(dm_double_sqrt(dm_double_fromstring("-4"))));
+
+      // Against exact squares in dm_quad: the directed roundings bracket the root, one unit apart unless it is exact,
+      // and the nearest roundings pick the side of their midpoint.
+   TestRandom next;
+   const dm_quad two = dm_quad_fromstring("2");
+   const size_t count = 4096U;
+   static dm_double values [count], expected [count], roots [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dm_double arg;
+      if (0U == (i % 4U)) // A perfect square
+       {
+         dm_double root = DM_DOUBLE_PACK(0, static_cast<int>(next() % 41U) - 20, (1000000U + next() % 9000000U) * 1000000000U);
+         arg = dm_double_mul(root, root);
+       }
+      else
+         arg = DM_DOUBLE_PACK(0, static_cast<int>(next() % 1021U) - 510, 1000000000000000ULL + next() % 9000000000000000ULL);
+      values[i] = arg;
+
+      dm_double down = dm_double_sqrt_r(arg, DM_FE_DOWNWARD);
+      dm_double up = dm_double_sqrt_r(arg, DM_FE_UPWARD);
+      dm_quad square = dm_double_toquad(arg);
+      dm_quad downSquare = dm_quad_mul(dm_double_toquad(down), dm_double_toquad(down));
+      dm_quad upSquare = dm_quad_mul(dm_double_toquad(up), dm_double_toquad(up));
+      EXPECT_TRUE(dm_quad_islessequal(downSquare, square)) << arg;
+      EXPECT_TRUE(dm_quad_isgreaterequal(upSquare, square)) << arg;
+      if (dm_quad_isequal(downSquare, square))
+         EXPECT_EQ(down, up) << arg;
+      else
+       {
+         int exponent = 0;
+         (void) dm_double_frexp(down, &exponent);
+         EXPECT_EQ(up, dm_double_add(down, dm_double_ldexp(dm_double_fromstring("1e-15"), exponent))) << arg;
+       }
+      dm_quad middle = dm_quad_div(dm_quad_add(dm_double_toquad(down), dm_double_toquad(up)), two);
+      dm_double nearest = dm_quad_isless(square, dm_quad_mul(middle, middle)) ? down : up;
+      EXPECT_EQ(nearest, dm_double_sqrt_r(arg, DM_FE_TONEAREST)) << arg;
+      EXPECT_EQ(nearest, dm_double_sqrt_r(arg, DM_FE_TONEARESTFROMZERO)) << arg;
+      EXPECT_EQ(nearest, dm_double_sqrt_r(arg, DM_FE_TONEARESTODD)) << arg;
+      EXPECT_EQ(nearest, dm_double_sqrt_r(arg, DM_FE_TONEARESTTOWARDZERO)) << arg;
+      EXPECT_EQ(down, dm_double_sqrt_r(arg, DM_FE_TOWARDZERO)) << arg;
+      EXPECT_EQ(up, dm_double_sqrt_r(arg, DM_FE_FROMZERO)) << arg;
+    }
+
+      // The array matches the scalar version, in place too.
+   values[1] = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+   values[2] = dm_double_fromstring("-1");
+   for (size_t i = 0U; i < count; ++i)
+      expected[i] = dm_double_sqrt_r(values[i], DM_FE_UPWARD);
+   dm_double_sqrt_array(values, roots, count, DM_FE_UPWARD);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(expected[i], roots[i]) << values[i];
+   dm_double_sqrt_array(values, values, count, DM_FE_UPWARD);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(expected[i], values[i]);
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_sqrt_r(dm_double_fromstring("2.25"), DM_FE_TONEAREST);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_sqrt_r(dm_double_fromstring("2"), DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_sqrt_r(dm_double_fromstring("-2"), DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testExpLog)
+ {
+   const dm_double one = dm_double_fromstring("1");
+   const dm_double nan = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 42U);
+   const dm_double inf = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double ninf = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double zero = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+   const dm_double nzero = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U);
+
+      // Against a high-precision reference.
+   EXPECT_EQ(dm_double_fromstring("2.718281828459045"), dm_double_exp(one));
+   EXPECT_EQ(dm_double_fromstring("0.3678794411714423"), dm_double_exp(dm_double_fromstring("-1")));
+   EXPECT_EQ(dm_double_fromstring("1.014232054735005e304"), dm_double_exp(dm_double_fromstring("700")));
+   EXPECT_EQ(dm_double_fromstring("1.0000000001"), dm_double_exp(dm_double_fromstring("1e-10")));
+   EXPECT_EQ(dm_double_fromstring("1.00000000005e-10"), dm_double_expm1(dm_double_fromstring("1e-10")));
+   EXPECT_EQ(dm_double_fromstring("0.05127109637602404"), dm_double_expm1(dm_double_fromstring("0.05")));
+   EXPECT_EQ(dm_double_fromstring("-0.2591817793182821"), dm_double_expm1(dm_double_fromstring("-0.3")));
+   EXPECT_EQ(dm_double_fromstring("0.6931471805599453"), dm_double_log(dm_double_fromstring("2")));
+   EXPECT_EQ(dm_double_fromstring("9.999999999999995e-16"), dm_double_log(dm_double_fromstring("1.000000000000001")));
+   EXPECT_EQ(dm_double_fromstring("-690.7755278982137"), dm_double_log(dm_double_fromstring("1e-300")));
+   EXPECT_EQ(dm_double_fromstring("0.3010299956639812"), dm_double_log10(dm_double_fromstring("2")));
+   EXPECT_EQ(dm_double_fromstring("-0.3010299956639812"), dm_double_log10(dm_double_fromstring("0.5")));
+   EXPECT_EQ(dm_double_fromstring("1e-20"), dm_double_log1p(dm_double_fromstring("1e-20")));
+   EXPECT_EQ(dm_double_fromstring("-0.6931471805599453"), dm_double_log1p(dm_double_fromstring("-0.5")));
+   EXPECT_EQ(dm_double_fromstring("1.414213562373095"), dm_double_pow(dm_double_fromstring("2"), dm_double_fromstring("0.5")));
+   EXPECT_EQ(dm_double_fromstring("7.612255042662029"), dm_double_pow(dm_double_fromstring("1.07"), dm_double_fromstring("30")));
+   EXPECT_EQ(dm_double_fromstring("0.003162277660168379"), dm_double_pow(dm_double_fromstring("10"), dm_double_fromstring("-2.5")));
+   EXPECT_EQ(dm_double_fromstring("2.718281692544966"), dm_double_pow(dm_double_fromstring("1.0000001"), dm_double_fromstring("1e7")));
+   EXPECT_EQ(dm_double_fromstring("0.9878765474230741"), dm_double_pow(dm_double_fromstring("1.05"), dm_double_fromstring("-0.25")));
+   EXPECT_EQ(dm_double_fromstring("-8"), dm_double_pow(dm_double_fromstring("-2"), dm_double_fromstring("3")));
+   EXPECT_EQ(dm_double_fromstring("0.25"), dm_double_pow(dm_double_fromstring("-2"), dm_double_fromstring("-2")));
+
+      // The current rounding mode is used.
+   dm_fesetround(DM_FE_UPWARD);
+   EXPECT_EQ(dm_double_fromstring("2.718281828459046"), dm_double_exp(one));
+   dm_fesetround(DM_FE_DOWNWARD);
+   EXPECT_EQ(dm_double_fromstring("0.6931471805599453"), dm_double_log(dm_double_fromstring("2")));
+   dm_fesetround(DM_FE_TONEAREST);
+
+      // Exact cases: the common logarithms of powers of ten, and the identities.
+   for (int power = -511; power <= 511; ++power)
+    {
+      char buffer [16];
+      std::snprintf(buffer, sizeof(buffer), "1e%d", power);
+      EXPECT_EQ(dm_double_fromint64(power), dm_double_log10(dm_double_fromstring(buffer))) << power;
+    }
+   EXPECT_EQ(one, dm_double_exp(zero));
+   EXPECT_EQ(one, dm_double_exp(nzero));
+   EXPECT_EQ(zero, dm_double_log(one));
+   EXPECT_EQ(zero, dm_double_log10(one));
+   EXPECT_EQ(nzero, dm_double_expm1(nzero));
+   EXPECT_EQ(nzero, dm_double_log1p(nzero));
+   EXPECT_EQ(dm_double_fromstring("1024"), dm_double_pow(dm_double_fromstring("2"), dm_double_fromstring("10")));
+   EXPECT_EQ(dm_double_fromstring("1e-300"), dm_double_pow(dm_double_fromstring("1e-100"), dm_double_fromstring("3")));
+
+      // Special values, as in C99.
+   EXPECT_EQ(nan, dm_double_exp(nan));
+   EXPECT_EQ(inf, dm_double_exp(inf));
+   EXPECT_EQ(zero, dm_double_exp(ninf));
+   EXPECT_EQ(dm_double_fromstring("-1"), dm_double_expm1(ninf));
+   EXPECT_EQ(inf, dm_double_exp(dm_double_fromstring("1300")));
+   EXPECT_EQ(zero, dm_double_exp(dm_double_fromstring("-1300")));
+   EXPECT_EQ(nan, dm_double_log(nan));
+   EXPECT_EQ(ninf, dm_double_log(zero));
+   EXPECT_EQ(ninf, dm_double_log10(nzero));
+   EXPECT_TRUE(dm_double_isnan(dm_double_log(dm_double_fromstring("-1"))));
+   EXPECT_EQ(inf, dm_double_log(inf));
+   EXPECT_EQ(ninf, dm_double_log1p(dm_double_fromstring("-1")));
+   EXPECT_TRUE(dm_double_isnan(dm_double_log1p(dm_double_fromstring("-2"))));
+   EXPECT_EQ(one, dm_double_pow(nan, zero));
+   EXPECT_EQ(one, dm_double_pow(one, nan));
+   EXPECT_EQ(nan, dm_double_pow(nan, one));
+   EXPECT_EQ(one, dm_double_pow(dm_double_fromstring("-1"), ninf));
+   EXPECT_EQ(zero, dm_double_pow(dm_double_fromstring("0.5"), inf));
+   EXPECT_EQ(inf, dm_double_pow(dm_double_fromstring("0.5"), ninf));
+   EXPECT_EQ(nzero, dm_double_pow(nzero, dm_double_fromstring("3")));
+   EXPECT_EQ(zero, dm_double_pow(nzero, dm_double_fromstring("2")));
+   EXPECT_EQ(ninf, dm_double_pow(nzero, dm_double_fromstring("-3")));
+   EXPECT_EQ(inf, dm_double_pow(zero, dm_double_fromstring("-0.5")));
+   EXPECT_EQ(ninf, dm_double_pow(ninf, dm_double_fromstring("3")));
+   EXPECT_EQ(nzero, dm_double_pow(ninf, dm_double_fromstring("-3")));
+   EXPECT_EQ(inf, dm_double_pow(ninf, dm_double_fromstring("0.5")));
+   EXPECT_TRUE(dm_double_isnan(dm_double_pow(dm_double_fromstring("-2"), dm_double_fromstring("0.5"))));
+   EXPECT_EQ(inf, dm_double_pow(dm_double_fromstring("10"), dm_double_fromstring("600")));
+   EXPECT_EQ(nzero, dm_double_pow(dm_double_fromstring("-10"), dm_double_fromstring("-601")));
+
+      // Against long double, where it has more digits, in every rounding mode: within the documented bound.
+   TestRandom next;
+   auto toLong = [](dm_double arg) { char buffer [32]; dm_double_tostring(arg, buffer); return std::strtold(buffer, nullptr); };
+   const size_t count = 1024U;
+   static dm_double values [count], bases [count], results [count];
+   for (size_t i = 0U; i < count; ++i)
+    {
+      values[i] = DM_DOUBLE_PACK(next() & 1U, -15 - static_cast<int>(next() % 3U), 1000000000000000ULL + next() % 9000000000000000ULL); // |x| < 10
+      bases[i] = DM_DOUBLE_PACK(0, static_cast<int>(next() % 41U) - 20, 1000000000000000ULL + next() % 9000000000000000ULL);
+    }
+   if (std::numeric_limits<long double>::digits >= 64)
+    {
+      for (int mode = DM_FE_TONEAREST; mode <= DM_FE_FROMZERO; ++mode)
+       {
+         const bool nearest = (DM_FE_TONEAREST == mode) || (DM_FE_TONEARESTFROMZERO == mode) || (DM_FE_TONEARESTODD == mode) || (DM_FE_TONEARESTTOWARDZERO == mode);
+         dm_fesetround(mode);
+         for (size_t i = 0U; i < count; ++i)
+          {
+            long double x = toLong(values[i]), b = toLong(bases[i]);
+            if (std::fabs(std::log(b)) < 0.05L) continue; // Ill conditioned in long double
+            const long double expected [] = { std::exp(x), std::log(b), std::log10(b), std::pow(b, x / 8.0L) };
+            const dm_double actual [] = { dm_double_exp(values[i]), dm_double_log(bases[i]), dm_double_log10(bases[i]),
+               dm_double_pow(bases[i], dm_double_div(values[i], dm_double_fromstring("8"))) };
+            for (size_t j = 0U; j < (sizeof(actual) / sizeof(actual[0])); ++j)
+             {
+               long double ulp = std::pow(10.0L, std::floor(std::log10(std::fabs(expected[j]))) - 15.0L);
+               EXPECT_LE(std::fabs(toLong(actual[j]) - expected[j]) / ulp, nearest ? 0.52L : 1.02L) << mode << " " << j << " " << values[i] << " " << bases[i];
+             }
+          }
+       }
+      dm_fesetround(DM_FE_TONEAREST);
+    }
+
+      // The arrays match the scalar versions.
+   values[1] = nan;
+   values[2] = ninf;
+   bases[3] = zero;
+   bases[4] = dm_double_fromstring("-1");
+   dm_double_exp_array(values, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_exp(values[i]), results[i]);
+   dm_double_expm1_array(values, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_expm1(values[i]), results[i]);
+   dm_double_log_array(bases, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_log(bases[i]), results[i]);
+   dm_double_log10_array(bases, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_log10(bases[i]), results[i]);
+   dm_double_log1p_array(values, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_log1p(values[i]), results[i]);
+   dm_double_pow_array(bases, values, results, count);
+   for (size_t i = 0U; i < count; ++i)
+      EXPECT_EQ(dm_double_pow(bases[i], values[i]), results[i]);
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_log10(dm_double_fromstring("1000"));
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_exp(one);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_log(zero);
+   EXPECT_EQ(DM_FE_DIVBYZERO, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_pow(dm_double_fromstring("-2"), dm_double_fromstring("0.5"));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_exp(dm_double_fromstring("1300"));
+   EXPECT_EQ(DM_FE_OVERFLOW | DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testPowi)
+ {
+   const dm_double one = dm_double_fromstring("1");
+   const dm_double nan = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 42U);
+   const dm_double inf = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double ninf = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double zero = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+   const dm_double nzero = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, 0U);
+
+      // Against a high-precision reference.
+   EXPECT_EQ(dm_double_fromstring("42476396.40868002"), dm_double_powi_r(dm_double_fromstring("1.05"), 360, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("42476396.40868003"), dm_double_powi_r(dm_double_fromstring("1.05"), 360, DM_FE_UPWARD));
+   EXPECT_EQ(dm_double_fromstring("2.718145926825225"), dm_double_powi_r(dm_double_fromstring("1.0001"), 10000, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("2.718281828459044"), dm_double_powi_r(dm_double_fromstring("1.000000000000001"), 1000000000000000LL, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("2.71964221644285"), dm_double_powi_r(dm_double_fromstring("0.999"), -1000, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("0.00005949901826619861"), dm_double_powi_r(dm_double_fromstring("7"), -5, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("0.3333333333333334"), dm_double_powi_r(dm_double_fromstring("3"), -1, DM_FE_FROMZERO));
+   EXPECT_EQ(dm_double_fromstring("1.152921504606847e18"), dm_double_powi_r(dm_double_fromstring("2"), 60, DM_FE_TONEAREST));
+   EXPECT_EQ(dm_double_fromstring("1.152921504606846e18"), dm_double_powi_r(dm_double_fromstring("2"), 60, DM_FE_TOWARDZERO));
+   EXPECT_EQ(dm_double_fromstring("-2.305843009213693e18"), dm_double_powi_r(dm_double_fromstring("-2"), 61, DM_FE_TOWARDZERO));
+
+      // Exact results are exact in every mode, and powers of ten only move the exponent.
+   for (int mode = DM_FE_TONEAREST; mode <= DM_FE_FROMZERO; ++mode)
+    {
+      EXPECT_EQ(dm_double_fromstring("1.1449"), dm_double_powi_r(dm_double_fromstring("1.07"), 2, mode));
+      EXPECT_EQ(dm_double_fromstring("9007199254740992"), dm_double_powi_r(dm_double_fromstring("2"), 53, mode));
+      EXPECT_EQ(dm_double_fromstring("-0.00006103515625"), dm_double_powi_r(dm_double_fromstring("-4"), -7, mode));
+      EXPECT_EQ(dm_double_fromstring("1e300"), dm_double_powi_r(dm_double_fromstring("10"), 300, mode));
+      EXPECT_EQ(dm_double_fromstring("1e100"), dm_double_powi_r(dm_double_fromstring("1e-5"), -20, mode));
+      EXPECT_EQ(dm_double_fromstring("-1e-15"), dm_double_powi_r(dm_double_fromstring("-0.001"), 5, mode));
+      EXPECT_EQ(one, dm_double_powi_r(dm_double_fromstring("-1"), INT64_MIN, mode));
+    }
+   EXPECT_EQ(dm_double_fromstring("123.456"), dm_double_powi_r(dm_double_fromstring("123.456"), 1, DM_FE_UPWARD));
+
+      // The special cases are those of pow with an integer y.
+   EXPECT_EQ(one, dm_double_powi_r(nan, 0, DM_FE_TONEAREST));
+   EXPECT_EQ(nan, dm_double_powi_r(nan, 3, DM_FE_TONEAREST));
+   EXPECT_EQ(nzero, dm_double_powi_r(nzero, 3, DM_FE_TONEAREST));
+   EXPECT_EQ(zero, dm_double_powi_r(nzero, 2, DM_FE_TONEAREST));
+   EXPECT_EQ(ninf, dm_double_powi_r(nzero, -3, DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_double_powi_r(zero, -3, DM_FE_TONEAREST));
+   EXPECT_EQ(ninf, dm_double_powi_r(ninf, 3, DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_double_powi_r(ninf, 2, DM_FE_TONEAREST));
+   EXPECT_EQ(nzero, dm_double_powi_r(ninf, -3, DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_double_powi_r(dm_double_fromstring("10"), 600, DM_FE_TONEAREST));
+   EXPECT_EQ(inf, dm_double_powi_r(dm_double_fromstring("2"), INT64_MAX, DM_FE_TONEAREST));
+   EXPECT_EQ(zero, dm_double_powi_r(dm_double_fromstring("10"), INT64_MIN, DM_FE_TONEAREST));
+   EXPECT_EQ(nzero, dm_double_powi_r(dm_double_fromstring("-1.5"), -3001, DM_FE_TONEAREST));
+
+      // pow takes integer powers through the same path.
+   EXPECT_EQ(dm_double_powi_r(dm_double_fromstring("1.05"), 360, DM_FE_TONEAREST), dm_double_pow(dm_double_fromstring("1.05"), dm_double_fromstring("360")));
+   EXPECT_EQ(dm_double_fromstring("-0.00006103515625"), dm_double_pow(dm_double_fromstring("-4"), dm_double_fromstring("-7")));
+   EXPECT_EQ(dm_double_fromstring("1e-40"), dm_double_pow(dm_double_fromstring("100"), dm_double_fromstring("-20")));
+
+      // Against dm_quad, which carries more digits than the error of repeated squaring: the directed roundings
+      // bracket the power, one unit apart unless it is exact.
+   TestRandom next;
+   for (size_t i = 0U; i < 2000U; ++i)
+    {
+      dm_double base = DM_DOUBLE_PACK(next() & 1U, static_cast<int>(next() % 9U) - 4, 1000000000000000ULL + next() % 9000000000000000ULL);
+      int64_t n = static_cast<int64_t>(next() % 41U) - 20;
+      if (0 == n) continue;
+      dm_quad power = dm_quad_fromstring("1");
+      for (int64_t j = 0; j < ((n < 0) ? -n : n); ++j)
+         power = dm_quad_mul(power, dm_double_toquad(base));
+      if (n < 0)
+         power = dm_quad_div(dm_quad_fromstring("1"), power);
+      dm_double down = dm_double_powi_r(base, n, DM_FE_DOWNWARD);
+      dm_double up = dm_double_powi_r(base, n, DM_FE_UPWARD);
+      EXPECT_TRUE(dm_quad_islessequal(dm_double_toquad(down), power)) << base << " " << n;
+      EXPECT_TRUE(dm_quad_isgreaterequal(dm_double_toquad(up), power)) << base << " " << n;
+      if (dm_quad_isequal(dm_double_toquad(down), power))
+         EXPECT_EQ(down, up) << base << " " << n;
+      else
+       {
+         int exponent = 0;
+         (void) dm_double_frexp(dm_double_signbit(down) ? up : down, &exponent); // The unit of the smaller magnitude
+         EXPECT_EQ(up, dm_double_add(down, dm_double_ldexp(dm_double_fromstring("1e-15"), exponent))) << base << " " << n;
+       }
+    }
+
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_powi_r(dm_double_fromstring("1.07"), 2, DM_FE_TONEAREST);
+   dm_double_powi_r(dm_double_fromstring("10"), -300, DM_FE_TONEAREST);
+   dm_double_pow(dm_double_fromstring("2"), dm_double_fromstring("10"));
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_powi_r(dm_double_fromstring("1.07"), 30, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_powi_r(dm_double_fromstring("0"), -1, DM_FE_TONEAREST);
+   EXPECT_EQ(DM_FE_DIVBYZERO, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+ }
+
+TEST(DMDoubleTest, testScan)
+ {
+   const dm_double nan = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 5U);
+   const dm_double inf = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   const dm_double zero = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+   dm_double dest [4];
+
+      // The serial scan rounds every sum, and the exact one only rounds what it hands out.
+   const dm_double cancel [] = { dm_double_fromstring("1e20"), dm_double_fromstring("1"), dm_double_fromstring("-1e20") };
+   dm_double_inclusive_scan(cancel, dest, 3U, DM_FE_TONEAREST, DM_SCAN_SERIAL);
+   EXPECT_EQ(cancel[0], dest[0]);
+   EXPECT_EQ(cancel[0], dest[1]);
+   EXPECT_EQ(zero, dest[2]);
+   dm_double_inclusive_scan(cancel, dest, 3U, DM_FE_TONEAREST, DM_SCAN_EXACT);
+   EXPECT_EQ(cancel[0], dest[0]);
+   EXPECT_EQ(cancel[0], dest[1]);
+   EXPECT_EQ(cancel[1], dest[2]);
+   dm_double_inclusive_scan(cancel, dest, 3U, DM_FE_UPWARD, DM_SCAN_EXACT);
+   EXPECT_EQ(dm_double_fromstring("1.000000000000001e20"), dest[1]);
+   EXPECT_EQ(cancel[1], dest[2]);
+   dm_double_exclusive_scan(cancel, dest, 3U, dm_double_fromstring("-1"), DM_FE_TOWARDZERO, DM_SCAN_EXACT);
+   EXPECT_EQ(dm_double_fromstring("-1"), dest[0]);
+   EXPECT_EQ(dm_double_fromstring("9.999999999999999e19"), dest[1]);
+   EXPECT_EQ(cancel[0], dest[2]);
+
+      // Exclusive scans start from the initial value, and both work in place.
+   dm_double values [] = { dm_double_fromstring("1.5"), dm_double_fromstring("2.25"), dm_double_fromstring("-3") };
+   for (int method = DM_SCAN_SERIAL; method <= DM_SCAN_EXACT; ++method)
+    {
+      dm_double copy [3] = { values[0], values[1], values[2] };
+      dm_double_exclusive_scan(copy, copy, 3U, dm_double_fromstring("10"), DM_FE_TONEAREST, method);
+      EXPECT_EQ(dm_double_fromstring("10"), copy[0]);
+      EXPECT_EQ(dm_double_fromstring("11.5"), copy[1]);
+      EXPECT_EQ(dm_double_fromstring("13.75"), copy[2]);
+      dm_double_inclusive_scan(values, copy, 3U, DM_FE_TONEAREST, method);
+      dm_double_inclusive_scan(copy, copy, 3U, DM_FE_TONEAREST, method);
+      EXPECT_EQ(dm_double_fromstring("1.5"), copy[0]);
+      EXPECT_EQ(dm_double_fromstring("5.25"), copy[1]);
+      EXPECT_EQ(dm_double_fromstring("6"), copy[2]);
+      dm_double_exclusive_scan(values, copy, 0U, zero, DM_FE_TONEAREST, method); // Nothing to do
+      dm_double_inclusive_scan(values, copy, 0U, DM_FE_TONEAREST, method);
+      EXPECT_EQ(dm_double_fromstring("6"), copy[2]);
+    }
+
+      // Where nothing rounds, both methods agree with each other: special values and the signs of zero too.
+   const dm_double specials [][4] =
+    {
+      { dm_double_fromstring("1"), inf, dm_double_neg(inf), nan },
+      { nan, dm_double_neg(inf), inf, dm_double_fromstring("1") },
+      { dm_double_neg(inf), dm_double_fromstring("2"), dm_double_neg(inf), inf },
+      { dm_double_neg(zero), dm_double_neg(zero), zero, dm_double_neg(zero) },
+      { zero, zero, dm_double_fromstring("1"), dm_double_fromstring("-1") },
+      { dm_double_fromstring("0.1"), dm_double_fromstring("-0.1"), dm_double_neg(zero), dm_double_fromstring("5e-511") }
+    };
+   for (const dm_double* row : specials)
+      for (int mode = DM_FE_TONEAREST; mode <= DM_FE_FROMZERO; ++mode)
+       {
+         dm_double serial [4];
+         dm_double_inclusive_scan(row, serial, 4U, mode, DM_SCAN_SERIAL);
+         dm_double_inclusive_scan(row, dest, 4U, mode, DM_SCAN_EXACT);
+         for (size_t i = 0U; i < 4U; ++i) EXPECT_EQ(serial[i], dest[i]) << mode << " " << i;
+         dm_double_exclusive_scan(row, serial, 4U, dm_double_neg(zero), mode, DM_SCAN_SERIAL);
+         dm_double_exclusive_scan(row, dest, 4U, dm_double_neg(zero), mode, DM_SCAN_EXACT);
+         for (size_t i = 0U; i < 4U; ++i) EXPECT_EQ(serial[i], dest[i]) << mode << " " << i;
+       }
+   dm_double_inclusive_scan(specials[1], dest, 4U, DM_FE_TONEAREST, DM_SCAN_EXACT);
+   EXPECT_EQ(nan, dest[3]); // The payload of the first NaN
+   dm_double_inclusive_scan(specials[0], dest, 4U, DM_FE_TONEAREST, DM_SCAN_EXACT);
+   EXPECT_TRUE(dm_double_isnan(dest[2]));
+   EXPECT_NE(nan, dest[3]); // Inf - Inf came first.
+
+   int threads = dm_double_batch_getthreads();
+#ifndef DM_NO_THREADS
+   EXPECT_EQ(3, dm_double_batch_setthreads(3));
+   EXPECT_EQ(3, dm_double_batch_getthreads());
+#endif /* ! DM_NO_THREADS */
+   EXPECT_LE(1, dm_double_batch_setthreads(0));
+   EXPECT_GE(64, dm_double_batch_setthreads(1000));
+
+      // Exponents close enough that dm_quad sums them exactly, so that every exact prefix can be checked.
+   TestRandom next(0x5CA115CA115CA11ULL);
+   const size_t count = 100000U;
+   static dm_double src [count], exact [count], split [count];
+   auto same = [&]() { size_t i = 0U; while ((i < count) && (exact[i] == split[i])) ++i; return i; };
+   for (size_t i = 0U; i < count; ++i)
+      src[i] = DM_DOUBLE_PACK(next() & 1U, (int)(next() % 9U), 1000000000000000ULL + next() % 9000000000000000ULL);
+   for (int mode : { DM_FE_TONEAREST, DM_FE_UPWARD, DM_FE_TONEARESTODD })
+    {
+      dm_double_batch_setthreads(1);
+      dm_double_inclusive_scan(src, exact, count, mode, DM_SCAN_EXACT);
+      dm_quad sum = dm_double_toquad(zero);
+      for (size_t i = 0U; i < count; ++i)
+       {
+         sum = dm_quad_add_r(sum, dm_double_toquad(src[i]), mode);
+         EXPECT_EQ(dm_double_fromquad_r(sum, mode), exact[i]) << mode << " " << i;
+       }
+
+         // The same bits however many threads there are.
+      for (int blocks : { 2, 5, 8 })
+       {
+         dm_double_batch_setthreads(blocks);
+         dm_double_inclusive_scan(src, split, count, mode, DM_SCAN_EXACT);
+         EXPECT_EQ(count, same()) << mode << " " << blocks;
+       }
+    }
+
+      // All the exponents, the special values, and an exclusive scan in place.
+   for (size_t i = 0U; i < count; ++i)
+      src[i] = DM_DOUBLE_PACK(next() & 1U, (int)(next() % 1023U) - 511, 1000000000000000ULL + next() % 9000000000000000ULL);
+   src[30000] = dm_double_neg(inf);
+   src[50000] = inf;
+   src[70000] = nan;
+   dm_double_batch_setthreads(1);
+   dm_double_exclusive_scan(src, exact, count, dm_double_fromstring("1e500"), DM_FE_DOWNWARD, DM_SCAN_EXACT);
+   EXPECT_TRUE(dm_double_isinf(exact[30001]));
+   EXPECT_TRUE(dm_double_isnan(exact[50001]));
+   for (int blocks : { 3, 7 })
+    {
+      dm_double_batch_setthreads(blocks);
+      for (size_t i = 0U; i < count; ++i) split[i] = src[i];
+      dm_double_exclusive_scan(split, split, count, dm_double_fromstring("1e500"), DM_FE_DOWNWARD, DM_SCAN_EXACT);
+      EXPECT_EQ(count, same()) << blocks;
+    }
+
+      // Amounts that never round: the methods agree. Only the last sum rounds, on the last thread.
+   for (size_t i = 0U; i < count; ++i)
+      src[i] = DM_DOUBLE_PACK(next() & 1U, 2, (100U + next() % 900U) * 10000000000000ULL);
+   src[count - 1U] = dm_double_fromstring("1e-20");
+   dm_double_batch_setthreads(4);
+   dm_double_inclusive_scan(src, exact, count, DM_FE_TONEAREST, DM_SCAN_SERIAL);
+#ifdef DM_FENV_FLAGS
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+   dm_double_inclusive_scan(src, split, count, DM_FE_TONEAREST, DM_SCAN_EXACT);
+#ifdef DM_FENV_FLAGS
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+#endif /* DM_FENV_FLAGS */
+   EXPECT_EQ(count, same());
+
+   dm_double_batch_setthreads(threads);
+ }
+
+#ifdef DM_STATS
+TEST(DMDoubleTest, testStats)
+ {
+   dm_double positiveOne  = DM_DOUBLE_PACK(0, 0, 1000000000000000ULL);
+   dm_double tiny         = DM_DOUBLE_PACK(0, -20, 1000000000000000ULL);
+   dm_double huge         = DM_DOUBLE_PACK(0, 400, 1000000000000000ULL);
+   dm_double small        = DM_DOUBLE_PACK(0, -400, 1000000000000000ULL);
+   dm_double digits       = DM_DOUBLE_PACK(0, 0, 1234567890123456ULL);
+   dm_stats stats;
+
+   dm_stats_reset();
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(0U, stats.round_inexact);
+   EXPECT_EQ(0U, stats.round_increment);
+   EXPECT_EQ(0U, stats.flush_to_zero);
+   EXPECT_EQ(0U, stats.flush_to_infinity);
+   EXPECT_EQ(0U, stats.add_degenerate);
+   EXPECT_EQ(0U, stats.fma_pathological);
+
+   EXPECT_EQ(positiveOne, dm_double_add_r(positiveOne, tiny, DM_FE_TONEAREST));
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(1U, stats.add_degenerate);
+   EXPECT_EQ(1U, stats.round_inexact);
+   EXPECT_EQ(0U, stats.round_increment);
+
+   EXPECT_NE(positiveOne, dm_double_add_r(positiveOne, tiny, DM_FE_UPWARD));
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(2U, stats.add_degenerate);
+   EXPECT_EQ(1U, stats.round_increment);
+
+   EXPECT_TRUE(dm_double_isinf(dm_double_mul(huge, huge)));
+   EXPECT_TRUE(dm_double_iszero(dm_double_mul(small, small)));
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(1U, stats.flush_to_infinity);
+   EXPECT_EQ(1U, stats.flush_to_zero);
+
+   dm_double_fma(digits, digits, dm_double_neg(dm_double_mul(digits, digits)));
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(1U, stats.fma_pathological);
+
+   dm_stats_reset();
+   dm_stats_snapshot(&stats);
+   EXPECT_EQ(0U, stats.add_degenerate);
+   EXPECT_EQ(0U, stats.fma_pathological);
+ }
+#endif /* DM_STATS */
+
+#ifdef DM_FENV_FLAGS
+TEST(DMDoubleTest, testFenvFlags)
+ {
+   dm_double positiveOne  = DM_DOUBLE_PACK(0, 0, 1000000000000000ULL);
+   dm_double positiveTwo  = DM_DOUBLE_PACK(0, 0, 2000000000000000ULL);
+   dm_double positiveInf  = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, DM_INFINITY);
+   dm_double negativeInf  = DM_DOUBLE_PACK_ALT(1, SPECIAL_EXPONENT, DM_INFINITY);
+   dm_double positiveZero = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+   dm_double nan          = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 1U);
+   dm_double huge         = DM_DOUBLE_PACK(0, 400, 1000000000000000ULL);
+   dm_double small        = DM_DOUBLE_PACK(0, -400, 1000000000000000ULL);
+
+   EXPECT_EQ(0, dm_feclearexcept(DM_FE_ALL_EXCEPT));
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+
+      // Exact operations and quiet NaNs raise nothing.
+   dm_double_add(positiveOne, positiveTwo);
+   dm_double_mul(positiveTwo, positiveTwo);
+   dm_double_div(positiveOne, positiveTwo);
+   dm_double_add(nan, positiveOne);
+   dm_double_ldexp(positiveZero, 1200);
+   dm_double_fromstring("0");
+   dm_double_fromstring("-0e-999");
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+
+   dm_double_div(positiveOne, DM_DOUBLE_PACK(0, 0, 3000000000000000ULL));
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_double_add(positiveOne, positiveTwo);
+   EXPECT_EQ(DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT)); // Sticky
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_OVERFLOW));
+   dm_feclearexcept(DM_FE_INEXACT);
+
+   EXPECT_EQ(positiveInf, dm_double_mul(huge, huge));
+   EXPECT_EQ(DM_FE_OVERFLOW | DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+
+   EXPECT_EQ(positiveZero, dm_double_mul(small, small));
+   EXPECT_EQ(DM_FE_UNDERFLOW | DM_FE_INEXACT, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+
+   EXPECT_EQ(positiveInf, dm_double_fromstring("1e600"));
+   EXPECT_EQ(DM_FE_OVERFLOW, dm_fetestexcept(DM_FE_OVERFLOW));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+
+   EXPECT_EQ(positiveInf, dm_double_div(positiveOne, positiveZero));
+   EXPECT_EQ(DM_FE_DIVBYZERO, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   dm_double_div(positiveInf, positiveZero);
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+
+   EXPECT_TRUE(dm_double_isnan(dm_double_add(positiveInf, negativeInf)));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   EXPECT_TRUE(dm_double_isnan(dm_double_mul(positiveZero, positiveInf)));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   EXPECT_TRUE(dm_double_isnan(dm_double_div(positiveZero, positiveZero)));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   EXPECT_TRUE(dm_double_isnan(dm_double_fmod(positiveOne, positiveZero)));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+   EXPECT_TRUE(dm_double_iszero(dm_double_fma(dm_double_fromstring("3"), dm_double_fromstring("0.25"), dm_double_fromstring("-0.75")))); // Exact cancellation
+   EXPECT_EQ(0, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   EXPECT_TRUE(dm_double_isnan(dm_double_fma(positiveZero, positiveInf, positiveOne)));
+   EXPECT_EQ(DM_FE_INVALID, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+
+   EXPECT_EQ(0, dm_feraiseexcept(DM_FE_UNDERFLOW));
+   EXPECT_EQ(DM_FE_INVALID | DM_FE_UNDERFLOW, dm_fetestexcept(DM_FE_ALL_EXCEPT));
+   dm_feclearexcept(DM_FE_ALL_EXCEPT);
+ }
+#endif /* DM_FENV_FLAGS */
+
+TEST(DMDoubleTest, testCxxWrapper)
+ {
+   using namespace dm::literals;
+   typedef std::numeric_limits<dm::decimal64> limits;
+
+      // The literals must match dm_double_fromstring, rounding and all.
+#define DM_LITERAL_CHECK(x) EXPECT_EQ(dm_double_fromstring(#x), (x##_dm).bits())
+   DM_LITERAL_CHECK(1.25);
+   DM_LITERAL_CHECK(0.01);
+   DM_LITERAL_CHECK(0);
+   DM_LITERAL_CHECK(0.000);
+   DM_LITERAL_CHECK(100);
+   DM_LITERAL_CHECK(123456789012345678);
+   DM_LITERAL_CHECK(1.2345678901234565);
+   DM_LITERAL_CHECK(1.2345678901234575);
+   DM_LITERAL_CHECK(1.23456789012345650001);
+   DM_LITERAL_CHECK(1.23456789012345649999);
+   DM_LITERAL_CHECK(9.99999999999999999);
+   DM_LITERAL_CHECK(0.000123456789012345678);
+   DM_LITERAL_CHECK(1e-511);
+   DM_LITERAL_CHECK(9.999999999999999e511);
+   DM_LITERAL_CHECK(1E+10);
+   DM_LITERAL_CHECK(1e600);
+   DM_LITERAL_CHECK(1e-600);
+   DM_LITERAL_CHECK(1e99999999999);
+#undef DM_LITERAL_CHECK
+   EXPECT_EQ(dm_double_fromstring("1000000.25"), (1'000'000.25_dm).bits());
+   EXPECT_EQ(dm_double_fromstring("-1.25"), (-1.25_dm).bits());
+
+   constexpr dm::decimal64 rate = 0.0725_dm; // Must be a constant expression
+   static_assert(rate.bits() == dm::decimal64::from_bits(rate.bits()).bits(), "");
+   static_assert(limits::is_specialized && (10 == limits::radix) && (16 == limits::digits10), "");
+   static_assert((limits::max().bits() == (9.999999999999999e511_dm).bits()) && (limits::min().bits() == (1e-511_dm).bits()), "");
+
+   EXPECT_TRUE(dm_double_iszero(dm::decimal64().bits()));
+   EXPECT_EQ(dm_double_fromstring("9.999999999999999e511"), limits::max().bits());
+   EXPECT_EQ(dm_double_fromstring("-9.999999999999999e511"), limits::lowest().bits());
+   EXPECT_EQ(dm_double_fromstring("1e-511"), limits::min().bits());
+   EXPECT_EQ(dm_double_fromstring("1e-15"), limits::epsilon().bits());
+   EXPECT_EQ(dm_double_fromstring("0.5"), limits::round_error().bits());
+   EXPECT_NE(1_dm, 1_dm + limits::epsilon());
+   EXPECT_EQ(1_dm, 1_dm + limits::epsilon() / 2_dm);
+   EXPECT_TRUE(isinf(limits::infinity()));
+   EXPECT_FALSE(signbit(limits::infinity()));
+   EXPECT_TRUE(isnan(limits::quiet_NaN()));
+   EXPECT_TRUE(dm_double_isnan(limits::quiet_NaN().bits()));
+
+   dm::decimal64 value = 1.25_dm;
+   EXPECT_TRUE(value + 2.5_dm == 3.75_dm);
+   EXPECT_TRUE(value - 2.5_dm == -1.25_dm);
+   EXPECT_TRUE(value * 4_dm == 5_dm);
+   EXPECT_TRUE(value / 5_dm == 0.25_dm);
+   value += 1_dm;
+   value *= 2_dm;
+   EXPECT_TRUE(value == 4.5_dm);
+   EXPECT_TRUE(value != 4.25_dm);
+   EXPECT_TRUE(value > 4.25_dm);
+   EXPECT_TRUE(value >= 4.5_dm);
+   EXPECT_TRUE(value < 4.75_dm);
+   EXPECT_TRUE(value <= 4.5_dm);
+   EXPECT_FALSE(limits::quiet_NaN() == limits::quiet_NaN());
+   EXPECT_TRUE(dm::decimal64("4.5") == value);
+   EXPECT_TRUE(fabs(-value) == value);
+   EXPECT_TRUE(fma(value, 2_dm, 1_dm) == 10_dm);
+   EXPECT_TRUE(fmod(value, 2_dm) == 0.5_dm);
+   EXPECT_EQ("4.5", dm::to_string(value).substr(0, 3));
+#ifndef DM_NO_DOUBLE_MATH
+   EXPECT_EQ(4.5, static_cast<double>(value));
+   EXPECT_TRUE(dm::decimal64(0.25) == 0.25_dm);
+#endif /* ! DM_NO_DOUBLE_MATH */
+ }
+
+TEST(DMDoubleTest, testConstexprCore)
+ {
+   using namespace dm::literals;
+
+      // Computed by the compiler.
+   static_assert(dm::add_r(0.1_dm, 0.2_dm).bits() == (0.3_dm).bits(), "");
+   static_assert(dm::sub_r(1_dm, 0.0725_dm).bits() == (0.9275_dm).bits(), "");
+   static_assert(dm::mul_r(19.99_dm, 1.0725_dm).bits() == (21.439275_dm).bits(), "");
+   static_assert(dm::div_r(1_dm, 3_dm).bits() == (0.3333333333333333_dm).bits(), "");
+   static_assert(dm::div_r(2_dm, 3_dm, DM_FE_TOWARDZERO).bits() == (0.6666666666666666_dm).bits(), "");
+   static_assert(dm::div_r(2_dm, 3_dm, DM_FE_UPWARD).bits() == (0.6666666666666667_dm).bits(), "");
+   static_assert(dm::fma_r(3_dm, 0.3333333333333333_dm, -1_dm).bits() == (-1e-16_dm).bits(), "");
+   static_assert(dm::mul_r(9e300_dm, 9e300_dm).bits() == std::numeric_limits<dm::decimal64>::infinity().bits(), "");
+   static_assert(dm::sqrt_r(2_dm).bits() == (1.414213562373095_dm).bits(), "");
+   static_assert(dm::sqrt_r(2_dm, DM_FE_UPWARD).bits() == (1.414213562373096_dm).bits(), "");
+   static_assert(dm::powi_r(1.05_dm, 360).bits() == (42476396.40868002_dm).bits(), "");
+   static_assert(dm::powi_r(10_dm, -300).bits() == (1e-300_dm).bits(), "");
+   static_assert((dm_core_digits(0U) == 0) && (dm_core_digits(9U) == 1) && (dm_core_digits(10U) == 2), "");
+   static_assert((dm_core_digits(9999999999999999ULL) == 16) && (dm_core_digits(18446744073709551615ULL) == 20), "");
+   static_assert((dm_core_trailingZeros(1U) == 0) && (dm_core_trailingZeros(4000000000000000ULL) == 15), "");
+   static_assert((dm_core_trailingZeros(10000000000000000000ULL) == 19) && (dm_core_trailingZeros(1024000U) == 3), "");
+   static_assert(dm_core_wide_digits(dm_core_wide_mul(10000000000000000ULL, 1000000000000000ULL)) == 32, "");
+   static_assert(dm_core_wide_digits(dm_core_wide_sub(dm_core_wide_mul(10000000000000000ULL, 1000000000000000ULL), dm_core_wide_from(1U))) == 31, "");
+#ifdef DM_CONSTEXPR_OPERATORS
+   static_assert((1.25_dm * 4_dm + 1_dm).bits() == (6_dm).bits(), "");
+#endif /* DM_CONSTEXPR_OPERATORS */
+
+      // The same bits as the C library, for every rounding mode, including the special values, flushing, and cancellation.
+   TestRandom next;
+   auto make = [&next](int exponentRange) -> dm_double
+    {
+      uint64_t r = next();
+      switch (r % 32U)
+       {
+         case 0: return dm::detail::special(false, 0U);
+         case 1: return dm::detail::special(true, 0U);
+         case 2: return dm::detail::special((r >> 5) & 1U, dm::detail::DM_INFINITY);
+         case 3: return dm::detail::special((r >> 5) & 1U, dm::detail::NAN_PAYLOAD);
+         case 4: return dm::detail::pack((r >> 5) & 1U, dm::detail::MAX_EXPONENT - static_cast<int32_t>(next() % 4U), dm::detail::MAX_SIGNIFICAND);
+         case 5: return dm::detail::pack((r >> 5) & 1U, dm::detail::MIN_EXPONENT + static_cast<int32_t>(next() % 4U), dm::detail::MIN_SIGNIFICAND);
+         default: break;
+       }
+      uint64_t significand = dm::detail::MIN_SIGNIFICAND + next() % (dm::detail::BIAS - dm::detail::MIN_SIGNIFICAND);
+      if (0U == ((r >> 6) % 4U))
+         significand -= significand % 1000000000U; // Short significands, to get exact results
+      int32_t exponent = static_cast<int32_t>(next() % (2U * exponentRange + 1U)) - exponentRange;
+      return dm::detail::pack((r >> 5) & 1U, exponent, significand);
+    };
+   for (int i = 0; i < 200000; ++i)
+    {
+      int exponentRange = (0 == (i % 8)) ? dm::detail::MAX_EXPONENT : 20;
+      dm_double lhs = make(exponentRange), rhs = make(exponentRange), ths = make(exponentRange);
+      if (0 == (i % 4)) // Nearly cancel the product, for the hard cases of fma.
+         ths = dm_double_neg(dm_double_mul(lhs, rhs)) ^ (next() & 1U);
+      int mode = static_cast<int>(i % 8);
+      EXPECT_EQ(dm_double_add_r(lhs, ths, mode), dm::detail::add_r(lhs, ths, mode));
+      EXPECT_EQ(dm_double_sub_r(lhs, ths, mode), dm::detail::sub_r(lhs, ths, mode));
+      EXPECT_EQ(dm_double_mul_r(lhs, rhs, mode), dm::detail::mul_r(lhs, rhs, mode));
+      EXPECT_EQ(dm_double_div_r(lhs, rhs, mode), dm::detail::div_r(lhs, rhs, mode));
+      EXPECT_EQ(dm_double_sqrt_r(lhs, mode), dm::detail::sqrt_r(lhs, mode));
+      dm_fesetround(mode);
+      EXPECT_EQ(dm_double_fma(lhs, rhs, ths), dm::detail::fma_r(lhs, rhs, ths, mode));
+    }
+   dm_fesetround(DM_FE_TONEAREST);
+ }
+
+TEST(DMDoubleTest, testExpressionTemplates)
+ {
+   using namespace dm::literals;
+   typedef std::numeric_limits<dm::decimal64> limits;
+
+      // x * y + z is one fma, and rounds once.
+   dm::decimal64 x = 1.000000000000001_dm;
+   EXPECT_EQ(dm_double_fromstring("2.000000000000001e-15"), dm::decimal64(x * x - 1_dm).bits());
+   EXPECT_EQ(dm_double_fromstring("2e-15"), dm::decimal64(dm::decimal64(x * x) - 1_dm).bits());
+   EXPECT_EQ(dm_double_fromstring("-2.000000000000001e-15"), dm::decimal64(1_dm - x * x).bits());
+   dm::decimal64 total = 1_dm;
+   total -= x * x;
+   EXPECT_EQ(dm_double_fromstring("-2.000000000000001e-15"), total.bits());
+
+      // A chain of additions is exact until it is rounded.
+   EXPECT_EQ(dm_double_fromstring("1"), dm::decimal64(1e20_dm + 1_dm - 1e20_dm).bits());
+   EXPECT_EQ(dm_double_fromstring("1.000000000000001"), dm::decimal64(1_dm + 5e-16_dm + 5e-16_dm).bits());
+   EXPECT_EQ(limits::max().bits(), dm::decimal64(limits::max() + limits::max() - limits::max()).bits());
+   EXPECT_EQ(limits::infinity().bits(), dm::decimal64(limits::max() + limits::max() + 0_dm).bits());
+   EXPECT_TRUE(isnan(dm::decimal64(limits::infinity() - limits::infinity() + 1_dm)));
+   EXPECT_EQ(dm_double_fromstring("0.3"), dm::decimal64(0.1_dm + 0.1_dm + 0.1_dm).bits());
+   EXPECT_EQ(dm_double_fromstring("6.75"), dm::decimal64(1_dm + (2_dm + 3_dm) - (0.25_dm - 2_dm * 0.5_dm)).bits());
+   EXPECT_FALSE(signbit(dm::decimal64(1_dm - 1_dm + 0_dm)));
+   EXPECT_TRUE(signbit(dm::decimal64(-0_dm + -0_dm + -0_dm)));
+   dm_fesetround(DM_FE_DOWNWARD);
+   EXPECT_TRUE(signbit(dm::decimal64(1_dm - 1_dm + 0_dm)));
+   EXPECT_EQ(dm_double_fromstring("1"), dm::decimal64(1_dm + 5e-16_dm + 4e-16_dm).bits());
+   dm_fesetround(DM_FE_UPWARD);
+   EXPECT_EQ(dm_double_fromstring("1.000000000000001"), dm::decimal64(1_dm + 1e-300_dm + 0_dm).bits());
+   dm_fesetround(DM_FE_TONEAREST);
+#ifdef DM_CONSTEXPR_OPERATORS
+   static_assert((1e20_dm + 1_dm - 1e20_dm).operator dm::decimal64().bits() == (1_dm).bits(), "");
+   static_assert((19.99_dm * 3_dm - 2.5_dm).bits() == (57.47_dm).bits(), "");
+#endif /* DM_CONSTEXPR_OPERATORS */
+
+      // Against the C functions: the exact sum of two numbers and a zero must be the correctly rounded sum.
+   TestRandom next;
+   auto make = [&next]() -> dm::decimal64
+    {
+      uint64_t r = next();
+      if (0U == (r % 64U))
+         return limits::infinity();
+      int32_t exponent = static_cast<int32_t>(next() % 41U) - 20;
+      if (0U == (r % 16U))
+         exponent = static_cast<int32_t>(next() % 1023U) - 511;
+      uint64_t significand = dm::detail::MIN_SIGNIFICAND + next() % (dm::detail::BIAS - dm::detail::MIN_SIGNIFICAND);
+      return dm::decimal64::from_bits(dm::detail::pack((r >> 8) & 1U, exponent, significand));
+    };
+   for (int i = 0; i < 100000; ++i)
+    {
+      dm::decimal64 lhs = make(), rhs = make(), ths = make();
+      int mode = i % 8;
+      dm_fesetround(mode);
+      EXPECT_EQ(dm_double_add_r(lhs.bits(), rhs.bits(), mode), dm::decimal64(lhs + rhs + 0_dm).bits());
+      EXPECT_EQ(dm_double_sub_r(lhs.bits(), rhs.bits(), mode), dm::decimal64(lhs - rhs - 0_dm).bits());
+      EXPECT_EQ(dm_double_fma(lhs.bits(), rhs.bits(), ths.bits()), dm::decimal64(lhs * rhs + ths).bits());
+      EXPECT_EQ(dm_double_fma(lhs.bits(), rhs.bits(), dm_double_neg(ths.bits())), dm::decimal64(lhs * rhs - ths).bits());
+    }
+   dm_fesetround(DM_FE_TONEAREST);
  }
@@ -1,5 +1,18 @@
 #!/bin/sh -x
 
-gcc -Wall -Wextra -Wpedantic -O3 -c dm_double.c dm_muldiv.c dm_double_pretty.c
+gcc -Wall -Wextra -Wpedantic -O3 -c dm_double.c dm_muldiv.c dm_double_pretty.c dm_double_batch.c dm_single.c dm_quad.c dm_decimal64.c dm_double_column.c dm_double_codec.c dm_double_layout.c
 ar -rcs libdecmath.a *.o
 rm *.o
+
+# Both implementations in one library, with their symbols prefixed (see dm_double_prefix.h).
+for FILE in dm_double dm_double_pretty dm_double_batch dm_decimal64 dm_double_column dm_double_codec
+do
+   gcc -Wall -Wextra -Wpedantic -O3 -DDM_DOUBLE_PREFIX=legacy_ -c $FILE.c -o legacy_$FILE.o
+done
+for FILE in dm_double_m dm_double_pretty dm_double_batch dm_decimal64 dm_double_column dm_double_codec
+do
+   gcc -Wall -Wextra -Wpedantic -O3 -DDM_DOUBLE_PREFIX=misra_ -c $FILE.c -o misra_$FILE.o
+done
+gcc -Wall -Wextra -Wpedantic -O3 -DDM_DOUBLE_PREFIX=misra_ -c dm_muldiv.c dm_single.c dm_quad.c dm_double_layout.c
+ar -rcs libdecmath_dual.a *.o
+rm *.o
@@ -0,0 +1,44 @@
+#!/bin/bash -x
+
+   # Builds one benchmark per variant: both versions, with and without the 128 bit type.
+
+rm -f DoubleBench-dm_double.exe
+rm -f DoubleBench-dm_double-no128.exe
+rm -f DoubleBench-dm_double_m.exe
+rm -f DoubleBench-dm_double_m-no128.exe
+
+if [ "$1" == "clean" ]; then
+   exit
+fi
+
+for FILE_TO_TEST in dm_double dm_double_m
+do
+   if [ "$FILE_TO_TEST" == "dm_double" ]
+   then
+      OPTION=""
+   else
+      OPTION="-DMISRAbleC"
+   fi
+
+   for WIDE in "" "-DDM_NO_128_BIT_TYPE"
+   do
+      if [ "$WIDE" == "" ]
+      then
+         NAME=DoubleBench-$FILE_TO_TEST
+      else
+         NAME=DoubleBench-$FILE_TO_TEST-no128
+      fi
+
+      rm -f $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o dm_double_batch.o dm_single.o dm_quad.o dm_decimal64.o dm_double_column.o dm_double_codec.o dm_double_layout.o
+      gcc -c -Wall -Wextra -Wpedantic -O3 $WIDE $FILE_TO_TEST.c dm_muldiv.c dm_double_pretty.c dm_double_batch.c dm_single.c dm_quad.c dm_decimal64.c dm_double_column.c dm_double_codec.c dm_double_layout.c
+      g++ -o $NAME -Wall -Wextra -Wpedantic -O3 $WIDE -I../External/benchmark/include $OPTION DoubleBench.cpp $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o dm_double_batch.o dm_single.o dm_quad.o dm_decimal64.o dm_double_column.o dm_double_codec.o dm_double_layout.o ../External/benchmark/lib/libbenchmark.a -lpthread
+      rm -f $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o dm_double_batch.o dm_single.o dm_quad.o dm_decimal64.o dm_double_column.o dm_double_codec.o dm_double_layout.o
+   done
+done
+
+if [ "$1" == "run" ]; then
+   ./DoubleBench-dm_double.exe
+   ./DoubleBench-dm_double-no128.exe
+   ./DoubleBench-dm_double_m.exe
+   ./DoubleBench-dm_double_m-no128.exe
+fi
@@ -11,13 +11,34 @@ fi
 rm -f $FILE_TO_TEST.o
 rm -f dm_muldiv.o
 rm -f dm_double_pretty.o
+rm -f dm_double_batch.o
+rm -f dm_single.o
+rm -f dm_quad.o
+rm -f dm_decimal64.o
+rm -f dm_double_column.o
+rm -f dm_double_codec.o
+rm -f dm_double_layout.o
 
 rm -f $FILE_TO_TEST.gcda
 rm -f $FILE_TO_TEST.gcno
 rm -f dm_muldiv.gcda
 rm -f dm_muldiv.gcno
 rm -f dm_double_pretty.gcda
+rm -f dm_double_batch.gcda
+rm -f dm_single.gcda
+rm -f dm_quad.gcda
+rm -f dm_decimal64.gcda
+rm -f dm_double_column.gcda
+rm -f dm_double_codec.gcda
+rm -f dm_double_layout.gcda
 rm -f dm_double_pretty.gcno
+rm -f dm_double_batch.gcno
+rm -f dm_single.gcno
+rm -f dm_quad.gcno
+rm -f dm_decimal64.gcno
+rm -f dm_double_column.gcno
+rm -f dm_double_codec.gcno
+rm -f dm_double_layout.gcno
 
 rm -f Base.info
 rm -f Run.info
@@ -34,8 +55,8 @@ if [ "$1" == "clean" ]; then
    exit
 fi
 
-gcc -c -Wall -Wextra -Wpedantic -g --coverage -O0 $FILE_TO_TEST.c dm_muldiv.c dm_double_pretty.c
-g++ -o DoubleTests -Wall -Wextra -Wpedantic -g --coverage -O0 -I../External/googletest/include $OPTION DoubleTests.cpp $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o ../External/googletest/lib/libgtest.a ../External/googletest/lib/libgtest_main.a
+gcc -c -Wall -Wextra -Wpedantic -g --coverage -O0 $FILE_TO_TEST.c dm_muldiv.c dm_double_pretty.c dm_double_batch.c dm_single.c dm_quad.c dm_decimal64.c dm_double_column.c dm_double_codec.c dm_double_layout.c
+g++ -o DoubleTests -Wall -Wextra -Wpedantic -g --coverage -O0 -I../External/googletest/include $OPTION DoubleTests.cpp $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o dm_double_batch.o dm_single.o dm_quad.o dm_decimal64.o dm_double_column.o dm_double_codec.o dm_double_layout.o ../External/googletest/lib/libgtest.a ../External/googletest/lib/libgtest_main.a -lpthread
 
 
 if [ "$1" == "nocov" ]; then
@@ -11,12 +11,19 @@ fi
 rm -f $FILE_TO_TEST.o
 rm -f dm_muldiv.o
 rm -f dm_double_pretty.o
+rm -f dm_double_batch.o
+rm -f dm_single.o
+rm -f dm_quad.o
+rm -f dm_decimal64.o
+rm -f dm_double_column.o
+rm -f dm_double_codec.o
+rm -f dm_double_layout.o
 rm -f DoubleTests.exe
 
 if [ "$1" == "clean" ]; then
    exit
 fi
 
-gcc -c -Wall -Wextra -Wpedantic -s -O3 $FILE_TO_TEST.c dm_muldiv.c dm_double_pretty.c
-g++ -o DoubleTests -Wall -Wextra -Wpedantic -s -O3 -I../External/googletest/include $OPTION DoubleTests.cpp $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o ../External/googletest/lib/libgtest.a ../External/googletest/lib/libgtest_main.a
+gcc -c -Wall -Wextra -Wpedantic -s -O3 $FILE_TO_TEST.c dm_muldiv.c dm_double_pretty.c dm_double_batch.c dm_single.c dm_quad.c dm_decimal64.c dm_double_column.c dm_double_codec.c dm_double_layout.c
+g++ -o DoubleTests -Wall -Wextra -Wpedantic -s -O3 -I../External/googletest/include $OPTION DoubleTests.cpp $FILE_TO_TEST.o dm_muldiv.o dm_double_pretty.o dm_double_batch.o dm_single.o dm_quad.o dm_decimal64.o dm_double_column.o dm_double_codec.o dm_double_layout.o ../External/googletest/lib/libgtest.a ../External/googletest/lib/libgtest_main.a -lpthread
 ./DoubleTests.exe
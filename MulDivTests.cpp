@@ -31,6 +31,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "gtest/gtest.h"
 
+#include <cstring>
+
 #include "dm_muldiv.h"
 
 TEST(MulDivLibTest, testLoadFrom)
@@ -216,3 +218,77 @@ TEST(MulDivLibTest, testMakeHappen)
    EXPECT_EQ(17156224954167381174ULL, q);
    EXPECT_EQ(     986000000000000ULL, r);
  }
+
+TEST(MulDivLibTest, testWideMulDiv)
+ {
+   uint64_t high, low;
+   dm_muldiv_wide_t a, b, q, r, t;
+
+      // 10 ^ 34 * 10 ^ 34 / 10 ^ 34
+   dm_muldiv_wide_loadFrom(a, 0x0001ED09BEAD87C0ULL, 0x378D8E6400000000ULL);
+   dm_muldiv_wide_mul(b, a, a);
+   EXPECT_EQ(226U, dm_muldiv_wide_bits(b));
+   dm_muldiv_wide_divBy(b, a, q, r);
+   EXPECT_TRUE(dm_muldiv_wide_zero(r));
+   dm_muldiv_wide_extract(q, &high, &low);
+   EXPECT_EQ(0x0001ED09BEAD87C0ULL, high);
+   EXPECT_EQ(0x378D8E6400000000ULL, low);
+
+      // (10 ^ 34 - 1) ^ 2 / 10 ^ 34 = 10 ^ 34 - 2 remainder 1
+   dm_muldiv_wide_loadFrom(t, 0U, 1U);
+   dm_muldiv_wide_sub(b, a, t);
+   dm_muldiv_wide_mul(b, b, b);
+   dm_muldiv_wide_divBy(b, a, q, r);
+   dm_muldiv_wide_extract(r, &high, &low);
+   EXPECT_EQ(0U, high);
+   EXPECT_EQ(1U, low);
+   dm_muldiv_wide_add(q, q, t);
+   dm_muldiv_wide_add(q, q, t);
+   dm_muldiv_wide_extract(q, &high, &low);
+   EXPECT_EQ(0x0001ED09BEAD87C0ULL, high);
+   EXPECT_EQ(0x378D8E6400000000ULL, low);
+
+      // Short division
+   dm_muldiv_wide_loadFrom(b, 0U, 7U);
+   dm_muldiv_wide_divBy(a, b, q, r);
+   dm_muldiv_wide_extract(r, &high, &low);
+   EXPECT_EQ(4U, low);
+   EXPECT_TRUE(dm_muldiv_wide_less(q, a));
+   EXPECT_FALSE(dm_muldiv_wide_less(a, q));
+   EXPECT_FALSE(dm_muldiv_wide_less(a, a));
+ }
+
+TEST(MulDivLibTest, testWideRandom)
+ {
+   uint64_t state = 0x243F6A8885A308D3ULL;
+   for (int i = 0; i < 100000; ++i)
+    {
+      dm_muldiv_wide_t a, b, d, q, r, t;
+      uint64_t x[6];
+      for (int j = 0; j < 6; ++j)
+       {
+         state ^= state << 13;
+         state ^= state >> 7;
+         state ^= state << 17;
+         x[j] = state;
+       }
+         // Vary the divisor's width, to exercise every normalization shift and both division paths.
+      unsigned int shift = static_cast<unsigned int>(x[4] % 128U);
+      uint64_t dHigh = (shift >= 64U) ? 0U : (x[2] >> shift);
+      uint64_t dLow = (shift >= 64U) ? (x[3] >> (shift - 64U)) : x[3];
+      if ((0U == dHigh) && (0U == dLow))
+       {
+         dLow = 1U;
+       }
+      dm_muldiv_wide_loadFrom(a, x[0], x[1]);
+      dm_muldiv_wide_loadFrom(b, x[5] >> (x[4] % 64U), x[4]);
+      dm_muldiv_wide_mul(a, a, b);
+      dm_muldiv_wide_loadFrom(d, dHigh, dLow);
+
+      dm_muldiv_wide_divBy(a, d, q, r);
+      EXPECT_TRUE(dm_muldiv_wide_less(r, d));
+      dm_muldiv_wide_mul(t, q, d);
+      dm_muldiv_wide_add(t, t, r);
+      EXPECT_EQ(0, memcmp(t, a, sizeof(a)));
+    }
+ }
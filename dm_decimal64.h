@@ -0,0 +1,155 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DECIMAL64_H
+#define DM_DECIMAL64_H
+
+/*
+   Conversions between dm_double and the IEEE 754-2008 decimal64 interchange
+   format, in its binary integer significand (BID) encoding.
+
+   A decimal64 is a sign, a coefficient of up to sixteen digits, and an
+   exponent q from -398 to 369, with the value coefficient * 10 ^ q. Every
+   decimal64 fits in a dm_double, so the conversions from decimal64 are always
+   exact: unnormalized coefficients are normalized, non-canonical coefficients
+   (over sixteen digits) read as zero, as the standard requires, and signaling
+   NaNs read as quiet NaNs. NaN payloads are kept where they fit.
+
+   The conversions to decimal64 are exact down to 1e-383. Below that, the
+   result is subnormal: it loses digits, and rounds, raising DM_FE_UNDERFLOW
+   and DM_FE_INEXACT if that lost anything. Above 9.999999999999999e384 the
+   result is infinity, raising DM_FE_OVERFLOW and DM_FE_INEXACT, following
+   dm_double's own overflow.
+
+   The array versions do the common case, finite numbers in range, without
+   branches, so that the compiler can vectorize them, and then go back over
+   the elements that need the scalar conversion, if there were any.
+
+   The same conversions exist for the densely packed decimal (DPD) encoding.
+   They transcode through BID with a table for each direction between the
+   ten-bit declets and their three digits, so they round and flush exactly as
+   the BID conversions do. The array versions work a cache-sized block at a
+   time.
+
+   The BID conversions are part of dm_double.c and dm_double_m.c, as they need
+   to know the layout of a dm_double: include dm_double.h or dm_double_m.h
+   first. The DPD conversions are in dm_decimal64.c, which works with either.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+   // Where the fields of a BID decimal64 are.
+#define DM_BID64_SIGN_MASK      0x8000000000000000ULL
+#define DM_BID64_INFINITY       0x7800000000000000ULL
+#define DM_BID64_NAN            0x7C00000000000000ULL
+#define DM_BID64_SNAN           0x7E00000000000000ULL
+#define DM_BID64_SPECIAL_MASK   0x7800000000000000ULL // All set: infinity or NaN
+#define DM_BID64_LARGE_MASK     0x6000000000000000ULL // All set: the coefficient has the implied 100 prefix
+#define DM_BID64_PAYLOAD_MASK   0x0003FFFFFFFFFFFFULL
+#define DM_BID64_EXPONENT_BIAS  398
+#define DM_BID64_MAX_EXPONENT   369  // Of q, the exponent of the last digit.
+#define DM_BID64_MIN_EXPONENT   (-398)
+#define DM_BID64_MAX_PAYLOAD    999999999999999ULL // Canonical NaN payloads have fifteen digits at most.
+#define DM_BID64_MAX_COEFFICIENT 9999999999999999ULL
+
+   // Packing and unpacking, without branches, so that the array loops vectorize.
+   // dm_bid64_pack needs a canonical coefficient and an exponent in range.
+static inline uint64_t dm_bid64_pack(uint64_t sign, int64_t exponent, uint64_t coefficient)
+ {
+   uint64_t biased = (uint64_t)(exponent + DM_BID64_EXPONENT_BIAS);
+   uint64_t large = 0U - (coefficient >> 53); // All ones if the coefficient needs the implied 100 prefix.
+   return (sign << 63) | (large & (DM_BID64_LARGE_MASK | (biased << 51) | (coefficient & 0x0007FFFFFFFFFFFFULL))) | (~large & ((biased << 53) | coefficient));
+ }
+
+static inline int dm_bid64_isspecial(uint64_t value)
+ {
+   return DM_BID64_SPECIAL_MASK == (value & DM_BID64_SPECIAL_MASK);
+ }
+
+static inline int64_t dm_bid64_unpack_exponent(uint64_t value)
+ {
+   uint64_t large = 0U - (uint64_t)(DM_BID64_LARGE_MASK == (value & DM_BID64_LARGE_MASK));
+   return (int64_t)(((large & (value >> 51)) | (~large & (value >> 53))) & 0x3FFU) - DM_BID64_EXPONENT_BIAS;
+ }
+
+static inline uint64_t dm_bid64_unpack_coefficient(uint64_t value)
+ {
+   uint64_t large = 0U - (uint64_t)(DM_BID64_LARGE_MASK == (value & DM_BID64_LARGE_MASK));
+   return (large & (0x0020000000000000ULL | (value & 0x0007FFFFFFFFFFFFULL))) | (~large & (value & 0x001FFFFFFFFFFFFFULL));
+ }
+
+   // Scales a non-zero canonical coefficient up to sixteen digits, by halving steps, and returns the number of digits added.
+static inline int64_t dm_bid64_normalize(uint64_t* coefficient)
+ {
+   uint64_t value = *coefficient;
+   uint64_t mask = 0U - (uint64_t)(value < 100000000ULL);
+   uint64_t shift = mask & 8U;
+   value = (mask & (value * 100000000ULL)) | (~mask & value);
+   mask = 0U - (uint64_t)(value < 1000000000000ULL);
+   shift += mask & 4U;
+   value = (mask & (value * 10000U)) | (~mask & value);
+   mask = 0U - (uint64_t)(value < 100000000000000ULL);
+   shift += mask & 2U;
+   value = (mask & (value * 100U)) | (~mask & value);
+   mask = 0U - (uint64_t)(value < 1000000000000000ULL);
+   shift += mask & 1U;
+   value = (mask & (value * 10U)) | (~mask & value);
+   *coefficient = value;
+   return (int64_t)shift;
+ }
+
+uint64_t  dm_double_to_bid64   (dm_double);      // dm_fegetround()
+uint64_t  dm_double_to_bid64_r (dm_double, int);
+dm_double dm_double_from_bid64 (uint64_t);       // Always exact
+
+void dm_double_to_bid64_array   (const dm_double*, uint64_t*, size_t, int);
+void dm_double_from_bid64_array (const uint64_t*, dm_double*, size_t);
+
+   // The densely packed decimal (DPD) encoding, in dm_decimal64.c.
+uint64_t  dm_bid64_to_dpd64    (uint64_t);
+uint64_t  dm_dpd64_to_bid64    (uint64_t);
+uint64_t  dm_double_to_dpd64   (dm_double);      // dm_fegetround()
+uint64_t  dm_double_to_dpd64_r (dm_double, int);
+dm_double dm_double_from_dpd64 (uint64_t);       // Always exact
+
+void dm_double_to_dpd64_array   (const dm_double*, uint64_t*, size_t, int);
+void dm_double_from_dpd64_array (const uint64_t*, dm_double*, size_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_DECIMAL64_H */
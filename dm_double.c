@@ -36,18 +36,25 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <inttypes.h>
 
 #include "dm_double.h"
+#include "dm_double_core.h"
+#include "dm_single.h"
 #include "dm_muldiv.h"
-
-const int16_t SPECIAL_EXPONENT = -512;
-const int16_t MAX_EXPONENT = 511;
-const int16_t MIN_EXPONENT = -MAX_EXPONENT;
-const uint64_t DM_INFINITY = 0x1FFFFFFFFFFFFFULL;
-const uint64_t SIGN_BIT = 0x20000000000000ULL;
-
-const uint64_t BIAS =           10000000000000000ULL;
-const uint64_t MAX_SIGNIFICAND = 9999999999999999ULL;
-const uint64_t MIN_SIGNIFICAND = 1000000000000000ULL;
-const int16_t CUTOFF = 16; // Difference in exponents where we consider the operation degenerate.
+#include "dm_quad.h"
+#include "dm_decimal64.h"
+#include "dm_double_codec.h"
+#define DM_DOUBLE_KERNELS_DEFINE // The batch kernels are built here, where the functions they loop over can be inlined into them.
+#include "dm_double_kernels.h"
+
+static const int16_t SPECIAL_EXPONENT = -512;
+static const int16_t MAX_EXPONENT = 511;
+static const int16_t MIN_EXPONENT = -MAX_EXPONENT;
+static const uint64_t DM_INFINITY = 0x1FFFFFFFFFFFFFULL;
+static const uint64_t SIGN_BIT = 0x20000000000000ULL;
+
+static const uint64_t BIAS =           10000000000000000ULL;
+static const uint64_t MAX_SIGNIFICAND = 9999999999999999ULL;
+static const uint64_t MIN_SIGNIFICAND = 1000000000000000ULL;
+static const int16_t CUTOFF = 16; // Difference in exponents where we consider the operation degenerate.
 
 #define DM_DOUBLE_PACK(sign, exponent, significand) ((((uint64_t)(exponent)) << 54) | ((significand) - MIN_SIGNIFICAND) | ((sign) ? SIGN_BIT : 0))
 #define DM_DOUBLE_PACK_ALT(sign, exponent, significand) ((((uint64_t)(exponent)) << 54) | (significand) | ((sign) ? SIGN_BIT : 0))
@@ -272,7 +279,7 @@ dm_double dm_double_copysign(dm_double mag, dm_double sgn)
    // Table of powers of ten up to CUTOFF.
    // (Yes, there is an extra entry, for the -1 case that needs to return 1.)
    // There's also an extra entry for 17, for the rounding case when all digits are rounded.
-const uint64_t makeShift [] =
+static const uint64_t makeShift [] =
  {
    1ULL, // -1
    1ULL, // 0
@@ -282,7 +289,49 @@ const uint64_t makeShift [] =
    10000000000000000ULL, 10000000000000000ULL // 16
  };
 
-int dm_global_round_mode = DM_FE_TONEAREST;
+static int dm_global_round_mode = DM_FE_TONEAREST;
+
+#ifdef DM_STATS
+static _Thread_local dm_stats dm_thread_stats;
+#define DM_STATS_COUNT(counter) (++dm_thread_stats.counter)
+
+void dm_stats_snapshot(dm_stats* dest)
+ {
+   *dest = dm_thread_stats;
+ }
+
+void dm_stats_reset(void)
+ {
+   dm_stats zero = { 0U, 0U, 0U, 0U, 0U, 0U };
+   dm_thread_stats = zero;
+ }
+#else
+#define DM_STATS_COUNT(counter) ((void) 0)
+#endif /* DM_STATS */
+
+#ifdef DM_FENV_FLAGS
+static _Thread_local int dm_thread_flags;
+#define DM_FE_RAISE(flags) (dm_thread_flags |= (flags))
+
+int dm_fetestexcept(int excepts)
+ {
+   return dm_thread_flags & excepts & DM_FE_ALL_EXCEPT;
+ }
+
+int dm_feclearexcept(int excepts)
+ {
+   dm_thread_flags &= ~excepts;
+   return 0;
+ }
+
+int dm_feraiseexcept(int excepts)
+ {
+   dm_thread_flags |= excepts & DM_FE_ALL_EXCEPT;
+   return 0;
+ }
+#else
+#define DM_FE_RAISE(flags) ((void) 0)
+#endif /* DM_FENV_FLAGS */
 
 int dm_fesetround(int round_mode)
  {
@@ -306,33 +355,53 @@ int dm_fegetround()
 // returns whether the unsigned significand should be incremented away from zero
 int dm_decideRound(int sign, int sodd, int64_t comp, int zero, int round_mode)
  {
-   switch (round_mode)
+   int result = dm_core_decideRound(sign, sodd, comp, zero, round_mode);
+   if (!zero)
     {
-      case DM_FE_TONEAREST:
-         if ((comp < 0) || ((comp == 0) && sodd)) return 1;
-         break;
-      case DM_FE_TONEARESTFROMZERO:
-         if (comp <= 0) return 1;
-         break;
-      case DM_FE_UPWARD:
-         if (!sign && !zero) return 1;
-         break;
-      case DM_FE_DOWNWARD:
-         if (sign && !zero) return 1;
-         break;
-      case DM_FE_TOWARDZERO:
-         break;
-      case DM_FE_TONEARESTODD:
-         if ((comp < 0) || ((comp == 0) && !sodd)) return 1;
-         break;
-      case DM_FE_TONEARESTTOWARDZERO:
-         if (comp < 0) return 1;
-         break;
-      case DM_FE_FROMZERO:
-         if (!zero) return 1;
-         break;
+      DM_STATS_COUNT(round_inexact);
+      DM_FE_RAISE(DM_FE_INEXACT);
     }
-   return 0;
+   if (result) DM_STATS_COUNT(round_increment);
+   return result;
+ }
+
+   // Count and raise what the arithmetic core reported.
+static void dm_double_report(int events)
+ {
+   if (events & DM_CORE_INEXACT)
+    {
+      DM_STATS_COUNT(round_inexact);
+      DM_FE_RAISE(DM_FE_INEXACT);
+    }
+   if (events & DM_CORE_INCREMENT) DM_STATS_COUNT(round_increment);
+   if (events & DM_CORE_DEGENERATE) DM_STATS_COUNT(add_degenerate);
+   if (events & DM_CORE_PATHOLOGICAL) DM_STATS_COUNT(fma_pathological);
+ }
+
+   // Unpack a finite, non-zero value for the arithmetic core.
+static dm_core_number dm_double_toCore(dm_double arg)
+ {
+   dm_core_number result = { dm_double_signbit(arg), DM_DOUBLE_UNPACK_EXPONENT(arg), DM_DOUBLE_UNPACK_SIGNIFICAND(arg) };
+   return result;
+ }
+
+   // Pack a result of the arithmetic core, flushing it if the exponent is out of range.
+static dm_double dm_double_fromCore(dm_core_number arg)
+ {
+   if (0U == arg.significand) return DM_DOUBLE_PACK(arg.sign, SPECIAL_EXPONENT, MIN_SIGNIFICAND); // An exact zero
+   if (arg.exponent > MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      return DM_DOUBLE_PACK(arg.sign, SPECIAL_EXPONENT, DM_INFINITY + MIN_SIGNIFICAND);
+    }
+   if (arg.exponent < MIN_EXPONENT) // Flush to zero?
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      return DM_DOUBLE_PACK(arg.sign, SPECIAL_EXPONENT, MIN_SIGNIFICAND);
+    }
+   return DM_DOUBLE_PACK(arg.sign, arg.exponent, arg.significand);
  }
 
 dm_double dm_double_ceil(dm_double arg)
@@ -504,13 +573,123 @@ dm_double dm_double_frexp(dm_double value, int* exponent)
 dm_double dm_double_ldexp(dm_double value, int exponent)
  {
    int16_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(value);
+   if (SPECIAL_EXPONENT == old_exponent) return value; // Zero, infinity, and NaN are unchanged.
    if (((MAX_EXPONENT << 1) < exponent) || (MAX_EXPONENT < (exponent + old_exponent)))
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       return dm_double_Inf | (value & SIGN_BIT);
+    }
    if (((MIN_EXPONENT * 2) > exponent) || (MIN_EXPONENT > (exponent + old_exponent)))
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       return dm_double_Zero | (value & SIGN_BIT);
+    }
    return DM_DOUBLE_PACK_ALT(value & SIGN_BIT, exponent + old_exponent, DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(value));
  }
 
+int dm_double_digits(dm_double value)
+ {
+   if (SPECIAL_EXPONENT == DM_DOUBLE_UNPACK_EXPONENT(value)) return 0;
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(value);
+   return dm_core_digits(significand) - dm_core_trailingZeros(significand);
+ }
+
+int dm_double_trailing_zeros(dm_double value)
+ {
+   if (SPECIAL_EXPONENT == DM_DOUBLE_UNPACK_EXPONENT(value)) return 0;
+   return dm_core_trailingZeros(DM_DOUBLE_UNPACK_SIGNIFICAND(value));
+ }
+
+dm_double dm_double_quantize_r(dm_double arg, int exponent, int round_mode)
+ {
+   int64_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == old_exponent) return arg; // Zero, infinity, and NaN are unchanged.
+   if (old_exponent - (CUTOFF - 1) >= exponent) return arg; // Already a multiple of 10 ^ exponent.
+
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   uint64_t divisor = (old_exponent < exponent - 1) ? (10U * makeShift[CUTOFF + 1]) : makeShift[CUTOFF + exponent - old_exponent]; // Below a tenth of the quantum, every digit is lost alike.
+   int events = 0;
+   uint64_t quotient = dm_core_round(dm_double_signbit(arg), significand / divisor, divisor, significand % divisor, round_mode, &events);
+   dm_double_report(events);
+   if (0U == quotient)
+      return dm_double_Zero | (arg & SIGN_BIT);
+   if (old_exponent < exponent - 1) // Rounded up to the quantum itself.
+    {
+      old_exponent = exponent;
+      significand = MIN_SIGNIFICAND;
+    }
+   else
+    {
+      significand = quotient * divisor;
+      if (BIAS == significand)
+       {
+         significand = MIN_SIGNIFICAND;
+         ++old_exponent;
+       }
+    }
+   if (old_exponent > MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      return dm_double_Inf | (arg & SIGN_BIT);
+    }
+   return DM_DOUBLE_PACK(arg & SIGN_BIT, old_exponent, significand);
+ }
+
+   // Whether dm_double_quantize_fast leaves arg to dm_double_quantize_r, without rounding or reporting anything.
+static inline int dm_double_quantize_slow(dm_double arg, int exponent)
+ {
+   int64_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if ((SPECIAL_EXPONENT == old_exponent) || (old_exponent - (CUTOFF - 1) >= exponent)) return 0; // Kept as it is
+   return (old_exponent < exponent) || (old_exponent >= MAX_EXPONENT);
+ }
+
+   // The common case of dm_double_quantize_array, without branches: rounding a finite number whose leading digit
+   // is at or above the quantum. Returns non-zero if the element needs dm_double_quantize_r, and leaves it as it is,
+   // so that the second pass finds it again when converting in place.
+static inline int dm_double_quantize_fast(dm_double arg, int exponent, int round_mode, dm_double* result)
+ {
+   int64_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int keep = (SPECIAL_EXPONENT == old_exponent) | (old_exponent - (CUTOFF - 1) >= exponent);
+   int fast = !keep & (old_exponent >= exponent) & (old_exponent < MAX_EXPONENT);
+   uint64_t divisor = makeShift[fast ? (CUTOFF + exponent - old_exponent) : 1];
+   int events = 0;
+   significand = divisor * dm_core_round(dm_double_signbit(arg), significand / divisor, divisor, significand % divisor, round_mode, &events);
+   dm_double_report(events);
+   uint64_t carry = 0U - (uint64_t)(BIAS == significand);
+   significand = (carry & MIN_SIGNIFICAND) | (~carry & significand);
+   uint64_t mask = 0U - (uint64_t)!fast;
+   *result = (mask & arg) | (~mask & DM_DOUBLE_PACK(arg & SIGN_BIT, old_exponent + (int64_t)(carry & 1U), significand));
+   return !(keep | fast);
+ }
+
+static inline void dm_double_quantize_kernel(const dm_double* src, dm_double* dest, size_t count, int exponent, int round_mode)
+ {
+   int slow = 0;
+   for (size_t i = 0U; i < count; ++i)
+      slow |= dm_double_quantize_fast(src[i], exponent, round_mode, dest + i);
+   if (slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+         if (dm_double_quantize_slow(src[i], exponent))
+            dest[i] = dm_double_quantize_r(src[i], exponent, round_mode);
+    }
+ }
+
+   // The two ways of rounding a ledger get kernels of their own, in which the rounding mode is a constant.
+void dm_double_quantize_array(const dm_double* src, dm_double* dest, size_t count, int exponent, int round_mode)
+ {
+   if (DM_FE_TONEAREST == round_mode)
+      dm_double_quantize_kernel(src, dest, count, exponent, DM_FE_TONEAREST);
+   else if (DM_FE_TONEARESTFROMZERO == round_mode)
+      dm_double_quantize_kernel(src, dest, count, exponent, DM_FE_TONEARESTFROMZERO);
+   else
+      dm_double_quantize_kernel(src, dest, count, exponent, round_mode);
+ }
+
 dm_double dm_double_neg(dm_double arg)
  {
    return arg ^ SIGN_BIT;
@@ -542,9 +721,7 @@ dm_double dm_double_div(dm_double lhs, dm_double rhs)
 
 uint64_t dm_internal_round(uint64_t quot, uint64_t rem)
  {
-   uint64_t result = 0U;
-   if ((0U != rem) && (0U == (quot % 5U))) result = 1U; // Remainder mod 10 is 0 or 5
-   return result;
+   return dm_core_internal_round(quot, rem);
  }
 
 dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
@@ -556,7 +733,11 @@ dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, if both are infinities.
    if (dm_double_isinf(lhs) && dm_double_isinf(rhs))
     {
-      if (dm_double_signbit(lhs) != dm_double_signbit(rhs)) return dm_double_NaN; // Inf - Inf = NaN
+      if (dm_double_signbit(lhs) != dm_double_signbit(rhs)) // Inf - Inf = NaN
+       {
+         DM_FE_RAISE(DM_FE_INVALID);
+         return dm_double_NaN;
+       }
       return lhs; // Both have the same sign, so just return lhs.
     }
       // Anything else with infinity is infinity
@@ -574,143 +755,10 @@ dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
    if (dm_double_iszero(rhs)) return lhs;
 
       // Now, we can start the add proper!
-   uint64_t lhd = DM_DOUBLE_UNPACK_SIGNIFICAND(lhs);
-   uint64_t rhd = DM_DOUBLE_UNPACK_SIGNIFICAND(rhs);
-   uint64_t resultSignificand;
-
-      // Normalize exponents
-   int16_t lhse = DM_DOUBLE_UNPACK_EXPONENT(lhs);
-   int16_t rhse = DM_DOUBLE_UNPACK_EXPONENT(rhs);
-   int32_t resultExponent = lhse;
-   int16_t expDiff = 0;
-   if (lhse > rhse)
-    {
-      if ((lhse - rhse) <= (CUTOFF + 1))
-       {
-         expDiff = lhse - rhse;
-         if (expDiff > 2) // 2 : guard digit, rounding digit / sticky digit
-          {
-            uint64_t removed;
-            removed = rhd % makeShift[(expDiff - 2) + 1];
-            rhd /= makeShift[(expDiff - 2) + 1];
-            rhd += dm_internal_round(rhd, removed);
-            expDiff = 2;
-          }
-         lhd *= makeShift[expDiff + 1];
-       }
-      else
-       {
-         expDiff = 2;
-         lhd *= 100U;
-         rhd = 1U;
-       }
-    }
-   else if (lhse < rhse)
-    {
-      resultExponent = rhse;
-      if ((rhse - lhse) <= (CUTOFF + 1))
-       {
-         expDiff = rhse - lhse;
-         if (expDiff > 2)
-          {
-            uint64_t removed;
-            removed = lhd % makeShift[(expDiff - 2) + 1];
-            lhd /= makeShift[(expDiff - 2) + 1];
-            lhd += dm_internal_round(lhd, removed);
-            expDiff = 2;
-          }
-         rhd *= makeShift[expDiff + 1];
-       }
-      else
-       {
-         expDiff = 2;
-         rhd *= 100U;
-         lhd = 1U;
-       }
-    }
-
-      // Compute the digits and sign.
-   int resultSign = dm_double_signbit(lhs);
-   if (dm_double_signbit(lhs) == dm_double_signbit(rhs)) // Both same sign
-    {
-      lhd += rhd;
-    }
-   else // Different Signs
-    {
-      if (lhd >= rhd) // lhs larger : result sign of lhs
-         lhd -= rhd;
-      else // rhs larger : result sign of rhs (opposite sign of lhs)
-       {
-         lhd = rhd - lhd;
-         resultSign = !resultSign;
-       }
-    }
-   resultSignificand = lhd;
-
-      // Normalize the result
-   if (0U == lhd)
-    {
-      if (DM_FE_DOWNWARD != round_mode) resultSign = 0;
-      else resultSign = 1;
-      resultExponent = SPECIAL_EXPONENT;
-      resultSignificand = MIN_SIGNIFICAND;
-    }
-   else if (lhd > MAX_SIGNIFICAND)
-    {
-      if (0 == expDiff) // Did overflow occur? ie 9 + 9
-       {
-         ++resultExponent;
-       }
-      uint64_t temp = makeShift[expDiff]; // This is why the table has one extra entry: we want the previous entry here.
-      uint64_t test = BIAS * makeShift[expDiff];
-      if (lhd < test) // Did destructive cancellation occur? ie 100 - 1.
-       {
-         --resultExponent;
-       }
-      else
-       {
-         temp *= 10U;
-         test *= 10U;
-         if (lhd >= test) // Did overflow occur? ie 99 + 1
-          {
-            ++resultExponent;
-            temp *= 10U;
-          }
-       }
-      uint64_t rem;
-      resultSignificand = lhd / temp;
-      rem = lhd % temp;
-      resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)temp - (int64_t)(rem << 1), rem == 0, round_mode);
-      if (resultSignificand == BIAS)
-       {
-         resultSignificand = MIN_SIGNIFICAND;
-         ++resultExponent;
-       }
-      if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-       {
-         resultSignificand = DM_INFINITY + MIN_SIGNIFICAND;
-         resultExponent = SPECIAL_EXPONENT;
-       }
-    }
-   else
-    {
-      if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
-       {
-         --resultExponent;
-       }
-      while (resultSignificand < MIN_SIGNIFICAND)
-       {
-         resultSignificand *= 10U;
-         --resultExponent;
-       }
-      if (resultExponent < MIN_EXPONENT) // Flush to zero?
-       {
-         resultSignificand = MIN_SIGNIFICAND;
-         resultExponent = SPECIAL_EXPONENT;
-       }
-    }
-
-   return DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
+   int events = 0;
+   dm_core_number result = dm_core_add(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
  }
 
 dm_double dm_double_sub_r(dm_double lhs, dm_double rhs, int round_mode)
@@ -733,6 +781,7 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, infinity times zero is NaN.
    if ((dm_double_isinf(lhs) && dm_double_iszero(rhs)) || (dm_double_iszero(lhs) && dm_double_isinf(rhs)))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (resultSign) return dm_double_neg(dm_double_NaN); // Preserve the sign of NaN ...
       return dm_double_NaN;
     }
@@ -755,48 +804,24 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
    int16_t resultExponent = DM_DOUBLE_UNPACK_EXPONENT(lhs) + DM_DOUBLE_UNPACK_EXPONENT(rhs);
    if (resultExponent > MAX_EXPONENT)
     {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Inf);
       return dm_double_Inf;
     }
    else if (resultExponent < (MIN_EXPONENT - 1)) // Minus one in case we can save the result from flushing to zero.
     {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Zero);
       return dm_double_Zero;
     }
 
       // Now, we can start the multiply proper!
-   dm_muldiv_t lhd;
-   dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-
-   dm_muldiv_mulBy(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(rhs));
-
-   uint64_t temp = MIN_SIGNIFICAND;
-   dm_muldiv_t test;
-   dm_muldiv_loadFrom(test, BIAS);
-   dm_muldiv_mulBy(test, MIN_SIGNIFICAND);
-   if (!dm_muldiv_less(lhd, test)) // lhd >= BIAS * MIN_SIGNIFICAND
-    {
-      temp *= 10;
-      ++resultExponent;
-    }
-
-   uint64_t resultSignificand, rem;
-   dm_muldiv_divBy(lhd, temp, &resultSignificand, &rem);
-      // This can't cause an overflow.
-   resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)temp - (int64_t)(rem << 1), rem == 0, round_mode);
-
-   if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-    {
-      if (resultSign) return dm_double_neg(dm_double_Inf);
-      return dm_double_Inf;
-    }
-   if (resultExponent < MIN_EXPONENT) // Were we unsuccessful in saving a result from flushing to zero?
-    {
-      if (resultSign) return dm_double_neg(dm_double_Zero);
-      return dm_double_Zero;
-    }
-
-   return DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
+   int events = 0;
+   dm_core_number result = dm_core_mul(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
  }
 
 dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
@@ -810,6 +835,7 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, zero divided by zero or infinity divided by infinity is NaN.
    if ((dm_double_iszero(lhs) && dm_double_iszero(rhs)) || (dm_double_isinf(lhs) && dm_double_isinf(rhs)))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (resultSign) return dm_double_neg(dm_double_NaN); // Preserve the sign of NaN ...
       return dm_double_NaN;
     }
@@ -817,6 +843,7 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, if the result is infinity.
    if (dm_double_isinf(lhs) || dm_double_iszero(rhs))
     {
+      if (!dm_double_isinf(lhs)) DM_FE_RAISE(DM_FE_DIVBYZERO); // Finite divided by zero
       if (resultSign) return dm_double_neg(dm_double_Inf);
       return dm_double_Inf;
     }
@@ -832,47 +859,194 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
    int16_t resultExponent = DM_DOUBLE_UNPACK_EXPONENT(lhs) - DM_DOUBLE_UNPACK_EXPONENT(rhs);
    if (resultExponent > (MAX_EXPONENT + 1)) // Plus one in case we can save the result from flushing to infinity.
     {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Inf);
       return dm_double_Inf;
     }
    else if (resultExponent < MIN_EXPONENT)
     {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Zero);
       return dm_double_Zero;
     }
 
       // Now, we can start the divide proper!
-   dm_muldiv_t lhd;
-   dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-   uint64_t rhd = DM_DOUBLE_UNPACK_SIGNIFICAND(rhs);
+   int events = 0;
+   dm_core_number result = dm_core_div(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_sqrt(dm_double arg)
+ {
+   return dm_double_sqrt_r(arg, dm_global_round_mode);
+ }
 
-   if (DM_DOUBLE_UNPACK_SIGNIFICAND(lhs) < DM_DOUBLE_UNPACK_SIGNIFICAND(rhs))
+dm_double dm_double_sqrt_r(dm_double arg, int round_mode)
+ {
+   if (dm_double_isnan(arg)) return arg;
+   if (dm_double_iszero(arg)) return arg; // sqrt(-0) = -0
+   if (dm_double_signbit(arg))
     {
-      --resultExponent;
+      DM_FE_RAISE(DM_FE_INVALID);
+      return dm_double_NaN;
     }
-   else
+   if (dm_double_isinf(arg)) return arg;
+
+      // Halving the exponent can't go out of range.
+   int events = 0;
+   dm_core_number result = dm_core_sqrt(dm_double_toCore(arg), round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_exp(dm_double arg)
+ {
+   if (dm_double_isnan(arg)) return arg;
+   if (dm_double_isinf(arg)) return dm_double_signbit(arg) ? dm_double_Zero : arg;
+   if (dm_double_iszero(arg)) return DM_DOUBLE_PACK(0, 0, MIN_SIGNIFICAND); // exp(0) = 1, exactly
+
+   int events = 0;
+   dm_core_number result = dm_core_exp(dm_double_toCore(arg), dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_expm1(dm_double arg)
+ {
+   if (dm_double_isnan(arg)) return arg;
+   if (dm_double_isinf(arg)) return dm_double_signbit(arg) ? DM_DOUBLE_PACK(1, 0, MIN_SIGNIFICAND) : arg;
+   if (dm_double_iszero(arg)) return arg;
+
+   int events = 0;
+   dm_core_number result = dm_core_expm1(dm_double_toCore(arg), dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+   // The natural logarithm, or the common logarithm.
+static dm_double dm_double_logarithm(dm_double arg, int common)
+ {
+   if (dm_double_isnan(arg)) return arg;
+   if (dm_double_iszero(arg))
+    {
+      DM_FE_RAISE(DM_FE_DIVBYZERO);
+      return dm_double_Inf | SIGN_BIT;
+    }
+   if (dm_double_signbit(arg))
     {
-      rhd *= 10;
+      DM_FE_RAISE(DM_FE_INVALID);
+      return dm_double_NaN;
     }
+   if (dm_double_isinf(arg)) return arg;
+
+   int events = 0;
+   dm_core_number result = dm_core_log(dm_double_toCore(arg), common, dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_log(dm_double arg)
+ {
+   return dm_double_logarithm(arg, 0);
+ }
 
-   dm_muldiv_mulBy(lhd, BIAS);
-   uint64_t resultSignificand, rem;
-   dm_muldiv_divBy(lhd, rhd, &resultSignificand, &rem);
-      // This can't cause an overflow.
-   resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)rhd - (int64_t)(rem << 1), rem == 0, round_mode);
+dm_double dm_double_log10(dm_double arg)
+ {
+   return dm_double_logarithm(arg, 1);
+ }
 
-   if (resultExponent > MAX_EXPONENT) // Were we unsuccessful in saving a result from flushing to infinity?
+dm_double dm_double_log1p(dm_double arg)
+ {
+   dm_double minusOne = DM_DOUBLE_PACK(1, 0, MIN_SIGNIFICAND);
+   if (dm_double_isnan(arg)) return arg;
+   if (dm_double_iszero(arg)) return arg;
+   if (dm_double_isequal(arg, minusOne))
     {
-      if (resultSign) return dm_double_neg(dm_double_Inf);
+      DM_FE_RAISE(DM_FE_DIVBYZERO);
+      return dm_double_Inf | SIGN_BIT;
+    }
+   if (dm_double_isless(arg, minusOne))
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      return dm_double_NaN;
+    }
+   if (dm_double_isinf(arg)) return arg;
+
+   int events = 0;
+   dm_core_number result = dm_core_log1p(dm_double_toCore(arg), dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_pow(dm_double lhs, dm_double rhs)
+ {
+   dm_double one = DM_DOUBLE_PACK(0, 0, MIN_SIGNIFICAND);
+
+      // pow(x, 0) and pow(1, y) are one, even for NaNs.
+   if (dm_double_iszero(rhs) || dm_double_isequal(lhs, one)) return one;
+   if (dm_double_isnan(lhs)) return lhs; // Prefer lhs NaN's payload.
+   if (dm_double_isnan(rhs)) return rhs;
+
+      // The result is negative when x is and y is an odd integer. Infinities are even.
+   int parity = dm_double_isinf(rhs) ? 1 : dm_core_parity(dm_double_toCore(rhs));
+   int resultSign = dm_double_signbit(lhs) && (2 == parity);
+   if (dm_double_iszero(lhs))
+    {
+      if (!dm_double_signbit(rhs)) return resultSign ? lhs : dm_double_Zero;
+      if (!dm_double_isinf(rhs)) DM_FE_RAISE(DM_FE_DIVBYZERO);
+      return resultSign ? (dm_double_Inf | SIGN_BIT) : dm_double_Inf;
+    }
+   if (dm_double_isinf(rhs))
+    {
+      dm_double magnitude = dm_double_fabs(lhs);
+      if (dm_double_isequal(magnitude, one)) return one; // pow(-1, Inf) = 1
+      if (dm_double_isless(magnitude, one) == !dm_double_signbit(rhs)) return dm_double_Zero;
       return dm_double_Inf;
     }
-   if (resultExponent < MIN_EXPONENT) // Flush to zero?
+   if (dm_double_isinf(lhs))
     {
-      if (resultSign) return dm_double_neg(dm_double_Zero);
-      return dm_double_Zero;
+      if (dm_double_signbit(rhs)) return resultSign ? (dm_double_Zero | SIGN_BIT) : dm_double_Zero;
+      return resultSign ? lhs : dm_double_Inf;
+    }
+   if (dm_double_signbit(lhs) && (0 == parity)) // A negative number to a non-integer power
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      return dm_double_NaN;
     }
 
-   return DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
+   int events = 0;
+   dm_core_number base = dm_double_toCore(lhs);
+   base.sign = resultSign;
+   dm_core_number result = dm_core_pow(base, dm_double_toCore(rhs), dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
+
+dm_double dm_double_powi_r(dm_double base, int64_t n, int round_mode)
+ {
+   if (0 == n) return DM_DOUBLE_PACK(0, 0, MIN_SIGNIFICAND); // Even for NaN, as pow(x, 0)
+   if (dm_double_isnan(base)) return base;
+
+   int resultSign = dm_double_signbit(base) && (0 != (n & 1));
+   if (dm_double_iszero(base))
+    {
+      if (n > 0) return resultSign ? base : dm_double_Zero;
+      DM_FE_RAISE(DM_FE_DIVBYZERO);
+      return resultSign ? (dm_double_Inf | SIGN_BIT) : dm_double_Inf;
+    }
+   if (dm_double_isinf(base))
+    {
+      if (n > 0) return resultSign ? base : dm_double_Inf;
+      return resultSign ? (dm_double_Zero | SIGN_BIT) : dm_double_Zero;
+    }
+
+   int events = 0;
+   dm_core_number result = dm_core_powi(dm_double_toCore(base), n, round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
  }
 
 dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
@@ -886,6 +1060,7 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
       // Then, check if the result is NaN.
    if (dm_double_isinf(lhs) || dm_double_iszero(rhs))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (resultSign) return dm_double_neg(dm_double_NaN);
       return dm_double_NaN;
     }
@@ -927,13 +1102,13 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
     }
    else if (resultSignificand < MIN_SIGNIFICAND)
     {
-      while (resultSignificand < MIN_SIGNIFICAND)
-       {
-         resultSignificand *= 10U;
-         --resultExponent;
-       }
+      int shift = CUTOFF - dm_core_digits(resultSignificand);
+      resultSignificand *= makeShift[shift + 1];
+      resultExponent -= shift;
       if (resultExponent < MIN_EXPONENT) // Flush to zero?
        {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
          resultSignificand = MIN_SIGNIFICAND;
          resultExponent = SPECIAL_EXPONENT;
        }
@@ -944,8 +1119,6 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
 
 dm_double dm_double_fma(dm_double lhs, dm_double rhs, dm_double ths)
  {
-   int prodSign = dm_double_signbit(lhs) != dm_double_signbit(rhs);
-
       // If any argument is Nan, Zero, or Infinity: then the result is the same as the result of the base operations.
       // And that means that if any aren't normal.
    if (!(dm_double_isnormal(lhs) && dm_double_isnormal(rhs) && dm_double_isnormal(ths)))
@@ -953,187 +1126,12 @@ dm_double dm_double_fma(dm_double lhs, dm_double rhs, dm_double ths)
       return dm_double_add(dm_double_mul(lhs, rhs), ths);
     }
 
-      // Compute the exponent of the product: we defer flush to infinity to the end.
-   int16_t phse = DM_DOUBLE_UNPACK_EXPONENT(lhs) + DM_DOUBLE_UNPACK_EXPONENT(rhs);
-
-      // Now, we can start the multiply proper!
-   dm_muldiv_t lhd;
-   dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-
-   dm_muldiv_mulBy(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(rhs));
-
-   uint64_t temp = MIN_SIGNIFICAND * 10U;
-   dm_muldiv_t test;
-   dm_muldiv_loadFrom(test, BIAS);
-   dm_muldiv_mulBy(test, MIN_SIGNIFICAND);
-   if (!dm_muldiv_less(lhd, test)) // lhd >= BIAS * MIN_SIGNIFICAND
-    {
-      ++phse;
-    }
-   else // Normalize the location of the product.
-    {
-      dm_muldiv_mulBy(lhd, 10U);
-    }
-
-   int32_t resultExponent = phse;
-   uint64_t resultSignificand;
-   int resultSign = prodSign;
-
-   int16_t thse = DM_DOUBLE_UNPACK_EXPONENT(ths);
-   int16_t expDiff = phse - thse;
-   if (expDiff < 0) expDiff = -expDiff;
-      // If we are not the special case (the case where we have to do a full subtraction)
-      // If the exponents are equal and the signs different, we may need all of the digits in order to handle cancellation.
-   if (!((expDiff < 2) && (prodSign != dm_double_signbit(ths))))
-    {
-      uint64_t thd = DM_DOUBLE_UNPACK_SIGNIFICAND(ths) * 100U;
-
-      uint64_t phd, rem;
-      dm_muldiv_divBy(lhd, temp / 100U, &phd, &rem);
-      phd += dm_internal_round(phd, rem);
-
-      if (phse > thse)
-       {
-         if (expDiff <= (CUTOFF + 1))
-          {
-            uint64_t removed;
-            removed = thd % makeShift[expDiff + 1];
-            thd /= makeShift[expDiff + 1];
-            thd += dm_internal_round(thd, removed);
-          }
-         else
-          {
-            thd = 1U;
-          }
-       }
-      else if (phse < thse)
-       {
-         resultExponent = thse;
-         if (expDiff <= (CUTOFF + 1))
-          {
-            uint64_t removed;
-            removed = phd % makeShift[expDiff + 1];
-            phd /= makeShift[expDiff + 1];
-            phd += dm_internal_round(phd, removed);
-          }
-         else
-          {
-            phd = 1U;
-          }
-       }
-
-         // Compute the digits and sign.
-      if (prodSign == dm_double_signbit(ths)) // Both same sign
-       {
-         phd += thd;
-       }
-      else // Different Signs
-       {
-         if (phd >= thd) // lhs larger : result sign of lhs
-            phd -= thd;
-         else // rhs larger : result sign of rhs (opposite sign of lhs)
-          {
-            phd = thd - phd;
-            resultSign = !resultSign;
-          }
-       }
-      resultSignificand = phd; // This cannot possibly be zero.
-
-         // Normalize the result
-      uint64_t scal = 10U;
-      uint64_t test = BIAS * 10U;
-      if (phd < test) // Did destructive cancellation occur? ie 100 - 1.
-       {
-         --resultExponent;
-       }
-      else
-       {
-         scal *= 10U;
-         test *= 10U;
-         if (phd >= test) // Did overflow occur? ie 9 + 1
-          {
-            ++resultExponent;
-            scal *= 10U;
-          }
-       }
-      resultSignificand = phd / scal;
-      rem = phd % scal;
-      resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)scal - (int64_t)(rem << 1), rem == 0, dm_global_round_mode);
-      if (resultSignificand == BIAS)
-       {
-         resultSignificand = MIN_SIGNIFICAND;
-         ++resultExponent;
-       }
-    }
-   else // The pathological case
-    {
-      dm_muldiv_t thd;
-      dm_muldiv_loadFrom(thd, DM_DOUBLE_UNPACK_SIGNIFICAND(ths));
-      dm_muldiv_mulBy(thd, BIAS);
-
-      if (phse > thse)
-       {
-         dm_muldiv_mulBy(lhd, 10U);
-       }
-      else if (phse < thse)
-       {
-         resultExponent = thse;
-         dm_muldiv_mulBy(thd, 10U);
-       }
-
-      if (!dm_muldiv_less(lhd, thd)) // lhs larger : result sign of lhs
-         dm_muldiv_sub(lhd, lhd, thd);
-      else // rhs larger : result sign of rhs (opposite sign of lhs)
-       {
-         dm_muldiv_sub(lhd, thd, lhd);
-         resultSign = !resultSign;
-       }
-
-      dm_muldiv_t test2;
-      dm_muldiv_loadFrom(test2, BIAS);
-      dm_muldiv_mulBy(test2, BIAS);
-      uint64_t rem;
-      if (dm_muldiv_zero(lhd))
-       {
-         if (DM_FE_DOWNWARD != dm_global_round_mode) resultSign = 0;
-         else resultSign = 1;
-         resultExponent = SPECIAL_EXPONENT;
-         resultSignificand = MIN_SIGNIFICAND;
-       }
-      else if (!dm_muldiv_less(lhd, test2))
-       {
-         dm_muldiv_divBy(lhd, BIAS * 10U, &resultSignificand, &rem);
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)(BIAS * 10U) - (int64_t)(rem << 1), rem == 0, dm_global_round_mode);
-       }
-      else
-       {
-         if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
-          {
-            --resultExponent;
-          }
-         while (dm_muldiv_less(lhd, test))
-          {
-            dm_muldiv_mulBy(lhd, 10U);
-            --resultExponent;
-          }
-         dm_muldiv_divBy(lhd, BIAS, &resultSignificand, &rem);
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1, (int64_t)BIAS - (int64_t)(rem << 1), rem == 0, dm_global_round_mode);
-       }
-    }
-
-   if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-    {
-      resultSignificand = DM_INFINITY + MIN_SIGNIFICAND;
-      resultExponent = SPECIAL_EXPONENT;
-    }
-   else if (resultExponent < MIN_EXPONENT) // Flush to zero?
-    {
-      resultSignificand = MIN_SIGNIFICAND;
-      resultExponent = SPECIAL_EXPONENT;
-    }
-
-   return DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
- }
+      // Now, we can start the fma proper!
+   int events = 0;
+   dm_core_number result = dm_core_fma(dm_double_toCore(lhs), dm_double_toCore(rhs), dm_double_toCore(ths), dm_global_round_mode, &events);
+   dm_double_report(events);
+   return dm_double_fromCore(result);
+ }
 
 void dm_double_tostring(dm_double arg, char dest [25])
  {
@@ -1328,17 +1326,21 @@ dm_double dm_double_fromstring(const char * arg)
 
    if (0 == resultSignificand)
     {
-      resultExponent = SPECIAL_EXPONENT;
-      resultSignificand = MIN_SIGNIFICAND;
+      if (resultSign) return dm_double_neg(dm_double_Zero);
+      return dm_double_Zero;
     }
 
    if (resultExponent > MAX_EXPONENT) // Flush to infinity?
     {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Inf);
       return dm_double_Inf;
     }
    if (resultExponent < MIN_EXPONENT) // Flush to zero?
     {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       if (resultSign) return dm_double_neg(dm_double_Zero);
       return dm_double_Zero;
     }
@@ -1346,6 +1348,620 @@ dm_double dm_double_fromstring(const char * arg)
    return DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
  }
 
+dm_double dm_double_fromsingle(dm_single arg)
+ {
+   int sign = (arg & DM_SINGLE_SIGN_MASK) ? 1 : 0;
+   if (DM_SINGLE_SPECIAL_EXPONENT == DM_SINGLE_UNPACK_EXPONENT(arg))
+    {
+      uint64_t significand = DM_SINGLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_SINGLE_INFINITY == significand)
+         significand = DM_INFINITY;
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, significand); // Zero, infinity, or NaN with its payload.
+    }
+   return DM_DOUBLE_PACK(sign, DM_SINGLE_UNPACK_EXPONENT(arg), (uint64_t)DM_SINGLE_UNPACK_SIGNIFICAND(arg) * DM_SINGLE_WIDEN);
+ }
+
+dm_single dm_double_tosingle(dm_double arg)
+ {
+   return dm_double_tosingle_r(arg, dm_global_round_mode);
+ }
+
+dm_single dm_double_tosingle_r(dm_double arg, int round_mode)
+ {
+   int sign = dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_INFINITY == significand)
+         significand = DM_SINGLE_INFINITY;
+      else if (significand >= DM_SINGLE_INFINITY)
+         significand = 255U; // A NaN whose payload doesn't fit.
+      return DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, significand);
+    }
+
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int events = 0;
+   significand = dm_core_round(sign, significand / DM_SINGLE_WIDEN, DM_SINGLE_WIDEN, significand % DM_SINGLE_WIDEN, round_mode, &events);
+   dm_double_report(events);
+   if (significand > DM_SINGLE_MAX_SIGNIFICAND)
+    {
+      significand = DM_SINGLE_MIN_SIGNIFICAND;
+      ++exponent;
+    }
+   if (exponent > DM_SINGLE_MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      return DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, DM_SINGLE_INFINITY);
+    }
+   if (exponent < DM_SINGLE_MIN_EXPONENT) // Flush to zero?
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      return DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, 0U);
+    }
+   return DM_SINGLE_PACK(sign, exponent, significand);
+ }
+
+   // Tight loops over the conversions above, which the compiler can inline here.
+void dm_double_fromsingle_array(const dm_single* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_fromsingle(src[i]);
+ }
+
+void dm_double_tosingle_array(const dm_double* src, dm_single* dest, size_t count, int round_mode)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_tosingle_r(src[i], round_mode);
+ }
+
+dm_quad dm_double_toquad(dm_double arg)
+ {
+   int sign = dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_INFINITY == significand)
+         return dm_quad_pack_alt(sign, DM_QUAD_SPECIAL_EXPONENT, DM_QUAD_INFINITY_HIGH, DM_QUAD_INFINITY_LOW);
+      return dm_quad_pack_alt(sign, DM_QUAD_SPECIAL_EXPONENT, 0U, significand); // Zero, or NaN with its payload.
+    }
+
+   dm_muldiv_wide_t significand, widen;
+   uint64_t high, low;
+   dm_muldiv_wide_loadFrom(significand, 0U, DM_DOUBLE_UNPACK_SIGNIFICAND(arg));
+   dm_muldiv_wide_loadFrom(widen, 0U, DM_QUAD_WIDEN);
+   dm_muldiv_wide_mul(significand, significand, widen);
+   dm_muldiv_wide_extract(significand, &high, &low);
+   return dm_quad_pack(sign, exponent, high, low);
+ }
+
+dm_double dm_double_fromquad(dm_quad arg)
+ {
+   return dm_double_fromquad_r(arg, dm_global_round_mode);
+ }
+
+dm_double dm_double_fromquad_r(dm_quad arg, int round_mode)
+ {
+   int sign = dm_quad_unpack_sign(arg);
+   int32_t exponent = dm_quad_unpack_exponent(arg);
+   uint64_t high, low;
+   if (DM_QUAD_SPECIAL_EXPONENT == exponent)
+    {
+      dm_quad_unpack_significand_alt(arg, &high, &low);
+      if ((DM_QUAD_INFINITY_HIGH == high) && (DM_QUAD_INFINITY_LOW == low))
+         low = DM_INFINITY;
+      else if ((0U != high) || (low >= DM_INFINITY))
+         low = 255U; // A NaN whose payload doesn't fit.
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, low);
+    }
+
+   dm_muldiv_wide_t significand, widen, rem;
+   uint64_t quot, remainder;
+   dm_quad_unpack_significand(arg, &high, &low);
+   dm_muldiv_wide_loadFrom(significand, high, low);
+   dm_muldiv_wide_loadFrom(widen, 0U, DM_QUAD_WIDEN);
+   dm_muldiv_wide_divBy(significand, widen, significand, rem);
+   dm_muldiv_wide_extract(significand, &high, &quot);
+   dm_muldiv_wide_extract(rem, &high, &remainder);
+   int events = 0;
+   quot = dm_core_round(sign, quot, DM_QUAD_WIDEN, remainder, round_mode, &events);
+   dm_double_report(events);
+   if (quot > MAX_SIGNIFICAND)
+    {
+      quot = MIN_SIGNIFICAND;
+      ++exponent;
+    }
+   if (exponent > MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+    }
+   if (exponent < MIN_EXPONENT) // Flush to zero?
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U);
+    }
+   return DM_DOUBLE_PACK(sign, exponent, quot);
+ }
+
+uint64_t dm_double_to_bid64(dm_double arg)
+ {
+   return dm_double_to_bid64_r(arg, dm_global_round_mode);
+ }
+
+uint64_t dm_double_to_bid64_r(dm_double arg, int round_mode)
+ {
+   uint64_t sign = (uint64_t)dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (0U == significand)
+         return dm_bid64_pack(sign, 0, 0U);
+      if (DM_INFINITY == significand)
+         return (sign << 63) | DM_BID64_INFINITY;
+      if (significand > DM_BID64_MAX_PAYLOAD)
+         significand = 0U; // A NaN whose payload doesn't fit.
+      return (sign << 63) | DM_BID64_NAN | significand;
+    }
+
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int64_t q = exponent - (CUTOFF - 1);
+   if (q > DM_BID64_MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      return (sign << 63) | DM_BID64_INFINITY;
+    }
+   if (q < DM_BID64_MIN_EXPONENT) // Subnormal: drop the digits below 10 ^ -398.
+    {
+      int64_t lost = DM_BID64_MIN_EXPONENT - q;
+      uint64_t divisor = (lost > CUTOFF) ? (10U * makeShift[CUTOFF + 1]) : makeShift[lost + 1]; // Past sixteen, every digit is lost alike.
+      int events = 0;
+      significand = dm_core_round((int)sign, significand / divisor, divisor, significand % divisor, round_mode, &events);
+      dm_double_report(events);
+      if (events & DM_CORE_INEXACT)
+       {
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         if (0U == significand)
+            DM_STATS_COUNT(flush_to_zero);
+       }
+      q = DM_BID64_MIN_EXPONENT;
+    }
+   return dm_bid64_pack(sign, q, significand);
+ }
+
+dm_double dm_double_from_bid64(uint64_t arg)
+ {
+   int sign = (arg & DM_BID64_SIGN_MASK) ? 1 : 0;
+   if (DM_BID64_SPECIAL_MASK == (arg & DM_BID64_SPECIAL_MASK))
+    {
+      if (DM_BID64_NAN != (arg & DM_BID64_NAN))
+         return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+      uint64_t payload = arg & DM_BID64_PAYLOAD_MASK;
+      if ((0U == payload) || (payload > DM_BID64_MAX_PAYLOAD))
+         payload = 255U; // No payload, or a non-canonical one: dm_double_NaN's.
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, payload);
+    }
+
+   uint64_t coefficient = dm_bid64_unpack_coefficient(arg);
+   if ((0U == coefficient) || (coefficient > MAX_SIGNIFICAND))
+      return DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U); // Zero in any cohort, or non-canonical.
+   int64_t shift = dm_bid64_normalize(&coefficient);
+   return DM_DOUBLE_PACK(sign, dm_bid64_unpack_exponent(arg) + (CUTOFF - 1) - shift, coefficient);
+ }
+
+   // The destinations must not overlap the sources, as the second loops go back to them.
+void dm_double_to_bid64_array(const dm_double* src, uint64_t* dest, size_t count, int round_mode)
+ {
+   uint64_t slow = 0U;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dm_double arg = src[i];
+      int64_t q = DM_DOUBLE_UNPACK_EXPONENT(arg) - (CUTOFF - 1); // The special exponent is out of range too.
+      slow |= (uint64_t)((q > DM_BID64_MAX_EXPONENT) | (q < DM_BID64_MIN_EXPONENT));
+      dest[i] = dm_bid64_pack((arg & SIGN_BIT) >> 53, q, DM_DOUBLE_UNPACK_SIGNIFICAND(arg));
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         int64_t q = DM_DOUBLE_UNPACK_EXPONENT(src[i]) - (CUTOFF - 1);
+         if ((q > DM_BID64_MAX_EXPONENT) || (q < DM_BID64_MIN_EXPONENT))
+            dest[i] = dm_double_to_bid64_r(src[i], round_mode);
+       }
+    }
+ }
+
+void dm_double_from_bid64_array(const uint64_t* src, dm_double* dest, size_t count)
+ {
+   uint64_t slow = 0U;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      uint64_t arg = src[i];
+      uint64_t coefficient = dm_bid64_unpack_coefficient(arg);
+      int64_t shift = dm_bid64_normalize(&coefficient);
+      slow |= (uint64_t)(dm_bid64_isspecial(arg) | (0U == coefficient) | (coefficient > MAX_SIGNIFICAND));
+      dest[i] = DM_DOUBLE_PACK(arg >> 63, dm_bid64_unpack_exponent(arg) + (CUTOFF - 1) - shift, coefficient);
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         uint64_t coefficient = dm_bid64_unpack_coefficient(src[i]);
+         if (dm_bid64_isspecial(src[i]) || (0U == coefficient) || (coefficient > MAX_SIGNIFICAND))
+            dest[i] = dm_double_from_bid64(src[i]);
+       }
+    }
+ }
+
+size_t dm_double_to_varint(dm_double arg, unsigned char* dest)
+ {
+   uint64_t sign = (arg & SIGN_BIT) >> 53;
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      dest[0] = 0U;
+      return 1U + dm_varint_put((DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg) << 1) | sign, dest + 1);
+    }
+
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int64_t zeros = dm_core_strip(&significand);
+   size_t length = dm_varint_put((significand << 1) - sign, dest); // Zigzag
+   return length + dm_varint_put(dm_zigzag_encode(exponent - (CUTOFF - 1) + zeros), dest + length);
+ }
+
+size_t dm_double_from_varint(const unsigned char* src, size_t length, dm_double* result)
+ {
+   uint64_t integer = 0U;
+   uint64_t second = 0U;
+   size_t first = dm_varint_get(src, length, &integer);
+   if (0U == first)
+      return 0U;
+   size_t last = dm_varint_get(src + first, length - first, &second);
+   if (0U == last)
+      return 0U;
+
+   uint64_t sign = integer & 1U;
+   if (0U == integer)
+    {
+      if ((second >> 1) > DM_INFINITY)
+         return 0U;
+      *result = DM_DOUBLE_PACK_ALT(second & 1U, SPECIAL_EXPONENT, second >> 1);
+      return first + last;
+    }
+
+   uint64_t significand = (integer + sign) >> 1;
+   if (significand > MAX_SIGNIFICAND)
+      return 0U;
+   int64_t exponent = dm_zigzag_decode(second) + (CUTOFF - 1) - dm_bid64_normalize(&significand);
+   if ((exponent > MAX_EXPONENT) || (exponent < MIN_EXPONENT))
+      return 0U;
+   *result = DM_DOUBLE_PACK(sign, exponent, significand);
+   return first + last;
+ }
+
+   // With room for the longest value, there is nothing to check. Only near the end is it written aside first.
+size_t dm_double_to_varint_array(const dm_double* src, size_t count, unsigned char* dest, size_t capacity, size_t* written)
+ {
+   unsigned char aside [DM_VARINT_MAX_BYTES];
+   size_t length = 0U;
+   size_t i = 0U;
+   for (; (i < count) && (capacity - length >= DM_VARINT_MAX_BYTES); ++i)
+      length += dm_double_to_varint(src[i], dest + length);
+   for (; i < count; ++i)
+    {
+      size_t size = dm_double_to_varint(src[i], aside);
+      if (size > capacity - length)
+         break;
+      for (size_t j = 0U; j < size; ++j)
+         dest[length + j] = aside[j];
+      length += size;
+    }
+   *written = length;
+   return i;
+ }
+
+size_t dm_double_from_varint_array(const unsigned char* src, size_t length, dm_double* dest, size_t count, size_t* read)
+ {
+   size_t position = 0U;
+   size_t i = 0U;
+   for (; i < count; ++i)
+    {
+      size_t size = dm_double_from_varint(src + position, length - position, dest + i);
+      if (0U == size)
+         break;
+      position += size;
+    }
+   *read = position;
+   return i;
+ }
+
+   // Converts magnitude * 10 ^ -scale.
+static int dm_double_frominteger(int sign, uint64_t magnitude, int scale, int round_mode, dm_double* result)
+ {
+   if (0U == magnitude)
+    {
+      *result = DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U);
+      return DM_CONVERT_EXACT;
+    }
+
+   int status = DM_CONVERT_EXACT;
+   int64_t exponent;
+   uint64_t significand = magnitude;
+   if (magnitude <= MAX_SIGNIFICAND)
+      exponent = (CUTOFF - 1) - dm_bid64_normalize(&significand);
+   else // Seventeen to twenty digits: round away those past the sixteenth.
+    {
+      int digits = dm_core_digits(magnitude);
+      uint64_t divisor = dm_core_powers[digits - CUTOFF];
+      int events = 0;
+      exponent = digits - 1;
+      significand = dm_core_round(sign, magnitude / divisor, divisor, magnitude % divisor, round_mode, &events);
+      dm_double_report(events);
+      if (significand > MAX_SIGNIFICAND)
+       {
+         significand = MIN_SIGNIFICAND;
+         ++exponent;
+       }
+      if (events & DM_CORE_INEXACT)
+         status = DM_CONVERT_INEXACT;
+    }
+
+   exponent -= scale;
+   if (exponent > MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      *result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+      return DM_CONVERT_SATURATED;
+    }
+   if (exponent < MIN_EXPONENT) // Flush to zero?
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      *result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U);
+      return DM_CONVERT_INEXACT;
+    }
+   *result = DM_DOUBLE_PACK(sign, exponent, significand);
+   return status;
+ }
+
+   // Rounds arg * 10 ^ scale to an integer, and gives its magnitude, saturated to the limit for the sign.
+static int dm_double_tointeger(dm_double arg, int scale, int round_mode, uint64_t positive_limit, uint64_t negative_limit, uint64_t* magnitude)
+ {
+   int sign = dm_double_signbit(arg);
+   uint64_t limit = sign ? negative_limit : positive_limit;
+   int64_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   *magnitude = 0U;
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (0U == significand)
+         return DM_CONVERT_EXACT;
+      DM_FE_RAISE(DM_FE_INVALID);
+      if (DM_INFINITY != significand)
+         return DM_CONVERT_INVALID;
+      *magnitude = limit;
+      return DM_CONVERT_SATURATED;
+    }
+
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int status = DM_CONVERT_EXACT;
+   uint64_t value;
+   exponent += scale;
+   if (exponent < CUTOFF) // Round away the fraction digits.
+    {
+      uint64_t divisor = (exponent < -1) ? (10U * makeShift[CUTOFF + 1]) : makeShift[CUTOFF - exponent]; // Below 0.1, every digit is lost alike.
+      int events = 0;
+      value = dm_core_round(sign, significand / divisor, divisor, significand % divisor, round_mode, &events);
+      dm_double_report(events);
+      if (events & DM_CORE_INEXACT)
+         status = DM_CONVERT_INEXACT;
+    }
+   else if ((exponent > CUTOFF + 3) || (significand > limit / makeShift[exponent - CUTOFF + 2])) // Past twenty digits, nothing fits.
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      *magnitude = limit;
+      return DM_CONVERT_SATURATED;
+    }
+   else
+      value = significand * makeShift[exponent - CUTOFF + 2];
+   if (value > limit) // Rounded up past the limit, or negative for dm_double_touint64_r.
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      *magnitude = limit;
+      return DM_CONVERT_SATURATED;
+    }
+   *magnitude = value;
+   return status;
+ }
+
+dm_double dm_double_fromint64(int64_t arg)
+ {
+   dm_double result;
+   dm_double_fromint64_r(arg, dm_global_round_mode, &result);
+   return result;
+ }
+
+dm_double dm_double_fromuint64(uint64_t arg)
+ {
+   dm_double result;
+   dm_double_fromuint64_r(arg, dm_global_round_mode, &result);
+   return result;
+ }
+
+int dm_double_fromint64_r(int64_t arg, int round_mode, dm_double* result)
+ {
+   return dm_double_from_scaled_r(arg, 0, round_mode, result);
+ }
+
+int dm_double_fromuint64_r(uint64_t arg, int round_mode, dm_double* result)
+ {
+   return dm_double_frominteger(0, arg, 0, round_mode, result);
+ }
+
+int dm_double_toint64_r(dm_double arg, int round_mode, int64_t* result)
+ {
+   return dm_double_to_scaled_r(arg, 0, round_mode, result);
+ }
+
+int dm_double_touint64_r(dm_double arg, int round_mode, uint64_t* result)
+ {
+   return dm_double_tointeger(arg, 0, round_mode, UINT64_MAX, 0U, result);
+ }
+
+int dm_double_fromint64_array(const int64_t* src, dm_double* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      status |= dm_double_fromint64_r(src[i], round_mode, dest + i);
+   return status;
+ }
+
+int dm_double_fromuint64_array(const uint64_t* src, dm_double* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      status |= dm_double_fromuint64_r(src[i], round_mode, dest + i);
+   return status;
+ }
+
+int dm_double_toint64_array(const dm_double* src, int64_t* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      status |= dm_double_toint64_r(src[i], round_mode, dest + i);
+   return status;
+ }
+
+int dm_double_touint64_array(const dm_double* src, uint64_t* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      status |= dm_double_touint64_r(src[i], round_mode, dest + i);
+   return status;
+ }
+
+dm_double dm_double_from_scaled(int64_t value, int scale)
+ {
+   dm_double result;
+   dm_double_from_scaled_r(value, scale, dm_global_round_mode, &result);
+   return result;
+ }
+
+int dm_double_from_scaled_r(int64_t value, int scale, int round_mode, dm_double* result)
+ {
+   if (value < 0)
+      return dm_double_frominteger(1, 0U - (uint64_t)value, scale, round_mode, result);
+   return dm_double_frominteger(0, (uint64_t)value, scale, round_mode, result);
+ }
+
+int dm_double_to_scaled_r(dm_double arg, int scale, int round_mode, int64_t* result)
+ {
+   uint64_t magnitude;
+   int status = dm_double_tointeger(arg, scale, round_mode, (uint64_t)INT64_MAX, (uint64_t)INT64_MAX + 1U, &magnitude);
+   if (dm_double_signbit(arg) && (0U != magnitude))
+      *result = -(int64_t)(magnitude - 1U) - 1; // Without overflow for INT64_MIN.
+   else
+      *result = (int64_t)magnitude;
+   return status;
+ }
+
+   // The common cases of the scaled array conversions, without branches. They return non-zero
+   // for the elements that need the scalar conversion: those that round, saturate, or are special.
+static inline int dm_double_from_scaled_fast(int64_t value, int scale, dm_double* result)
+ {
+   uint64_t sign = (uint64_t)value >> 63;
+   uint64_t magnitude = ((uint64_t)value ^ (0U - sign)) + sign;
+   uint64_t significand = magnitude;
+   int64_t shift = dm_bid64_normalize(&significand);
+   uint64_t zero = 0U - (uint64_t)(0U == magnitude);
+   *result = (zero & DM_DOUBLE_PACK_ALT(0, SPECIAL_EXPONENT, 0U)) | (~zero & DM_DOUBLE_PACK(sign, (CUTOFF - 1) - shift - scale, significand));
+   return magnitude > MAX_SIGNIFICAND;
+ }
+
+static inline int dm_double_to_scaled_fast(dm_double arg, int scale, int64_t* result)
+ {
+   int64_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   int64_t digits = exponent + scale; // The power of ten of the leading digit, once scaled.
+   uint64_t sign = (arg & SIGN_BIT) >> 53;
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   int zero = (SPECIAL_EXPONENT == exponent) & (0U == DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg));
+   int divide = (SPECIAL_EXPONENT != exponent) & (digits >= 0) & (digits < CUTOFF);
+   int multiply = (SPECIAL_EXPONENT != exponent) & (digits >= CUTOFF) & ((digits < CUTOFF + 2) | ((CUTOFF + 2 == digits) & (significand <= (uint64_t)INT64_MAX / 1000U)));
+   uint64_t divisor = makeShift[divide ? (CUTOFF - digits) : 1];
+   uint64_t multiplier = makeShift[multiply ? (digits - (CUTOFF - 2)) : 1];
+   uint64_t magnitude = ((significand / divisor) * multiplier) & (0U - (uint64_t)(divide | multiply));
+   *result = (int64_t)((magnitude ^ (0U - sign)) + sign);
+   return ((divide | multiply) & (0U != significand % divisor)) | (!(divide | multiply) & !zero);
+ }
+
+static inline int dm_double_from_scaled_kernel(const int64_t* src, dm_double* dest, size_t count, int scale, int round_mode)
+ {
+   int slow = 0;
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      slow |= dm_double_from_scaled_fast(src[i], scale, dest + i);
+   if (slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+         if (dm_double_from_scaled_fast(src[i], scale, dest + i))
+            status |= dm_double_from_scaled_r(src[i], scale, round_mode, dest + i);
+    }
+   return status;
+ }
+
+static inline int dm_double_to_scaled_kernel(const dm_double* src, int64_t* dest, size_t count, int scale, int round_mode)
+ {
+   int slow = 0;
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+      slow |= dm_double_to_scaled_fast(src[i], scale, dest + i);
+   if (slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+         if (dm_double_to_scaled_fast(src[i], scale, dest + i))
+            status |= dm_double_to_scaled_r(src[i], scale, round_mode, dest + i);
+    }
+   return status;
+ }
+
+   // Cents, basis points, and satoshi-like units get kernels of their own, in which the scale is a constant.
+int dm_double_from_scaled_array(const int64_t* src, dm_double* dest, size_t count, int scale, int round_mode)
+ {
+   if (2 == scale)
+      return dm_double_from_scaled_kernel(src, dest, count, 2, round_mode);
+   if (4 == scale)
+      return dm_double_from_scaled_kernel(src, dest, count, 4, round_mode);
+   if (8 == scale)
+      return dm_double_from_scaled_kernel(src, dest, count, 8, round_mode);
+   if ((scale > -MIN_EXPONENT) || (scale < (CUTOFF - 1) - MAX_EXPONENT)) // Where the common case could leave the exponent range.
+    {
+      int status = DM_CONVERT_EXACT;
+      for (size_t i = 0U; i < count; ++i)
+         status |= dm_double_from_scaled_r(src[i], scale, round_mode, dest + i);
+      return status;
+    }
+   return dm_double_from_scaled_kernel(src, dest, count, scale, round_mode);
+ }
+
+int dm_double_to_scaled_array(const dm_double* src, int64_t* dest, size_t count, int scale, int round_mode)
+ {
+   if (2 == scale)
+      return dm_double_to_scaled_kernel(src, dest, count, 2, round_mode);
+   if (4 == scale)
+      return dm_double_to_scaled_kernel(src, dest, count, 4, round_mode);
+   if (8 == scale)
+      return dm_double_to_scaled_kernel(src, dest, count, 8, round_mode);
+   return dm_double_to_scaled_kernel(src, dest, count, scale, round_mode);
+ }
+
 #ifndef DM_NO_DOUBLE_MATH
 
 double dm_double_todouble(dm_double arg)
@@ -1483,11 +2099,15 @@ dm_double dm_double_fromlongdouble(long double arg)
 
       if (exponent > MAX_EXPONENT) // Can overflow in the dest
        {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
          significand = DM_INFINITY + MIN_SIGNIFICAND;
          exponent = SPECIAL_EXPONENT;
        }
       else if (exponent < MIN_EXPONENT)
        {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
          significand = MIN_SIGNIFICAND;
          exponent = SPECIAL_EXPONENT;
        }
@@ -55,14 +55,22 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
       the C++ types float or double would expect.
 */
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "dm_double_prefix.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef uint64_t dm_double;
 
+   // Where the fields are, for code that builds dm_doubles at compile time (see dm_double.hpp).
+#define DM_DOUBLE_EXPONENT_SHIFT 54
+#define DM_DOUBLE_EXPONENT_BIAS  0
+#define DM_DOUBLE_SIGN_MASK      0x20000000000000ULL
+
 
 int dm_double_fpclassify  (dm_double); // Returns FP_NORMAL for non-canonical numbers.
 int dm_double_iscanonical (dm_double); // Returns 0 for "trap representations"
@@ -104,6 +112,36 @@ int dm_fesetround  (int);
 int dm_fegetround  ();
 int dm_decideRound (int, int, int64_t, int, int);
 
+#ifdef DM_FENV_FLAGS
+   // Sticky per-thread status flags, like those of <fenv.h>.
+   // Build with DM_FENV_FLAGS defined to get them: without it, raising them compiles away.
+#define DM_FE_INVALID    0x01 // Inf - Inf, zero times Inf, 0 / 0, Inf / Inf, fmod(Inf, y), fmod(x, 0), sqrt(x < 0), log(x < 0), and pow(x < 0, non-integer)
+#define DM_FE_DIVBYZERO  0x02 // Finite non-zero divided by zero, log(0), and pow(0, y < 0)
+#define DM_FE_OVERFLOW   0x04 // Flushed to infinity
+#define DM_FE_UNDERFLOW  0x08 // Flushed to zero
+#define DM_FE_INEXACT    0x10 // Rounded
+#define DM_FE_ALL_EXCEPT 0x1F
+int dm_fetestexcept  (int); // Returns which of the given flags are set
+int dm_feclearexcept (int); // Returns zero
+int dm_feraiseexcept (int); // Returns zero
+#endif /* DM_FENV_FLAGS */
+
+#ifdef DM_STATS
+   // Per-thread counts of how often the slow and exceptional paths are taken.
+   // Build with DM_STATS defined to get them: without it, the counting compiles away.
+typedef struct dm_stats
+ {
+   uint64_t round_inexact;     // dm_decideRound called with a non-zero remainder
+   uint64_t round_increment;   // dm_decideRound decided to increment the significand
+   uint64_t flush_to_zero;
+   uint64_t flush_to_infinity;
+   uint64_t add_degenerate;    // dm_double_add_r with exponents more than CUTOFF + 1 apart
+   uint64_t fma_pathological;  // dm_double_fma needing every digit for cancellation
+ } dm_stats;
+void dm_stats_snapshot (dm_stats*); // Of the calling thread
+void dm_stats_reset    (void);
+#endif /* DM_STATS */
+
 dm_double dm_double_ceil      (dm_double); // DM_FE_UPWARD
 dm_double dm_double_floor     (dm_double); // DM_FE_DOWNWARD
 dm_double dm_double_trunc     (dm_double); // DM_FE_TOWARDZERO
@@ -115,9 +153,28 @@ dm_double dm_double_modf      (dm_double, dm_double*);
 dm_double dm_double_frexp     (dm_double, int*);       // This is BASE 10!
 dm_double dm_double_ldexp     (dm_double, int);        // This is BASE 10!
 
+int dm_double_digits         (dm_double); // Significant digits: 1 to 16, or 0 for zero, infinity, and NaN
+int dm_double_trailing_zeros (dm_double); // Zeros ending the sixteen digit significand: 0 to 15, or 0 as above
+
+dm_double dm_double_quantize_r     (dm_double, int, int); // Rounds to a multiple of 10 ^ exponent, in the given mode
+void      dm_double_quantize_array (const dm_double*, dm_double*, size_t, int, int); // May work in place
+
 dm_double dm_double_fmod (dm_double, dm_double);
 dm_double dm_double_fma  (dm_double, dm_double, dm_double);
 
+dm_double dm_double_sqrt   (dm_double);      // dm_fegetround()
+dm_double dm_double_sqrt_r (dm_double, int); // Correctly rounded
+
+   // dm_fegetround(), but not correctly rounded: see README.md for the error bound.
+dm_double dm_double_exp   (dm_double);
+dm_double dm_double_expm1 (dm_double); // exp(x) - 1
+dm_double dm_double_log   (dm_double);
+dm_double dm_double_log10 (dm_double); // Exact for powers of ten
+dm_double dm_double_log1p (dm_double); // log(1 + x)
+dm_double dm_double_pow   (dm_double, dm_double); // Integer powers as dm_double_powi_r
+
+dm_double dm_double_powi_r (dm_double, int64_t, int); // x ^ n, rounded once
+
 dm_double dm_double_neg   (dm_double);            // -x
 dm_double dm_double_add   (dm_double, dm_double); // x + y
 dm_double dm_double_sub   (dm_double, dm_double); // x - y
@@ -140,6 +197,31 @@ dm_double   dm_double_fromlongdouble (long double);
    #endif /* ! DM_NO_LONG_DOUBLE_MATH */
 #endif /* ! DM_NO_DOUBLE_MATH */
 
+   // Integer conversions. The _r forms round in the given mode, saturate, and return how it went.
+   // The array forms return the statuses of all the elements, or-ed together.
+#define DM_CONVERT_EXACT     0
+#define DM_CONVERT_INEXACT   1 // Rounded
+#define DM_CONVERT_SATURATED 2 // Out of range, including infinities: clamped to the nearest limit
+#define DM_CONVERT_INVALID   4 // NaN: converted to zero
+dm_double dm_double_fromint64        (int64_t);  // dm_fegetround()
+dm_double dm_double_fromuint64       (uint64_t); // dm_fegetround()
+int       dm_double_fromint64_r      (int64_t, int, dm_double*);
+int       dm_double_fromuint64_r     (uint64_t, int, dm_double*);
+int       dm_double_toint64_r        (dm_double, int, int64_t*);
+int       dm_double_touint64_r       (dm_double, int, uint64_t*);
+int       dm_double_fromint64_array  (const int64_t*, dm_double*, size_t, int);
+int       dm_double_fromuint64_array (const uint64_t*, dm_double*, size_t, int);
+int       dm_double_toint64_array    (const dm_double*, int64_t*, size_t, int);
+int       dm_double_touint64_array   (const dm_double*, uint64_t*, size_t, int);
+
+   // Fixed-point conversions, of an integer times 10 ^ -scale: int64_t cents are scale 2.
+   // The array forms have kernels of their own for scales 2, 4, and 8.
+dm_double dm_double_from_scaled       (int64_t, int); // dm_fegetround()
+int       dm_double_from_scaled_r     (int64_t, int, int, dm_double*);
+int       dm_double_to_scaled_r       (dm_double, int, int, int64_t*);
+int       dm_double_from_scaled_array (const int64_t*, dm_double*, size_t, int, int);
+int       dm_double_to_scaled_array   (const dm_double*, int64_t*, size_t, int, int);
+
 #ifdef __cplusplus
 }
 #endif
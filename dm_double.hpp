@@ -0,0 +1,783 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_HPP
+#define DM_DOUBLE_HPP
+
+/*
+   dm::decimal64 is a header-only C++ value class around dm_double.
+
+   It wraps whichever version of the library was included first: include
+   dm_double_m.h before this header to get the MISRA version, otherwise
+   dm_double.h is used. The arithmetic operators are done by the C functions,
+   and so use the current rounding mode.
+
+   add_r, sub_r, mul_r, div_r, fma_r, sqrt_r, and powi_r take the rounding
+   mode as an argument (DM_FE_TONEAREST by default), and are constexpr: they
+   use the same arithmetic core as the C library (dm_double_core.h), and so
+   give the same bits, whether at compile time or at run time. With C++20,
+   the arithmetic operators are constexpr too: in a constant expression they
+   round to nearest, the default rounding mode.
+
+   The arithmetic operators build expression templates, which are evaluated
+   when converted to decimal64. x * y + z and x * y - z are done by one
+   dm_double_fma, and so are rounded once. A chain of additions and
+   subtractions (a + b - c + d) is summed exactly, and rounded once. The
+   expressions hold copies of their operands, but are evaluated in the
+   rounding mode current at the conversion: so convert them, rather than
+   keeping them in auto variables.
+
+   The _dm literal (1.25_dm) is parsed by the compiler with the same digit,
+   residue, and rounding logic as dm_double_fromstring, in the default
+   rounding mode (DM_FE_TONEAREST). It is always evaluated at compile time:
+   with C++20 the operator is consteval, and before that it is a literal
+   operator template whose value is a constexpr variable template. So a
+   literal that isn't a decimal number (0x10_dm) fails the compile. Digit
+   separators (1'000.25_dm) are allowed.
+*/
+
+#include "dm_double.h"
+#include "dm_double_core.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#if defined(__cpp_consteval) && (__cpp_consteval >= 201811L)
+   #define DM_CONSTEVAL_LITERAL
+#endif
+
+#if defined(__cpp_lib_is_constant_evaluated) && (__cpp_lib_is_constant_evaluated >= 201811L)
+   #define DM_CONSTEXPR_OPERATORS
+   #define DM_CONSTEXPR20 constexpr
+#else
+   #define DM_CONSTEXPR20 inline
+#endif
+
+#ifdef DM_FENV_FLAGS
+   #define DM_CXX_RAISE(flags) (detail::constant_evaluated() ? 0 : dm_feraiseexcept(flags))
+#else
+   #define DM_CXX_RAISE(flags) ((void) 0)
+#endif
+
+namespace dm
+ {
+
+namespace detail
+ {
+   constexpr int16_t SPECIAL_EXPONENT = -512;
+   constexpr int16_t MAX_EXPONENT = 511;
+   constexpr int16_t MIN_EXPONENT = -MAX_EXPONENT;
+   constexpr uint64_t DM_INFINITY = 0x1FFFFFFFFFFFFFULL;
+   constexpr uint64_t NAN_PAYLOAD = 255U; // The payload of dm_double_NaN
+
+   constexpr uint64_t BIAS = DM_CORE_BIAS;
+   constexpr uint64_t MAX_SIGNIFICAND = DM_CORE_MAX_SIGNIFICAND;
+   constexpr uint64_t MIN_SIGNIFICAND = DM_CORE_MIN_SIGNIFICAND;
+   constexpr int16_t CUTOFF = DM_CORE_CUTOFF;
+
+   constexpr dm_double pack_alt(bool sign, int32_t exponent, uint64_t significand)
+    {
+      return (static_cast<uint64_t>(exponent + DM_DOUBLE_EXPONENT_BIAS) << DM_DOUBLE_EXPONENT_SHIFT) | significand | (sign ? DM_DOUBLE_SIGN_MASK : 0U);
+    }
+
+   constexpr dm_double pack(bool sign, int32_t exponent, uint64_t significand)
+    {
+      return pack_alt(sign, exponent, significand - MIN_SIGNIFICAND);
+    }
+
+      // The digit accumulation of dm_double_fromstring: the first sixteen significant digits are kept,
+      // and the rest are summarized as being below, at, or above half of the last kept digit.
+   struct digit_state
+    {
+      uint64_t significand = 0U;
+      int32_t exponent = -1;
+      int digits = 0;
+      bool hasResidue = false;
+      bool allZero = true;
+      bool realDigit = false;
+      int residue = 0;
+
+      constexpr void add(char digit)
+       {
+         if (digits < CUTOFF)
+          {
+            if (realDigit || ('0' != digit))
+             {
+               significand = significand * 10U + static_cast<uint64_t>(digit - '0');
+               ++digits;
+               realDigit = true;
+             }
+          }
+         else if (!hasResidue)
+          {
+            hasResidue = true;
+            if ('0' != digit)
+             {
+               allZero = false;
+               if (digit > '5')
+                  residue = -1;
+               else if (digit < '5')
+                  residue = 1;
+             }
+          }
+         else if ((0 == residue) && ('0' != digit))
+          {
+            residue = allZero ? 1 : -1;
+            allZero = false;
+          }
+       }
+    };
+
+   constexpr bool isdigit(char arg)
+    {
+      return (arg >= '0') && (arg <= '9');
+    }
+
+   constexpr dm_double fromstring(const char* arg, int round_mode)
+    {
+      digit_state state;
+      bool resultSign = false;
+
+      if ('-' == *arg)
+       {
+         resultSign = true;
+         ++arg;
+       }
+      for (; isdigit(*arg) || ('\'' == *arg); ++arg)
+       {
+         if ('\'' == *arg) continue;
+         state.add(*arg);
+         if (state.realDigit)
+            ++state.exponent;
+       }
+      if ('.' == *arg)
+       {
+         ++arg;
+       }
+      for (; isdigit(*arg) || ('\'' == *arg); ++arg)
+       {
+         if ('\'' == *arg) continue;
+         state.add(*arg);
+         if (!state.realDigit)
+            --state.exponent;
+       }
+
+      uint64_t resultSignificand = state.significand;
+      int32_t resultExponent = state.exponent;
+      for (int digits = state.digits; digits < CUTOFF; ++digits)
+       {
+         resultSignificand *= 10U;
+       }
+      int residue = state.allZero ? 1 : state.residue; // By the definition of the comp argument.
+      if (0 != dm_core_decideRound(resultSign, 1U & resultSignificand, residue, state.allZero, round_mode))
+       {
+         ++resultSignificand;
+       }
+      if (resultSignificand == BIAS)
+       {
+         resultSignificand = MIN_SIGNIFICAND;
+         ++resultExponent;
+       }
+
+      if ('e' == (*arg | ' '))
+       {
+         ++arg;
+         int32_t exponentSign = 1;
+         int32_t exponentValue = 0;
+         if ('-' == *arg)
+          {
+            exponentSign = -1;
+            ++arg;
+          }
+         if ('+' == *arg)
+          {
+            ++arg;
+          }
+         while (isdigit(*arg))
+          {
+            exponentValue = exponentValue * 10 + *arg - '0';
+            ++arg;
+            if (((exponentValue * exponentSign) > (2 * MAX_EXPONENT)) || ((exponentValue * exponentSign) < (2 * MIN_EXPONENT)))
+               break;
+          }
+         while (isdigit(*arg)) // The clamped digits still belong to the literal.
+          {
+            ++arg;
+          }
+         resultExponent += exponentValue * exponentSign;
+       }
+
+      if ('\0' != *arg)
+       {
+         throw "dm::decimal64 literals must be decimal numbers"; // Not a constant expression: fails the compile of a literal
+       }
+
+      if (0U == resultSignificand)
+         return pack_alt(resultSign, SPECIAL_EXPONENT, 0U);
+      if (resultExponent > MAX_EXPONENT) // Flush to infinity?
+         return pack_alt(resultSign, SPECIAL_EXPONENT, DM_INFINITY);
+      if (resultExponent < MIN_EXPONENT) // Flush to zero?
+         return pack_alt(resultSign, SPECIAL_EXPONENT, 0U);
+      return pack(resultSign, resultExponent, resultSignificand);
+    }
+
+      // Unpacking and classification for the compile-time arithmetic, in either layout.
+   constexpr int32_t unpack_exponent(dm_double arg)
+    {
+      int32_t field = static_cast<int32_t>((arg >> DM_DOUBLE_EXPONENT_SHIFT) & 1023U);
+      return (0 == DM_DOUBLE_EXPONENT_BIAS) ? ((field ^ 512) - 512) : (field - DM_DOUBLE_EXPONENT_BIAS); // Two's complement or biased
+    }
+
+   constexpr uint64_t unpack_raw(dm_double arg) { return arg & DM_INFINITY; }
+   constexpr bool signbit(dm_double arg) { return 0U != (arg & DM_DOUBLE_SIGN_MASK); }
+   constexpr bool isnormal(dm_double arg) { return SPECIAL_EXPONENT != unpack_exponent(arg); }
+   constexpr bool iszero(dm_double arg) { return !isnormal(arg) && (0U == unpack_raw(arg)); }
+   constexpr bool isinf(dm_double arg) { return !isnormal(arg) && (DM_INFINITY == unpack_raw(arg)); }
+   constexpr bool isnan(dm_double arg) { return !isnormal(arg) && !iszero(arg) && !isinf(arg); }
+
+   constexpr dm_double special(bool sign, uint64_t raw)
+    {
+      return pack_alt(sign, SPECIAL_EXPONENT, raw);
+    }
+
+   constexpr dm_core_number to_core(dm_double arg)
+    {
+      return dm_core_number { signbit(arg) ? 1 : 0, unpack_exponent(arg), unpack_raw(arg) + MIN_SIGNIFICAND };
+    }
+
+   constexpr dm_double from_core(dm_core_number arg)
+    {
+      if (0U == arg.significand) // An exact zero
+         return special(0 != arg.sign, 0U);
+      if (arg.exponent > MAX_EXPONENT) // Flush to infinity?
+         return special(0 != arg.sign, DM_INFINITY);
+      if (arg.exponent < MIN_EXPONENT) // Flush to zero?
+         return special(0 != arg.sign, 0U);
+      return pack(0 != arg.sign, arg.exponent, arg.significand);
+    }
+
+      // The special cases are those of dm_double_add_r, dm_double_mul_r, dm_double_div_r, dm_double_fma, dm_double_sqrt_r, and dm_double_powi_r;
+      // the rest is done by the arithmetic core.
+   constexpr dm_double add_r(dm_double lhs, dm_double rhs, int round_mode)
+    {
+      if (isnan(lhs)) return lhs; // Prefer lhs NaN's payload.
+      if (isnan(rhs)) return rhs;
+      if (isinf(lhs) && isinf(rhs))
+         return (signbit(lhs) != signbit(rhs)) ? special(false, NAN_PAYLOAD) : lhs; // Inf - Inf = NaN
+      if (isinf(lhs)) return lhs;
+      if (isinf(rhs)) return rhs;
+      if (iszero(lhs) && iszero(rhs))
+         return special((signbit(lhs) && signbit(rhs)) || ((signbit(lhs) != signbit(rhs)) && (DM_FE_DOWNWARD == round_mode)), 0U);
+      if (iszero(lhs)) return rhs;
+      if (iszero(rhs)) return lhs;
+
+      int events = 0;
+      return from_core(dm_core_add(to_core(lhs), to_core(rhs), round_mode, &events));
+    }
+
+   constexpr dm_double sub_r(dm_double lhs, dm_double rhs, int round_mode)
+    {
+      if (isnan(lhs)) return lhs;
+      if (isnan(rhs)) return rhs;
+      return add_r(lhs, rhs ^ DM_DOUBLE_SIGN_MASK, round_mode);
+    }
+
+   constexpr dm_double mul_r(dm_double lhs, dm_double rhs, int round_mode)
+    {
+      bool resultSign = signbit(lhs) != signbit(rhs);
+      if (isnan(lhs)) return lhs;
+      if (isnan(rhs)) return rhs;
+      if ((isinf(lhs) && iszero(rhs)) || (iszero(lhs) && isinf(rhs)))
+         return special(resultSign, NAN_PAYLOAD);
+      if (isinf(lhs) || isinf(rhs))
+         return special(resultSign, DM_INFINITY);
+      if (iszero(lhs) || iszero(rhs))
+         return special(resultSign, 0U);
+
+      int32_t resultExponent = unpack_exponent(lhs) + unpack_exponent(rhs);
+      if (resultExponent > MAX_EXPONENT)
+         return special(resultSign, DM_INFINITY);
+      if (resultExponent < (MIN_EXPONENT - 1)) // Minus one in case we can save the result from flushing to zero.
+         return special(resultSign, 0U);
+
+      int events = 0;
+      return from_core(dm_core_mul(to_core(lhs), to_core(rhs), round_mode, &events));
+    }
+
+   constexpr dm_double div_r(dm_double lhs, dm_double rhs, int round_mode)
+    {
+      bool resultSign = signbit(lhs) != signbit(rhs);
+      if (isnan(lhs)) return lhs;
+      if (isnan(rhs)) return rhs;
+      if ((iszero(lhs) && iszero(rhs)) || (isinf(lhs) && isinf(rhs)))
+         return special(resultSign, NAN_PAYLOAD);
+      if (isinf(lhs) || iszero(rhs))
+         return special(resultSign, DM_INFINITY);
+      if (iszero(lhs) || isinf(rhs))
+         return special(resultSign, 0U);
+
+      int32_t resultExponent = unpack_exponent(lhs) - unpack_exponent(rhs);
+      if (resultExponent > (MAX_EXPONENT + 1)) // Plus one in case we can save the result from flushing to infinity.
+         return special(resultSign, DM_INFINITY);
+      if (resultExponent < MIN_EXPONENT)
+         return special(resultSign, 0U);
+
+      int events = 0;
+      return from_core(dm_core_div(to_core(lhs), to_core(rhs), round_mode, &events));
+    }
+
+   constexpr dm_double fma_r(dm_double lhs, dm_double rhs, dm_double ths, int round_mode)
+    {
+      if (!(isnormal(lhs) && isnormal(rhs) && isnormal(ths)))
+         return add_r(mul_r(lhs, rhs, round_mode), ths, round_mode);
+
+      int events = 0;
+      return from_core(dm_core_fma(to_core(lhs), to_core(rhs), to_core(ths), round_mode, &events));
+    }
+
+   constexpr dm_double sqrt_r(dm_double arg, int round_mode)
+    {
+      if (isnan(arg) || iszero(arg)) return arg; // sqrt(-0) = -0
+      if (signbit(arg)) return special(false, NAN_PAYLOAD);
+      if (isinf(arg)) return arg;
+
+      int events = 0;
+      return from_core(dm_core_sqrt(to_core(arg), round_mode, &events));
+    }
+
+   constexpr dm_double powi_r(dm_double base, int64_t n, int round_mode)
+    {
+      bool resultSign = signbit(base) && (0 != (n & 1));
+      if (0 == n) return pack(false, 0, MIN_SIGNIFICAND); // Even for NaN, as pow(x, 0)
+      if (isnan(base)) return base;
+      if (iszero(base)) return special(resultSign, (n > 0) ? 0U : DM_INFINITY);
+      if (isinf(base)) return special(resultSign, (n > 0) ? DM_INFINITY : 0U);
+
+      int events = 0;
+      return from_core(dm_core_powi(to_core(base), n, round_mode, &events));
+    }
+
+   DM_CONSTEXPR20 bool constant_evaluated()
+    {
+#ifdef DM_CONSTEXPR_OPERATORS
+      return std::is_constant_evaluated();
+#else
+      return false;
+#endif
+    }
+
+      // The C functions at run time, and the compile-time arithmetic in a constant expression.
+   DM_CONSTEXPR20 dm_double add(dm_double lhs, dm_double rhs) { return constant_evaluated() ? add_r(lhs, rhs, DM_FE_TONEAREST) : dm_double_add(lhs, rhs); }
+   DM_CONSTEXPR20 dm_double sub(dm_double lhs, dm_double rhs) { return constant_evaluated() ? sub_r(lhs, rhs, DM_FE_TONEAREST) : dm_double_sub(lhs, rhs); }
+   DM_CONSTEXPR20 dm_double mul(dm_double lhs, dm_double rhs) { return constant_evaluated() ? mul_r(lhs, rhs, DM_FE_TONEAREST) : dm_double_mul(lhs, rhs); }
+   DM_CONSTEXPR20 dm_double div(dm_double lhs, dm_double rhs) { return constant_evaluated() ? div_r(lhs, rhs, DM_FE_TONEAREST) : dm_double_div(lhs, rhs); }
+   DM_CONSTEXPR20 dm_double fma(dm_double lhs, dm_double rhs, dm_double ths) { return constant_evaluated() ? fma_r(lhs, rhs, ths, DM_FE_TONEAREST) : dm_double_fma(lhs, rhs, ths); }
+   DM_CONSTEXPR20 int round_mode() { return constant_evaluated() ? DM_FE_TONEAREST : dm_fegetround(); }
+
+      // Subtraction doesn't change the sign of a NaN.
+   constexpr dm_double negate(dm_double arg) { return isnan(arg) ? arg : (arg ^ DM_DOUBLE_SIGN_MASK); }
+
+      // An exact sum of any number of values, rounded once. The base 10 ^ 9 limbs cover every digit position
+      // from the least significant digit of min() to the most significant digit of max(), with room for carries.
+   class accumulator
+    {
+   public:
+      DM_CONSTEXPR20 void add(dm_double arg)
+       {
+         if (isnan(arg))
+          {
+            if (!isnan(specialValue)) // The first NaN wins, as it would adding from left to right.
+               specialValue = arg;
+          }
+         else if (isinf(arg))
+          {
+            if (isinf(specialValue) && (signbit(specialValue) != signbit(arg))) // Inf - Inf = NaN
+               specialValue = special(false, NAN_PAYLOAD);
+            else if (!isnan(specialValue))
+               specialValue = arg;
+          }
+         else if (iszero(arg))
+          {
+            if (signbit(arg))
+               negativeZero = true;
+            else
+               positiveZero = true;
+          }
+         else
+          {
+            int32_t position = unpack_exponent(arg) - MIN_EXPONENT; // Of the least significant digit
+            int index = position / DIGITS;
+            uint64_t shift = dm_core_makeShift[(position % DIGITS) + 1];
+            uint64_t significand = unpack_raw(arg) + MIN_SIGNIFICAND;
+            uint64_t low = (significand % LIMB) * shift;
+            uint64_t high = (significand / LIMB) * shift;
+            int64_t sign = signbit(arg) ? -1 : 1;
+            limbs[index] += sign * static_cast<int64_t>(low % LIMB);
+            limbs[index + 1] += sign * static_cast<int64_t>((low / LIMB) + (high % LIMB));
+            limbs[index + 2] += sign * static_cast<int64_t>(high / LIMB);
+            if (index < lowest)
+               lowest = index;
+            if ((index + 2) > highest)
+               highest = index + 2;
+          }
+       }
+
+      DM_CONSTEXPR20 dm_double round(int round_mode)
+       {
+         if (isnan(specialValue) || isinf(specialValue))
+            return specialValue;
+
+         bool resultSign = false;
+         int top = lowest - 1;
+         if (highest >= 0)
+          {
+            top = highest + 2; // A carry can't get further, with fewer than 10 ^ 8 terms.
+            carry(top);
+            if (limbs[top] < 0)
+             {
+               resultSign = true;
+               for (int i = lowest; i <= top; ++i)
+                  limbs[i] = -limbs[i];
+               carry(top);
+             }
+            while ((top >= lowest) && (0 == limbs[top]))
+               --top;
+          }
+
+         if (top < lowest) // An exact zero: with the signs of a left to right addition
+          {
+            if (highest >= 0)
+               resultSign = DM_FE_DOWNWARD == round_mode;
+            else
+               resultSign = negativeZero && (!positiveZero || (DM_FE_DOWNWARD == round_mode));
+            return special(resultSign, 0U);
+          }
+
+            // The first CUTOFF digits are the significand, then a rounding digit, and whether anything else is non-zero.
+         int digits = 1;
+         while (limbs[top] >= static_cast<int64_t>(dm_core_makeShift[digits + 1]))
+            ++digits;
+         int32_t resultExponent = (DIGITS * top) + (digits - 1) + MIN_EXPONENT - (CUTOFF - 1);
+         uint64_t resultSignificand = 0U;
+         int taken = 0;
+         int roundDigit = 0;
+         bool sticky = false;
+         for (int i = top; i >= lowest; --i)
+          {
+            if (taken > CUTOFF)
+             {
+               sticky = sticky || (0 != limbs[i]);
+               continue;
+             }
+            for (int k = ((i == top) ? digits : DIGITS) - 1; k >= 0; --k)
+             {
+               int digit = static_cast<int>((limbs[i] / static_cast<int64_t>(dm_core_makeShift[k + 1])) % 10);
+               if (taken < CUTOFF)
+                  resultSignificand = resultSignificand * 10U + static_cast<uint64_t>(digit);
+               else if (taken == CUTOFF)
+                  roundDigit = digit;
+               else
+                  sticky = sticky || (0 != digit);
+               ++taken;
+             }
+          }
+         for (; taken < CUTOFF; ++taken)
+            resultSignificand *= 10U;
+
+         bool exact = (0 == roundDigit) && !sticky;
+         int64_t comp = ((roundDigit > 5) || ((5 == roundDigit) && sticky)) ? -1 : ((5 == roundDigit) ? 0 : 1);
+         if (!exact)
+            DM_CXX_RAISE(DM_FE_INEXACT);
+         if (0 != dm_core_decideRound(resultSign, 1U & resultSignificand, comp, exact, round_mode))
+            ++resultSignificand;
+         if (resultSignificand == BIAS)
+          {
+            resultSignificand = MIN_SIGNIFICAND;
+            ++resultExponent;
+          }
+
+         if (resultExponent > MAX_EXPONENT) // Flush to infinity?
+          {
+            DM_CXX_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+            return special(resultSign, DM_INFINITY);
+          }
+         if (resultExponent < MIN_EXPONENT) // Flush to zero?
+          {
+            DM_CXX_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+            return special(resultSign, 0U);
+          }
+         return pack(resultSign, resultExponent, resultSignificand);
+       }
+
+   private:
+      static constexpr int DIGITS = 9;
+      static constexpr uint64_t LIMB = 1000000000U;
+      static constexpr int LIMBS = 120; // (MAX_EXPONENT - MIN_EXPONENT + CUTOFF) / DIGITS, with three to spare
+
+         // Leaves every limb below top from zero to LIMB - 1, and top with the sign of the sum.
+      DM_CONSTEXPR20 void carry(int top)
+       {
+         for (int i = lowest; i < top; ++i)
+          {
+            int64_t quotient = limbs[i] / static_cast<int64_t>(LIMB);
+            if ((limbs[i] % static_cast<int64_t>(LIMB)) < 0)
+               --quotient;
+            limbs[i] -= quotient * static_cast<int64_t>(LIMB);
+            limbs[i + 1] += quotient;
+          }
+       }
+
+      int64_t limbs [LIMBS] = { };
+      int lowest = LIMBS;
+      int highest = -1;
+      dm_double specialValue = special(false, 0U); // Zero when there are no NaNs or infinities
+      bool positiveZero = false;
+      bool negativeZero = false;
+    };
+ } // namespace detail
+
+class decimal64
+ {
+public:
+   constexpr decimal64() noexcept : value(detail::pack_alt(false, detail::SPECIAL_EXPONENT, 0U)) { } // Zero
+   explicit decimal64(const char* arg) : value(dm_double_fromstring(arg)) { }
+   explicit decimal64(const std::string& arg) : value(dm_double_fromstring(arg.c_str())) { }
+#ifndef DM_NO_DOUBLE_MATH
+   explicit decimal64(double arg) : value(dm_double_fromdouble(arg)) { }
+   explicit operator double() const { return dm_double_todouble(value); }
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+   static constexpr decimal64 from_bits(dm_double bits) noexcept
+    {
+      decimal64 result;
+      result.value = bits;
+      return result;
+    }
+   constexpr dm_double bits() const noexcept { return value; }
+
+   DM_CONSTEXPR20 decimal64& operator+= (decimal64 rhs) { value = detail::add(value, rhs.value); return *this; }
+   DM_CONSTEXPR20 decimal64& operator-= (decimal64 rhs) { value = detail::sub(value, rhs.value); return *this; }
+   DM_CONSTEXPR20 decimal64& operator*= (decimal64 rhs) { value = detail::mul(value, rhs.value); return *this; }
+   DM_CONSTEXPR20 decimal64& operator/= (decimal64 rhs) { value = detail::div(value, rhs.value); return *this; }
+
+private:
+   dm_double value;
+ };
+
+constexpr decimal64 operator+ (decimal64 arg) noexcept { return arg; }
+constexpr decimal64 operator- (decimal64 arg) noexcept { return decimal64::from_bits(arg.bits() ^ DM_DOUBLE_SIGN_MASK); }
+
+   // The same results as the C functions, which the compiler can evaluate.
+constexpr decimal64 add_r (decimal64 lhs, decimal64 rhs, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::add_r(lhs.bits(), rhs.bits(), round_mode)); }
+constexpr decimal64 sub_r (decimal64 lhs, decimal64 rhs, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::sub_r(lhs.bits(), rhs.bits(), round_mode)); }
+constexpr decimal64 mul_r (decimal64 lhs, decimal64 rhs, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::mul_r(lhs.bits(), rhs.bits(), round_mode)); }
+constexpr decimal64 div_r (decimal64 lhs, decimal64 rhs, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::div_r(lhs.bits(), rhs.bits(), round_mode)); }
+constexpr decimal64 fma_r (decimal64 lhs, decimal64 rhs, decimal64 ths, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::fma_r(lhs.bits(), rhs.bits(), ths.bits(), round_mode)); }
+constexpr decimal64 sqrt_r (decimal64 arg, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::sqrt_r(arg.bits(), round_mode)); }
+constexpr decimal64 powi_r (decimal64 base, int64_t n, int round_mode = DM_FE_TONEAREST) { return decimal64::from_bits(detail::powi_r(base.bits(), n, round_mode)); }
+
+   // x * y, until it is known whether something is added to it.
+struct product_expression
+ {
+   decimal64 lhs;
+   decimal64 rhs;
+
+   DM_CONSTEXPR20 operator decimal64() const { return decimal64::from_bits(detail::mul(lhs.bits(), rhs.bits())); }
+ };
+
+   // The terms of a chain of additions and subtractions, with the subtracted ones negated.
+template <std::size_t N>
+struct sum_expression
+ {
+   dm_double term [N];
+
+   DM_CONSTEXPR20 operator decimal64() const
+    {
+      if (2U == N) // The C function is already correctly rounded.
+         return decimal64::from_bits(detail::add(term[0], term[N - 1U]));
+      detail::accumulator total;
+      for (std::size_t i = 0U; i < N; ++i)
+         total.add(term[i]);
+      return decimal64::from_bits(total.round(detail::round_mode()));
+    }
+ };
+
+namespace detail
+ {
+   constexpr sum_expression<1> term(decimal64 arg)
+    {
+      return sum_expression<1> { { arg.bits() } };
+    }
+
+   template <std::size_t N, std::size_t M>
+   DM_CONSTEXPR20 sum_expression<N + M> join(const sum_expression<N>& lhs, const sum_expression<M>& rhs, bool negated)
+    {
+      sum_expression<N + M> result = { };
+      for (std::size_t i = 0U; i < N; ++i)
+         result.term[i] = lhs.term[i];
+      for (std::size_t i = 0U; i < M; ++i)
+         result.term[N + i] = negated ? negate(rhs.term[i]) : rhs.term[i];
+      return result;
+    }
+ } // namespace detail
+
+DM_CONSTEXPR20 product_expression operator* (decimal64 lhs, decimal64 rhs) { return product_expression { lhs, rhs }; }
+DM_CONSTEXPR20 decimal64 operator/ (decimal64 lhs, decimal64 rhs) { return lhs /= rhs; }
+
+   // x * y + z and x * y - z, in one rounding.
+DM_CONSTEXPR20 decimal64 operator+ (const product_expression& lhs, decimal64 rhs) { return decimal64::from_bits(detail::fma(lhs.lhs.bits(), lhs.rhs.bits(), rhs.bits())); }
+DM_CONSTEXPR20 decimal64 operator+ (decimal64 lhs, const product_expression& rhs) { return rhs + lhs; }
+DM_CONSTEXPR20 decimal64 operator+ (const product_expression& lhs, const product_expression& rhs) { return lhs + static_cast<decimal64>(rhs); }
+DM_CONSTEXPR20 decimal64 operator- (const product_expression& lhs, decimal64 rhs) { return lhs + decimal64::from_bits(detail::negate(rhs.bits())); }
+DM_CONSTEXPR20 decimal64 operator- (decimal64 lhs, const product_expression& rhs) { return product_expression { decimal64::from_bits(detail::negate(rhs.lhs.bits())), rhs.rhs } + lhs; }
+DM_CONSTEXPR20 decimal64 operator- (const product_expression& lhs, const product_expression& rhs) { return lhs - static_cast<decimal64>(rhs); }
+DM_CONSTEXPR20 decimal64& operator+= (decimal64& lhs, const product_expression& rhs) { return lhs = lhs + rhs; }
+DM_CONSTEXPR20 decimal64& operator-= (decimal64& lhs, const product_expression& rhs) { return lhs = lhs - rhs; }
+
+   // Chains of additions and subtractions, in one rounding: a product in a chain is rounded on its own.
+DM_CONSTEXPR20 sum_expression<2> operator+ (decimal64 lhs, decimal64 rhs) { return detail::join(detail::term(lhs), detail::term(rhs), false); }
+DM_CONSTEXPR20 sum_expression<2> operator- (decimal64 lhs, decimal64 rhs) { return detail::join(detail::term(lhs), detail::term(rhs), true); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator+ (const sum_expression<N>& lhs, decimal64 rhs) { return detail::join(lhs, detail::term(rhs), false); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator- (const sum_expression<N>& lhs, decimal64 rhs) { return detail::join(lhs, detail::term(rhs), true); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator+ (decimal64 lhs, const sum_expression<N>& rhs) { return detail::join(detail::term(lhs), rhs, false); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator- (decimal64 lhs, const sum_expression<N>& rhs) { return detail::join(detail::term(lhs), rhs, true); }
+template <std::size_t N, std::size_t M> DM_CONSTEXPR20 sum_expression<N + M> operator+ (const sum_expression<N>& lhs, const sum_expression<M>& rhs) { return detail::join(lhs, rhs, false); }
+template <std::size_t N, std::size_t M> DM_CONSTEXPR20 sum_expression<N + M> operator- (const sum_expression<N>& lhs, const sum_expression<M>& rhs) { return detail::join(lhs, rhs, true); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator+ (const sum_expression<N>& lhs, const product_expression& rhs) { return lhs + static_cast<decimal64>(rhs); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator- (const sum_expression<N>& lhs, const product_expression& rhs) { return lhs - static_cast<decimal64>(rhs); }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator+ (const product_expression& lhs, const sum_expression<N>& rhs) { return static_cast<decimal64>(lhs) + rhs; }
+template <std::size_t N> DM_CONSTEXPR20 sum_expression<N + 1> operator- (const product_expression& lhs, const sum_expression<N>& rhs) { return static_cast<decimal64>(lhs) - rhs; }
+
+   // NaNs are unordered, just as with double.
+inline bool operator== (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_isequal(lhs.bits(), rhs.bits()); }
+inline bool operator!= (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_isunequal(lhs.bits(), rhs.bits()); }
+inline bool operator<  (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_isless(lhs.bits(), rhs.bits()); }
+inline bool operator<= (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_islessequal(lhs.bits(), rhs.bits()); }
+inline bool operator>  (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_isgreater(lhs.bits(), rhs.bits()); }
+inline bool operator>= (decimal64 lhs, decimal64 rhs) { return 0 != dm_double_isgreaterequal(lhs.bits(), rhs.bits()); }
+
+inline bool isnan    (decimal64 arg) { return 0 != dm_double_isnan(arg.bits()); }
+inline bool isinf    (decimal64 arg) { return 0 != dm_double_isinf(arg.bits()); }
+inline bool isfinite (decimal64 arg) { return 0 != dm_double_isfinite(arg.bits()); }
+inline bool signbit  (decimal64 arg) { return 0 != dm_double_signbit(arg.bits()); }
+
+inline decimal64 fabs (decimal64 arg) { return decimal64::from_bits(dm_double_fabs(arg.bits())); }
+inline decimal64 fmod (decimal64 lhs, decimal64 rhs) { return decimal64::from_bits(dm_double_fmod(lhs.bits(), rhs.bits())); }
+inline decimal64 fma  (decimal64 lhs, decimal64 rhs, decimal64 ths) { return decimal64::from_bits(dm_double_fma(lhs.bits(), rhs.bits(), ths.bits())); }
+inline decimal64 sqrt (decimal64 arg) { return decimal64::from_bits(dm_double_sqrt(arg.bits())); }
+inline decimal64 exp  (decimal64 arg) { return decimal64::from_bits(dm_double_exp(arg.bits())); }
+inline decimal64 expm1 (decimal64 arg) { return decimal64::from_bits(dm_double_expm1(arg.bits())); }
+inline decimal64 log  (decimal64 arg) { return decimal64::from_bits(dm_double_log(arg.bits())); }
+inline decimal64 log10 (decimal64 arg) { return decimal64::from_bits(dm_double_log10(arg.bits())); }
+inline decimal64 log1p (decimal64 arg) { return decimal64::from_bits(dm_double_log1p(arg.bits())); }
+inline decimal64 pow  (decimal64 lhs, decimal64 rhs) { return decimal64::from_bits(dm_double_pow(lhs.bits(), rhs.bits())); }
+
+inline std::string to_string(decimal64 arg)
+ {
+   char buffer [25]; // Big enough for either version
+   dm_double_tostring(arg.bits(), buffer);
+   return buffer;
+ }
+
+#ifndef DM_CONSTEVAL_LITERAL
+namespace detail
+ {
+      // Initializing a constexpr variable is a constant expression, even where the literal is used at run time.
+   template <char... chars> constexpr char literal_text [] = { chars..., '\0' };
+   template <char... chars> constexpr dm_double literal_bits = fromstring(literal_text<chars...>, DM_FE_TONEAREST);
+ } // namespace detail
+#endif /* ! DM_CONSTEVAL_LITERAL */
+
+inline namespace literals
+ {
+#ifdef DM_CONSTEVAL_LITERAL
+   consteval decimal64 operator""_dm (const char* arg)
+    {
+      return decimal64::from_bits(detail::fromstring(arg, DM_FE_TONEAREST));
+    }
+#else
+   template <char... chars> constexpr decimal64 operator""_dm ()
+    {
+      return decimal64::from_bits(detail::literal_bits<chars...>);
+    }
+#endif /* DM_CONSTEVAL_LITERAL */
+ } // namespace literals
+
+ } // namespace dm
+
+namespace std
+ {
+
+template <>
+class numeric_limits<dm::decimal64>
+ {
+public:
+   static constexpr bool is_specialized = true;
+   static constexpr bool is_signed = true;
+   static constexpr bool is_integer = false;
+   static constexpr bool is_exact = false;
+   static constexpr bool has_infinity = true;
+   static constexpr bool has_quiet_NaN = true;
+   static constexpr bool has_signaling_NaN = false;
+   static constexpr std::float_denorm_style has_denorm = std::denorm_absent; // Flushes to zero instead
+   static constexpr bool has_denorm_loss = false;
+   static constexpr std::float_round_style round_style = std::round_to_nearest; // Of the default rounding mode
+   static constexpr bool is_iec559 = false;
+   static constexpr bool is_bounded = true;
+   static constexpr bool is_modulo = false;
+   static constexpr int digits = 16;
+   static constexpr int digits10 = 16;
+   static constexpr int max_digits10 = 16;
+   static constexpr int radix = 10;
+   static constexpr int min_exponent = dm::detail::MIN_EXPONENT + 1;
+   static constexpr int min_exponent10 = dm::detail::MIN_EXPONENT;
+   static constexpr int max_exponent = dm::detail::MAX_EXPONENT + 1;
+   static constexpr int max_exponent10 = dm::detail::MAX_EXPONENT;
+   static constexpr bool traps = false;
+   static constexpr bool tinyness_before = false;
+
+   static constexpr dm::decimal64 min() noexcept { return dm::decimal64::from_bits(dm::detail::pack(false, dm::detail::MIN_EXPONENT, dm::detail::MIN_SIGNIFICAND)); }
+   static constexpr dm::decimal64 max() noexcept { return dm::decimal64::from_bits(dm::detail::pack(false, dm::detail::MAX_EXPONENT, dm::detail::MAX_SIGNIFICAND)); }
+   static constexpr dm::decimal64 lowest() noexcept { return -max(); }
+   static constexpr dm::decimal64 epsilon() noexcept { return dm::decimal64::from_bits(dm::detail::pack(false, 1 - dm::detail::CUTOFF, dm::detail::MIN_SIGNIFICAND)); }
+   static constexpr dm::decimal64 round_error() noexcept { return dm::decimal64::from_bits(dm::detail::pack(false, -1, 5U * dm::detail::MIN_SIGNIFICAND)); }
+   static constexpr dm::decimal64 infinity() noexcept { return dm::decimal64::from_bits(dm::detail::pack_alt(false, dm::detail::SPECIAL_EXPONENT, dm::detail::DM_INFINITY)); }
+   static constexpr dm::decimal64 quiet_NaN() noexcept { return dm::decimal64::from_bits(dm::detail::pack_alt(false, dm::detail::SPECIAL_EXPONENT, dm::detail::NAN_PAYLOAD)); }
+   static constexpr dm::decimal64 signaling_NaN() noexcept { return quiet_NaN(); }
+   static constexpr dm::decimal64 denorm_min() noexcept { return min(); }
+ };
+
+ } // namespace std
+
+#endif /* DM_DOUBLE_HPP */
@@ -0,0 +1,706 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef DM_NO_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif /* ! DM_NO_THREADS */
+
+#include "dm_double_prefix.h"
+
+   /* ABI compatible defines. */
+typedef uint64_t dm_double;
+
+dm_double dm_double_add_r    (dm_double, dm_double, int);
+dm_double dm_double_exp      (dm_double);
+dm_double dm_double_expm1    (dm_double);
+dm_double dm_double_log      (dm_double);
+dm_double dm_double_log10    (dm_double);
+dm_double dm_double_log1p    (dm_double);
+dm_double dm_double_pow      (dm_double, dm_double);
+int       dm_double_isfinite   (dm_double);
+int       dm_double_isnan      (dm_double);
+int       dm_double_iszero     (dm_double);
+int       dm_double_signbit    (dm_double);
+dm_double dm_double_neg        (dm_double);
+dm_double dm_double_frexp      (dm_double, int*);
+int       dm_double_to_scaled_r   (dm_double, int, int, int64_t*);
+int       dm_double_from_scaled_r (int64_t, int, int, dm_double*);
+#define DM_FE_DOWNWARD   3
+#define DM_FE_TOWARDZERO 4
+#ifdef DM_FENV_FLAGS
+#define DM_FE_ALL_EXCEPT 0x1F
+int dm_fetestexcept  (int);
+int dm_feraiseexcept (int);
+#endif /* DM_FENV_FLAGS */
+
+#include "dm_double_batch.h"
+#include "dm_double_kernels.h"
+
+   // The kernels in use. The table carries its level, so that one pointer publishes both.
+static _Atomic(const struct dm_batch_kernels *) dm_batch_active = NULL;
+static atomic_int dm_batch_threads = 0; // Zero until the first scan asks how many processors there are
+
+   // The best level whose extensions (see dm_double_kernels.h) the CPU has.
+static int dm_batch_hardwareLevel(void)
+ {
+   int result = DM_ISA_SCALAR;
+#ifdef DM_KERNELS_X86
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+    {
+      result = DM_ISA_SSE42;
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("lzcnt"))
+       {
+         result = DM_ISA_AVX2;
+         if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+          {
+            result = DM_ISA_AVX512;
+          }
+       }
+    }
+#endif /* DM_KERNELS_X86 */
+   return result;
+ }
+
+   // The environment variable can only lower the level: asking for an instruction set we don't have would be a crash.
+   // A name that isn't one of the four is ignored, as dm_double_batch.h says.
+static int dm_batch_environmentLevel(int level)
+ {
+   const char * name = getenv("DM_DOUBLE_ISA");
+   int result = level;
+   if (NULL != name)
+    {
+      if (0 == strcmp(name, "scalar")) result = DM_ISA_SCALAR;
+      else if (0 == strcmp(name, "sse4.2")) result = DM_ISA_SSE42;
+      else if (0 == strcmp(name, "avx2")) result = DM_ISA_AVX2;
+      else if (0 == strcmp(name, "avx512")) result = DM_ISA_AVX512;
+    }
+   if (result > level)
+      result = level;
+   return result;
+ }
+
+   // The first call selects the kernels. Threads that race here agree on the table, unless dm_double_batch_setisa
+   // got in first, and then they take its choice.
+static const struct dm_batch_kernels * dm_batch_get(void)
+ {
+   const struct dm_batch_kernels * result = atomic_load(&dm_batch_active);
+   if (NULL == result)
+    {
+      const struct dm_batch_kernels * expected = NULL;
+      result = dm_double_batch_kernels(dm_batch_environmentLevel(dm_batch_hardwareLevel()));
+      if (!atomic_compare_exchange_strong(&dm_batch_active, &expected, result))
+         result = expected;
+    }
+   return result;
+ }
+
+int dm_double_batch_getisa(void)
+ {
+   return dm_batch_get()->level;
+ }
+
+int dm_double_batch_setisa(int level)
+ {
+   int hardware = dm_batch_hardwareLevel();
+   const struct dm_batch_kernels * kernels;
+   if (level < DM_ISA_SCALAR) level = DM_ISA_SCALAR;
+   if (level > hardware) level = hardware;
+   kernels = dm_double_batch_kernels(level);
+   atomic_store(&dm_batch_active, kernels);
+   return kernels->level;
+ }
+
+void dm_double_add_array(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count, int round_mode)
+ {
+   dm_batch_get()->add(lhs, rhs, dest, count, round_mode);
+ }
+
+void dm_double_sub_array(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count, int round_mode)
+ {
+   dm_batch_get()->sub(lhs, rhs, dest, count, round_mode);
+ }
+
+void dm_double_mul_array(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count, int round_mode)
+ {
+   dm_batch_get()->mul(lhs, rhs, dest, count, round_mode);
+ }
+
+void dm_double_div_array(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count, int round_mode)
+ {
+   dm_batch_get()->div(lhs, rhs, dest, count, round_mode);
+ }
+
+void dm_double_sqrt_array(const dm_double* src, dm_double* dest, size_t count, int round_mode)
+ {
+   dm_batch_get()->sqrt(src, dest, count, round_mode);
+ }
+
+void dm_double_fma_array(const dm_double* lhs, const dm_double* rhs, const dm_double* ths, dm_double* dest, size_t count)
+ {
+   dm_batch_get()->fma(lhs, rhs, ths, dest, count);
+ }
+
+   // The transcendental functions aren't built for each level (see dm_double_kernels.h).
+void dm_double_exp_array(const dm_double* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_exp(src[i]);
+ }
+
+void dm_double_expm1_array(const dm_double* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_expm1(src[i]);
+ }
+
+void dm_double_log_array(const dm_double* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_log(src[i]);
+ }
+
+void dm_double_log10_array(const dm_double* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_log10(src[i]);
+ }
+
+void dm_double_log1p_array(const dm_double* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_log1p(src[i]);
+ }
+
+void dm_double_pow_array(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+      dest[i] = dm_double_pow(lhs[i], rhs[i]);
+ }
+
+void dm_double_isless_array(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count)
+ {
+   dm_batch_get()->isless(lhs, rhs, dest, count);
+ }
+
+void dm_double_islessequal_array(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count)
+ {
+   dm_batch_get()->islessequal(lhs, rhs, dest, count);
+ }
+
+void dm_double_isgreater_array(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count)
+ {
+   dm_batch_get()->isgreater(lhs, rhs, dest, count);
+ }
+
+void dm_double_isgreaterequal_array(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count)
+ {
+   dm_batch_get()->isgreaterequal(lhs, rhs, dest, count);
+ }
+
+void dm_double_isequal_array(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count)
+ {
+   dm_batch_get()->isequal(lhs, rhs, dest, count);
+ }
+
+void dm_double_fromstring_array(const char * const * src, dm_double* dest, size_t count)
+ {
+   dm_batch_get()->fromstring(src, dest, count);
+ }
+
+#ifndef DM_NO_DOUBLE_MATH
+void dm_double_todouble_array(const dm_double* src, double* dest, size_t count)
+ {
+   dm_batch_get()->todouble(src, dest, count);
+ }
+
+void dm_double_fromdouble_array(const double* src, dm_double* dest, size_t count)
+ {
+   dm_batch_get()->fromdouble(src, dest, count);
+ }
+
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+
+/*
+   Running sums.
+
+   DM_SCAN_SERIAL is the loop that everyone writes: each sum is the previous one plus the next
+   element, rounded. Every result depends on the rounding of the one before it, so there is
+   nothing to hand to another thread.
+
+   DM_SCAN_EXACT carries the running sum exactly, and rounds each prefix from it once. The exact
+   sum is in limbs of eighteen digits, enough for any finite dm_double and twenty more digits of
+   growth, in ten's complement: adding a term touches two limbs and whatever the carry reaches. The
+   limbs that are zero at the bottom, or sign fill at the top, aren't stored, so that a sum of
+   amounts only keeps a few limbs. Because every prefix is exact before it is rounded, a block of
+   the array can start from the exact sum of the blocks before it: the first pass sums the blocks
+   on their own threads, and the second pass scans them from those offsets. The results don't
+   depend on how the array was split.
+
+   The sums only go through the public interface (frexp, to_scaled_r, and from_scaled_r), so this
+   works for either layout.
+*/
+
+#define DM_SCAN_LIMBS     60                    // Of eighteen digits each
+#define DM_SCAN_LOWEST    (-540)                // The power of ten of the lowest digit of the lowest limb
+#define DM_SCAN_BASE      1000000000000000000LL // 10 ^ 18
+#define DM_SCAN_MIN_BLOCK 16384                 // Fewer elements per thread aren't worth starting one for
+#define DM_SCAN_NONE      SIZE_MAX              // The position of a special value that hasn't been seen
+
+static const int64_t dm_scan_pow10 [19] =
+ {
+   1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+   10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+   1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+ };
+
+struct dm_scan_sum
+ {
+   int64_t limb [DM_SCAN_LIMBS]; // Each from 0 to DM_SCAN_BASE - 1. Only those from low to high are stored.
+   int low;                      // The limbs below are zero.
+   int high;                     // The limbs above are the fill: DM_SCAN_BASE - 1 if negative, else zero.
+   int negative;
+   int negativeZeros;            // Every term was -0, or every one +0, so that an exact zero keeps the sign.
+   int positiveZeros;
+   size_t nanAt;                 // The positions of the first NaN and infinities, which decide the special results
+   size_t positiveAt;
+   size_t negativeAt;
+   dm_double nan;
+   dm_double positiveInf;
+   dm_double negativeInf;
+ };
+
+static void dm_scan_init(struct dm_scan_sum* sum)
+ {
+   sum->low = 0;
+   sum->high = 0;
+   sum->limb[0] = 0;
+   sum->negative = 0;
+   sum->negativeZeros = 1;
+   sum->positiveZeros = 1;
+   sum->nanAt = DM_SCAN_NONE;
+   sum->positiveAt = DM_SCAN_NONE;
+   sum->negativeAt = DM_SCAN_NONE;
+   sum->nan = 0U;
+   sum->positiveInf = 0U;
+   sum->negativeInf = 0U;
+ }
+
+   // Add delta, from -DM_SCAN_BASE to DM_SCAN_BASE exclusive, to the limb at index, and carry.
+static void dm_scan_addAt(struct dm_scan_sum* sum, int index, int64_t delta)
+ {
+   int64_t carry = delta;
+   int i = index;
+   while (sum->low > index)
+      sum->limb[--sum->low] = 0;
+   while (sum->high < index)
+      sum->limb[++sum->high] = sum->negative ? (DM_SCAN_BASE - 1) : 0;
+   while ((0 != carry) && (i <= sum->high))
+    {
+      int64_t value = sum->limb[i] + carry;
+      carry = 0;
+      if (value >= DM_SCAN_BASE)
+       {
+         value -= DM_SCAN_BASE;
+         carry = 1;
+       }
+      else if (value < 0)
+       {
+         value += DM_SCAN_BASE;
+         carry = -1;
+       }
+      sum->limb[i] = value;
+      ++i;
+    }
+      // A carry into the fill either flips the sign, or starts a new limb.
+   if (0 != carry)
+    {
+      if (sum->negative == (carry > 0))
+         sum->negative = !sum->negative;
+      else
+       {
+         ++sum->high;
+         sum->limb[sum->high] = sum->negative ? (DM_SCAN_BASE - 2) : 1;
+       }
+    }
+ }
+
+static void dm_scan_add(struct dm_scan_sum* sum, dm_double term, size_t position)
+ {
+   if (!dm_double_isfinite(term))
+    {
+      if (dm_double_isnan(term))
+       {
+         if (DM_SCAN_NONE == sum->nanAt)
+          {
+            sum->nanAt = position;
+            sum->nan = term;
+          }
+       }
+      else if (dm_double_signbit(term))
+       {
+         if (DM_SCAN_NONE == sum->negativeAt)
+          {
+            sum->negativeAt = position;
+            sum->negativeInf = term;
+          }
+       }
+      else if (DM_SCAN_NONE == sum->positiveAt)
+       {
+         sum->positiveAt = position;
+         sum->positiveInf = term;
+       }
+      return;
+    }
+
+   if (dm_double_iszero(term))
+    {
+      if (dm_double_signbit(term))
+         sum->positiveZeros = 0;
+      else
+         sum->negativeZeros = 0;
+      return;
+    }
+   sum->negativeZeros = 0;
+   sum->positiveZeros = 0;
+
+   int exponent = 0;
+   int64_t significand = 0;
+   (void) dm_double_to_scaled_r(dm_double_frexp(term, &exponent), 15, DM_FE_TOWARDZERO, &significand); // Exact: sixteen digits
+
+      // The lowest digit is at exponent - 15. Split the significand where it crosses a limb boundary.
+   int offset = exponent - 15 - DM_SCAN_LOWEST;
+   int index = offset / 18;
+   int shift = offset % 18;
+   int64_t magnitude = (significand < 0) ? -significand : significand;
+   int64_t lowPart = (magnitude % dm_scan_pow10[18 - shift]) * dm_scan_pow10[shift];
+   int64_t highPart = magnitude / dm_scan_pow10[18 - shift];
+   if (significand < 0)
+    {
+      lowPart = -lowPart;
+      highPart = -highPart;
+    }
+   dm_scan_addAt(sum, index, lowPart);
+   if (0 != highPart)
+      dm_scan_addAt(sum, index + 1, highPart);
+ }
+
+   // sum += other, where other covers the terms after those of sum.
+static void dm_scan_merge(struct dm_scan_sum* sum, const struct dm_scan_sum* other)
+ {
+   for (int i = other->low; i <= other->high; ++i)
+      if (0 != other->limb[i])
+         dm_scan_addAt(sum, i, other->limb[i]);
+   if (other->negative) // Ten's complement: the fill is minus one at the limb above the stored ones.
+      dm_scan_addAt(sum, other->high + 1, -1);
+   sum->negativeZeros = sum->negativeZeros && other->negativeZeros;
+   sum->positiveZeros = sum->positiveZeros && other->positiveZeros;
+   if (DM_SCAN_NONE == sum->nanAt)
+    {
+      sum->nanAt = other->nanAt;
+      sum->nan = other->nan;
+    }
+   if (DM_SCAN_NONE == sum->positiveAt)
+    {
+      sum->positiveAt = other->positiveAt;
+      sum->positiveInf = other->positiveInf;
+    }
+   if (DM_SCAN_NONE == sum->negativeAt)
+    {
+      sum->negativeAt = other->negativeAt;
+      sum->negativeInf = other->negativeInf;
+    }
+ }
+
+static dm_double dm_scan_round(struct dm_scan_sum* sum, int round_mode)
+ {
+   dm_double result = 0U;
+
+      // The special values, in the order that the serial sum would have met them: Inf - Inf is NaN.
+   if ((DM_SCAN_NONE != sum->nanAt) || (DM_SCAN_NONE != sum->positiveAt) || (DM_SCAN_NONE != sum->negativeAt))
+    {
+      size_t both = (sum->positiveAt > sum->negativeAt) ? sum->positiveAt : sum->negativeAt;
+      if (sum->nanAt < both)
+         return sum->nan;
+      if (DM_SCAN_NONE != both)
+         return dm_double_add_r(sum->positiveInf, sum->negativeInf, round_mode);
+      return (DM_SCAN_NONE != sum->positiveAt) ? sum->positiveInf : sum->negativeInf;
+    }
+
+      // Drop the limbs that don't matter: zeros at the bottom, and fill at the top.
+   int64_t fill = sum->negative ? (DM_SCAN_BASE - 1) : 0;
+   while ((sum->high > sum->low) && (fill == sum->limb[sum->high]))
+      --sum->high;
+   while ((sum->low < sum->high) && (0 == sum->limb[sum->low]))
+      ++sum->low;
+
+      // The top two limbs of the magnitude, and whether anything below them isn't zero.
+   int index = sum->high;
+   int64_t top;
+   int64_t next = 0;
+   int sticky = sum->low < (sum->high - 1);
+   if (!sum->negative)
+    {
+      top = sum->limb[index];
+      if (0 == top)
+       {
+         (void) dm_double_from_scaled_r(0, 0, round_mode, &result);
+            // Like x - x, a zero from terms that weren't all the same zero is -0 only when rounding down.
+         if (sum->negativeZeros || (!sum->positiveZeros && (DM_FE_DOWNWARD == round_mode)))
+            result = dm_double_neg(result);
+         return result;
+       }
+      if (index > sum->low)
+         next = sum->limb[index - 1];
+    }
+   else if (sum->low == sum->high)
+    {
+      top = DM_SCAN_BASE - sum->limb[index];
+      if (DM_SCAN_BASE == top) // Minus one at the limb above.
+       {
+         top = 1;
+         ++index;
+       }
+    }
+   else
+    {
+      top = (DM_SCAN_BASE - 1) - sum->limb[index];
+      next = (DM_SCAN_BASE - ((index - 1) == sum->low ? 0 : 1)) - sum->limb[index - 1];
+    }
+
+      // Eighteen digits, with the last one made non-zero if anything below them is, so that the rounding sees it.
+   int digits = 1;
+   while (top >= dm_scan_pow10[digits])
+      ++digits;
+   int64_t value = top * dm_scan_pow10[18 - digits] + next / dm_scan_pow10[digits];
+   if ((sticky || (0 != next % dm_scan_pow10[digits])) && (0 == value % 5))
+      ++value;
+   (void) dm_double_from_scaled_r(sum->negative ? -value : value, (18 - digits) - DM_SCAN_LOWEST - 18 * index, round_mode, &result);
+   return result;
+ }
+
+   // One thread's share of an exact scan. The first pass sums the block, and the second
+   // scans it from the exact sum of everything before it.
+struct dm_scan_block
+ {
+   const dm_double* src;
+   dm_double* dest;
+   size_t count;
+   size_t position;  // Of the first element, counting the initial value of an exclusive scan as zero
+   int inclusive;
+   int round_mode;
+   int flags;        // The status flags that the thread raised, to raise again in the caller
+   struct dm_scan_sum sum;
+ };
+
+static void* dm_scan_sumBlock(void* arg)
+ {
+   struct dm_scan_block* block = (struct dm_scan_block*) arg;
+   dm_scan_init(&block->sum);
+   for (size_t i = 0U; i < block->count; ++i)
+      dm_scan_add(&block->sum, block->src[i], block->position + i);
+   return NULL;
+ }
+
+static void* dm_scan_scanBlock(void* arg)
+ {
+   struct dm_scan_block* block = (struct dm_scan_block*) arg;
+   for (size_t i = 0U; i < block->count; ++i)
+    {
+      dm_double term = block->src[i]; // Before the destination overwrites it
+      if (block->inclusive)
+       {
+         dm_scan_add(&block->sum, term, block->position + i);
+         block->dest[i] = dm_scan_round(&block->sum, block->round_mode);
+       }
+      else
+       {
+         block->dest[i] = dm_scan_round(&block->sum, block->round_mode);
+         dm_scan_add(&block->sum, term, block->position + i);
+       }
+    }
+#ifdef DM_FENV_FLAGS
+   block->flags = dm_fetestexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+   return NULL;
+ }
+
+   // Run the blocks at once: all but the first on threads of their own, and the first in the caller.
+   // A thread that can't be started runs in the caller too: the results are the same either way.
+static void dm_scan_parallel(void* (*work)(void*), struct dm_scan_block* blocks, int count)
+ {
+#ifndef DM_NO_THREADS
+   pthread_t threads [DM_SCAN_MAX_THREADS];
+   int started [DM_SCAN_MAX_THREADS];
+   for (int i = 1; i < count; ++i)
+      started[i] = (0 == pthread_create(&threads[i], NULL, work, &blocks[i]));
+   (void) work(&blocks[0]);
+   for (int i = 1; i < count; ++i)
+    {
+      if (started[i])
+         (void) pthread_join(threads[i], NULL);
+      else
+         (void) work(&blocks[i]);
+    }
+#else
+   for (int i = 0; i < count; ++i)
+      (void) work(&blocks[i]);
+#endif /* ! DM_NO_THREADS */
+ }
+
+static void dm_scan_exact(const dm_double* src, dm_double* dest, size_t count, const dm_double* init, int round_mode)
+ {
+   struct dm_scan_block blocks [DM_SCAN_MAX_THREADS];
+   int threads = dm_double_batch_getthreads();
+   if ((size_t)threads > count / DM_SCAN_MIN_BLOCK)
+      threads = (int)(count / DM_SCAN_MIN_BLOCK);
+   if (threads < 1)
+      threads = 1;
+
+   size_t start = 0U;
+   for (int i = 0; i < threads; ++i)
+    {
+      blocks[i].src = src + start;
+      blocks[i].dest = dest + start;
+      blocks[i].count = (i == threads - 1) ? count - start : count / threads;
+      blocks[i].position = start + ((NULL != init) ? 1U : 0U);
+      blocks[i].inclusive = (NULL == init);
+      blocks[i].round_mode = round_mode;
+      blocks[i].flags = 0;
+      start += blocks[i].count;
+    }
+
+      // The last block's sum isn't needed.
+   if (threads > 1)
+      dm_scan_parallel(dm_scan_sumBlock, blocks, threads - 1);
+
+      // Each block starts from the sum of those before it. The scans overwrite them, so go from the end.
+   for (int i = threads - 1; i > 0; --i)
+    {
+      struct dm_scan_sum offset;
+      dm_scan_init(&offset);
+      if (NULL != init)
+         dm_scan_add(&offset, *init, 0U);
+      for (int j = 0; j < i; ++j)
+         dm_scan_merge(&offset, &blocks[j].sum);
+      blocks[i].sum = offset;
+    }
+   dm_scan_init(&blocks[0].sum);
+   if (NULL != init)
+      dm_scan_add(&blocks[0].sum, *init, 0U);
+
+   dm_scan_parallel(dm_scan_scanBlock, blocks, threads);
+#ifdef DM_FENV_FLAGS
+   for (int i = 1; i < threads; ++i)
+      (void) dm_feraiseexcept(blocks[i].flags);
+#endif /* DM_FENV_FLAGS */
+ }
+
+   // The number of threads for a request of threads, which is one per processor if it is less than one.
+static int dm_batch_threadCount(int threads)
+ {
+#ifndef DM_NO_THREADS
+   if (threads < 1)
+    {
+      threads = 1;
+#ifdef _SC_NPROCESSORS_ONLN
+      long processors = sysconf(_SC_NPROCESSORS_ONLN);
+      if (processors > 1)
+         threads = (processors > DM_SCAN_MAX_THREADS) ? DM_SCAN_MAX_THREADS : (int)processors;
+#endif /* _SC_NPROCESSORS_ONLN */
+    }
+   if (threads > DM_SCAN_MAX_THREADS) threads = DM_SCAN_MAX_THREADS;
+#else
+   threads = 1;
+#endif /* ! DM_NO_THREADS */
+   return threads;
+ }
+
+   // The default only replaces zero, so that it can't undo a dm_double_batch_setthreads on another thread.
+int dm_double_batch_getthreads(void)
+ {
+   int result = atomic_load(&dm_batch_threads);
+   if (0 == result)
+    {
+      int expected = 0;
+      result = dm_batch_threadCount(0);
+      if (!atomic_compare_exchange_strong(&dm_batch_threads, &expected, result))
+         result = expected;
+    }
+   return result;
+ }
+
+int dm_double_batch_setthreads(int threads)
+ {
+   int result = dm_batch_threadCount(threads);
+   atomic_store(&dm_batch_threads, result);
+   return result;
+ }
+
+void dm_double_inclusive_scan(const dm_double* src, dm_double* dest, size_t count, int round_mode, int method)
+ {
+   if (DM_SCAN_EXACT == method)
+      dm_scan_exact(src, dest, count, NULL, round_mode);
+   else if (0U != count)
+    {
+      dm_double sum = src[0];
+      dest[0] = sum;
+      for (size_t i = 1U; i < count; ++i)
+       {
+         sum = dm_double_add_r(sum, src[i], round_mode);
+         dest[i] = sum;
+       }
+    }
+ }
+
+void dm_double_exclusive_scan(const dm_double* src, dm_double* dest, size_t count, dm_double init, int round_mode, int method)
+ {
+   if (DM_SCAN_EXACT == method)
+      dm_scan_exact(src, dest, count, &init, round_mode);
+   else
+    {
+      dm_double sum = init;
+      for (size_t i = 0U; i < count; ++i)
+       {
+         dm_double term = src[i]; // Before the destination overwrites it
+         dest[i] = sum;
+         sum = dm_double_add_r(sum, term, round_mode);
+       }
+    }
+ }
@@ -0,0 +1,115 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_BATCH_H
+#define DM_DOUBLE_BATCH_H
+
+/*
+   Array versions of the arithmetic, comparison, conversion, and parsing
+   functions. Like the pretty printer, the code here never looks at the
+   underlying representation, so it works with either dm_double or
+   dm_double_m.
+
+   The kernels are built by dm_double.c and dm_double_m.c, once for each
+   instruction set level below, with the scalar function inlined into the
+   loop (see dm_double_kernels.h). The best level that the CPU supports is
+   selected the first time any kernel is called. Setting the environment
+   variable DM_DOUBLE_ISA to one of "scalar", "sse4.2", "avx2", or "avx512"
+   forces a lower level, so that every path can be tested and benchmarked on
+   one machine; any other value is ignored. The exponential, logarithm, and
+   power functions have one loop for every level.
+
+   Selecting the level is thread safe, and a kernel that is already running
+   finishes at the level it started with.
+*/
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_ISA_SCALAR 0
+#define DM_ISA_SSE42  1 // With POPCNT
+#define DM_ISA_AVX2   2 // With BMI, BMI2, and LZCNT
+#define DM_ISA_AVX512 3 // AVX-512 F, BW, DQ, and VL
+int dm_double_batch_getisa (void);
+int dm_double_batch_setisa (int); // Will not select a level the CPU doesn't have. Returns the level in use.
+
+   // dest[i] = lhs[i] op rhs[i]. The destination may alias either source.
+void dm_double_add_array (const dm_double*, const dm_double*, dm_double*, size_t, int);
+void dm_double_sub_array (const dm_double*, const dm_double*, dm_double*, size_t, int);
+void dm_double_mul_array (const dm_double*, const dm_double*, dm_double*, size_t, int);
+void dm_double_div_array (const dm_double*, const dm_double*, dm_double*, size_t, int);
+void dm_double_sqrt_array (const dm_double*, dm_double*, size_t, int); // The destination may alias the source.
+void dm_double_fma_array (const dm_double*, const dm_double*, const dm_double*, dm_double*, size_t); // dm_fegetround()
+
+   // dm_fegetround(). The destination may alias the source.
+void dm_double_exp_array   (const dm_double*, dm_double*, size_t);
+void dm_double_expm1_array (const dm_double*, dm_double*, size_t);
+void dm_double_log_array   (const dm_double*, dm_double*, size_t);
+void dm_double_log10_array (const dm_double*, dm_double*, size_t);
+void dm_double_log1p_array (const dm_double*, dm_double*, size_t);
+void dm_double_pow_array   (const dm_double*, const dm_double*, dm_double*, size_t); // May alias either source.
+
+void dm_double_isless_array         (const dm_double*, const dm_double*, int*, size_t);
+void dm_double_islessequal_array    (const dm_double*, const dm_double*, int*, size_t);
+void dm_double_isgreater_array      (const dm_double*, const dm_double*, int*, size_t);
+void dm_double_isgreaterequal_array (const dm_double*, const dm_double*, int*, size_t);
+void dm_double_isequal_array        (const dm_double*, const dm_double*, int*, size_t);
+
+   // Running sums: dest[i] = src[0] + ... + src[i] (inclusive), or init + src[0] + ... + src[i - 1]
+   // (exclusive). The destination may alias the source.
+   // DM_SCAN_SERIAL rounds each sum before adding the next element, exactly like a loop around
+   // dm_double_add_r, which leaves nothing to do in parallel. DM_SCAN_EXACT keeps the running sum
+   // exactly and rounds every result once from it, so that cancellation doesn't leave behind the
+   // rounding errors of the terms that cancelled. Large arrays are split between threads, and the
+   // results are the same bits whatever the split.
+#define DM_SCAN_SERIAL 0
+#define DM_SCAN_EXACT  1
+void dm_double_inclusive_scan (const dm_double*, dm_double*, size_t, int, int);
+void dm_double_exclusive_scan (const dm_double*, dm_double*, size_t, dm_double, int, int);
+
+#define DM_SCAN_MAX_THREADS 64
+int dm_double_batch_getthreads (void);
+int dm_double_batch_setthreads (int); // The most threads an exact scan uses. Zero for one per processor. Returns the number in use. Thread safe.
+
+void dm_double_fromstring_array (const char * const *, dm_double*, size_t);
+#ifndef DM_NO_DOUBLE_MATH
+void dm_double_todouble_array   (const dm_double*, double*, size_t);
+void dm_double_fromdouble_array (const double*, dm_double*, size_t);
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_DOUBLE_BATCH_H */
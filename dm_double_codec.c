@@ -0,0 +1,256 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "dm_double_prefix.h"
+
+   /* ABI compatible defines. */
+typedef uint64_t dm_double;
+
+int       dm_double_isfinite    (dm_double);
+int       dm_double_iszero      (dm_double);
+int       dm_double_signbit     (dm_double);
+dm_double dm_double_frexp       (dm_double, int*);
+int       dm_double_trailing_zeros (dm_double);
+int       dm_double_to_scaled_r (dm_double, int, int, int64_t*);
+int       dm_double_to_scaled_array   (const dm_double*, int64_t*, size_t, int, int);
+int       dm_double_from_scaled_array (const int64_t*, dm_double*, size_t, int, int);
+#define DM_FE_TONEAREST   0
+#define DM_FE_TOWARDZERO  4
+#define DM_CONVERT_EXACT  0
+#ifdef DM_FENV_FLAGS
+#define DM_FE_ALL_EXCEPT 0x1F
+int dm_fetestexcept  (int);
+int dm_feclearexcept (int);
+int dm_feraiseexcept (int);
+#endif /* DM_FENV_FLAGS */
+
+#include "dm_double_codec.h"
+
+#define DM_CODEC_CHUNK_ROWS 32U // Rows decoded at a time: 2 KiB of integers, which stays in the L1 cache.
+
+   // The header, one field at a time, so that the block needs no alignment.
+static void dm_codec_putHeader(unsigned char* out, uint32_t count, uint8_t kind, uint8_t width, int16_t scale, int64_t reference)
+ {
+   memcpy(out, &count, 4U);
+   out[4] = kind;
+   out[5] = width;
+   memcpy(out + 6, &scale, 2U);
+   memcpy(out + 8, &reference, 8U);
+ }
+
+static size_t dm_codec_raw(const dm_double* values, size_t count, unsigned char* out)
+ {
+   dm_codec_putHeader(out, (uint32_t)count, DM_CODEC_RAW, 64U, 0, 0);
+   if (0U != count)
+      memcpy(out + DM_CODEC_HEADER_SIZE, values, count * sizeof(dm_double));
+   return DM_CODEC_MAX_ENCODED(count);
+ }
+
+   // The power of ten of the lowest non-zero digit of a finite non-zero value.
+static int dm_codec_lowestDigit(dm_double value)
+ {
+   int exponent = 0;
+   (void) dm_double_frexp(value, &exponent);
+   return exponent - 15 + dm_double_trailing_zeros(value);
+ }
+
+   // The integers are written over the space that the packed words will take, which is never ahead of them:
+   // a row is read before any word is stored, and the words of row r end by word r.
+static size_t dm_codec_pack(unsigned char* out, size_t count, unsigned width, int64_t reference)
+ {
+   unsigned char* data = out + DM_CODEC_HEADER_SIZE;
+   uint64_t accumulator [DM_CODEC_LANES] = { 0U };
+   unsigned used = 0U;
+   size_t word = 0U;
+   size_t rows = (count + DM_CODEC_LANES - 1U) / DM_CODEC_LANES;
+
+   for (size_t row = 0U; row < rows; ++row)
+    {
+      uint64_t values [DM_CODEC_LANES] = { 0U };
+      size_t first = row * DM_CODEC_LANES;
+      size_t length = ((count - first) < DM_CODEC_LANES) ? (count - first) : DM_CODEC_LANES;
+      memcpy(values, data + (first * 8U), length * 8U);
+      for (size_t lane = 0U; lane < DM_CODEC_LANES; ++lane)
+       {
+         values[lane] = (lane < length) ? (values[lane] - (uint64_t)reference) : 0U;
+         accumulator[lane] |= values[lane] << used;
+       }
+      used += width;
+      if (used >= 64U)
+       {
+         used -= 64U;
+         memcpy(data + (word * DM_CODEC_LANES * 8U), accumulator, sizeof(accumulator));
+         ++word;
+         for (size_t lane = 0U; lane < DM_CODEC_LANES; ++lane)
+            accumulator[lane] = (0U == used) ? 0U : (values[lane] >> (width - used));
+       }
+    }
+   if (0U != used)
+    {
+      memcpy(data + (word * DM_CODEC_LANES * 8U), accumulator, sizeof(accumulator));
+      ++word;
+    }
+   return DM_CODEC_HEADER_SIZE + (word * DM_CODEC_LANES * 8U);
+ }
+
+size_t dm_double_block_encode(const dm_double* values, size_t count, void* out)
+ {
+   unsigned char* bytes = (unsigned char*)out;
+   int lowest = 0;
+   int found = 0;
+
+   for (size_t i = 0U; i < count; ++i)
+    {
+      if (!dm_double_isfinite(values[i]) || (dm_double_iszero(values[i]) && dm_double_signbit(values[i])))
+         return dm_codec_raw(values, count, bytes); // Specials don't rescale.
+      if (!dm_double_iszero(values[i]))
+       {
+         int digit = dm_codec_lowestDigit(values[i]);
+         if (!found || (digit < lowest))
+            lowest = digit;
+         found = 1;
+       }
+    }
+   if (0U == count)
+      return dm_codec_raw(values, count, bytes);
+
+      // Rescale into the output, where the raw values would go. Only the block that doesn't fit an int64_t rounds.
+   int64_t* integers = (int64_t*)(void*)(bytes + DM_CODEC_HEADER_SIZE);
+   int64_t scratch = 0;
+   int status = DM_CONVERT_EXACT;
+#ifdef DM_FENV_FLAGS
+   int flags = dm_fetestexcept(DM_FE_ALL_EXCEPT);
+#endif /* DM_FENV_FLAGS */
+   if (0 == ((uintptr_t)integers % sizeof(int64_t)))
+      status = dm_double_to_scaled_array(values, integers, count, -lowest, DM_FE_TOWARDZERO);
+   else
+      for (size_t i = 0U; i < count; ++i)
+       {
+         status |= dm_double_to_scaled_r(values[i], -lowest, DM_FE_TOWARDZERO, &scratch);
+         memcpy(bytes + DM_CODEC_HEADER_SIZE + (i * 8U), &scratch, 8U);
+       }
+   if (DM_CONVERT_EXACT != status)
+    {
+#ifdef DM_FENV_FLAGS
+      dm_feclearexcept(DM_FE_ALL_EXCEPT);
+      dm_feraiseexcept(flags);
+#endif /* DM_FENV_FLAGS */
+      return dm_codec_raw(values, count, bytes);
+    }
+
+   int64_t least = INT64_MAX;
+   int64_t greatest = INT64_MIN;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      memcpy(&scratch, bytes + DM_CODEC_HEADER_SIZE + (i * 8U), 8U);
+      least = (scratch < least) ? scratch : least;
+      greatest = (scratch > greatest) ? scratch : greatest;
+    }
+   uint64_t range = (uint64_t)greatest - (uint64_t)least;
+   unsigned width = 0U;
+   while ((width < 64U) && (0U != (range >> width)))
+      ++width;
+
+      // Whole words per lane, and it has to be smaller than the values.
+   size_t rows = (count + DM_CODEC_LANES - 1U) / DM_CODEC_LANES;
+   size_t words = ((rows * width) + 63U) / 64U;
+   if (words * DM_CODEC_LANES >= count)
+      return dm_codec_raw(values, count, bytes);
+
+   dm_codec_putHeader(bytes, (uint32_t)count, DM_CODEC_PACKED, (uint8_t)width, (int16_t)(-lowest), least);
+   return dm_codec_pack(bytes, count, width, least);
+ }
+
+size_t dm_double_block_count(const void* in)
+ {
+   uint32_t count = 0U;
+   memcpy(&count, in, 4U);
+   return count;
+ }
+
+size_t dm_double_block_decode(const void* in, dm_double* values)
+ {
+   const unsigned char* bytes = (const unsigned char*)in;
+   const unsigned char* data = bytes + DM_CODEC_HEADER_SIZE;
+   size_t count = dm_double_block_count(in);
+   unsigned width = bytes[5];
+   int16_t scale = 0;
+   int64_t reference = 0;
+   memcpy(&scale, bytes + 6, 2U);
+   memcpy(&reference, bytes + 8, 8U);
+
+   if (DM_CODEC_RAW == bytes[4])
+    {
+      if (0U != count)
+         memcpy(values, data, count * sizeof(dm_double));
+      return DM_CODEC_MAX_ENCODED(count);
+    }
+
+   uint64_t mask = (64U == width) ? ~(uint64_t)0U : ((((uint64_t)1U) << width) - 1U);
+   size_t rows = (count + DM_CODEC_LANES - 1U) / DM_CODEC_LANES;
+   size_t words = ((rows * width) + 63U) / 64U;
+   int64_t integers [DM_CODEC_CHUNK_ROWS * DM_CODEC_LANES];
+
+   for (size_t first = 0U; first < rows; first += DM_CODEC_CHUNK_ROWS)
+    {
+      size_t last = ((rows - first) < DM_CODEC_CHUNK_ROWS) ? rows : (first + DM_CODEC_CHUNK_ROWS);
+      for (size_t row = first; row < last; ++row)
+       {
+            // Every lane shifts by the same amount.
+         size_t bit = row * width;
+         size_t word = bit / 64U;
+         unsigned shift = (unsigned)(bit % 64U);
+         uint64_t low [DM_CODEC_LANES];
+         uint64_t high [DM_CODEC_LANES] = { 0U };
+         int64_t* dest = integers + ((row - first) * DM_CODEC_LANES);
+         if (word < words)
+            memcpy(low, data + (word * DM_CODEC_LANES * 8U), sizeof(low));
+         else
+            memset(low, 0, sizeof(low)); // Width zero
+         if (shift + width > 64U)
+            memcpy(high, data + ((word + 1U) * DM_CODEC_LANES * 8U), sizeof(high));
+         for (size_t lane = 0U; lane < DM_CODEC_LANES; ++lane)
+          {
+            uint64_t value = (low[lane] >> shift) | ((high[lane] << 1) << (63U - shift));
+            dest[lane] = (int64_t)((value & mask) + (uint64_t)reference);
+          }
+       }
+      size_t start = first * DM_CODEC_LANES;
+      size_t length = ((count - start) < ((last - first) * DM_CODEC_LANES)) ? (count - start) : ((last - first) * DM_CODEC_LANES);
+      (void) dm_double_from_scaled_array(integers, values + start, length, scale, DM_FE_TONEAREST); // Exact: they came from these digits.
+    }
+   return DM_CODEC_HEADER_SIZE + (words * DM_CODEC_LANES * 8U);
+ }
@@ -0,0 +1,194 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_CODEC_H
+#define DM_DOUBLE_CODEC_H
+
+/*
+   Compression of blocks of dm_doubles, for storage.
+
+   dm_double_block_encode finds the lowest power of ten that any value in the
+   block has a digit at, and rescales every value, exactly, to an integer
+   number of it. Amounts, prices, and measurements have few digits past their
+   common point, and their integers are close together, so they are stored as
+   their differences from the least of them (frame of reference), each in
+   just enough bits for the greatest difference. Cents between 0 and 10000.00
+   take 20 bits, against 64 for the dm_double.
+
+   A block that holds an infinity, a NaN, or a negative zero, whose integers
+   don't fit in an int64_t, or that packing wouldn't make smaller, is stored
+   raw, as it is.
+
+   The packed differences are interleaved in DM_CODEC_LANES lanes: the i-th
+   value is in lane i % DM_CODEC_LANES, and each lane is its own stream of
+   bits. Decoding a row of values, one from each lane, then shifts every lane
+   by the same amount, so the unpacking loop vectorizes without gathers. The
+   integers go back to dm_doubles through dm_double_from_scaled_array.
+
+   An encoded block is a 16 byte header, then the data, in the byte order of
+   the machine that wrote it:
+
+      count      uint32_t, the number of values
+      kind       uint8_t, DM_CODEC_RAW or DM_CODEC_PACKED
+      width      uint8_t, bits per value
+      scale      int16_t, the values are the integers times 10 ^ -scale
+      reference  int64_t, the least of the integers
+
+   This never looks at the representation, and works with either dm_double
+   or dm_double_m.
+
+   The varint encoding is for streams of values, one at a time, and takes
+   fewer bytes the fewer digits a value has. dm_double_to_varint strips the
+   trailing zeros from the sixteen digit significand, and writes the integer
+   that is left, with its sign, then the power of ten of its last digit, both
+   as zigzag varints: seven bits to a byte, low bits first, with the top bit
+   set on every byte but the last. 123.45 is the integer 12345 and the
+   exponent -2, which take three bytes and one. A value takes at most
+   DM_VARINT_MAX_BYTES. Zero, infinity, and NaN are the integer zero, followed
+   by their significand field, shifted left once, with the sign in the low
+   bit, so that NaN payloads and the sign of zero survive.
+
+   The varint conversions need to know the layout of a dm_double, so they are
+   part of dm_double.c and dm_double_m.c: include dm_double.h or
+   dm_double_m.h first. The array versions stop at the first value that
+   doesn't fit in the destination, or that is cut off or invalid in the
+   source, so that the writer and reader below can stream through buffers of
+   any size, without allocating.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_CODEC_RAW         0
+#define DM_CODEC_PACKED      1
+#define DM_CODEC_LANES       8U
+#define DM_CODEC_HEADER_SIZE 16U
+#define DM_CODEC_MAX_BLOCK   0xFFFFFFFFU
+#define DM_CODEC_MAX_ENCODED(count) (DM_CODEC_HEADER_SIZE + (count) * 8U) // Bytes, for a block of count values.
+
+   // Returns the number of bytes written, at most DM_CODEC_MAX_ENCODED(count). The count can be at most DM_CODEC_MAX_BLOCK.
+size_t dm_double_block_encode (const dm_double*, size_t, void*);
+size_t dm_double_block_count  (const void*); // The number of values in an encoded block.
+size_t dm_double_block_decode (const void*, dm_double*); // Returns the number of bytes read.
+
+#define DM_VARINT_MAX_BYTES 10U // Eight for the integer, two for the exponent.
+
+   // Zigzag maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ..., so that small negative numbers have short varints too.
+static inline uint64_t dm_zigzag_encode(int64_t value)
+ {
+   return ((uint64_t)value << 1) ^ (0U - ((uint64_t)value >> 63));
+ }
+
+static inline int64_t dm_zigzag_decode(uint64_t value)
+ {
+   return (int64_t)((value >> 1) ^ (0U - (value & 1U)));
+ }
+
+   // Returns the number of bytes written.
+static inline size_t dm_varint_put(uint64_t value, unsigned char* dest)
+ {
+   size_t length = 0U;
+   while (value >= 0x80U)
+    {
+      dest[length++] = (unsigned char)(value | 0x80U);
+      value >>= 7;
+    }
+   dest[length++] = (unsigned char)value;
+   return length;
+ }
+
+   // Returns the number of bytes read, or zero if the varint is cut off or longer than eight bytes.
+static inline size_t dm_varint_get(const unsigned char* src, size_t available, uint64_t* value)
+ {
+   size_t limit = (available < 8U) ? available : 8U;
+   uint64_t result = 0U;
+   for (size_t i = 0U; i < limit; ++i)
+    {
+      result |= (uint64_t)(src[i] & 0x7FU) << (7U * i);
+      if (0U == (src[i] & 0x80U))
+       {
+         *value = result;
+         return i + 1U;
+       }
+    }
+   return 0U;
+ }
+
+size_t dm_double_to_varint   (dm_double, unsigned char*); // Returns the number of bytes written.
+size_t dm_double_from_varint (const unsigned char*, size_t, dm_double*); // Returns the number of bytes read, zero if it was cut off or invalid.
+
+   // They return the number of values converted, and set the last argument to the number of bytes written or read.
+size_t dm_double_to_varint_array   (const dm_double*, size_t, unsigned char*, size_t, size_t*);
+size_t dm_double_from_varint_array (const unsigned char*, size_t, dm_double*, size_t, size_t*);
+
+   // Appends to a buffer that the caller owns, and empties when it fills up.
+typedef struct dm_varint_writer
+ {
+   unsigned char* buffer;
+   size_t capacity;
+   size_t length;
+ } dm_varint_writer;
+
+   // Returns the number of values appended: fewer than were given if the buffer filled up.
+static inline size_t dm_varint_write(dm_varint_writer* writer, const dm_double* values, size_t count)
+ {
+   size_t bytes = 0U;
+   size_t done = dm_double_to_varint_array(values, count, writer->buffer + writer->length, writer->capacity - writer->length, &bytes);
+   writer->length += bytes;
+   return done;
+ }
+
+typedef struct dm_varint_reader
+ {
+   const unsigned char* buffer;
+   size_t length;
+   size_t position;
+ } dm_varint_reader;
+
+   // Returns the number of values read. Fewer than asked for, with bytes left over, means the last value
+   // is cut off at the end of the buffer, or, with DM_VARINT_MAX_BYTES or more left over, that it is invalid.
+static inline size_t dm_varint_read(dm_varint_reader* reader, dm_double* values, size_t count)
+ {
+   size_t bytes = 0U;
+   size_t done = dm_double_from_varint_array(reader->buffer + reader->position, reader->length - reader->position, values, count, &bytes);
+   reader->position += bytes;
+   return done;
+ }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_DOUBLE_CODEC_H */
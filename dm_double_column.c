@@ -0,0 +1,351 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32) && !defined(DM_NO_MMAP)
+#define DM_NO_MMAP
+#endif
+#ifndef DM_NO_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* ! DM_NO_MMAP */
+
+#include "dm_double_prefix.h"
+
+   /* ABI compatible defines. */
+typedef uint64_t dm_double;
+
+int dm_double_isnan       (dm_double);
+int dm_double_isless      (dm_double, dm_double);
+int dm_double_islessequal (dm_double, dm_double);
+int dm_double_signbit     (dm_double);
+
+#include "dm_double_column.h"
+#include "dm_double_layout.h"
+
+typedef struct dm_column_header
+ {
+   char magic [8];
+   uint32_t version;
+   uint32_t layout;
+   uint64_t count;
+   uint64_t block_size;
+   uint64_t blocks;
+   uint64_t zones;
+   uint64_t data;
+   uint64_t reserved;
+ } dm_column_header;
+
+static const char dm_column_magic [8] = { 'D', 'M', 'C', 'O', 'L', 'U', 'M', 'N' };
+
+#define DM_COLUMN_ALIGN 64U // Of the values in the file, so that they are as aligned in the mapping.
+
+   // The top bit is the sign in the MISRA layout, and part of the exponent of zero in the legacy one.
+static int dm_column_layout(void)
+ {
+   return dm_double_signbit(0x8000000000000000ULL) ? DM_COLUMN_MISRA : DM_COLUMN_LEGACY;
+ }
+
+static size_t dm_column_blocks(uint64_t count, uint64_t block_size)
+ {
+   return (size_t)((count / block_size) + (0U != (count % block_size)));
+ }
+
+   // The comparisons are false for NaNs, so they only need counting. A block of nothing but NaNs keeps one as its bounds.
+static dm_double_column_zone dm_column_zone(const dm_double* values, size_t count)
+ {
+   dm_double_column_zone zone;
+   size_t i = 0U;
+   while ((i < count) && dm_double_isnan(values[i]))
+      ++i;
+   zone.nulls = i;
+   zone.min = values[(i < count) ? i : 0U];
+   zone.max = zone.min;
+   for (; i < count; ++i)
+    {
+      zone.nulls += (uint64_t)dm_double_isnan(values[i]);
+      if (dm_double_isless(values[i], zone.min))
+         zone.min = values[i];
+      if (dm_double_isless(zone.max, values[i]))
+         zone.max = values[i];
+    }
+   return zone;
+ }
+
+int dm_double_column_write(const char* path, const dm_double* values, size_t count, size_t block_size)
+ {
+   static const char padding [DM_COLUMN_ALIGN] = { 0 };
+   dm_column_header header;
+   FILE* file = NULL;
+   int ok = 0;
+   size_t blocks = 0U;
+   size_t zones_end = 0U;
+
+   if (0U == block_size)
+      block_size = DM_COLUMN_DEFAULT_BLOCK;
+   blocks = dm_column_blocks(count, block_size);
+   zones_end = DM_COLUMN_HEADER_SIZE + (blocks * sizeof(dm_double_column_zone));
+
+   memcpy(header.magic, dm_column_magic, sizeof(header.magic));
+   header.version = DM_COLUMN_VERSION;
+   header.layout = (uint32_t)dm_column_layout();
+   header.count = count;
+   header.block_size = block_size;
+   header.blocks = blocks;
+   header.zones = DM_COLUMN_HEADER_SIZE;
+   header.data = (zones_end + DM_COLUMN_ALIGN - 1U) / DM_COLUMN_ALIGN * DM_COLUMN_ALIGN;
+   header.reserved = 0U;
+
+   file = fopen(path, "wb");
+   if (NULL == file)
+      return DM_COLUMN_IO;
+   ok = (1U == fwrite(&header, sizeof(header), 1U, file));
+   for (size_t block = 0U; ok && (block < blocks); ++block)
+    {
+      size_t start = block * block_size;
+      size_t length = ((count - start) < block_size) ? (count - start) : block_size;
+      dm_double_column_zone zone = dm_column_zone(values + start, length);
+      ok = (1U == fwrite(&zone, sizeof(zone), 1U, file));
+    }
+   if (ok && (header.data != zones_end))
+      ok = (1U == fwrite(padding, (size_t)header.data - zones_end, 1U, file));
+   if (ok && (0U != count))
+      ok = (count == fwrite(values, sizeof(dm_double), count, file));
+   if (0 != fclose(file))
+      ok = 0;
+   return ok ? DM_COLUMN_OK : DM_COLUMN_IO;
+ }
+
+   // Checks that everything the header says is inside the file, before believing it.
+static int dm_column_parse(dm_double_column* column, void* base, size_t length)
+ {
+   dm_column_header header;
+
+   if (length < sizeof(header))
+      return DM_COLUMN_FORMAT;
+   memcpy(&header, base, sizeof(header));
+   if ((0 != memcmp(header.magic, dm_column_magic, sizeof(header.magic))) || (DM_COLUMN_VERSION != header.version) ||
+         ((DM_COLUMN_LEGACY != header.layout) && (DM_COLUMN_MISRA != header.layout)))
+      return DM_COLUMN_FORMAT;
+   if ((0U == header.block_size) || ((size_t)header.block_size != header.block_size) || (DM_COLUMN_HEADER_SIZE != header.zones) ||
+         (0U != (header.data % DM_COLUMN_ALIGN)) || (header.data < header.zones) || (header.data > length) ||
+         (header.count > ((length - header.data) / sizeof(dm_double))))
+      return DM_COLUMN_FORMAT;
+      // The zones have to end by the time the values begin. Divided, rather than multiplied, so that no count of blocks can wrap.
+   if ((header.blocks != dm_column_blocks(header.count, header.block_size)) ||
+         (header.blocks > ((header.data - header.zones) / sizeof(dm_double_column_zone))))
+      return DM_COLUMN_FORMAT;
+
+   column->values = (const dm_double*)((const char*)base + header.data);
+   column->zones = (const dm_double_column_zone*)((const char*)base + header.zones);
+   column->count = (size_t)header.count;
+   column->block_size = (size_t)header.block_size;
+   column->blocks = (size_t)header.blocks;
+   column->layout = (int)header.layout;
+   column->base = base;
+   column->length = length;
+   return DM_COLUMN_OK;
+ }
+
+   // The zones and values of a file from the other implementation, in place. The bounds stay bounds: both layouts order the same numbers.
+static void dm_column_convert(dm_double_column* column)
+ {
+   void (*convert)(const uint64_t*, uint64_t*, size_t) = (DM_COLUMN_MISRA == column->layout) ? dm_double_m_to_legacy_array : dm_double_legacy_to_m_array;
+   dm_double* values = (dm_double*)column->values;
+   dm_double_column_zone* zones = (dm_double_column_zone*)column->zones;
+
+   convert(values, values, column->count);
+   for (size_t block = 0U; block < column->blocks; ++block)
+    {
+      convert(&zones[block].min, &zones[block].min, 1U);
+      convert(&zones[block].max, &zones[block].max, 1U);
+    }
+ }
+
+#ifndef DM_NO_MMAP
+
+int dm_double_column_open(const char* path, dm_double_column* column)
+ {
+   struct stat info;
+   void* base = NULL;
+   size_t length = 0U;
+   int fd = -1;
+   int result = DM_COLUMN_OK;
+
+   memset(column, 0, sizeof(*column));
+   fd = open(path, O_RDONLY);
+   if (fd < 0)
+      return DM_COLUMN_IO;
+   if (0 != fstat(fd, &info))
+    {
+      close(fd);
+      return DM_COLUMN_IO;
+    }
+   length = (size_t)info.st_size;
+   if (((off_t)length != info.st_size) || (length < DM_COLUMN_HEADER_SIZE))
+    {
+      close(fd);
+      return DM_COLUMN_FORMAT;
+    }
+   base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd); // The mapping keeps the file.
+   if (MAP_FAILED == base)
+      return DM_COLUMN_IO;
+
+   result = dm_column_parse(column, base, length);
+   if ((DM_COLUMN_OK == result) && (dm_column_layout() != column->layout))
+    {
+         // Only the pages that change are copied.
+      if (0 == mprotect(base, length, PROT_READ | PROT_WRITE))
+       {
+         dm_column_convert(column);
+         mprotect(base, length, PROT_READ);
+       }
+      else
+         result = DM_COLUMN_IO;
+    }
+   if (DM_COLUMN_OK != result)
+    {
+      munmap(base, length);
+      memset(column, 0, sizeof(*column));
+    }
+   return result;
+ }
+
+void dm_double_column_close(dm_double_column* column)
+ {
+   if (NULL != column->base)
+      munmap(column->base, column->length);
+   memset(column, 0, sizeof(*column));
+ }
+
+#else /* DM_NO_MMAP */
+
+int dm_double_column_open(const char* path, dm_double_column* column)
+ {
+   FILE* file = NULL;
+   void* base = NULL;
+   long length = 0;
+   int result = DM_COLUMN_OK;
+
+   memset(column, 0, sizeof(*column));
+   file = fopen(path, "rb");
+   if (NULL == file)
+      return DM_COLUMN_IO;
+   if ((0 != fseek(file, 0, SEEK_END)) || ((length = ftell(file)) < 0) || (0 != fseek(file, 0, SEEK_SET)))
+    {
+      fclose(file);
+      return DM_COLUMN_IO;
+    }
+   if (length < (long)DM_COLUMN_HEADER_SIZE)
+    {
+      fclose(file);
+      return DM_COLUMN_FORMAT;
+    }
+   base = malloc((size_t)length);
+   if (NULL == base)
+    {
+      fclose(file);
+      return DM_COLUMN_MEMORY;
+    }
+   if ((size_t)length != fread(base, 1U, (size_t)length, file))
+      result = DM_COLUMN_IO;
+   fclose(file);
+
+   if (DM_COLUMN_OK == result)
+      result = dm_column_parse(column, base, (size_t)length);
+   if ((DM_COLUMN_OK == result) && (dm_column_layout() != column->layout))
+      dm_column_convert(column);
+   if (DM_COLUMN_OK != result)
+    {
+      free(base);
+      memset(column, 0, sizeof(*column));
+    }
+   return result;
+ }
+
+void dm_double_column_close(dm_double_column* column)
+ {
+   free(column->base);
+   memset(column, 0, sizeof(*column));
+ }
+
+#endif /* DM_NO_MMAP */
+
+const dm_double* dm_double_column_block(const dm_double_column* column, size_t block, size_t* length)
+ {
+   size_t start = block * column->block_size;
+   *length = ((column->count - start) < column->block_size) ? (column->count - start) : column->block_size;
+   return column->values + start;
+ }
+
+   // The negation of the test for an overlap, rather than dm_double_isless(max, low) || dm_double_isless(high, min), so that NaNs skip.
+int dm_double_column_skip(const dm_double_column_zone* zone, dm_double low, dm_double high)
+ {
+   return !(dm_double_islessequal(low, zone->max) && dm_double_islessequal(zone->min, high));
+ }
+
+size_t dm_double_column_select(const dm_double_column* column, dm_double low, dm_double high, size_t* rows)
+ {
+   size_t found = 0U;
+   for (size_t block = 0U; block < column->blocks; ++block)
+    {
+      const dm_double_column_zone* zone = &column->zones[block];
+      size_t start = block * column->block_size;
+      size_t length = 0U;
+      const dm_double* values = dm_double_column_block(column, block, &length);
+
+      if (dm_double_column_skip(zone, low, high))
+         continue;
+      if ((0U == zone->nulls) && dm_double_islessequal(low, zone->min) && dm_double_islessequal(zone->max, high))
+       {
+            // The whole block is in range.
+         for (size_t i = 0U; i < length; ++i)
+            rows[found + i] = start + i;
+         found += length;
+       }
+      else
+       {
+            // Only the matches are written: rows may have no room past them.
+         for (size_t i = 0U; i < length; ++i)
+            if (dm_double_islessequal(low, values[i]) && dm_double_islessequal(values[i], high))
+               rows[found++] = start + i;
+       }
+    }
+   return found;
+ }
@@ -0,0 +1,127 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_COLUMN_H
+#define DM_DOUBLE_COLUMN_H
+
+/*
+   A file format for a column of dm_doubles, and range scans over it.
+
+   The file is a 64 byte header, a zone map, and the values, in the byte order
+   of the machine that wrote it:
+
+      "DMCOLUMN"   eight bytes of magic
+      version      uint32_t, DM_COLUMN_VERSION
+      layout       uint32_t, DM_COLUMN_LEGACY or DM_COLUMN_MISRA
+      count        uint64_t, the number of values
+      block_size   uint64_t, values per block
+      blocks       uint64_t, count / block_size, rounded up
+      zones        uint64_t, the offset of the zone map: 64
+      data         uint64_t, the offset of the values, a multiple of 64
+      reserved     uint64_t, zero
+
+   The zone map has a dm_double_column_zone for each block: the least and the
+   greatest of the values in the block that aren't NaN, and the number of
+   NaNs, which are the nulls of the column. A block of nothing but NaNs has
+   NaN for both.
+
+   dm_double_column_open maps the file into memory, and hands out the values
+   where they are, without copying them. A file written by the other
+   implementation is mapped copy-on-write, and its values and zones converted
+   to this implementation's layout (see dm_double_layout.h). Where there is no
+   mmap (on Windows, or with DM_NO_MMAP defined), the file is read into memory
+   instead.
+
+   dm_double_column_skip tests a block's zone against a closed range, with
+   the comparisons of dm_double_isless, so that range scans only look at the
+   blocks that can hold a match. dm_double_column_select is such a scan.
+
+   Like dm_double_batch.c, this never looks at the representation, and works
+   with either dm_double or dm_double_m.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_COLUMN_VERSION       1U
+#define DM_COLUMN_LEGACY        0 // dm_double.c
+#define DM_COLUMN_MISRA         1 // dm_double_m.c
+#define DM_COLUMN_HEADER_SIZE   64U
+#define DM_COLUMN_DEFAULT_BLOCK 4096U
+
+   // Status codes
+#define DM_COLUMN_OK     0
+#define DM_COLUMN_IO     1 // See errno.
+#define DM_COLUMN_FORMAT 2 // Not a column file, or a damaged one.
+#define DM_COLUMN_MEMORY 3 // Only without mmap.
+
+typedef struct dm_double_column_zone
+ {
+   dm_double min;
+   dm_double max;
+   uint64_t nulls;
+ } dm_double_column_zone;
+
+typedef struct dm_double_column
+ {
+   const dm_double* values;             // All of them, one block after another.
+   const dm_double_column_zone* zones;  // One for each block.
+   size_t count;
+   size_t block_size;
+   size_t blocks;
+   int layout;                          // Of the file. The values have been converted, if it isn't this one's.
+   void* base;                          // The mapping, for dm_double_column_close.
+   size_t length;
+ } dm_double_column;
+
+   // A block size of zero is DM_COLUMN_DEFAULT_BLOCK.
+int dm_double_column_write (const char*, const dm_double*, size_t, size_t);
+int dm_double_column_open  (const char*, dm_double_column*);
+void dm_double_column_close (dm_double_column*);
+
+   // The values of one block, and how many there are.
+const dm_double* dm_double_column_block (const dm_double_column*, size_t, size_t*);
+
+   // Whether no value of the zone's block can be in [low, high]. Always true for NaN bounds.
+int dm_double_column_skip (const dm_double_column_zone*, dm_double, dm_double);
+
+   // Writes the index of every value in [low, high] to rows, which needs room for all of them, in order, and returns how many there were.
+size_t dm_double_column_select (const dm_double_column*, dm_double, dm_double, size_t*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_DOUBLE_COLUMN_H */
@@ -0,0 +1,1636 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_CORE_H
+#define DM_DOUBLE_CORE_H
+
+/*
+   The arithmetic core shared by dm_double.c, dm_double_m.c, and the
+   compile-time arithmetic of dm_double.hpp.
+
+   The functions here work on unpacked finite, non-zero numbers, and
+   return unpacked results that have been rounded, but not flushed: the
+   callers handle the special values, the range of the exponent, and the
+   packing for their layout. Everything is static inline in C, and
+   constexpr in C++ (which needs C++14 or later), so the C library and the
+   C++ constant folding get their results from the same code.
+
+   Include dm_double.h or dm_double_m.h first: the rounding modes come from
+   there.
+*/
+
+#ifndef DM_DOUBLE_H
+   #error "Include dm_double.h or dm_double_m.h before dm_double_core.h"
+#endif
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+   #define DM_CORE_FUNC  constexpr inline
+   #define DM_CORE_TABLE constexpr
+#else
+   #define DM_CORE_FUNC  static inline
+   #define DM_CORE_TABLE static const
+#endif
+
+#ifndef __SIZEOF_INT128__
+   #ifndef DM_NO_128_BIT_TYPE
+      #define DM_NO_128_BIT_TYPE
+   #endif
+#endif
+
+#define DM_CORE_BIAS            10000000000000000ULL
+#define DM_CORE_MAX_SIGNIFICAND  9999999999999999ULL
+#define DM_CORE_MIN_SIGNIFICAND  1000000000000000ULL
+#define DM_CORE_CUTOFF          16
+
+   // What happened while computing a result, for the statistics and the status flags.
+#define DM_CORE_INEXACT      0x01 // The rounding had a non-zero remainder
+#define DM_CORE_INCREMENT    0x02 // The rounding incremented the significand
+#define DM_CORE_DEGENERATE   0x04 // dm_core_add with exponents more than CUTOFF + 1 apart
+#define DM_CORE_PATHOLOGICAL 0x08 // dm_core_fma needing every digit for cancellation
+
+typedef struct dm_core_number
+ {
+   int sign;             // Non-zero is negative
+   int32_t exponent;
+   uint64_t significand; // MIN_SIGNIFICAND to MAX_SIGNIFICAND, or zero for a result of zero
+ } dm_core_number;
+
+DM_CORE_TABLE uint64_t dm_core_makeShift [] = // The same as makeShift: the index is one more than the power.
+ {
+   1ULL, // -1
+   1ULL, // 0
+                  10ULL,               100ULL,           1000ULL,           10000ULL,           100000ULL, // 5
+             1000000ULL,          10000000ULL,      100000000ULL,      1000000000ULL,      10000000000ULL, // 10
+        100000000000ULL,     1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, // 15
+   10000000000000000ULL, 10000000000000000ULL // 16
+ };
+
+   // Every power of ten that fits in 64 bits: the index is the power.
+DM_CORE_TABLE uint64_t dm_core_powers [] =
+ {
+   1ULL,                   10ULL,                   100ULL,                   1000ULL,                   10000ULL,
+   100000ULL,              1000000ULL,              10000000ULL,              100000000ULL,              1000000000ULL,
+   10000000000ULL,         100000000000ULL,         1000000000000ULL,         10000000000000ULL,         100000000000000ULL,
+   1000000000000000ULL,    10000000000000000ULL,    100000000000000000ULL,    1000000000000000000ULL,    10000000000000000000ULL
+ };
+
+   // For 5 ^ 16, 5 ^ 8, 5 ^ 4, 5 ^ 2, and 5: the inverse modulo 2 ^ 64, and (2 ^ 64 - 1) / 5 ^ k.
+   // n is a multiple of 5 ^ k exactly when n times the inverse is no more than the limit, and then the product is the quotient.
+DM_CORE_TABLE uint64_t dm_core_fiveInverse [] = { 0xE4A4D1417CD9A041ULL, 0xC767074B22E90E21ULL, 0xD288CE703AFB7E91ULL, 0x8F5C28F5C28F5C29ULL, 0xCCCCCCCCCCCCCCCDULL };
+DM_CORE_TABLE uint64_t dm_core_fiveLimit [] = { 120892581ULL, 47223664828696ULL, 29514790517935282ULL, 737869762948382064ULL, 3689348814741910323ULL };
+
+   // The number of bits in arg, 0 for 0.
+DM_CORE_FUNC int dm_core_bits(uint64_t arg)
+ {
+#if defined(__GNUC__) || defined(__clang__)
+   return (0U == arg) ? 0 : (64 - __builtin_clzll(arg));
+#else
+   int result = 0;
+   uint64_t rest = arg;
+   for (int step = 32; step > 0; step >>= 1)
+    {
+      if (0U != (rest >> step))
+       {
+         rest >>= step;
+         result += step;
+       }
+    }
+   return result + (int)rest;
+#endif
+ }
+
+   // The number of decimal digits in arg, 0 for 0: the bit count gives the answer or one less.
+DM_CORE_FUNC int dm_core_digits(uint64_t arg)
+ {
+   int guess = (dm_core_bits(arg) * 1233) >> 12; // 1233 / 4096 is just over log10(2)
+   return guess + ((arg >= dm_core_powers[guess]) ? 1 : 0);
+ }
+
+   // Divides the trailing decimal zeros out of a non-zero arg, by halving steps, and returns how many there were.
+   // A step of k removes 10 ^ k when the low k bits are clear and what is left is a multiple of 5 ^ k.
+DM_CORE_FUNC int dm_core_strip(uint64_t* arg)
+ {
+   int result = 0;
+   uint64_t rest = *arg;
+   for (int step = 0; step < 5; ++step)
+    {
+      int k = 16 >> step;
+      uint64_t quotient = (rest >> k) * dm_core_fiveInverse[step];
+      if ((0U == (rest & ((1ULL << k) - 1U))) && (quotient <= dm_core_fiveLimit[step]))
+       {
+         rest = quotient;
+         result += k;
+       }
+    }
+   *arg = rest;
+   return result;
+ }
+
+   // The number of trailing decimal zeros of a non-zero arg.
+DM_CORE_FUNC int dm_core_trailingZeros(uint64_t arg)
+ {
+   uint64_t rest = arg;
+   return dm_core_strip(&rest);
+ }
+
+
+   // A 128 bit unsigned number, with just enough operations for the arithmetic.
+#ifndef DM_NO_128_BIT_TYPE
+typedef __uint128_t dm_core_wide;
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_mul(uint64_t lhs, uint64_t rhs)
+ {
+   return ((dm_core_wide)lhs) * rhs;
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_mulBy(dm_core_wide lhs, uint64_t rhs)
+ {
+   return lhs * rhs;
+ }
+
+   // The quotient must fit in 64 bits.
+DM_CORE_FUNC uint64_t dm_core_wide_divBy(dm_core_wide lhs, uint64_t rhs, uint64_t* rem)
+ {
+   *rem = (uint64_t)(lhs % rhs);
+   return (uint64_t)(lhs / rhs);
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_sub(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   return lhs - rhs;
+ }
+
+DM_CORE_FUNC int dm_core_wide_less(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   return lhs < rhs;
+ }
+
+DM_CORE_FUNC int dm_core_wide_zero(dm_core_wide arg)
+ {
+   return 0U == arg;
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_add(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   return lhs + rhs;
+ }
+
+   // Unlike divBy, the quotient can be wide.
+DM_CORE_FUNC dm_core_wide dm_core_wide_div(dm_core_wide lhs, uint64_t rhs, uint64_t* rem)
+ {
+   *rem = (uint64_t)(lhs % rhs);
+   return lhs / rhs;
+ }
+
+   // The value must fit in 64 bits.
+DM_CORE_FUNC uint64_t dm_core_wide_low(dm_core_wide arg)
+ {
+   return (uint64_t)arg;
+ }
+
+DM_CORE_FUNC uint64_t dm_core_wide_high(dm_core_wide arg)
+ {
+   return (uint64_t)(arg >> 64U);
+ }
+#else /* DM_NO_128_BIT_TYPE */
+typedef struct dm_core_wide
+ {
+   uint64_t high;
+   uint64_t low;
+ } dm_core_wide;
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_mul(uint64_t lhs, uint64_t rhs)
+ {
+      // Schoolbook multiplication of 32 bit halves: none of the partial sums can overflow.
+   uint64_t lhsLow = lhs & 0xFFFFFFFFU;
+   uint64_t lhsHigh = lhs >> 32U;
+   uint64_t rhsLow = rhs & 0xFFFFFFFFU;
+   uint64_t rhsHigh = rhs >> 32U;
+   uint64_t lowLow = lhsLow * rhsLow;
+   uint64_t middle = (lhsHigh * rhsLow) + (lowLow >> 32U);
+   uint64_t middle2 = (lhsLow * rhsHigh) + (middle & 0xFFFFFFFFU);
+   dm_core_wide result = { 0U, 0U };
+   result.high = (lhsHigh * rhsHigh) + (middle >> 32U) + (middle2 >> 32U);
+   result.low = (middle2 << 32U) | (lowLow & 0xFFFFFFFFU);
+   return result;
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_mulBy(dm_core_wide lhs, uint64_t rhs)
+ {
+   dm_core_wide result = dm_core_wide_mul(lhs.low, rhs);
+   result.high += lhs.high * rhs;
+   return result;
+ }
+
+   // The quotient must fit in 64 bits: that is, lhs.high < rhs.
+DM_CORE_FUNC uint64_t dm_core_wide_divBy(dm_core_wide lhs, uint64_t rhs, uint64_t* rem)
+ {
+      // Shift-subtract one bit at a time. Every divisor in the arithmetic is less than 2 ^ 63,
+      // so the running remainder can be doubled without overflowing.
+   uint64_t remainder = lhs.high;
+   uint64_t quotient = 0U;
+   for (int bit = 63; bit >= 0; --bit)
+    {
+      remainder = (remainder << 1U) | ((lhs.low >> bit) & 1U);
+      quotient <<= 1U;
+      if (remainder >= rhs)
+       {
+         remainder -= rhs;
+         quotient |= 1U;
+       }
+    }
+   *rem = remainder;
+   return quotient;
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_sub(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   dm_core_wide result = { 0U, 0U };
+   result.low = lhs.low - rhs.low;
+   result.high = lhs.high - rhs.high - ((lhs.low < rhs.low) ? 1U : 0U);
+   return result;
+ }
+
+DM_CORE_FUNC int dm_core_wide_less(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   return (lhs.high < rhs.high) || ((lhs.high == rhs.high) && (lhs.low < rhs.low));
+ }
+
+DM_CORE_FUNC int dm_core_wide_zero(dm_core_wide arg)
+ {
+   return 0U == (arg.high | arg.low);
+ }
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_add(dm_core_wide lhs, dm_core_wide rhs)
+ {
+   dm_core_wide result = { 0U, 0U };
+   result.low = lhs.low + rhs.low;
+   result.high = lhs.high + rhs.high + ((result.low < lhs.low) ? 1U : 0U);
+   return result;
+ }
+
+   // Unlike divBy, the quotient can be wide. The divisor must be less than 2 ^ 63.
+DM_CORE_FUNC dm_core_wide dm_core_wide_div(dm_core_wide lhs, uint64_t rhs, uint64_t* rem)
+ {
+   dm_core_wide result = { 0U, 0U };
+   dm_core_wide rest = { 0U, 0U };
+   rest.high = lhs.high % rhs;
+   rest.low = lhs.low;
+   result.high = lhs.high / rhs;
+   result.low = dm_core_wide_divBy(rest, rhs, rem);
+   return result;
+ }
+
+   // The value must fit in 64 bits.
+DM_CORE_FUNC uint64_t dm_core_wide_low(dm_core_wide arg)
+ {
+   return arg.low;
+ }
+
+DM_CORE_FUNC uint64_t dm_core_wide_high(dm_core_wide arg)
+ {
+   return arg.high;
+ }
+#endif /* DM_NO_128_BIT_TYPE */
+
+DM_CORE_FUNC dm_core_wide dm_core_wide_from(uint64_t arg)
+ {
+   return dm_core_wide_mul(arg, 1U);
+ }
+
+   // The number of decimal digits in a non-zero arg, which must be less than 10 ^ 37.
+DM_CORE_FUNC int dm_core_wide_digits(dm_core_wide arg)
+ {
+   uint64_t high = dm_core_wide_high(arg);
+   int result = 0;
+   if (0U == high)
+    {
+      result = dm_core_digits(dm_core_wide_low(arg));
+    }
+   else
+    {
+      int guess = ((64 + dm_core_bits(high)) * 1233) >> 12;
+      result = guess + (dm_core_wide_less(arg, dm_core_wide_mul(dm_core_powers[guess - 18], dm_core_powers[18])) ? 0 : 1);
+    }
+   return result;
+ }
+
+
+   // This code is suspiciously familiar....
+// sign - sign of result (non-zero is negative)
+// sodd - whether the current significand is even : significand & 1
+// comp - divisor - 2 * remainder : this will be positive if we should round down, negative if we should round up, and zero if we are exactly in the middle
+// zero - whether the remainder is zero : one if the division was exact (if one, comp must be positive)
+// returns whether the unsigned significand should be incremented away from zero
+DM_CORE_FUNC int dm_core_decideRound(int sign, int sodd, int64_t comp, int zero, int round_mode)
+ {
+   int result = 0;
+   switch (round_mode)
+    {
+      case DM_FE_TONEAREST:
+         result = (comp < 0) || ((comp == 0) && sodd);
+         break;
+      case DM_FE_TONEARESTFROMZERO:
+         result = comp <= 0;
+         break;
+      case DM_FE_UPWARD:
+         result = !sign && !zero;
+         break;
+      case DM_FE_DOWNWARD:
+         result = sign && !zero;
+         break;
+      case DM_FE_TOWARDZERO:
+         break;
+      case DM_FE_TONEARESTODD:
+         result = (comp < 0) || ((comp == 0) && !sodd);
+         break;
+      case DM_FE_TONEARESTTOWARDZERO:
+         result = comp < 0;
+         break;
+      case DM_FE_FROMZERO:
+         result = !zero;
+         break;
+      default:
+            // This case should never happen and indicates a programming error.
+         break;
+    }
+   return result;
+ }
+
+   // Sticky rounding of digits that will be rounded again.
+DM_CORE_FUNC uint64_t dm_core_internal_round(uint64_t quot, uint64_t rem)
+ {
+   uint64_t result = 0U;
+   if ((0U != rem) && (0U == (quot % 5U)))
+    {
+      result = 1U; // Remainder mod 10 is 0 or 5
+    }
+   return result;
+ }
+
+   // Rounds quot, the result of dividing by divisor with a remainder of rem.
+DM_CORE_FUNC uint64_t dm_core_round(int sign, uint64_t quot, uint64_t divisor, uint64_t rem, int round_mode, int* events)
+ {
+   uint64_t result = quot;
+   if (0U != rem)
+    {
+      *events |= DM_CORE_INEXACT;
+    }
+   if (dm_core_decideRound(sign, (int)(quot & 1U), (int64_t)divisor - (int64_t)(rem << 1U), 0U == rem, round_mode))
+    {
+      *events |= DM_CORE_INCREMENT;
+      ++result;
+    }
+   return result;
+ }
+
+
+DM_CORE_FUNC dm_core_number dm_core_add(dm_core_number lhs, dm_core_number rhs, int round_mode, int* events)
+ {
+   uint64_t lhd = lhs.significand;
+   uint64_t rhd = rhs.significand;
+   uint64_t resultSignificand = 0U;
+
+      // Normalize exponents
+   int32_t resultExponent = lhs.exponent;
+   int32_t expDiff = 0;
+   if (lhs.exponent > rhs.exponent)
+    {
+      if ((lhs.exponent - rhs.exponent) <= (DM_CORE_CUTOFF + 1))
+       {
+         expDiff = lhs.exponent - rhs.exponent;
+         if (expDiff > 2) // 2 : guard digit, rounding digit / sticky digit
+          {
+            uint64_t removed = rhd % dm_core_makeShift[(expDiff - 2) + 1];
+            rhd /= dm_core_makeShift[(expDiff - 2) + 1];
+            rhd += dm_core_internal_round(rhd, removed);
+            expDiff = 2;
+          }
+         lhd *= dm_core_makeShift[expDiff + 1];
+       }
+      else
+       {
+         *events |= DM_CORE_DEGENERATE;
+         expDiff = 2;
+         lhd *= 100U;
+         rhd = 1U;
+       }
+    }
+   else if (lhs.exponent < rhs.exponent)
+    {
+      resultExponent = rhs.exponent;
+      if ((rhs.exponent - lhs.exponent) <= (DM_CORE_CUTOFF + 1))
+       {
+         expDiff = rhs.exponent - lhs.exponent;
+         if (expDiff > 2)
+          {
+            uint64_t removed = lhd % dm_core_makeShift[(expDiff - 2) + 1];
+            lhd /= dm_core_makeShift[(expDiff - 2) + 1];
+            lhd += dm_core_internal_round(lhd, removed);
+            expDiff = 2;
+          }
+         rhd *= dm_core_makeShift[expDiff + 1];
+       }
+      else
+       {
+         *events |= DM_CORE_DEGENERATE;
+         expDiff = 2;
+         rhd *= 100U;
+         lhd = 1U;
+       }
+    }
+   else
+    {
+      // No normalization needed
+    }
+
+      // Compute the digits and sign.
+   int resultSign = !!lhs.sign;
+   if (!!lhs.sign == !!rhs.sign) // Both same sign
+    {
+      lhd += rhd;
+    }
+   else // Different Signs
+    {
+      if (lhd >= rhd) // lhs larger : result sign of lhs
+       {
+         lhd -= rhd;
+       }
+      else // rhs larger : result sign of rhs (opposite sign of lhs)
+       {
+         lhd = rhd - lhd;
+         resultSign = !resultSign;
+       }
+    }
+
+      // Normalize the result
+   if (0U == lhd)
+    {
+      resultSign = DM_FE_DOWNWARD == round_mode;
+    }
+   else if (lhd > DM_CORE_MAX_SIGNIFICAND)
+    {
+      if (0 == expDiff) // Did overflow occur? ie 9 + 9
+       {
+         ++resultExponent;
+       }
+      uint64_t temp = dm_core_makeShift[expDiff]; // This is why the table has one extra entry: we want the previous entry here.
+      uint64_t test = DM_CORE_BIAS * dm_core_makeShift[expDiff];
+      if (lhd < test) // Did destructive cancellation occur? ie 100 - 1.
+       {
+         --resultExponent;
+       }
+      else
+       {
+         temp *= 10U;
+         test *= 10U;
+         if (lhd >= test) // Did overflow occur? ie 99 + 1
+          {
+            ++resultExponent;
+            temp *= 10U;
+          }
+       }
+      resultSignificand = dm_core_round(resultSign, lhd / temp, temp, lhd % temp, round_mode, events);
+      if (resultSignificand == DM_CORE_BIAS)
+       {
+         resultSignificand = DM_CORE_MIN_SIGNIFICAND;
+         ++resultExponent;
+       }
+    }
+   else
+    {
+      resultSignificand = lhd;
+      if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
+       {
+         --resultExponent;
+       }
+      int shift = DM_CORE_CUTOFF - dm_core_digits(resultSignificand);
+      resultSignificand *= dm_core_makeShift[shift + 1];
+      resultExponent -= shift;
+    }
+
+   dm_core_number result = { resultSign, resultExponent, resultSignificand };
+   return result;
+ }
+
+DM_CORE_FUNC dm_core_number dm_core_mul(dm_core_number lhs, dm_core_number rhs, int round_mode, int* events)
+ {
+   int resultSign = !!lhs.sign != !!rhs.sign;
+   int32_t resultExponent = lhs.exponent + rhs.exponent;
+
+   dm_core_wide lhd = dm_core_wide_mul(lhs.significand, rhs.significand);
+
+   uint64_t temp = DM_CORE_MIN_SIGNIFICAND;
+   if (!dm_core_wide_less(lhd, dm_core_wide_mul(DM_CORE_BIAS, DM_CORE_MIN_SIGNIFICAND))) // lhd >= BIAS * MIN_SIGNIFICAND
+    {
+      temp *= 10U;
+      ++resultExponent;
+    }
+
+   uint64_t rem = 0U;
+   uint64_t quot = dm_core_wide_divBy(lhd, temp, &rem);
+      // This can't cause an overflow.
+   dm_core_number result = { resultSign, resultExponent, dm_core_round(resultSign, quot, temp, rem, round_mode, events) };
+   return result;
+ }
+
+DM_CORE_FUNC dm_core_number dm_core_div(dm_core_number lhs, dm_core_number rhs, int round_mode, int* events)
+ {
+   int resultSign = !!lhs.sign != !!rhs.sign;
+   int32_t resultExponent = lhs.exponent - rhs.exponent;
+
+   uint64_t rhd = rhs.significand;
+   if (lhs.significand < rhs.significand)
+    {
+      --resultExponent;
+    }
+   else
+    {
+      rhd *= 10U;
+    }
+
+   uint64_t rem = 0U;
+   uint64_t quot = dm_core_wide_divBy(dm_core_wide_mul(lhs.significand, DM_CORE_BIAS), rhd, &rem);
+      // This can't cause an overflow.
+   dm_core_number result = { resultSign, resultExponent, dm_core_round(resultSign, quot, rhd, rem, round_mode, events) };
+   return result;
+ }
+
+   // The integer square root of a number from 10 ^ 15 to 10 ^ 17, by Newton's method from above.
+DM_CORE_FUNC uint64_t dm_core_isqrt(uint64_t arg)
+ {
+   uint64_t result = (arg < DM_CORE_BIAS) ? 100000000U : 316227767U; // At least the root
+   uint64_t next = (result + arg / result) >> 1U;
+   while (next < result)
+    {
+      result = next;
+      next = (result + arg / result) >> 1U;
+    }
+   return result;
+ }
+
+   // The square root of a positive number.
+DM_CORE_FUNC dm_core_number dm_core_sqrt(dm_core_number arg, int round_mode, int* events)
+ {
+      // Scale the significand to thirty-one or thirty-two digits, so that the exponent left over is even,
+      // and the root has sixteen digits.
+   int odd = (int)(arg.exponent & 1);
+   dm_core_wide square = dm_core_wide_mul(arg.significand, odd ? DM_CORE_BIAS : DM_CORE_MIN_SIGNIFICAND);
+   int32_t resultExponent = DM_CORE_CUTOFF - 1 + (arg.exponent - (DM_CORE_CUTOFF - 1) - (odd ? 16 : 15)) / 2;
+
+      // Start from above, with the root of the leading digits, and the quotients only get closer.
+      // The last quotient gives the remainder: square = quot * root + rem, and quot >= root.
+   uint64_t root = odd ? (dm_core_isqrt(arg.significand) + 1U) * 100000000U : (dm_core_isqrt(arg.significand * 10U) + 1U) * 10000000U;
+   uint64_t rem = 0U;
+   uint64_t quot = dm_core_wide_divBy(square, root, &rem);
+   uint64_t next = (root + quot) >> 1U;
+   while (next < root)
+    {
+      root = next;
+      quot = dm_core_wide_divBy(square, root, &rem);
+      next = (root + quot) >> 1U;
+    }
+
+      // The root is between root and root + 1, and it is never exactly halfway, as (root + 1/2) ^ 2 isn't an integer.
+      // So, rounding square - root ^ 2 out of 2 * root + 1 rounds the root.
+   uint64_t resultSignificand = dm_core_round(0, root, 2U * root + 1U, (quot - root) * root + rem, round_mode, events);
+   if (DM_CORE_BIAS == resultSignificand)
+    {
+      resultSignificand = DM_CORE_MIN_SIGNIFICAND;
+      ++resultExponent;
+    }
+
+   dm_core_number result = { 0, resultExponent, resultSignificand };
+   return result;
+ }
+
+DM_CORE_FUNC dm_core_number dm_core_fma(dm_core_number lhs, dm_core_number rhs, dm_core_number ths, int round_mode, int* events)
+ {
+   int prodSign = !!lhs.sign != !!rhs.sign;
+   int thsSign = !!ths.sign;
+
+      // Compute the exponent of the product: the caller flushes at the end.
+   int32_t phse = lhs.exponent + rhs.exponent;
+
+      // Now, we can start the multiply proper!
+   dm_core_wide lhd = dm_core_wide_mul(lhs.significand, rhs.significand);
+
+   dm_core_wide test = dm_core_wide_mul(DM_CORE_BIAS, DM_CORE_MIN_SIGNIFICAND);
+   if (!dm_core_wide_less(lhd, test)) // lhd >= BIAS * MIN_SIGNIFICAND
+    {
+      ++phse;
+    }
+   else // Normalize the location of the product.
+    {
+      lhd = dm_core_wide_mulBy(lhd, 10U);
+    }
+
+   int32_t resultExponent = phse;
+   uint64_t resultSignificand = 0U;
+   int resultSign = prodSign;
+
+   int32_t thse = ths.exponent;
+   int32_t expDiff = phse - thse;
+   if (expDiff < 0)
+    {
+      expDiff = -expDiff;
+    }
+      // If we are not the special case (the case where we have to do a full subtraction)
+      // If the exponents are equal and the signs different, we may need all of the digits in order to handle cancellation.
+   if (!((expDiff < 2) && (prodSign != thsSign)))
+    {
+      uint64_t thd = ths.significand * 100U;
+
+      uint64_t rem = 0U;
+      uint64_t phd = dm_core_wide_divBy(lhd, DM_CORE_MIN_SIGNIFICAND / 10U, &rem);
+      phd += dm_core_internal_round(phd, rem);
+
+      if (phse > thse)
+       {
+         if (expDiff <= (DM_CORE_CUTOFF + 1))
+          {
+            uint64_t removed = thd % dm_core_makeShift[expDiff + 1];
+            thd /= dm_core_makeShift[expDiff + 1];
+            thd += dm_core_internal_round(thd, removed);
+          }
+         else
+          {
+            thd = 1U;
+          }
+       }
+      else if (phse < thse)
+       {
+         resultExponent = thse;
+         if (expDiff <= (DM_CORE_CUTOFF + 1))
+          {
+            uint64_t removed = phd % dm_core_makeShift[expDiff + 1];
+            phd /= dm_core_makeShift[expDiff + 1];
+            phd += dm_core_internal_round(phd, removed);
+          }
+         else
+          {
+            phd = 1U;
+          }
+       }
+      else
+       {
+         // No normalization needed
+       }
+
+         // Compute the digits and sign.
+      if (prodSign == thsSign) // Both same sign
+       {
+         phd += thd;
+       }
+      else // Different Signs
+       {
+         if (phd >= thd) // lhs larger : result sign of lhs
+          {
+            phd -= thd;
+          }
+         else // rhs larger : result sign of rhs (opposite sign of lhs)
+          {
+            phd = thd - phd;
+            resultSign = !resultSign;
+          }
+       }
+
+         // Normalize the result: this cannot possibly be zero.
+      uint64_t scal = 10U;
+      uint64_t limit = DM_CORE_BIAS * 10U;
+      if (phd < limit) // Did destructive cancellation occur? ie 100 - 1.
+       {
+         --resultExponent;
+       }
+      else
+       {
+         scal *= 10U;
+         limit *= 10U;
+         if (phd >= limit) // Did overflow occur? ie 9 + 1
+          {
+            ++resultExponent;
+            scal *= 10U;
+          }
+       }
+      resultSignificand = dm_core_round(resultSign, phd / scal, scal, phd % scal, round_mode, events);
+      if (resultSignificand == DM_CORE_BIAS)
+       {
+         resultSignificand = DM_CORE_MIN_SIGNIFICAND;
+         ++resultExponent;
+       }
+    }
+   else // The pathological case
+    {
+      *events |= DM_CORE_PATHOLOGICAL;
+      dm_core_wide thd = dm_core_wide_mul(ths.significand, DM_CORE_BIAS);
+
+      if (phse > thse)
+       {
+         lhd = dm_core_wide_mulBy(lhd, 10U);
+       }
+      else if (phse < thse)
+       {
+         resultExponent = thse;
+         thd = dm_core_wide_mulBy(thd, 10U);
+       }
+      else
+       {
+         // No normalization needed
+       }
+
+      if (!dm_core_wide_less(lhd, thd)) // lhs larger : result sign of lhs
+       {
+         lhd = dm_core_wide_sub(lhd, thd);
+       }
+      else // rhs larger : result sign of rhs (opposite sign of lhs)
+       {
+         lhd = dm_core_wide_sub(thd, lhd);
+         resultSign = !resultSign;
+       }
+
+      uint64_t rem = 0U;
+      if (dm_core_wide_zero(lhd))
+       {
+         resultSign = DM_FE_DOWNWARD == round_mode;
+       }
+      else if (!dm_core_wide_less(lhd, dm_core_wide_mul(DM_CORE_BIAS, DM_CORE_BIAS)))
+       {
+         uint64_t quot = dm_core_wide_divBy(lhd, DM_CORE_BIAS * 10U, &rem);
+         resultSignificand = dm_core_round(resultSign, quot, DM_CORE_BIAS * 10U, rem, round_mode, events);
+       }
+      else
+       {
+         if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
+          {
+            --resultExponent;
+          }
+         int shift = (2 * DM_CORE_CUTOFF) - dm_core_wide_digits(lhd); // Up to test, which has thirty-two digits
+         resultExponent -= shift;
+         if (shift > DM_CORE_CUTOFF)
+          {
+            lhd = dm_core_wide_mulBy(lhd, DM_CORE_BIAS);
+            shift -= DM_CORE_CUTOFF;
+          }
+         lhd = dm_core_wide_mulBy(lhd, dm_core_makeShift[shift + 1]);
+         uint64_t quot = dm_core_wide_divBy(lhd, DM_CORE_BIAS, &rem);
+         resultSignificand = dm_core_round(resultSign, quot, DM_CORE_BIAS, rem, round_mode, events);
+       }
+    }
+
+   dm_core_number result = { resultSign, resultExponent, resultSignificand };
+   return result;
+ }
+
+
+/*
+   The exponential and logarithmic functions: exp, expm1, log, log10, log1p, and pow.
+
+   These aren't correctly rounded. The decimal exponent takes out the powers of ten (so that, for
+   example, the common logarithm of a power of ten is exact), a small table takes out most of what is
+   left, and a short series finishes the job. The arithmetic is integer fixed point, with eighteen
+   decimal places, or dm_core_wide where more are needed: the reductions are exact, and the series
+   are evaluated by Horner's rule with one rounding per step. The approximation is then rounded once,
+   in the requested mode. README.md has the error bound.
+*/
+
+#define DM_CORE_FIXED    1000000000000000000ULL // One, with eighteen decimal places
+#define DM_CORE_LN10     2302585092994045684ULL // ln(10), with eighteen decimal places (truncated)
+#define DM_CORE_LN10_LOW    179914546843642ULL // The next sixteen decimal places of ln(10)
+#define DM_CORE_INV_LN10 4342944819032518277ULL // 1 / ln(10), with nineteen decimal places
+#define DM_CORE_FLUSH    100000                 // An exponent that every layout flushes
+
+   // exp(j / 32), for j from -37 to 37, with eighteen decimal places.
+DM_CORE_TABLE int64_t dm_core_expTable [] =
+ {
+    314663961018459027LL,  324652467358349730LL,  334958042925294954LL,  345590752576974516LL,  356560980663946984LL, // -33
+    367879441171442322LL,  379557188183089584LL,  391605626676798993LL,  404036523663342095LL,  416862019678508403LL, // -28
+    430094640640062251LL,  443747310081079872LL,  457833361771614261LL,  472366552741014707LL,  487361076713619111LL, // -23
+    502831577970940960LL,  518793165653889356LL,  535261428518990242LL,  552252450163020365LL,  569782824730923010LL, // -18
+    587869673122346494LL,  606530659712633424LL,  625784009604591122LL,  645648526427892037LL,  666143610703487774LL, // -13
+    687289278790972199LL,  709106182437398412LL,  731615628946641791LL,  754839601989007337LL,  778800783071404868LL, // -8
+    803522573689060734LL,  829029118180400343LL,  855345327307422538LL,  882496902584595403LL,  910510361380034128LL, // -3
+    939413062813475786LL,  969233234476344082LL, 1000000000000000000LL, 1031743407499102671LL, 1064494458917859430LL, // 2
+   1098285140307825849LL, 1133148453066826317LL, 1169118446169504402LL, 1206230249420980711LL, 1244520107766095155LL, // 7
+   1284025416687741484LL, 1324784758728865569LL, 1366837941173796363LL, 1410226034925710706LL, 1454991414618201336LL, // 12
+   1501177800000122752LL, 1548830298634133098LL, 1597995449950633268LL, 1648721270700128147LL, 1701057301848400679LL, // 17
+   1755054656960298557LL, 1810766072119387164LL, 1868245957432222407LL, 1927550450167544665LL, 1988737469582291831LL, // 22
+   2051866773487976824LL, 2117000016612674669LL, 2184200810815617925LL, 2253534787213208545LL, 2325069660277121051LL, // 27
+   2398875293967097915LL, 2475023769963025215LL, 2553589458062926873LL, 2634649088815631112LL, 2718281828459045235LL, // 32
+   2804569356237226612LL, 2893595944171760941LL, 2985448539365355891LL, 3080216848918031245LL, 3177993427538838277LL // 37
+ };
+
+   // ln(j / 10), for j from 10 to 95: eighteen decimal places (truncated), and the next thirteen.
+DM_CORE_TABLE uint64_t dm_core_logTable [][2] =
+ {
+   {                   0ULL,             0ULL }, // 1.0
+   {   95310179804324860ULL,  439521232808ULL }, // 1.1
+   {  182321556793954626ULL, 2117180251545ULL }, // 1.2
+   {  262364264467491052ULL,  354959868810ULL }, // 1.3
+   {  336472236621212930ULL, 5045934102170ULL }, // 1.4
+   {  405465108108164381ULL, 9780131154643ULL }, // 1.5
+   {  470003629245735553ULL, 6509370311483ULL }, // 1.6
+   {  530628251062170396ULL, 2315431631888ULL }, // 1.7
+   {  587786664902119008ULL, 1897311406189ULL }, // 1.8
+   {  641853886172394775ULL, 9910359772035ULL }, // 1.9
+   {  693147180559945309ULL, 4172321214582ULL }, // 2.0
+   {  741937344729377312ULL, 4826065256813ULL }, // 2.1
+   {  788457360364270169ULL, 4611842447389ULL }, // 2.2
+   {  832909122935104006ULL, 7887613771258ULL }, // 2.3
+   {  875468737353899935ULL, 6289501466127ULL }, // 2.4
+   {  916290731874155065ULL, 1835272117680ULL }, // 2.5
+   {  955511445027436361ULL, 4527281083391ULL }, // 2.6
+   {  993251773010283390ULL, 1677442560832ULL }, // 2.7
+   { 1029619417181158239ULL, 9218255316752ULL }, // 2.8
+   { 1064710736992428343ULL, 1652805776775ULL }, // 2.9
+   { 1098612288668109691ULL, 3952452369225ULL }, // 3.0
+   { 1131402111491100561ULL, 9111728698580ULL }, // 3.1
+   { 1163150809805680863ULL,  681691526065ULL }, // 3.2
+   { 1193922468472434551ULL, 4391973602033ULL }, // 3.3
+   { 1223775431622115705ULL, 6487752846469ULL }, // 3.4
+   { 1252762968495367995ULL, 6881206219850ULL }, // 3.5
+   { 1280933845462064317ULL, 6069632620770ULL }, // 3.6
+   { 1308332819650178760ULL, 3501042163471ULL }, // 3.7
+   { 1335001066732340085ULL, 4082680986617ULL }, // 3.8
+   { 1360976553135600743ULL, 4307412238035ULL }, // 3.9
+   { 1386294361119890618ULL, 8344642429164ULL }, // 4.0
+   { 1410986973710262119ULL, 8487719183530ULL }, // 4.1
+   { 1435084525289322621ULL, 8998386471395ULL }, // 4.2
+   { 1458615022699516739ULL, 4548510586615ULL }, // 4.3
+   { 1481604540924215478ULL, 8784163661971ULL }, // 4.4
+   { 1504077396776274073ULL, 3732583523869ULL }, // 4.5
+   { 1526056303495049316ULL, 2059934985840ULL }, // 4.6
+   { 1547562508716012902ULL, 8029592150878ULL }, // 4.7
+   { 1568615917913845245ULL,  461822680709ULL }, // 4.8
+   { 1589235205116580926ULL, 1927140322020ULL }, // 4.9
+   { 1609437912434100374ULL, 6007593332262ULL }, // 5.0
+   { 1629240539730280087ULL, 6267884001113ULL }, // 5.1
+   { 1648658625587381670ULL, 8699602297973ULL }, // 5.2
+   { 1667706820558076150ULL, 1264776843447ULL }, // 5.3
+   { 1686398953570228699ULL, 5849763775414ULL }, // 5.4
+   { 1704748092238425234ULL, 6447114565070ULL }, // 5.5
+   { 1722766597741103549ULL, 3390576531333ULL }, // 5.6
+   { 1740466174840504467ULL, 3862812141260ULL }, // 5.7
+   { 1757857917552373652ULL, 5825126991357ULL }, // 5.8
+   { 1774952350911673766ULL, 5980589190353ULL }, // 5.9
+   { 1791759469228055000ULL, 8124773583807ULL }, // 6.0
+   { 1808288771179265564ULL, 7333976487413ULL }, // 6.1
+   { 1824549292051045871ULL, 3284049913162ULL }, // 6.2
+   { 1840549633397487003ULL, 8778517626039ULL }, // 6.3
+   { 1856297990365626172ULL, 4854012740647ULL }, // 6.4
+   { 1871802176901591426ULL, 6362553201071ULL }, // 6.5
+   { 1887069649032379860ULL, 8564294816615ULL }, // 6.6
+   { 1902107526396920375ULL, 6520805416794ULL }, // 6.7
+   { 1916922612182061015ULL,  660074061051ULL }, // 6.8
+   { 1931521411603213698ULL, 1840066140484ULL }, // 6.9
+   { 1945910149055313305ULL, 1053527434432ULL }, // 7.0
+   { 1960094784047269737ULL, 3114630778287ULL }, // 7.1
+   { 1974081026022009627ULL,  241953835352ULL }, // 7.2
+   { 1987874348154345445ULL,  741174027542ULL }, // 7.3
+   { 2001480000210124069ULL, 7673363378053ULL }, // 7.4
+   { 2014903020542264756ULL, 5787724486905ULL }, // 7.5
+   { 2028148247292285394ULL, 8255002201198ULL }, // 7.6
+   { 2041220328859638165ULL, 1493048667239ULL }, // 7.7
+   { 2054123733695546052ULL, 8479733452617ULL }, // 7.8
+   { 2066862759472975810ULL, 1549540867970ULL }, // 7.9
+   { 2079441541679835928ULL, 2516963643745ULL }, // 8.0
+   { 2091864061678393081ULL, 5629894930057ULL }, // 8.1
+   { 2104134154270207429ULL, 2660040398112ULL }, // 8.2
+   { 2116255514802552239ULL, 4574807686070ULL }, // 8.3
+   { 2128231705849267931ULL, 3170707685977ULL }, // 8.4
+   { 2140066163496270770ULL, 8323024964149ULL }, // 8.5
+   { 2151762203259462048ULL, 8720831801197ULL }, // 8.6
+   { 2163323025660538034ULL, 5605258146001ULL }, // 8.7
+   { 2174751721484160788ULL, 2956484876553ULL }, // 8.8
+   { 2186051276738094154ULL, 2998240859855ULL }, // 8.9
+   { 2197224577336219382ULL, 7904904738451ULL }, // 9.0
+   { 2208274413522804357ULL, 1408487303241ULL }, // 9.1
+   { 2219203484054994625ULL, 6232256200422ULL }, // 9.2
+   { 2230014400159210253ULL, 3064181067805ULL }, // 9.3
+   { 2240709689275958212ULL, 2201913365460ULL }, // 9.4
+   { 2251291798606495150ULL, 5917953104297ULL }  // 9.5
+ };
+
+   // 10 ^ power, for power from 0 to 19.
+DM_CORE_FUNC uint64_t dm_core_pow10(int32_t power)
+ {
+   uint64_t result = dm_core_makeShift[((power > 16) ? 16 : power) + 1];
+   for (int32_t extra = power; extra > 16; --extra)
+    {
+      result *= 10U;
+    }
+   return result;
+ }
+
+   // lhs * rhs in fixed point, rounded to nearest. The product must fit.
+DM_CORE_FUNC int64_t dm_core_fixed_mul(int64_t lhs, int64_t rhs)
+ {
+   uint64_t rem = 0U;
+   uint64_t quot = dm_core_wide_divBy(dm_core_wide_mul((uint64_t)((lhs < 0) ? -lhs : lhs), (uint64_t)((rhs < 0) ? -rhs : rhs)), DM_CORE_FIXED, &rem);
+   if (rem >= (DM_CORE_FIXED >> 1U))
+    {
+      ++quot;
+    }
+   return ((lhs < 0) != (rhs < 0)) ? -(int64_t)quot : (int64_t)quot;
+ }
+
+   // The magnitude of a number from 10 ^ -18 to 10 ^ 4 in fixed point: exact for exponents from -3 up, and truncated below.
+DM_CORE_FUNC dm_core_wide dm_core_toFixed(dm_core_number arg)
+ {
+   dm_core_wide result = dm_core_wide_from(arg.significand / dm_core_makeShift[((arg.exponent < -3) ? (-3 - arg.exponent) : 0) + 1]);
+   if (arg.exponent > -3)
+    {
+      result = dm_core_wide_mul(arg.significand, dm_core_makeShift[arg.exponent + 3 + 1]);
+    }
+   return result;
+ }
+
+   // value * 10 ^ power, rounded to nearest, and saturating at 10 ^ 30, which is far more than the exponential can take.
+DM_CORE_FUNC dm_core_wide dm_core_wide_scale(dm_core_wide value, int32_t power)
+ {
+   dm_core_wide limit = dm_core_wide_mul(DM_CORE_FIXED, DM_CORE_FIXED / 1000000U);
+   dm_core_wide result = value;
+   uint64_t rem = 0U;
+   int32_t left = power;
+   while ((left > 0) && dm_core_wide_less(result, limit))
+    {
+      int32_t step = (left > 8) ? 8 : left;
+      result = dm_core_wide_mulBy(result, dm_core_makeShift[step + 1]);
+      left -= step;
+    }
+   if (left > 0)
+    {
+      result = limit;
+    }
+   while ((left < 0) && !dm_core_wide_zero(result))
+    {
+      int32_t step = (left < -16) ? 16 : -left;
+      result = dm_core_wide_div(result, dm_core_makeShift[step + 1], &rem);
+      if (rem >= (dm_core_makeShift[step + 1] - rem))
+       {
+         result = dm_core_wide_add(result, dm_core_wide_from(1U));
+       }
+      left += step;
+    }
+   return result;
+ }
+
+   // Add a signed value to a sum held as a sign and a magnitude.
+DM_CORE_FUNC dm_core_wide dm_core_wide_accumulate(dm_core_wide sum, int* sumSign, dm_core_wide value, int sign)
+ {
+   dm_core_wide result = dm_core_wide_add(sum, value);
+   if (*sumSign != sign)
+    {
+      if (dm_core_wide_less(sum, value))
+       {
+         result = dm_core_wide_sub(value, sum);
+         *sumSign = sign;
+       }
+      else
+       {
+         result = dm_core_wide_sub(sum, value);
+       }
+    }
+   return result;
+ }
+
+   // Cut a non-zero wide value down to nineteen digits (or fewer, if that's all there are), with a sticky last digit.
+   // The number of digits removed is added to power.
+DM_CORE_FUNC uint64_t dm_core_shorten(dm_core_wide value, int32_t* power)
+ {
+   dm_core_wide rest = value;
+   uint64_t rem = 0U;
+   uint64_t sticky = 0U;
+   int32_t shift = 0;
+   if (!dm_core_wide_less(rest, dm_core_wide_mul(DM_CORE_FIXED * 10U, DM_CORE_BIAS)))
+    {
+      rest = dm_core_wide_div(rest, DM_CORE_BIAS, &sticky);
+      *power += DM_CORE_CUTOFF;
+    }
+   if (!dm_core_wide_less(rest, dm_core_wide_mul(DM_CORE_FIXED * 10U, 100000000U)))
+    {
+      shift = 8;
+    }
+   while (!dm_core_wide_less(rest, dm_core_wide_mul(DM_CORE_FIXED * 10U, dm_core_makeShift[shift + 1])))
+    {
+      ++shift;
+    }
+   uint64_t result = dm_core_wide_divBy(rest, dm_core_makeShift[shift + 1], &rem);
+   *power += shift;
+   return result + dm_core_internal_round(result, rem | sticky);
+ }
+
+   // Round digits * 10 ^ power, for non-zero digits.
+DM_CORE_FUNC dm_core_number dm_core_fromDigits(int sign, uint64_t digits, int32_t power, int round_mode, int* events)
+ {
+   int count = dm_core_digits(digits);
+   uint64_t scaled = digits;
+   uint64_t divisor = 1U;
+   int32_t resultExponent = power + count - 1;
+   if (count < DM_CORE_CUTOFF)
+    {
+      scaled *= dm_core_makeShift[(DM_CORE_CUTOFF - count) + 1];
+    }
+   else
+    {
+      divisor = dm_core_powers[count - DM_CORE_CUTOFF];
+    }
+   uint64_t resultSignificand = dm_core_round(sign, scaled / divisor, divisor, scaled % divisor, round_mode, events);
+   if (DM_CORE_BIAS == resultSignificand)
+    {
+      resultSignificand = DM_CORE_MIN_SIGNIFICAND;
+      ++resultExponent;
+    }
+
+   dm_core_number result = { sign, resultExponent, resultSignificand };
+   return result;
+ }
+
+   // expm1(t) / t, for |t| <= 1 / 64, to the term in t ^ 7.
+DM_CORE_FUNC int64_t dm_core_expm1_series(int64_t t)
+ {
+   int64_t result = 24801587301587LL; // 1 / 8!
+   result = 198412698412698LL + dm_core_fixed_mul(result, t); // 1 / 7!
+   result = 1388888888888889LL + dm_core_fixed_mul(result, t); // 1 / 6!
+   result = 8333333333333333LL + dm_core_fixed_mul(result, t); // 1 / 5!
+   result = 41666666666666667LL + dm_core_fixed_mul(result, t); // 1 / 4!
+   result = 166666666666666667LL + dm_core_fixed_mul(result, t); // 1 / 3!
+   result = 500000000000000000LL + dm_core_fixed_mul(result, t); // 1 / 2!
+   result = (int64_t)DM_CORE_FIXED + dm_core_fixed_mul(result, t);
+   return result;
+ }
+
+   // exp(x) = y * 10 ^ k, for x in fixed point, with a magnitude less than 2 * 10 ^ 22.
+   // Returns y, in fixed point, from 10 ^ -1/2 to 10 ^ 1/2.
+DM_CORE_FUNC int64_t dm_core_exp_fixed(int sign, dm_core_wide x, int32_t* k)
+ {
+      // x = k ln(10) + r, with |r| <= ln(10) / 2. The low digits of ln(10) keep r accurate when k is large.
+   uint64_t rem = 0U;
+   uint64_t count = dm_core_wide_divBy(x, DM_CORE_LN10, &rem);
+   int64_t reduced = (int64_t)rem;
+   if (rem > (DM_CORE_LN10 >> 1U))
+    {
+      ++count;
+      reduced -= (int64_t)DM_CORE_LN10;
+    }
+   reduced -= (int64_t)dm_core_wide_divBy(dm_core_wide_add(dm_core_wide_mul(count, DM_CORE_LN10_LOW), dm_core_wide_from(DM_CORE_BIAS >> 1U)), DM_CORE_BIAS, &rem);
+   if (0 != sign)
+    {
+      reduced = -reduced;
+    }
+   *k = (0 != sign) ? -(int32_t)count : (int32_t)count;
+
+      // r = j / 32 + t, with |t| <= 1 / 64, and exp(r) = exp(j / 32) + exp(j / 32) expm1(t).
+   int64_t step = (int64_t)(DM_CORE_FIXED >> 5U);
+   int64_t index = (reduced + ((reduced < 0) ? -(step >> 1) : (step >> 1))) / step;
+   int64_t t = reduced - index * step;
+   int64_t scale = dm_core_expTable[index + 37];
+   return scale + dm_core_fixed_mul(scale, dm_core_fixed_mul(t, dm_core_expm1_series(t)));
+ }
+
+   // 2 atanh(u) = ln((1 + u) / (1 - u)), for u = num * 10 ^ numPower / den, with den in fixed point
+   // from 0.2 to 2.1, and |u| < 0.03. Returns the result as wide * 10 ^ power, to more than thirty digits.
+DM_CORE_FUNC dm_core_wide dm_core_atanh2(uint64_t num, int32_t numPower, uint64_t den, int32_t* power)
+ {
+      // u to about thirty-six digits, in two parts: u = (high + low / 10 ^ 18) * 10 ^ uPower.
+   uint64_t scaled = num;
+   int32_t uPower = numPower;
+   uint64_t rem = 0U;
+   while (scaled < (DM_CORE_FIXED / 10U))
+    {
+      scaled *= 10U;
+      --uPower;
+    }
+   uint64_t high = dm_core_wide_divBy(dm_core_wide_mul(scaled, DM_CORE_FIXED), den, &rem);
+   uint64_t low = dm_core_wide_divBy(dm_core_wide_mul(rem, DM_CORE_FIXED), den, &rem);
+
+      // 2 atanh(u) = 2u + 2u v (1/3 + v/5 + v^2/7 + ...), with v = u ^ 2 < 0.0009. The first term is exact,
+      // and the second is small enough that it only needs to be accurate relative to itself.
+   int64_t u = (-uPower - 18 > 19) ? 0 : (int64_t)(high / dm_core_pow10(-uPower - 18));
+   int64_t v = dm_core_fixed_mul(u, u);
+   int64_t series = (int64_t)(DM_CORE_FIXED / 13U);
+   series = (int64_t)(DM_CORE_FIXED / 11U) + dm_core_fixed_mul(series, v);
+   series = (int64_t)(DM_CORE_FIXED / 9U) + dm_core_fixed_mul(series, v);
+   series = (int64_t)(DM_CORE_FIXED / 7U) + dm_core_fixed_mul(series, v);
+   series = (int64_t)(DM_CORE_FIXED / 5U) + dm_core_fixed_mul(series, v);
+   series = (int64_t)(DM_CORE_FIXED / 3U) + dm_core_fixed_mul(series, v);
+   int32_t termPower = 0;
+   uint64_t term = dm_core_shorten(dm_core_wide_mul(high, high), &termPower);
+   term = dm_core_shorten(dm_core_wide_mul(term, high), &termPower);
+   term = dm_core_shorten(dm_core_wide_mul(term, (uint64_t)series), &termPower); // u v series = term * 10 ^ (termPower + 3 uPower - 18)
+
+   dm_core_wide result = dm_core_wide_add(dm_core_wide_mul(high, DM_CORE_FIXED), dm_core_wide_from(low));
+   result = dm_core_wide_add(result, dm_core_wide_scale(dm_core_wide_from(term), termPower + 2 * uPower));
+   *power = uPower - 18;
+   return dm_core_wide_mulBy(result, 2U);
+ }
+
+   // ln(m * 10 ^ exponent) = exponent ln(10) + ln(c) + 2 atanh((m - c) / (m + c)), with m in fixed point from
+   // one to ten, and c = j / 10 the closest tenth to m (or one, for m from 9.5 up, which adds one to exponent).
+   // Returns j, and the last term as wide * 10 ^ power, with its sign.
+DM_CORE_FUNC dm_core_wide dm_core_log_reduce(uint64_t m, int32_t* exponent, int32_t* index, int* sign, int32_t* power)
+ {
+   uint64_t tenth = DM_CORE_FIXED / 10U;
+   uint64_t scaled = m;
+   if (scaled >= (95U * tenth))
+    {
+      scaled /= 10U;
+      *exponent += 1;
+    }
+   *index = (int32_t)((scaled + (tenth >> 1U)) / tenth);
+   uint64_t center = (uint64_t)*index * tenth;
+   dm_core_wide result = dm_core_wide_from(0U);
+   *sign = scaled < center;
+   *power = 0;
+   if (scaled != center)
+    {
+      result = dm_core_atanh2((0 != *sign) ? center - scaled : scaled - center, -19, (scaled + 5U) / 10U + center / 10U, power);
+    }
+   return result;
+ }
+
+   // ln(m * 10 ^ exponent) as wide * 10 ^ power, with a sign, for m in fixed point from one to ten.
+   // Close to one, this is accurate relative to the result; elsewhere, it has thirty-one decimal places.
+DM_CORE_FUNC dm_core_wide dm_core_log_wide(uint64_t m, int32_t exponent, int* sign, int32_t* power)
+ {
+   int32_t resultExponent = exponent;
+   int32_t index = 0;
+   dm_core_wide result = dm_core_log_reduce(m, &resultExponent, &index, sign, power);
+   if ((0 != resultExponent) || (10 != index))
+    {
+      dm_core_wide ln10 = dm_core_wide_add(dm_core_wide_mul(DM_CORE_LN10, dm_core_makeShift[13 + 1]), dm_core_wide_from((DM_CORE_LN10_LOW + 500U) / 1000U));
+      result = dm_core_wide_scale(result, *power + 31);
+      result = dm_core_wide_accumulate(result, sign, dm_core_wide_add(dm_core_wide_mul(dm_core_logTable[index - 10][0], dm_core_makeShift[13 + 1]), dm_core_wide_from(dm_core_logTable[index - 10][1])), 0);
+      result = dm_core_wide_accumulate(result, sign, dm_core_wide_mulBy(ln10, (uint64_t)((resultExponent < 0) ? -resultExponent : resultExponent)), resultExponent < 0);
+      *power = -31;
+    }
+   return result;
+ }
+
+   // The exponential of a number.
+DM_CORE_FUNC dm_core_number dm_core_exp(dm_core_number arg, int round_mode, int* events)
+ {
+   dm_core_number result = { 0, (0 != arg.sign) ? -DM_CORE_FLUSH : DM_CORE_FLUSH, DM_CORE_MIN_SIGNIFICAND };
+   if (arg.exponent < -18)
+    {
+         // exp(x) = 1 + x, to well past the last digit: only the direction matters.
+      result = dm_core_fromDigits(0, (0 != arg.sign) ? DM_CORE_FIXED - 1U : DM_CORE_FIXED + 1U, -18, round_mode, events);
+    }
+   else if (arg.exponent < 4) // Otherwise, |x| >= 10 ^ 4, which overflows or underflows.
+    {
+      int32_t power = 0;
+      int64_t digits = dm_core_exp_fixed(arg.sign, dm_core_toFixed(arg), &power);
+      result = dm_core_fromDigits(0, (uint64_t)digits, power - 18, round_mode, events);
+    }
+   *events |= DM_CORE_INEXACT;
+   return result;
+ }
+
+   // exp(x) - 1, accurate for x close to zero.
+DM_CORE_FUNC dm_core_number dm_core_expm1(dm_core_number arg, int round_mode, int* events)
+ {
+   dm_core_number result = { 0, DM_CORE_FLUSH, DM_CORE_MIN_SIGNIFICAND };
+   if (arg.exponent < -18)
+    {
+         // expm1(x) = x + x ^ 2 / 2, to well past the last digit.
+      result = dm_core_fromDigits(arg.sign, (0 != arg.sign) ? arg.significand * 1000U - 1U : arg.significand * 1000U + 1U, arg.exponent - 18, round_mode, events);
+    }
+   else if (arg.exponent > 3)
+    {
+      if (0 != arg.sign)
+       {
+         result = dm_core_fromDigits(1, DM_CORE_FIXED - 1U, -18, round_mode, events); // Just above -1
+       }
+    }
+   else
+    {
+      dm_core_wide fixed = dm_core_toFixed(arg);
+      int resultSign = arg.sign;
+      int32_t power = -18;
+      uint64_t digits = 0U;
+      if (arg.exponent < 0)
+       {
+            // For |x| < 1, expm1(x) = x P(x) for |x| <= 1/64, and expm1(2x) = expm1(x) (expm1(x) + 2) takes
+            // larger x down to that. The result is accurate relative to itself.
+         int32_t halvings = 0;
+         while ((dm_core_wide_low(fixed) >> halvings) > (DM_CORE_FIXED >> 6U))
+          {
+            ++halvings;
+          }
+         int64_t t = (int64_t)(dm_core_wide_low(fixed) >> halvings);
+         power = arg.exponent - 33;
+         digits = dm_core_shorten(dm_core_wide_mul(arg.significand, DM_CORE_FIXED >> halvings), &power);
+         power -= 18;
+         digits = dm_core_shorten(dm_core_wide_mul(digits, (uint64_t)dm_core_expm1_series((0 != arg.sign) ? -t : t)), &power);
+         for (; halvings > 0; --halvings)
+          {
+            uint64_t fixedDigits = dm_core_wide_low(dm_core_wide_scale(dm_core_wide_from(digits), power + 18));
+            power -= 18;
+            digits = dm_core_shorten(dm_core_wide_mul(digits, (0 != arg.sign) ? 2U * DM_CORE_FIXED - fixedDigits : 2U * DM_CORE_FIXED + fixedDigits), &power);
+          }
+       }
+      else
+       {
+         int32_t k = 0;
+         int64_t y = dm_core_exp_fixed(arg.sign, fixed, &k);
+         if (0 == k)
+          {
+            resultSign = y < (int64_t)DM_CORE_FIXED;
+            digits = (0 != resultSign) ? DM_CORE_FIXED - (uint64_t)y : (uint64_t)y - DM_CORE_FIXED;
+          }
+         else if (k > 18) // The one is past the digits that matter.
+          {
+            digits = (uint64_t)y - 1U;
+            power = k - 18;
+          }
+         else if (k > 0)
+          {
+            dm_core_wide scaled = dm_core_wide_mulBy(dm_core_wide_mul((uint64_t)y, dm_core_makeShift[((k > 16) ? 16 : k) + 1]), dm_core_pow10((k > 16) ? k - 16 : 0));
+            digits = dm_core_shorten(dm_core_wide_sub(scaled, dm_core_wide_from(DM_CORE_FIXED)), &power);
+          }
+         else if (k >= -16)
+          {
+            power = k - 18;
+            digits = dm_core_shorten(dm_core_wide_sub(dm_core_wide_mul(DM_CORE_FIXED, dm_core_makeShift[-k + 1]), dm_core_wide_from((uint64_t)y)), &power);
+          }
+         else
+          {
+            digits = DM_CORE_FIXED - 1U; // Just above -1
+          }
+       }
+      result = dm_core_fromDigits(resultSign, digits, power, round_mode, events);
+    }
+   *events |= DM_CORE_INEXACT;
+   return result;
+ }
+
+   // The natural logarithm, or the common logarithm, of a positive number.
+DM_CORE_FUNC dm_core_number dm_core_log(dm_core_number arg, int common, int round_mode, int* events)
+ {
+   dm_core_number result = { 0, 0, 0U }; // The logarithm of one is zero.
+   if ((0 != common) && (DM_CORE_MIN_SIGNIFICAND == arg.significand))
+    {
+      if (0 != arg.exponent) // The common logarithm of a power of ten is exact.
+       {
+         result = dm_core_fromDigits(arg.exponent < 0, (uint64_t)((arg.exponent < 0) ? -arg.exponent : arg.exponent), 0, round_mode, events);
+       }
+    }
+   else
+    {
+      int sign = 0;
+      int32_t power = 0;
+      dm_core_wide value = dm_core_log_wide(arg.significand * 1000U, arg.exponent, &sign, &power);
+      if (!dm_core_wide_zero(value))
+       {
+         uint64_t digits = dm_core_shorten(value, &power);
+         if (0 != common)
+          {
+            power -= 19;
+            digits = dm_core_shorten(dm_core_wide_mul(digits, DM_CORE_INV_LN10), &power);
+          }
+         result = dm_core_fromDigits(sign, digits, power, round_mode, events);
+         *events |= DM_CORE_INEXACT;
+       }
+    }
+   return result;
+ }
+
+   // ln(1 + x), for x > -1, accurate for x close to zero.
+DM_CORE_FUNC dm_core_number dm_core_log1p(dm_core_number arg, int round_mode, int* events)
+ {
+   int sign = arg.sign;
+   int32_t power = 0;
+   dm_core_wide value = dm_core_wide_from(0U);
+   if ((arg.exponent < -2) || ((-2 == arg.exponent) && (arg.significand < 5U * DM_CORE_MIN_SIGNIFICAND)))
+    {
+         // For |x| < 0.05, ln(1 + x) = 2 atanh(x / (2 + x)), which is accurate relative to x.
+      uint64_t fixed = (arg.exponent < -18) ? 0U : dm_core_wide_low(dm_core_toFixed(arg));
+      value = dm_core_atanh2(arg.significand, arg.exponent - 15, (0 != sign) ? 2U * DM_CORE_FIXED - fixed : 2U * DM_CORE_FIXED + fixed, &power);
+    }
+   else
+    {
+         // Otherwise, 1 + x is exact in fixed point, or has more digits than the logarithm needs.
+      uint64_t m = DM_CORE_FIXED;
+      int32_t exponent = 0;
+      if (0 != sign)
+       {
+         m -= arg.significand * dm_core_makeShift[arg.exponent + 3 + 1];
+         while (m < DM_CORE_FIXED)
+          {
+            m *= 10U;
+            --exponent;
+          }
+       }
+      else if (arg.exponent < 0)
+       {
+         m += arg.significand * dm_core_makeShift[arg.exponent + 3 + 1];
+       }
+      else
+       {
+         m = arg.significand * 1000U + ((arg.exponent > 18) ? 1U : dm_core_pow10(18 - arg.exponent));
+         exponent = arg.exponent;
+         if (m >= (DM_CORE_FIXED * 10U))
+          {
+            m /= 10U;
+            ++exponent;
+          }
+       }
+      value = dm_core_log_wide(m, exponent, &sign, &power);
+    }
+   uint64_t digits = dm_core_shorten(value, &power);
+   *events |= DM_CORE_INEXACT;
+   return dm_core_fromDigits(sign, digits, power, round_mode, events);
+ }
+
+   // 0 if a number isn't an integer, 1 if it's an even one, and 2 if it's an odd one.
+DM_CORE_FUNC int dm_core_parity(dm_core_number arg)
+ {
+   int result = 1; // From 10 ^ 16 up, every number is a multiple of ten.
+   if (arg.exponent < 0)
+    {
+      result = 0;
+    }
+   else if (arg.exponent < DM_CORE_CUTOFF)
+    {
+      uint64_t shift = dm_core_makeShift[DM_CORE_CUTOFF - 1 - arg.exponent + 1];
+      result = (0U != (arg.significand % shift)) ? 0 : 1 + (int)((arg.significand / shift) & 1U);
+    }
+   return result;
+ }
+
+   // Integer powers are carried to 38 digits, so that they can be rounded once at the end: a significand from
+   // 10 ^ 37 up to 10 ^ 38, truncated, and a flag for whether anything was lost. The truncations leave a relative
+   // error below 2 n 10 ^ -36 in x ^ n, so the result is correctly rounded unless it is that close to a rounding
+   // boundary. Nothing is truncated when the result has 16 digits or fewer, so exact results stay exact.
+#define DM_CORE_HALF_LONG 10000000000000000000ULL // 10 ^ 19, half of the digits
+
+   // Split off the low half of the digits. The divisors of the portable wide division must be less than 2 ^ 63,
+   // so 10 ^ 19 is divided out in two steps.
+DM_CORE_FUNC dm_core_wide dm_core_wide_divHalf(dm_core_wide lhs, uint64_t* rem)
+ {
+   uint64_t lowRem = 0U;
+   uint64_t highRem = 0U;
+   dm_core_wide result = dm_core_wide_div(lhs, 10000000000ULL, &lowRem);
+   result = dm_core_wide_div(result, 1000000000U, &highRem);
+   *rem = (highRem * 10000000000ULL) + lowRem;
+   return result;
+ }
+
+   // lhs * rhs / 10 ^ 38, truncated, renormalized to 38 digits, and with the renormalization taken from the power.
+DM_CORE_FUNC dm_core_wide dm_core_long_mul(dm_core_wide lhs, dm_core_wide rhs, int32_t* power, int* lost)
+ {
+   uint64_t lhsLow = 0U;
+   uint64_t rhsLow = 0U;
+   uint64_t lhsHigh = dm_core_wide_low(dm_core_wide_divHalf(lhs, &lhsLow));
+   uint64_t rhsHigh = dm_core_wide_low(dm_core_wide_divHalf(rhs, &rhsLow));
+   uint64_t lowRem = 0U;
+   uint64_t middleRem = 0U;
+   uint64_t carry = dm_core_wide_low(dm_core_wide_divHalf(dm_core_wide_mul(lhsLow, rhsLow), &lowRem));
+   dm_core_wide middle = dm_core_wide_add(dm_core_wide_add(dm_core_wide_mul(lhsHigh, rhsLow), dm_core_wide_mul(lhsLow, rhsHigh)),
+      dm_core_wide_from(carry));
+   dm_core_wide result = dm_core_wide_add(dm_core_wide_mul(lhsHigh, rhsHigh), dm_core_wide_divHalf(middle, &middleRem));
+   if ((0U != lowRem) || (0U != middleRem))
+    {
+      *lost = 1;
+    }
+   if (dm_core_wide_less(result, dm_core_wide_mul(DM_CORE_HALF_LONG, DM_CORE_FIXED)))
+    {
+      result = dm_core_wide_mulBy(result, 10U);
+      *power -= 1;
+    }
+   return result;
+ }
+
+   // x ^ n, for finite non-zero x and non-zero n, by binary exponentiation. A power of ten only needs its exponent
+   // multiplied. A negative n takes the reciprocal of x first, to 38 digits.
+DM_CORE_FUNC dm_core_number dm_core_powi(dm_core_number base, int64_t n, int round_mode, int* events)
+ {
+   int sign = ((0 != base.sign) && (0 != (n & 1))) ? 1 : 0;
+   dm_core_number result = { sign, 0, DM_CORE_MIN_SIGNIFICAND };
+   uint64_t count = (n < 0) ? 0U - (uint64_t)n : (uint64_t)n;
+   int flush = 0; // Positive to overflow, negative to underflow
+
+   if (DM_CORE_MIN_SIGNIFICAND == base.significand)
+    {
+      int64_t exponent = (int64_t)base.exponent * ((n < 0) ? -1 : 1);
+      if ((0 != exponent) && (count > (uint64_t)DM_CORE_FLUSH))
+       {
+         flush = (exponent < 0) ? -1 : 1;
+       }
+      else
+       {
+         result.exponent = (int32_t)(exponent * (int64_t)count);
+       }
+    }
+   else
+    {
+      int lost = 0;
+      dm_core_wide square = dm_core_wide_mulBy(dm_core_wide_mul(base.significand, DM_CORE_HALF_LONG), 1000U); // 10 ^ 37 up to 10 ^ 38
+      int32_t squarePower = base.exponent - 37;
+      dm_core_wide product = dm_core_wide_from(0U);
+      int32_t productPower = 0;
+      if (n < 0)
+       {
+            // 10 ^ 53 / significand, in two steps.
+         uint64_t rem = 0U;
+         dm_core_wide high = dm_core_wide_div(dm_core_wide_mul(DM_CORE_HALF_LONG, DM_CORE_HALF_LONG), base.significand, &rem);
+         uint64_t low = dm_core_wide_divBy(dm_core_wide_mul(rem, DM_CORE_MIN_SIGNIFICAND), base.significand, &rem);
+         square = dm_core_wide_add(dm_core_wide_mulBy(high, DM_CORE_MIN_SIGNIFICAND), dm_core_wide_from(low));
+         squarePower = -38 - base.exponent;
+         lost = (0U != rem) ? 1 : 0;
+       }
+      while ((0U != count) && (0 == flush))
+       {
+         if (0U != (count & 1U))
+          {
+            if (dm_core_wide_zero(product))
+             {
+               product = square;
+               productPower = squarePower;
+             }
+            else
+             {
+               productPower += squarePower + 38;
+               product = dm_core_long_mul(product, square, &productPower, &lost);
+             }
+          }
+         count >>= 1U;
+         if (0U != count)
+          {
+            squarePower += squarePower + 38;
+            square = dm_core_long_mul(square, square, &squarePower, &lost);
+
+               // Every factor is on the same side of one, so the result is at least this far out.
+            if ((squarePower > 1000) || (squarePower < -1000))
+             {
+               flush = (squarePower < 0) ? -1 : 1;
+             }
+          }
+       }
+      if (0 == flush)
+       {
+            // Leave the last digit non-zero if anything was lost, so that the rounding sees it.
+         uint64_t rem = 0U;
+         (void)dm_core_wide_div(product, 10U, &rem);
+         if ((0 != lost) && (0U == rem))
+          {
+            product = dm_core_wide_add(product, dm_core_wide_from(1U));
+          }
+         uint64_t digits = dm_core_shorten(product, &productPower);
+         result = dm_core_fromDigits(sign, digits, productPower, round_mode, events);
+       }
+    }
+   if (0 != flush)
+    {
+      result.exponent = flush * DM_CORE_FLUSH;
+      *events |= DM_CORE_INEXACT;
+    }
+   return result;
+ }
+
+   // x ^ y = exp(y ln(x)), for finite non-zero x and y. The sign of x is taken to be the sign of the result:
+   // the caller works that out from y.
+DM_CORE_FUNC dm_core_number dm_core_pow_real(dm_core_number lhs, dm_core_number rhs, int round_mode, int* events)
+ {
+   dm_core_number result = { lhs.sign, 0, DM_CORE_MIN_SIGNIFICAND };
+   int flush = 0; // Positive to overflow, negative to underflow
+   int32_t exponent = lhs.exponent;
+   int32_t index = 0;
+   int atanhSign = 0;
+   int32_t atanhPower = 0;
+   dm_core_wide atanh = dm_core_log_reduce(lhs.significand * 1000U, &exponent, &index, &atanhSign, &atanhPower);
+
+      // Center ln(c) on zero, so that when the exponent isn't zero, exponent ln(10) gives the sign of ln(x),
+      // and bounds the rest.
+   uint64_t lowLn10 = (DM_CORE_LN10_LOW + 500U) / 1000U;
+   uint64_t tableHigh = dm_core_logTable[index - 10][0];
+   uint64_t tableLow = dm_core_logTable[index - 10][1];
+   int tableSign = 0;
+   if (index > 31)
+    {
+      ++exponent;
+      tableSign = 1;
+      tableHigh = DM_CORE_LN10 - tableHigh - ((tableLow > lowLn10) ? 1U : 0U);
+      tableLow = ((tableLow > lowLn10) ? dm_core_makeShift[13 + 1] : 0U) + lowLn10 - tableLow;
+    }
+   int logSign = (0 != exponent) ? (exponent < 0) : ((10 != index) ? tableSign : atanhSign);
+   int32_t yPower = rhs.exponent - (DM_CORE_CUTOFF - 1);
+
+   if ((rhs.exponent > 5) && ((0 != exponent) || (10 != index)))
+    {
+         // |y| >= 10 ^ 6, and |ln(x)| > 0.048.
+      flush = (rhs.sign != logSign) ? -1 : 1;
+    }
+   else
+    {
+         // y ln(x) = k ln(10) + w, with k the nearest integer to y exponent, and w in fixed point.
+      dm_core_wide sum = dm_core_wide_from(0U);
+      int sumSign = 0;
+      int32_t whole = 0;
+      if (0 != exponent)
+       {
+         uint64_t product = rhs.significand * (uint64_t)((exponent < 0) ? -exponent : exponent);
+         int productSign = rhs.sign != (exponent < 0);
+         uint64_t fraction = product;
+         sumSign = productSign;
+         if (yPower > -20)
+          {
+            uint64_t unit = dm_core_pow10(-yPower);
+            uint64_t count = product / unit;
+            fraction = product % unit;
+            if (fraction >= (unit - fraction))
+             {
+               ++count;
+               fraction = unit - fraction;
+               sumSign = !productSign;
+             }
+            if (count > 4000U)
+             {
+               flush = (0 != productSign) ? -1 : 1;
+             }
+            whole = (0 != productSign) ? -(int32_t)count : (int32_t)count;
+          }
+         sum = dm_core_wide_scale(dm_core_wide_mul(fraction, DM_CORE_LN10), yPower);
+       }
+      if (10 != index)
+       {
+         dm_core_wide part = dm_core_wide_add(dm_core_wide_scale(dm_core_wide_mul(rhs.significand, tableHigh), yPower),
+            dm_core_wide_scale(dm_core_wide_mul(rhs.significand, tableLow), yPower - 13));
+         sum = dm_core_wide_accumulate(sum, &sumSign, part, rhs.sign != tableSign);
+       }
+      if (!dm_core_wide_zero(atanh))
+       {
+         uint64_t rem = 0U;
+         uint64_t high = dm_core_wide_divBy(atanh, DM_CORE_FIXED, &rem);
+         dm_core_wide part = dm_core_wide_add(dm_core_wide_scale(dm_core_wide_mul(rhs.significand, high), atanhPower + 36 + yPower),
+            dm_core_wide_scale(dm_core_wide_mul(rhs.significand, rem), atanhPower + 18 + yPower));
+         sum = dm_core_wide_accumulate(sum, &sumSign, part, rhs.sign != atanhSign);
+       }
+
+      if ((0 == flush) && !dm_core_wide_less(sum, dm_core_wide_mul(DM_CORE_FIXED, 20000U)))
+       {
+         flush = (0 != sumSign) ? -1 : 1;
+       }
+      if (0 == flush)
+       {
+         int32_t power = 0;
+         int64_t digits = dm_core_exp_fixed(sumSign, sum, &power);
+         result = dm_core_fromDigits(lhs.sign, (uint64_t)digits, whole + power - 18, round_mode, events);
+       }
+    }
+   if (0 != flush)
+    {
+      result.exponent = flush * DM_CORE_FLUSH;
+    }
+   *events |= DM_CORE_INEXACT;
+   return result;
+ }
+
+   // x ^ y, for finite non-zero x and y, with the sign of the result on x, as above. Integer powers that fit in
+   // an int64_t go through dm_core_powi, so that those with a 16 digit result are exact.
+DM_CORE_FUNC dm_core_number dm_core_pow(dm_core_number lhs, dm_core_number rhs, int round_mode, int* events)
+ {
+   dm_core_number result = { 0, 0, 0U };
+   if ((rhs.exponent < 18) && (0 != dm_core_parity(rhs)))
+    {
+      int64_t n = (int64_t)((rhs.exponent < (DM_CORE_CUTOFF - 1)) ? (rhs.significand / dm_core_pow10(DM_CORE_CUTOFF - 1 - rhs.exponent)) :
+         (rhs.significand * dm_core_pow10(rhs.exponent - (DM_CORE_CUTOFF - 1))));
+      result = dm_core_powi(lhs, (0 != rhs.sign) ? -n : n, round_mode, events);
+    }
+   else
+    {
+      result = dm_core_pow_real(lhs, rhs, round_mode, events);
+    }
+   return result;
+ }
+
+#endif /* DM_DOUBLE_CORE_H */
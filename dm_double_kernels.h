@@ -0,0 +1,192 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_KERNELS_H
+#define DM_DOUBLE_KERNELS_H
+
+/*
+   The batch kernels for arithmetic, comparison, conversion, and parsing,
+   built inside dm_double.c and dm_double_m.c.
+
+   dm_double_batch.c doesn't know the layout, so the most that it can do is
+   call the scalar functions out of line, and a loop around a call is the
+   same code whatever instruction set it is compiled for. So each
+   implementation includes this header with DM_DOUBLE_KERNELS_DEFINE, and
+   every kernel is instantiated in its translation unit once for each level
+   of dm_double_batch.h: the whole scalar function is inlined into the loop
+   (flatten), and compiled for that level (target), so that the 128 bit
+   multiplies and the digit counts of the core get MULX and LZCNT, and the
+   shifts of the packing get BMI2. dm_double_batch.c asks for the table of a
+   level with dm_double_batch_kernels.
+
+   The exponential, logarithm, and power functions aren't here: each spends
+   its time in a dozen operations, and inlining all of them for every level
+   would only make the library bigger.
+
+   Include dm_double.h or dm_double_m.h first.
+*/
+
+#include <stddef.h>
+
+#include "dm_double_batch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define DM_KERNELS_X86
+#endif
+
+struct dm_batch_kernels
+ {
+   int level; // The DM_ISA_ level they were built for
+   void (*add) (const dm_double*, const dm_double*, dm_double*, size_t, int);
+   void (*sub) (const dm_double*, const dm_double*, dm_double*, size_t, int);
+   void (*mul) (const dm_double*, const dm_double*, dm_double*, size_t, int);
+   void (*div) (const dm_double*, const dm_double*, dm_double*, size_t, int);
+   void (*sqrt) (const dm_double*, dm_double*, size_t, int);
+   void (*fma) (const dm_double*, const dm_double*, const dm_double*, dm_double*, size_t);
+   void (*isless) (const dm_double*, const dm_double*, int*, size_t);
+   void (*islessequal) (const dm_double*, const dm_double*, int*, size_t);
+   void (*isgreater) (const dm_double*, const dm_double*, int*, size_t);
+   void (*isgreaterequal) (const dm_double*, const dm_double*, int*, size_t);
+   void (*isequal) (const dm_double*, const dm_double*, int*, size_t);
+   void (*fromstring) (const char * const *, dm_double*, size_t);
+#ifndef DM_NO_DOUBLE_MATH
+   void (*todouble) (const dm_double*, double*, size_t);
+   void (*fromdouble) (const double*, dm_double*, size_t);
+#endif /* ! DM_NO_DOUBLE_MATH */
+ };
+
+   // The kernels of a DM_ISA_ level, or NULL if that level wasn't built. The caller checks what the CPU supports.
+const struct dm_batch_kernels * dm_double_batch_kernels (int);
+
+#ifdef DM_DOUBLE_KERNELS_DEFINE
+
+#ifdef __GNUC__
+   #define DM_KERNELS_FLATTEN __attribute__((flatten))
+#else
+   #define DM_KERNELS_FLATTEN
+#endif
+
+#define DM_KERNELS_BINARY(name, op, target) \
+   static target DM_KERNELS_FLATTEN void name(const dm_double* lhs, const dm_double* rhs, dm_double* dest, size_t count, int round_mode) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = op(lhs[i], rhs[i], round_mode); \
+    }
+
+#define DM_KERNELS_COMPARE(name, op, target) \
+   static target DM_KERNELS_FLATTEN void name(const dm_double* lhs, const dm_double* rhs, int* dest, size_t count) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = op(lhs[i], rhs[i]); \
+    }
+
+#ifndef DM_NO_DOUBLE_MATH
+#define DM_KERNELS_DOUBLE(name, target) \
+   static target DM_KERNELS_FLATTEN void name##_todouble(const dm_double* src, double* dest, size_t count) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = dm_double_todouble(src[i]); \
+    } \
+   static target DM_KERNELS_FLATTEN void name##_fromdouble(const double* src, dm_double* dest, size_t count) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = dm_double_fromdouble(src[i]); \
+    }
+#define DM_KERNELS_DOUBLE_ENTRIES(name) , name##_todouble, name##_fromdouble
+#else
+#define DM_KERNELS_DOUBLE(name, target)
+#define DM_KERNELS_DOUBLE_ENTRIES(name)
+#endif /* ! DM_NO_DOUBLE_MATH */
+
+   // Instantiate every kernel for one instruction set level, and the table that points to them.
+#define DM_KERNELS_LEVEL(name, level, target) \
+   DM_KERNELS_BINARY(name##_add, dm_double_add_r, target) \
+   DM_KERNELS_BINARY(name##_sub, dm_double_sub_r, target) \
+   DM_KERNELS_BINARY(name##_mul, dm_double_mul_r, target) \
+   DM_KERNELS_BINARY(name##_div, dm_double_div_r, target) \
+   static target DM_KERNELS_FLATTEN void name##_sqrt(const dm_double* src, dm_double* dest, size_t count, int round_mode) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = dm_double_sqrt_r(src[i], round_mode); \
+    } \
+   static target DM_KERNELS_FLATTEN void name##_fma(const dm_double* lhs, const dm_double* rhs, const dm_double* ths, dm_double* dest, size_t count) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = dm_double_fma(lhs[i], rhs[i], ths[i]); \
+    } \
+   DM_KERNELS_COMPARE(name##_isless, dm_double_isless, target) \
+   DM_KERNELS_COMPARE(name##_islessequal, dm_double_islessequal, target) \
+   DM_KERNELS_COMPARE(name##_isgreater, dm_double_isgreater, target) \
+   DM_KERNELS_COMPARE(name##_isgreaterequal, dm_double_isgreaterequal, target) \
+   DM_KERNELS_COMPARE(name##_isequal, dm_double_isequal, target) \
+   static target DM_KERNELS_FLATTEN void name##_fromstring(const char * const * src, dm_double* dest, size_t count) \
+    { \
+      for (size_t i = 0U; i < count; ++i) \
+         dest[i] = dm_double_fromstring(src[i]); \
+    } \
+   DM_KERNELS_DOUBLE(name, target) \
+   static const struct dm_batch_kernels name##_table = \
+    { \
+      level, name##_add, name##_sub, name##_mul, name##_div, name##_sqrt, name##_fma, \
+      name##_isless, name##_islessequal, name##_isgreater, name##_isgreaterequal, name##_isequal, \
+      name##_fromstring DM_KERNELS_DOUBLE_ENTRIES(name) \
+    };
+
+   // The extensions of each level are those that dm_double_batch.c checks for before selecting it.
+DM_KERNELS_LEVEL(dm_kernels_scalar, DM_ISA_SCALAR, )
+#ifdef DM_KERNELS_X86
+DM_KERNELS_LEVEL(dm_kernels_sse42, DM_ISA_SSE42, __attribute__((target("sse4.2,popcnt"))))
+DM_KERNELS_LEVEL(dm_kernels_avx2, DM_ISA_AVX2, __attribute__((target("avx2,bmi,bmi2,lzcnt,popcnt"))))
+DM_KERNELS_LEVEL(dm_kernels_avx512, DM_ISA_AVX512, __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,bmi,bmi2,lzcnt,popcnt"))))
+#endif /* DM_KERNELS_X86 */
+
+const struct dm_batch_kernels * dm_double_batch_kernels(int level)
+ {
+   static const struct dm_batch_kernels * const levels [] =
+    {
+      &dm_kernels_scalar_table,
+#ifdef DM_KERNELS_X86
+      &dm_kernels_sse42_table,
+      &dm_kernels_avx2_table,
+      &dm_kernels_avx512_table
+#endif /* DM_KERNELS_X86 */
+    };
+   const struct dm_batch_kernels * result = NULL;
+   if ((level >= 0) && ((size_t)level < (sizeof(levels) / sizeof(levels[0]))))
+    {
+      result = levels[level];
+    }
+   return result;
+ }
+
+#endif /* DM_DOUBLE_KERNELS_DEFINE */
+
+#endif /* DM_DOUBLE_KERNELS_H */
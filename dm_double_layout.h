@@ -0,0 +1,84 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_LAYOUT_H
+#define DM_DOUBLE_LAYOUT_H
+
+/*
+   Conversions between the bit layouts of dm_double.c (the legacy layout) and
+   dm_double_m.c (the MISRA layout), for moving stored data from one to the
+   other.
+
+   The significand field is the same in both: the low 53 bits. The legacy
+   layout keeps the sign at bit 53 and the exponent as a ten bit two's
+   complement number above it. The MISRA layout keeps the sign at bit 63 and
+   the exponent biased by 512 below it, so that positive numbers sort as
+   integers. Biasing a ten bit two's complement number by 512 is flipping its
+   top bit, so the conversions are a few shifts and masks, with no branches:
+   the array loops vectorize, and the source and destination may be the same
+   array. Special values and non-canonical bit patterns map bit for bit.
+
+   They don't depend on either implementation, so they need neither linked in,
+   and are not prefixed (see dm_double_prefix.h).
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DM_LAYOUT_SIGNIFICAND_MASK 0x001FFFFFFFFFFFFFULL
+#define DM_LAYOUT_EXPONENT_FLIP    0x200U // The top bit of the exponent field.
+
+static inline uint64_t dm_double_legacy_to_m(uint64_t value)
+ {
+   uint64_t sign = (value >> 53) & 1U;
+   uint64_t exponent = (value >> 54) ^ DM_LAYOUT_EXPONENT_FLIP;
+   return (sign << 63) | (exponent << 53) | (value & DM_LAYOUT_SIGNIFICAND_MASK);
+ }
+
+static inline uint64_t dm_double_m_to_legacy(uint64_t value)
+ {
+   uint64_t sign = value >> 63;
+   uint64_t exponent = ((value >> 53) & 0x3FFU) ^ DM_LAYOUT_EXPONENT_FLIP;
+   return (exponent << 54) | (sign << 53) | (value & DM_LAYOUT_SIGNIFICAND_MASK);
+ }
+
+void dm_double_legacy_to_m_array (const uint64_t*, uint64_t*, size_t);
+void dm_double_m_to_legacy_array (const uint64_t*, uint64_t*, size_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_DOUBLE_LAYOUT_H */
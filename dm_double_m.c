@@ -35,44 +35,51 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <math.h> // Needed for constants such as FP_NORMAL
 
 #include "dm_double_m.h"
+#include "dm_double_core.h"
+#include "dm_single.h"
 #include "dm_muldiv.h"
-
-const int16_t SPECIAL_EXPONENT = -512;
-const int16_t MAX_EXPONENT = 511;
-const int16_t MIN_EXPONENT = -MAX_EXPONENT;
-const uint64_t DM_INFINITY = 0x1FFFFFFFFFFFFFULL;
-const uint64_t SIGN_BIT =  0x8000000000000000ULL;
-const uint64_t EXPONENT_FIELD = 1023ULL; // MAX_EXPONENT - SPECIAL_EXPONENT
-
-const uint64_t BIAS =           10000000000000000ULL;
-const uint64_t MAX_SIGNIFICAND = 9999999999999999ULL;
-const uint64_t MIN_SIGNIFICAND = 1000000000000000ULL;
-const int16_t CUTOFF = 16; // Difference in exponents where we consider the operation degenerate.
-
-dm_double DM_DOUBLE_PACK(uint64_t sign, int16_t exponent, uint64_t significand)
+#include "dm_quad.h"
+#include "dm_decimal64.h"
+#include "dm_double_codec.h"
+#define DM_DOUBLE_KERNELS_DEFINE // The batch kernels are built here, where the functions they loop over can be inlined into them.
+#include "dm_double_kernels.h"
+
+static const int16_t SPECIAL_EXPONENT = -512;
+static const int16_t MAX_EXPONENT = 511;
+static const int16_t MIN_EXPONENT = -MAX_EXPONENT;
+static const uint64_t DM_INFINITY = 0x1FFFFFFFFFFFFFULL;
+static const uint64_t SIGN_BIT =  0x8000000000000000ULL;
+static const uint64_t EXPONENT_FIELD = 1023ULL; // MAX_EXPONENT - SPECIAL_EXPONENT
+
+static const uint64_t BIAS =           10000000000000000ULL;
+static const uint64_t MAX_SIGNIFICAND = 9999999999999999ULL;
+static const uint64_t MIN_SIGNIFICAND = 1000000000000000ULL;
+static const int16_t CUTOFF = 16; // Difference in exponents where we consider the operation degenerate.
+
+static dm_double DM_DOUBLE_PACK(uint64_t sign, int16_t exponent, uint64_t significand)
  {
    int16_t real_exponent = exponent - SPECIAL_EXPONENT;
    uint64_t use_exponent = (uint64_t)real_exponent;
    return (use_exponent << 53) | (significand - MIN_SIGNIFICAND) | (!!sign ? SIGN_BIT : 0U);
  }
-dm_double DM_DOUBLE_PACK_ALT(uint64_t sign, int16_t exponent, uint64_t significand)
+static dm_double DM_DOUBLE_PACK_ALT(uint64_t sign, int16_t exponent, uint64_t significand)
  {
    int16_t real_exponent = exponent - SPECIAL_EXPONENT;
    uint64_t use_exponent = (uint64_t)real_exponent;
    return (use_exponent << 53) | significand | (!!sign ? SIGN_BIT : 0U);
  }
 
-int16_t DM_DOUBLE_UNPACK_EXPONENT(dm_double value)
+static int16_t DM_DOUBLE_UNPACK_EXPONENT(dm_double value)
  {
    uint64_t use_exponent = (value >> 53) & EXPONENT_FIELD;
    int16_t real_exponent = (int16_t)use_exponent;
    return real_exponent + SPECIAL_EXPONENT;
  }
-uint64_t DM_DOUBLE_UNPACK_SIGNIFICAND(dm_double value)
+static uint64_t DM_DOUBLE_UNPACK_SIGNIFICAND(dm_double value)
  {
    return (value & DM_INFINITY) + MIN_SIGNIFICAND;
  }
-uint64_t DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(dm_double value)
+static uint64_t DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(dm_double value)
  {
    return value & DM_INFINITY;
  }
@@ -463,7 +470,7 @@ dm_double dm_double_copysign(dm_double mag, dm_double sgn)
    // Table of powers of ten up to CUTOFF.
    // (Yes, there is an extra entry, for the -1 case that needs to return 1.)
    // There's also an extra entry for 17, for the rounding case when all digits are rounded.
-const uint64_t makeShift [] =
+static const uint64_t makeShift [] =
  {
    1ULL, // -1
    1ULL, // 0
@@ -473,7 +480,49 @@ const uint64_t makeShift [] =
    10000000000000000ULL, 10000000000000000ULL // 16
  };
 
-int dm_global_round_mode = DM_FE_TONEAREST;
+static int dm_global_round_mode = DM_FE_TONEAREST;
+
+#ifdef DM_STATS
+static _Thread_local dm_stats dm_thread_stats;
+#define DM_STATS_COUNT(counter) (++dm_thread_stats.counter)
+
+void dm_stats_snapshot(dm_stats* dest)
+ {
+   *dest = dm_thread_stats;
+ }
+
+void dm_stats_reset(void)
+ {
+   dm_stats zero = { 0U, 0U, 0U, 0U, 0U, 0U };
+   dm_thread_stats = zero;
+ }
+#else
+#define DM_STATS_COUNT(counter) ((void) 0)
+#endif /* DM_STATS */
+
+#ifdef DM_FENV_FLAGS
+static _Thread_local int dm_thread_flags;
+#define DM_FE_RAISE(flags) (dm_thread_flags |= (flags))
+
+int dm_fetestexcept(int excepts)
+ {
+   return dm_thread_flags & excepts & DM_FE_ALL_EXCEPT;
+ }
+
+int dm_feclearexcept(int excepts)
+ {
+   dm_thread_flags &= ~excepts;
+   return 0;
+ }
+
+int dm_feraiseexcept(int excepts)
+ {
+   dm_thread_flags |= excepts & DM_FE_ALL_EXCEPT;
+   return 0;
+ }
+#else
+#define DM_FE_RAISE(flags) ((void) 0)
+#endif /* DM_FENV_FLAGS */
 
 int dm_fesetround(int round_mode)
  {
@@ -498,55 +547,75 @@ int dm_fegetround()
 uint64_t dm_decideRound(int sign, int sodd, int64_t comp, int zero, int round_mode)
  {
    uint64_t result = 0U;
-   switch (round_mode)
+   if (!!dm_core_decideRound(sign, sodd, comp, zero, round_mode))
     {
-      case DM_FE_TONEAREST:
-         if ((comp < 0) || ((comp == 0) && !!sodd))
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_TONEARESTFROMZERO:
-         if (comp <= 0)
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_UPWARD:
-         if (!sign && !zero)
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_DOWNWARD:
-         if (!!sign && !zero)
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_TOWARDZERO:
-         break;
-      case DM_FE_TONEARESTODD:
-         if ((comp < 0) || ((comp == 0) && !sodd))
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_TONEARESTTOWARDZERO:
-         if (comp < 0)
-          {
-            result = 1U;
-          }
-         break;
-      case DM_FE_FROMZERO:
-         if (!zero)
-          {
-            result = 1U;
-          }
-         break;
-      default:
-         // This case should never happen and indicates a programming error.
-         break;
+      result = 1U;
+    }
+   if (!zero)
+    {
+      DM_STATS_COUNT(round_inexact);
+      DM_FE_RAISE(DM_FE_INEXACT);
+    }
+   if (0U != result)
+    {
+      DM_STATS_COUNT(round_increment);
+    }
+   return result;
+ }
+
+   // Count and raise what the arithmetic core reported.
+static void dm_double_report(int events)
+ {
+   if (0 != (events & DM_CORE_INEXACT))
+    {
+      DM_STATS_COUNT(round_inexact);
+      DM_FE_RAISE(DM_FE_INEXACT);
+    }
+   if (0 != (events & DM_CORE_INCREMENT))
+    {
+      DM_STATS_COUNT(round_increment);
+    }
+   if (0 != (events & DM_CORE_DEGENERATE))
+    {
+      DM_STATS_COUNT(add_degenerate);
+    }
+   if (0 != (events & DM_CORE_PATHOLOGICAL))
+    {
+      DM_STATS_COUNT(fma_pathological);
+    }
+ }
+
+   // Unpack a finite, non-zero value for the arithmetic core.
+static dm_core_number dm_double_toCore(dm_double arg)
+ {
+   dm_core_number result = { dm_double_signbit(arg), DM_DOUBLE_UNPACK_EXPONENT(arg), DM_DOUBLE_UNPACK_SIGNIFICAND(arg) };
+   return result;
+ }
+
+   // Pack a result of the arithmetic core, flushing it if the exponent is out of range.
+static dm_double dm_double_fromCore(dm_core_number arg)
+ {
+   dm_double result;
+   uint64_t sign = (0 != arg.sign) ? 1U : 0U;
+   if (0U == arg.significand) // An exact zero
+    {
+      result = DM_DOUBLE_PACK(sign, SPECIAL_EXPONENT, MIN_SIGNIFICAND);
+    }
+   else if (arg.exponent > MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      result = DM_DOUBLE_PACK(sign, SPECIAL_EXPONENT, DM_INFINITY + MIN_SIGNIFICAND);
+    }
+   else if (arg.exponent < MIN_EXPONENT) // Flush to zero?
+    {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      result = DM_DOUBLE_PACK(sign, SPECIAL_EXPONENT, MIN_SIGNIFICAND);
+    }
+   else
+    {
+      result = DM_DOUBLE_PACK(sign, (int16_t)arg.exponent, arg.significand);
     }
    return result;
  }
@@ -849,12 +918,20 @@ dm_double dm_double_ldexp(dm_double value, int exponent)
  {
    dm_double result;
    int16_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(value);
-   if (((MAX_EXPONENT * 2) < exponent) || (MAX_EXPONENT < (exponent + old_exponent)))
+   if (SPECIAL_EXPONENT == old_exponent) // Zero, infinity, and NaN are unchanged.
+    {
+      result = value;
+    }
+   else if (((MAX_EXPONENT * 2) < exponent) || (MAX_EXPONENT < (exponent + old_exponent)))
     {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       result = dm_double_Inf | (value & SIGN_BIT);
     }
    else if (((MIN_EXPONENT * 2) > exponent) || (MIN_EXPONENT > (exponent + old_exponent)))
     {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       result = dm_double_Zero | (value & SIGN_BIT);
     }
    else
@@ -864,6 +941,159 @@ dm_double dm_double_ldexp(dm_double value, int exponent)
    return result;
  }
 
+int dm_double_digits(dm_double value)
+ {
+   int result = 0;
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(value);
+   if (SPECIAL_EXPONENT != DM_DOUBLE_UNPACK_EXPONENT(value))
+    {
+      result = dm_core_digits(significand) - dm_core_trailingZeros(significand);
+    }
+   return result;
+ }
+
+int dm_double_trailing_zeros(dm_double value)
+ {
+   int result = 0;
+   if (SPECIAL_EXPONENT != DM_DOUBLE_UNPACK_EXPONENT(value))
+    {
+      result = dm_core_trailingZeros(DM_DOUBLE_UNPACK_SIGNIFICAND(value));
+    }
+   return result;
+ }
+
+dm_double dm_double_quantize_r(dm_double arg, int exponent, int round_mode)
+ {
+   dm_double result;
+   int64_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == old_exponent) // Zero, infinity, and NaN are unchanged.
+    {
+      result = arg;
+    }
+   else if ((old_exponent - (CUTOFF - 1)) >= exponent) // Already a multiple of 10 ^ exponent.
+    {
+      result = arg;
+    }
+   else
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+      uint64_t divisor;
+      uint64_t quotient;
+      int events = 0;
+      if (old_exponent < (exponent - 1))
+       {
+         divisor = 10U * makeShift[CUTOFF + 1]; // Below a tenth of the quantum, every digit is lost alike.
+       }
+      else
+       {
+         divisor = makeShift[(CUTOFF + exponent) - old_exponent];
+       }
+      quotient = dm_core_round(dm_double_signbit(arg), significand / divisor, divisor, significand % divisor, round_mode, &events);
+      dm_double_report(events);
+      if (0U == quotient)
+       {
+         result = dm_double_Zero | (arg & SIGN_BIT);
+       }
+      else
+       {
+         if (old_exponent < (exponent - 1)) // Rounded up to the quantum itself.
+          {
+            old_exponent = exponent;
+            significand = MIN_SIGNIFICAND;
+          }
+         else
+          {
+            significand = quotient * divisor;
+            if (BIAS == significand)
+             {
+               significand = MIN_SIGNIFICAND;
+               ++old_exponent;
+             }
+            else
+             {
+               // Nothing to do
+             }
+          }
+         if (old_exponent > MAX_EXPONENT) // Flush to infinity?
+          {
+            DM_STATS_COUNT(flush_to_infinity);
+            DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+            result = dm_double_Inf | (arg & SIGN_BIT);
+          }
+         else
+          {
+            result = DM_DOUBLE_PACK(arg & SIGN_BIT, (int16_t)old_exponent, significand);
+          }
+       }
+    }
+   return result;
+ }
+
+   // Whether dm_double_quantize_fast leaves arg to dm_double_quantize_r, without rounding or reporting anything.
+static inline uint64_t dm_double_quantize_slow(dm_double arg, int exponent)
+ {
+   int16_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   uint64_t keep = (uint64_t)(SPECIAL_EXPONENT == old_exponent) | (uint64_t)(((int64_t)old_exponent - (CUTOFF - 1)) >= exponent);
+   return (keep ^ 1U) & ((uint64_t)(old_exponent < exponent) | (uint64_t)(old_exponent >= MAX_EXPONENT));
+ }
+
+   // The common case of dm_double_quantize_array, without branches: rounding a finite number whose leading digit
+   // is at or above the quantum. Returns non-zero if the element needs dm_double_quantize_r, and leaves it as it is,
+   // so that the second pass finds it again when converting in place.
+static inline uint64_t dm_double_quantize_fast(dm_double arg, int exponent, int round_mode, dm_double* result)
+ {
+   int16_t old_exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   uint64_t keep = (uint64_t)(SPECIAL_EXPONENT == old_exponent) | (uint64_t)(((int64_t)old_exponent - (CUTOFF - 1)) >= exponent);
+   uint64_t fast = (keep ^ 1U) & (uint64_t)(old_exponent >= exponent) & (uint64_t)(old_exponent < MAX_EXPONENT);
+   uint64_t divisor = makeShift[(0U != fast) ? ((CUTOFF + exponent) - old_exponent) : 1];
+   int events = 0;
+   uint64_t carry;
+   uint64_t mask = fast - 1U;
+   significand = divisor * dm_core_round(dm_double_signbit(arg), significand / divisor, divisor, significand % divisor, round_mode, &events);
+   dm_double_report(events);
+   carry = 0U - (uint64_t)(BIAS == significand);
+   significand = (carry & MIN_SIGNIFICAND) | (~carry & significand);
+   *result = (mask & arg) | (~mask & DM_DOUBLE_PACK(arg & SIGN_BIT, (int16_t)(old_exponent + (int16_t)(carry & 1U)), significand));
+   return (keep | fast) ^ 1U;
+ }
+
+static inline void dm_double_quantize_kernel(const dm_double* src, dm_double* dest, size_t count, int exponent, int round_mode)
+ {
+   uint64_t slow = 0U;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      slow |= dm_double_quantize_fast(src[i], exponent, round_mode, &dest[i]);
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         if (0U != dm_double_quantize_slow(src[i], exponent))
+          {
+            dest[i] = dm_double_quantize_r(src[i], exponent, round_mode);
+          }
+       }
+    }
+ }
+
+   // The two ways of rounding a ledger get kernels of their own, in which the rounding mode is a constant.
+void dm_double_quantize_array(const dm_double* src, dm_double* dest, size_t count, int exponent, int round_mode)
+ {
+   if (DM_FE_TONEAREST == round_mode)
+    {
+      dm_double_quantize_kernel(src, dest, count, exponent, DM_FE_TONEAREST);
+    }
+   else if (DM_FE_TONEARESTFROMZERO == round_mode)
+    {
+      dm_double_quantize_kernel(src, dest, count, exponent, DM_FE_TONEARESTFROMZERO);
+    }
+   else
+    {
+      dm_double_quantize_kernel(src, dest, count, exponent, round_mode);
+    }
+ }
+
 dm_double dm_double_neg(dm_double arg)
  {
    return arg ^ SIGN_BIT;
@@ -905,12 +1135,7 @@ dm_double dm_double_div(dm_double lhs, dm_double rhs)
 
 uint64_t dm_internal_round(uint64_t quot, uint64_t rem)
  {
-   uint64_t result = 0U;
-   if ((0U != rem) && (0U == (quot % 5U))) // Remainder mod 10 is 0 or 5
-    {
-      result = 1U;
-    }
-   return result;
+   return dm_core_internal_round(quot, rem);
  }
 
 dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
@@ -931,6 +1156,7 @@ dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
     {
       if (dm_double_signbit(lhs) != dm_double_signbit(rhs))
        {
+         DM_FE_RAISE(DM_FE_INVALID);
          result = dm_double_NaN; // Inf - Inf = NaN
        }
       else
@@ -972,155 +1198,10 @@ dm_double dm_double_add_r(dm_double lhs, dm_double rhs, int round_mode)
    else
     {
          // Now, we can start the add proper!
-      uint64_t lhd = DM_DOUBLE_UNPACK_SIGNIFICAND(lhs);
-      uint64_t rhd = DM_DOUBLE_UNPACK_SIGNIFICAND(rhs);
-      uint64_t resultSignificand;
-
-         // Normalize exponents
-      int16_t lhse = DM_DOUBLE_UNPACK_EXPONENT(lhs);
-      int16_t rhse = DM_DOUBLE_UNPACK_EXPONENT(rhs);
-      int32_t resultExponent = lhse;
-      int16_t expDiff = 0;
-      if (lhse > rhse)
-       {
-         if ((lhse - rhse) <= (CUTOFF + 1))
-          {
-            expDiff = lhse - rhse;
-            if (expDiff > 2) // 2 : guard digit, rounding digit / sticky digit
-             {
-               uint64_t removed;
-               removed = rhd % makeShift[(expDiff - 2) + 1];
-               rhd /= makeShift[(expDiff - 2) + 1];
-               rhd += dm_internal_round(rhd, removed);
-               expDiff = 2;
-             }
-            lhd *= makeShift[expDiff + 1];
-          }
-         else
-          {
-            expDiff = 2;
-            lhd *= 100U;
-            rhd = 1U;
-          }
-       }
-      else if (lhse < rhse)
-       {
-         resultExponent = rhse;
-         if ((rhse - lhse) <= (CUTOFF + 1))
-          {
-            expDiff = rhse - lhse;
-            if (expDiff > 2)
-             {
-               uint64_t removed;
-               removed = lhd % makeShift[(expDiff - 2) + 1];
-               lhd /= makeShift[(expDiff - 2) + 1];
-               lhd += dm_internal_round(lhd, removed);
-               expDiff = 2;
-             }
-            rhd *= makeShift[expDiff + 1];
-          }
-         else
-          {
-            expDiff = 2;
-            rhd *= 100U;
-            lhd = 1U;
-          }
-       }
-      else
-       {
-         // Exponents are the same
-       }
-
-         // Compute the digits and sign.
-      int resultSign = dm_double_signbit(lhs);
-      if (dm_double_signbit(lhs) == dm_double_signbit(rhs)) // Both same sign
-       {
-         lhd += rhd;
-       }
-      else // Different Signs
-       {
-         if (lhd >= rhd) // lhd >= rhd, lhs larger : result sign of lhs
-          {
-            lhd -= rhd;
-          }
-         else // rhs larger : result sign of rhs (opposite sign of lhs)
-          {
-            lhd = rhd - lhd;
-            resultSign = !resultSign;
-          }
-       }
-      resultSignificand = lhd;
-
-         // Normalize the result
-      if (0U == lhd)
-       {
-         if (DM_FE_DOWNWARD != round_mode)
-          {
-            resultSign = 0;
-          }
-         else
-          {
-            resultSign = 1;
-          }
-         resultExponent = SPECIAL_EXPONENT;
-         resultSignificand = MIN_SIGNIFICAND;
-       }
-      else if (lhd > MAX_SIGNIFICAND)
-       {
-         if (0 == expDiff) // Did overflow occur? ie 9 + 9
-          {
-            ++resultExponent;
-          }
-         uint64_t temp = makeShift[expDiff]; // This is why the table has one extra entry: we want the previous entry here.
-         uint64_t test = BIAS * makeShift[expDiff];
-         if (lhd < test) // Did destructive cancellation occur? ie 100 - 1.
-          {
-            --resultExponent;
-          }
-         else
-          {
-            temp *= 10U;
-            test *= 10U;
-            if (lhd >= test) // Did overflow occur? ie 99 + 1
-             {
-               ++resultExponent;
-               temp *= 10U;
-             }
-          }
-         uint64_t rem;
-         resultSignificand = lhd / temp;
-         rem = lhd % temp;
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)temp - (int64_t)(rem << 1), 0U == rem, round_mode);
-         if (resultSignificand == BIAS)
-          {
-            resultSignificand = MIN_SIGNIFICAND;
-            ++resultExponent;
-          }
-         if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-          {
-            resultSignificand = DM_INFINITY + MIN_SIGNIFICAND;
-            resultExponent = SPECIAL_EXPONENT;
-          }
-       }
-      else
-       {
-         if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
-          {
-            --resultExponent;
-          }
-         while (resultSignificand < MIN_SIGNIFICAND)
-          {
-            resultSignificand *= 10U;
-            --resultExponent;
-          }
-         if (resultExponent < MIN_EXPONENT) // Flush to zero?
-          {
-            resultSignificand = MIN_SIGNIFICAND;
-            resultExponent = SPECIAL_EXPONENT;
-          }
-       }
-
-      result = DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
+      int events = 0;
+      dm_core_number core = dm_core_add(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
     }
    return result;
  }
@@ -1162,6 +1243,7 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, infinity times zero is NaN.
    else if ((dm_double_isinf(lhs) && dm_double_iszero(rhs)) || (dm_double_iszero(lhs) && dm_double_isinf(rhs)))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (!!resultSign)
        {
          result = dm_double_neg(dm_double_NaN); // Preserve the sign of NaN ...
@@ -1204,6 +1286,8 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
       int16_t resultExponent = DM_DOUBLE_UNPACK_EXPONENT(lhs) + DM_DOUBLE_UNPACK_EXPONENT(rhs);
       if (resultExponent > MAX_EXPONENT)
        {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
          if (!!resultSign)
           {
             result = dm_double_neg(dm_double_Inf);
@@ -1215,6 +1299,8 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
        }
       else if (resultExponent < (MIN_EXPONENT - 1)) // Minus one in case we can save the result from flushing to zero.
        {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
          if (!!resultSign)
           {
             result = dm_double_neg(dm_double_Zero);
@@ -1228,76 +1314,34 @@ dm_double dm_double_mul_r(dm_double lhs, dm_double rhs, int round_mode)
        {
          // Result is in range
             // Now, we can start the multiply proper!
-         dm_muldiv_t lhd;
-         dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-
-         dm_muldiv_mulBy(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(rhs));
+         int events = 0;
+         dm_core_number core = dm_core_mul(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+         dm_double_report(events);
+         result = dm_double_fromCore(core);
+       }
+    }
+   return result;
+ }
 
-         uint64_t temp = MIN_SIGNIFICAND;
-         dm_muldiv_t test;
-         dm_muldiv_loadFrom(test, BIAS);
-         dm_muldiv_mulBy(test, MIN_SIGNIFICAND);
-         if (!dm_muldiv_less(lhd, test)) // lhd >= BIAS * MIN_SIGNIFICAND
-          {
-            temp *= 10;
-            ++resultExponent;
-          }
+dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
+ {
+   dm_double result;
+   int resultSign = dm_double_signbit(lhs) != dm_double_signbit(rhs);
 
-         uint64_t resultSignificand;
-         uint64_t rem;
-         dm_muldiv_divBy(lhd, temp, &resultSignificand, &rem);
-            // This can't cause an overflow.
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)temp - (int64_t)(rem << 1), 0U == rem, round_mode);
-
-         if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-          {
-            if (!!resultSign)
-             {
-               result = dm_double_neg(dm_double_Inf);
-             }
-            else
-             {
-               result = dm_double_Inf;
-             }
-          }
-         else if (resultExponent < MIN_EXPONENT) // Were we unsuccessful in saving a result from flushing to zero?
-          {
-            if (!!resultSign)
-             {
-               result = dm_double_neg(dm_double_Zero);
-             }
-            else
-             {
-               result = dm_double_Zero;
-             }
-          }
-         else
-          {
-            result = DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
-          }
-       }
-    }
-   return result;
- }
-
-dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
- {
-   dm_double result;
-   int resultSign = dm_double_signbit(lhs) != dm_double_signbit(rhs);
-
-      // First, handle NaNs, as they have the highest precedence.
-   if (!!dm_double_isnan(lhs))
-    {
-      result = lhs; // Prefer lhs NaN's payload.
-    }
-   else if (!!dm_double_isnan(rhs))
-    {
-      result = rhs;
-    }
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_double_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_double_isnan(rhs))
+    {
+      result = rhs;
+    }
 
       // Next, zero divided by zero or infinity divided by infinity is NaN.
    else if ((dm_double_iszero(lhs) && dm_double_iszero(rhs)) || (dm_double_isinf(lhs) && dm_double_isinf(rhs)))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (!!resultSign)
        {
          result = dm_double_neg(dm_double_NaN); // Preserve the sign of NaN ...
@@ -1311,6 +1355,10 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
       // Next, if the result is infinity.
    else if (dm_double_isinf(lhs) || dm_double_iszero(rhs))
     {
+      if (!dm_double_isinf(lhs)) // Finite divided by zero
+       {
+         DM_FE_RAISE(DM_FE_DIVBYZERO);
+       }
       if (!!resultSign)
        {
          result = dm_double_neg(dm_double_Inf);
@@ -1340,6 +1388,8 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
       int16_t resultExponent = DM_DOUBLE_UNPACK_EXPONENT(lhs) - DM_DOUBLE_UNPACK_EXPONENT(rhs);
       if (resultExponent > (MAX_EXPONENT + 1)) // Plus one in case we can save the result from flushing to infinity.
        {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
          if (!!resultSign)
           {
             result = dm_double_neg(dm_double_Inf);
@@ -1351,6 +1401,8 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
        }
       else if (resultExponent < MIN_EXPONENT)
        {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
          if (!!resultSign)
           {
             result = dm_double_neg(dm_double_Zero);
@@ -1364,54 +1416,308 @@ dm_double dm_double_div_r(dm_double lhs, dm_double rhs, int round_mode)
        {
          // Result is in range
             // Now, we can start the divide proper!
-         dm_muldiv_t lhd;
-         dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-         uint64_t rhd = DM_DOUBLE_UNPACK_SIGNIFICAND(rhs);
+         int events = 0;
+         dm_core_number core = dm_core_div(dm_double_toCore(lhs), dm_double_toCore(rhs), round_mode, &events);
+         dm_double_report(events);
+         result = dm_double_fromCore(core);
+       }
+    }
+   return result;
+ }
 
-         if (DM_DOUBLE_UNPACK_SIGNIFICAND(lhs) < DM_DOUBLE_UNPACK_SIGNIFICAND(rhs))
-          {
-            --resultExponent;
-          }
-         else
-          {
-            rhd *= 10;
-          }
+dm_double dm_double_sqrt(dm_double arg)
+ {
+   return dm_double_sqrt_r(arg, dm_global_round_mode);
+ }
+
+dm_double dm_double_sqrt_r(dm_double arg, int round_mode)
+ {
+   dm_double result;
+   if (!!dm_double_isnan(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_iszero(arg))
+    {
+      result = arg; // sqrt(-0) = -0
+    }
+   else if (!!dm_double_signbit(arg))
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      result = dm_double_NaN;
+    }
+   else if (!!dm_double_isinf(arg))
+    {
+      result = arg;
+    }
+   else
+    {
+         // Halving the exponent can't go out of range.
+      int events = 0;
+      dm_core_number core = dm_core_sqrt(dm_double_toCore(arg), round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
 
-         dm_muldiv_mulBy(lhd, BIAS);
-         uint64_t resultSignificand;
-         uint64_t rem;
-         dm_muldiv_divBy(lhd, rhd, &resultSignificand, &rem);
-            // This can't cause an overflow.
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)rhd - (int64_t)(rem << 1), 0U == rem, round_mode);
+dm_double dm_double_exp(dm_double arg)
+ {
+   dm_double result;
+   if (!!dm_double_isnan(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_isinf(arg))
+    {
+      result = !!dm_double_signbit(arg) ? dm_double_Zero : arg;
+    }
+   else if (!!dm_double_iszero(arg))
+    {
+      result = DM_DOUBLE_PACK(0U, 0, MIN_SIGNIFICAND); // exp(0) = 1, exactly
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_exp(dm_double_toCore(arg), dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
 
-         if (resultExponent > MAX_EXPONENT) // Were we unsuccessful in saving a result from flushing to infinity?
-          {
-            if (!!resultSign)
-             {
-               result = dm_double_neg(dm_double_Inf);
-             }
-            else
-             {
-               result = dm_double_Inf;
-             }
-          }
-         else if (resultExponent < MIN_EXPONENT) // Flush to zero?
-          {
-            if (!!resultSign)
-             {
-               result = dm_double_neg(dm_double_Zero);
-             }
-            else
-             {
-               result = dm_double_Zero;
-             }
-          }
-         else
+dm_double dm_double_expm1(dm_double arg)
+ {
+   dm_double result;
+   if (!!dm_double_isnan(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_isinf(arg))
+    {
+      result = !!dm_double_signbit(arg) ? DM_DOUBLE_PACK(1U, 0, MIN_SIGNIFICAND) : arg;
+    }
+   else if (!!dm_double_iszero(arg))
+    {
+      result = arg;
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_expm1(dm_double_toCore(arg), dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
+
+   // The natural logarithm, or the common logarithm.
+static dm_double dm_double_logarithm(dm_double arg, int common)
+ {
+   dm_double result;
+   if (!!dm_double_isnan(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_iszero(arg))
+    {
+      DM_FE_RAISE(DM_FE_DIVBYZERO);
+      result = dm_double_Inf | SIGN_BIT;
+    }
+   else if (!!dm_double_signbit(arg))
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      result = dm_double_NaN;
+    }
+   else if (!!dm_double_isinf(arg))
+    {
+      result = arg;
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_log(dm_double_toCore(arg), common, dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
+
+dm_double dm_double_log(dm_double arg)
+ {
+   return dm_double_logarithm(arg, 0);
+ }
+
+dm_double dm_double_log10(dm_double arg)
+ {
+   return dm_double_logarithm(arg, 1);
+ }
+
+dm_double dm_double_log1p(dm_double arg)
+ {
+   dm_double result;
+   dm_double minusOne = DM_DOUBLE_PACK(1U, 0, MIN_SIGNIFICAND);
+   if (!!dm_double_isnan(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_iszero(arg))
+    {
+      result = arg;
+    }
+   else if (!!dm_double_isequal(arg, minusOne))
+    {
+      DM_FE_RAISE(DM_FE_DIVBYZERO);
+      result = dm_double_Inf | SIGN_BIT;
+    }
+   else if (!!dm_double_isless(arg, minusOne))
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      result = dm_double_NaN;
+    }
+   else if (!!dm_double_isinf(arg))
+    {
+      result = arg;
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_log1p(dm_double_toCore(arg), dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
+
+dm_double dm_double_pow(dm_double lhs, dm_double rhs)
+ {
+   dm_double result;
+   dm_double one = DM_DOUBLE_PACK(0U, 0, MIN_SIGNIFICAND);
+
+      // The result is negative when x is and y is an odd integer. Infinities are even.
+   int parity = 1;
+   int resultSign = 0;
+   if (!dm_double_isnan(rhs) && !dm_double_isinf(rhs))
+    {
+      parity = dm_core_parity(dm_double_toCore(rhs));
+    }
+   resultSign = (!!dm_double_signbit(lhs) && (2 == parity)) ? 1 : 0;
+
+      // pow(x, 0) and pow(1, y) are one, even for NaNs.
+   if (!!dm_double_iszero(rhs) || !!dm_double_isequal(lhs, one))
+    {
+      result = one;
+    }
+   else if (!!dm_double_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_double_isnan(rhs))
+    {
+      result = rhs;
+    }
+   else if (!!dm_double_iszero(lhs))
+    {
+      if (!dm_double_signbit(rhs))
+       {
+         result = (0 != resultSign) ? lhs : dm_double_Zero;
+       }
+      else
+       {
+         if (!dm_double_isinf(rhs))
           {
-            result = DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
+            DM_FE_RAISE(DM_FE_DIVBYZERO);
           }
+         result = (0 != resultSign) ? (dm_double_Inf | SIGN_BIT) : dm_double_Inf;
+       }
+    }
+   else if (!!dm_double_isinf(rhs))
+    {
+      dm_double magnitude = dm_double_fabs(lhs);
+      if (!!dm_double_isequal(magnitude, one))
+       {
+         result = one; // pow(-1, Inf) = 1
+       }
+      else if ((!!dm_double_isless(magnitude, one)) == (!dm_double_signbit(rhs)))
+       {
+         result = dm_double_Zero;
+       }
+      else
+       {
+         result = dm_double_Inf;
+       }
+    }
+   else if (!!dm_double_isinf(lhs))
+    {
+      if (!!dm_double_signbit(rhs))
+       {
+         result = (0 != resultSign) ? (dm_double_Zero | SIGN_BIT) : dm_double_Zero;
+       }
+      else
+       {
+         result = (0 != resultSign) ? lhs : dm_double_Inf;
+       }
+    }
+   else if (!!dm_double_signbit(lhs) && (0 == parity)) // A negative number to a non-integer power
+    {
+      DM_FE_RAISE(DM_FE_INVALID);
+      result = dm_double_NaN;
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number base = dm_double_toCore(lhs);
+      dm_core_number core;
+      base.sign = resultSign;
+      core = dm_core_pow(base, dm_double_toCore(rhs), dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
+   return result;
+ }
+
+dm_double dm_double_powi_r(dm_double base, int64_t n, int round_mode)
+ {
+   dm_double result;
+   int resultSign = (!!dm_double_signbit(base) && (0 != (n & 1))) ? 1 : 0;
+   if (0 == n)
+    {
+      result = DM_DOUBLE_PACK(0U, 0, MIN_SIGNIFICAND); // Even for NaN, as pow(x, 0)
+    }
+   else if (!!dm_double_isnan(base))
+    {
+      result = base;
+    }
+   else if (!!dm_double_iszero(base))
+    {
+      if (n > 0)
+       {
+         result = (0 != resultSign) ? base : dm_double_Zero;
+       }
+      else
+       {
+         DM_FE_RAISE(DM_FE_DIVBYZERO);
+         result = (0 != resultSign) ? (dm_double_Inf | SIGN_BIT) : dm_double_Inf;
+       }
+    }
+   else if (!!dm_double_isinf(base))
+    {
+      if (n > 0)
+       {
+         result = (0 != resultSign) ? base : dm_double_Inf;
+       }
+      else
+       {
+         result = (0 != resultSign) ? (dm_double_Zero | SIGN_BIT) : dm_double_Zero;
        }
     }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_powi(dm_double_toCore(base), n, round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
    return result;
  }
 
@@ -1433,6 +1739,7 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
       // Then, check if the result is NaN.
    else if (dm_double_isinf(lhs) || dm_double_iszero(rhs))
     {
+      DM_FE_RAISE(DM_FE_INVALID);
       if (!!resultSign)
        {
          result = dm_double_neg(dm_double_NaN);
@@ -1482,13 +1789,13 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
        }
       else if (resultSignificand < MIN_SIGNIFICAND)
        {
-         while (resultSignificand < MIN_SIGNIFICAND)
-          {
-            resultSignificand *= 10U;
-            --resultExponent;
-          }
+         int shift = CUTOFF - dm_core_digits(resultSignificand);
+         resultSignificand *= makeShift[shift + 1];
+         resultExponent -= shift;
          if (resultExponent < MIN_EXPONENT) // Flush to zero?
           {
+            DM_STATS_COUNT(flush_to_zero);
+            DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
             resultSignificand = MIN_SIGNIFICAND;
             resultExponent = SPECIAL_EXPONENT;
           }
@@ -1507,7 +1814,6 @@ dm_double dm_double_fmod(dm_double lhs, dm_double rhs)
 dm_double dm_double_fma(dm_double lhs, dm_double rhs, dm_double ths)
  {
    dm_double result;
-   int prodSign = dm_double_signbit(lhs) != dm_double_signbit(rhs);
 
       // If any argument is Nan, Zero, or Infinity: then the result is the same as the result of the base operations.
       // And that means that if any aren't normal.
@@ -1517,218 +1823,15 @@ dm_double dm_double_fma(dm_double lhs, dm_double rhs, dm_double ths)
     }
    else
     {
+         // Now, we can start the fma proper!
+      int events = 0;
+      dm_core_number core = dm_core_fma(dm_double_toCore(lhs), dm_double_toCore(rhs), dm_double_toCore(ths), dm_global_round_mode, &events);
+      dm_double_report(events);
+      result = dm_double_fromCore(core);
+    }
 
-         // Compute the exponent of the product: we defer flush to infinity to the end.
-      int16_t phse = DM_DOUBLE_UNPACK_EXPONENT(lhs) + DM_DOUBLE_UNPACK_EXPONENT(rhs);
-
-         // Now, we can start the multiply proper!
-      dm_muldiv_t lhd;
-      dm_muldiv_loadFrom(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(lhs));
-
-      dm_muldiv_mulBy(lhd, DM_DOUBLE_UNPACK_SIGNIFICAND(rhs));
-
-      uint64_t temp = MIN_SIGNIFICAND * 10U;
-      dm_muldiv_t test;
-      dm_muldiv_loadFrom(test, BIAS);
-      dm_muldiv_mulBy(test, MIN_SIGNIFICAND);
-      if (!dm_muldiv_less(lhd, test)) // lhd >= BIAS * MIN_SIGNIFICAND
-       {
-         ++phse;
-       }
-      else // Normalize the location of the product.
-       {
-         dm_muldiv_mulBy(lhd, 10U);
-       }
-
-      int32_t resultExponent = phse;
-      uint64_t resultSignificand;
-      int resultSign = prodSign;
-
-      int16_t thse = DM_DOUBLE_UNPACK_EXPONENT(ths);
-      int16_t expDiff = phse - thse;
-      if (expDiff < 0)
-       {
-         expDiff = -expDiff;
-       }
-         // If we are not the special case (the case where we have to do a full subtraction)
-         // If the exponents are equal and the signs different, we may need all of the digits in order to handle cancellation.
-      if (!((expDiff < 2) && (prodSign != dm_double_signbit(ths))))
-       {
-         uint64_t thd = DM_DOUBLE_UNPACK_SIGNIFICAND(ths) * 100U;
-
-         uint64_t phd;
-         uint64_t rem;
-         dm_muldiv_divBy(lhd, temp / 100U, &phd, &rem);
-         phd += dm_internal_round(phd, rem);
-
-         if (phse > thse)
-          {
-            if (expDiff <= (CUTOFF + 1))
-             {
-               uint64_t removed;
-               removed = thd % makeShift[expDiff + 1];
-               thd /= makeShift[expDiff + 1];
-               thd += dm_internal_round(thd, removed);
-             }
-            else
-             {
-               thd = 1U;
-             }
-          }
-         else if (phse < thse)
-          {
-            resultExponent = thse;
-            if (expDiff <= (CUTOFF + 1))
-             {
-               uint64_t removed;
-               removed = phd % makeShift[expDiff + 1];
-               phd /= makeShift[expDiff + 1];
-               phd += dm_internal_round(phd, removed);
-             }
-            else
-             {
-               phd = 1U;
-             }
-          }
-         else
-          {
-            // No normalization needed
-          }
-
-            // Compute the digits and sign.
-         if (prodSign == dm_double_signbit(ths)) // Both same sign
-          {
-            phd += thd;
-          }
-         else // Different Signs
-          {
-            if (phd >= thd) // lhs larger : result sign of lhs
-             {
-               phd -= thd;
-             }
-            else // rhs larger : result sign of rhs (opposite sign of lhs)
-             {
-               phd = thd - phd;
-               resultSign = !resultSign;
-             }
-          }
-         resultSignificand = phd; // This cannot possibly be zero.
-
-            // Normalize the result
-         uint64_t scal = 10U;
-         uint64_t test = BIAS * 10U;
-         if (phd < test) // Did destructive cancellation occur? ie 100 - 1.
-          {
-            --resultExponent;
-          }
-         else
-          {
-            scal *= 10U;
-            test *= 10U;
-            if (phd >= test) // Did overflow occur? ie 9 + 1
-             {
-               ++resultExponent;
-               scal *= 10U;
-             }
-          }
-         resultSignificand = phd / scal;
-         rem = phd % scal;
-         resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)scal - (int64_t)(rem << 1), rem == 0U, dm_global_round_mode);
-         if (resultSignificand == BIAS)
-          {
-            resultSignificand = MIN_SIGNIFICAND;
-            ++resultExponent;
-          }
-       }
-      else // The pathological case
-       {
-         dm_muldiv_t thd;
-         dm_muldiv_loadFrom(thd, DM_DOUBLE_UNPACK_SIGNIFICAND(ths));
-         dm_muldiv_mulBy(thd, BIAS);
-
-         if (phse > thse)
-          {
-            dm_muldiv_mulBy(lhd, 10U);
-          }
-         else if (phse < thse)
-          {
-            resultExponent = thse;
-            dm_muldiv_mulBy(thd, 10U);
-          }
-         else
-          {
-            // No normalization needed
-          }
-
-         if (!dm_muldiv_less(lhd, thd)) // lhs larger : result sign of lhs
-          {
-            dm_muldiv_sub(lhd, lhd, thd);
-          }
-         else // rhs larger : result sign of rhs (opposite sign of lhs)
-          {
-            dm_muldiv_sub(lhd, thd, lhd);
-            resultSign = !resultSign;
-          }
-
-         dm_muldiv_t test2;
-         dm_muldiv_loadFrom(test2, BIAS);
-         dm_muldiv_mulBy(test2, BIAS);
-         uint64_t rem;
-         if (!!dm_muldiv_zero(lhd))
-          {
-            if (DM_FE_DOWNWARD != dm_global_round_mode)
-             {
-               resultSign = 0;
-             }
-            else
-             {
-               resultSign = 1;
-             }
-            resultExponent = SPECIAL_EXPONENT;
-            resultSignificand = MIN_SIGNIFICAND;
-          }
-         else if (!dm_muldiv_less(lhd, test2))
-          {
-            uint64_t shift = BIAS * 10U;
-            dm_muldiv_divBy(lhd, shift, &resultSignificand, &rem);
-            resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)(shift) - (int64_t)(rem << 1), rem == 0U, dm_global_round_mode);
-          }
-         else
-          {
-            if (expDiff == 1) // If we have gotten here, and an operation like 10 - 1 occurred, then fix the exponent.
-             {
-               --resultExponent;
-             }
-            while (!!dm_muldiv_less(lhd, test))
-             {
-               dm_muldiv_mulBy(lhd, 10U);
-               --resultExponent;
-             }
-            dm_muldiv_divBy(lhd, BIAS, &resultSignificand, &rem);
-            resultSignificand += dm_decideRound(resultSign, resultSignificand & 1U, (int64_t)BIAS - (int64_t)(rem << 1), rem == 0U, dm_global_round_mode);
-          }
-       }
-
-      if (resultExponent > MAX_EXPONENT) // Flush to infinity?
-       {
-         resultSignificand = DM_INFINITY + MIN_SIGNIFICAND;
-         resultExponent = SPECIAL_EXPONENT;
-       }
-      else if (resultExponent < MIN_EXPONENT) // Flush to zero?
-       {
-         resultSignificand = MIN_SIGNIFICAND;
-         resultExponent = SPECIAL_EXPONENT;
-       }
-      else
-       {
-         // Normal number.
-       }
-
-      result = DM_DOUBLE_PACK(resultSign, resultExponent, resultSignificand);
-    }
-
-   return result;
- }
+   return result;
+ }
 
 void dm_double_tostring(dm_double arg, char dest [24])
  {
@@ -2022,15 +2125,22 @@ dm_double dm_double_fromstring(const char * arg)
       resultExponent += exponentValue * exponentSign;
     }
 
+   dm_double finalResult;
    if (0U == resultSignificand)
     {
-      resultExponent = SPECIAL_EXPONENT;
-      resultSignificand = MIN_SIGNIFICAND;
+      if (!!resultSign)
+       {
+         finalResult = dm_double_neg(dm_double_Zero);
+       }
+      else
+       {
+         finalResult = dm_double_Zero;
+       }
     }
-
-   dm_double finalResult;
-   if (resultExponent > MAX_EXPONENT) // Flush to infinity?
+   else if (resultExponent > MAX_EXPONENT) // Flush to infinity?
     {
+      DM_STATS_COUNT(flush_to_infinity);
+      DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
       if (!!resultSign)
        {
          finalResult = dm_double_neg(dm_double_Inf);
@@ -2042,6 +2152,8 @@ dm_double dm_double_fromstring(const char * arg)
     }
    else if (resultExponent < MIN_EXPONENT) // Flush to zero?
     {
+      DM_STATS_COUNT(flush_to_zero);
+      DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
       if (!!resultSign)
       {
          finalResult = dm_double_neg(dm_double_Zero);
@@ -2059,6 +2171,865 @@ dm_double dm_double_fromstring(const char * arg)
    return finalResult;
  }
 
+dm_double dm_double_fromsingle(dm_single arg)
+ {
+   dm_double result;
+   uint64_t sign = (0U != (arg & DM_SINGLE_SIGN_MASK)) ? 1U : 0U;
+   if (DM_SINGLE_SPECIAL_EXPONENT == DM_SINGLE_UNPACK_EXPONENT(arg))
+    {
+      uint64_t significand = DM_SINGLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_SINGLE_INFINITY == significand)
+       {
+         significand = DM_INFINITY;
+       }
+      result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, significand); // Zero, infinity, or NaN with its payload.
+    }
+   else
+    {
+      result = DM_DOUBLE_PACK(sign, (int16_t)DM_SINGLE_UNPACK_EXPONENT(arg), (uint64_t)DM_SINGLE_UNPACK_SIGNIFICAND(arg) * DM_SINGLE_WIDEN);
+    }
+   return result;
+ }
+
+dm_single dm_double_tosingle(dm_double arg)
+ {
+   return dm_double_tosingle_r(arg, dm_global_round_mode);
+ }
+
+dm_single dm_double_tosingle_r(dm_double arg, int round_mode)
+ {
+   dm_single result;
+   int sign = dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_INFINITY == significand)
+       {
+         significand = DM_SINGLE_INFINITY;
+       }
+      else if (significand >= DM_SINGLE_INFINITY)
+       {
+         significand = 255U; // A NaN whose payload doesn't fit.
+       }
+      else
+       {
+         // Zero, or a NaN that keeps its payload.
+       }
+      result = DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, significand);
+    }
+   else
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+      int events = 0;
+      significand = dm_core_round(sign, significand / DM_SINGLE_WIDEN, DM_SINGLE_WIDEN, significand % DM_SINGLE_WIDEN, round_mode, &events);
+      dm_double_report(events);
+      if (significand > DM_SINGLE_MAX_SIGNIFICAND)
+       {
+         significand = DM_SINGLE_MIN_SIGNIFICAND;
+         ++exponent;
+       }
+
+      if (exponent > DM_SINGLE_MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         result = DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, DM_SINGLE_INFINITY);
+       }
+      else if (exponent < DM_SINGLE_MIN_EXPONENT) // Flush to zero?
+       {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         result = DM_SINGLE_PACK_ALT(sign, DM_SINGLE_SPECIAL_EXPONENT, 0U);
+       }
+      else
+       {
+         result = DM_SINGLE_PACK(sign, exponent, significand);
+       }
+    }
+   return result;
+ }
+
+   // Tight loops over the conversions above, which the compiler can inline here.
+void dm_double_fromsingle_array(const dm_single* src, dm_double* dest, size_t count)
+ {
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dest[i] = dm_double_fromsingle(src[i]);
+    }
+ }
+
+void dm_double_tosingle_array(const dm_double* src, dm_single* dest, size_t count, int round_mode)
+ {
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dest[i] = dm_double_tosingle_r(src[i], round_mode);
+    }
+ }
+
+dm_quad dm_double_toquad(dm_double arg)
+ {
+   dm_quad result;
+   int sign = dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_INFINITY == significand)
+       {
+         result = dm_quad_pack_alt(sign, DM_QUAD_SPECIAL_EXPONENT, DM_QUAD_INFINITY_HIGH, DM_QUAD_INFINITY_LOW);
+       }
+      else
+       {
+         result = dm_quad_pack_alt(sign, DM_QUAD_SPECIAL_EXPONENT, 0U, significand); // Zero, or NaN with its payload.
+       }
+    }
+   else
+    {
+      dm_muldiv_wide_t significand;
+      dm_muldiv_wide_t widen;
+      uint64_t high;
+      uint64_t low;
+      dm_muldiv_wide_loadFrom(significand, 0U, DM_DOUBLE_UNPACK_SIGNIFICAND(arg));
+      dm_muldiv_wide_loadFrom(widen, 0U, DM_QUAD_WIDEN);
+      dm_muldiv_wide_mul(significand, significand, widen);
+      dm_muldiv_wide_extract(significand, &high, &low);
+      result = dm_quad_pack(sign, exponent, high, low);
+    }
+   return result;
+ }
+
+dm_double dm_double_fromquad(dm_quad arg)
+ {
+   return dm_double_fromquad_r(arg, dm_global_round_mode);
+ }
+
+dm_double dm_double_fromquad_r(dm_quad arg, int round_mode)
+ {
+   dm_double result;
+   int sign = dm_quad_unpack_sign(arg);
+   int32_t exponent = dm_quad_unpack_exponent(arg);
+   uint64_t high;
+   uint64_t low;
+   if (DM_QUAD_SPECIAL_EXPONENT == exponent)
+    {
+      dm_quad_unpack_significand_alt(arg, &high, &low);
+      if ((DM_QUAD_INFINITY_HIGH == high) && (DM_QUAD_INFINITY_LOW == low))
+       {
+         low = DM_INFINITY;
+       }
+      else if ((0U != high) || (low >= DM_INFINITY))
+       {
+         low = 255U; // A NaN whose payload doesn't fit.
+       }
+      else
+       {
+         // Zero, or a NaN that keeps its payload.
+       }
+      result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, low);
+    }
+   else
+    {
+      dm_muldiv_wide_t significand;
+      dm_muldiv_wide_t widen;
+      dm_muldiv_wide_t rem;
+      uint64_t quot;
+      uint64_t remainder;
+      dm_quad_unpack_significand(arg, &high, &low);
+      dm_muldiv_wide_loadFrom(significand, high, low);
+      dm_muldiv_wide_loadFrom(widen, 0U, DM_QUAD_WIDEN);
+      dm_muldiv_wide_divBy(significand, widen, significand, rem);
+      dm_muldiv_wide_extract(significand, &high, &quot);
+      dm_muldiv_wide_extract(rem, &high, &remainder);
+      int events = 0;
+      quot = dm_core_round(sign, quot, DM_QUAD_WIDEN, remainder, round_mode, &events);
+      dm_double_report(events);
+      if (quot > MAX_SIGNIFICAND)
+       {
+         quot = MIN_SIGNIFICAND;
+         ++exponent;
+       }
+
+      if (exponent > MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+       }
+      else if (exponent < MIN_EXPONENT) // Flush to zero?
+       {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U);
+       }
+      else
+       {
+         result = DM_DOUBLE_PACK(sign, (int16_t)exponent, quot);
+       }
+    }
+   return result;
+ }
+
+uint64_t dm_double_to_bid64(dm_double arg)
+ {
+   return dm_double_to_bid64_r(arg, dm_global_round_mode);
+ }
+
+uint64_t dm_double_to_bid64_r(dm_double arg, int round_mode)
+ {
+   uint64_t result;
+   uint64_t sign = (uint64_t)dm_double_signbit(arg);
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (0U == significand)
+       {
+         result = dm_bid64_pack(sign, 0, 0U);
+       }
+      else if (DM_INFINITY == significand)
+       {
+         result = (sign << 63) | DM_BID64_INFINITY;
+       }
+      else if (significand > DM_BID64_MAX_PAYLOAD)
+       {
+         result = (sign << 63) | DM_BID64_NAN; // A NaN whose payload doesn't fit.
+       }
+      else
+       {
+         result = (sign << 63) | DM_BID64_NAN | significand;
+       }
+    }
+   else
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+      int64_t q = (int64_t)exponent - (CUTOFF - 1);
+      if (q > DM_BID64_MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         result = (sign << 63) | DM_BID64_INFINITY;
+       }
+      else
+       {
+         if (q < DM_BID64_MIN_EXPONENT) // Subnormal: drop the digits below 10 ^ -398.
+          {
+            int64_t lost = DM_BID64_MIN_EXPONENT - q;
+            uint64_t divisor;
+            int events = 0;
+            if (lost > CUTOFF)
+             {
+               divisor = 10U * makeShift[CUTOFF + 1]; // Past sixteen, every digit is lost alike.
+             }
+            else
+             {
+               divisor = makeShift[lost + 1];
+             }
+            significand = dm_core_round((int)sign, significand / divisor, divisor, significand % divisor, round_mode, &events);
+            dm_double_report(events);
+            if (0 != (events & DM_CORE_INEXACT))
+             {
+               DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+               if (0U == significand)
+                {
+                  DM_STATS_COUNT(flush_to_zero);
+                }
+             }
+            q = DM_BID64_MIN_EXPONENT;
+          }
+         result = dm_bid64_pack(sign, q, significand);
+       }
+    }
+   return result;
+ }
+
+dm_double dm_double_from_bid64(uint64_t arg)
+ {
+   dm_double result;
+   uint64_t sign = arg >> 63;
+   if (!!dm_bid64_isspecial(arg))
+    {
+      if (DM_BID64_NAN != (arg & DM_BID64_NAN))
+       {
+         result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+       }
+      else
+       {
+         uint64_t payload = arg & DM_BID64_PAYLOAD_MASK;
+         if ((0U == payload) || (payload > DM_BID64_MAX_PAYLOAD))
+          {
+            payload = 255U; // No payload, or a non-canonical one: dm_double_NaN's.
+          }
+         result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, payload);
+       }
+    }
+   else
+    {
+      uint64_t coefficient = dm_bid64_unpack_coefficient(arg);
+      if ((0U == coefficient) || (coefficient > MAX_SIGNIFICAND))
+       {
+         result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U); // Zero in any cohort, or non-canonical.
+       }
+      else
+       {
+         int64_t shift = dm_bid64_normalize(&coefficient);
+         result = DM_DOUBLE_PACK(sign, (int16_t)(dm_bid64_unpack_exponent(arg) + (CUTOFF - 1) - shift), coefficient);
+       }
+    }
+   return result;
+ }
+
+   // The destinations must not overlap the sources, as the second loops go back to them.
+void dm_double_to_bid64_array(const dm_double* src, uint64_t* dest, size_t count, int round_mode)
+ {
+   uint64_t slow = 0U;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      dm_double arg = src[i];
+      int64_t q = (int64_t)DM_DOUBLE_UNPACK_EXPONENT(arg) - (CUTOFF - 1); // The special exponent is out of range too.
+      slow |= (uint64_t)((q > DM_BID64_MAX_EXPONENT) | (q < DM_BID64_MIN_EXPONENT));
+      dest[i] = dm_bid64_pack(arg >> 63, q, DM_DOUBLE_UNPACK_SIGNIFICAND(arg));
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         int64_t q = (int64_t)DM_DOUBLE_UNPACK_EXPONENT(src[i]) - (CUTOFF - 1);
+         if ((q > DM_BID64_MAX_EXPONENT) || (q < DM_BID64_MIN_EXPONENT))
+          {
+            dest[i] = dm_double_to_bid64_r(src[i], round_mode);
+          }
+       }
+    }
+ }
+
+void dm_double_from_bid64_array(const uint64_t* src, dm_double* dest, size_t count)
+ {
+   uint64_t slow = 0U;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      uint64_t arg = src[i];
+      uint64_t coefficient = dm_bid64_unpack_coefficient(arg);
+      int64_t shift = dm_bid64_normalize(&coefficient);
+      slow |= (uint64_t)(dm_bid64_isspecial(arg) | (0U == coefficient) | (coefficient > MAX_SIGNIFICAND));
+      dest[i] = DM_DOUBLE_PACK(arg >> 63, (int16_t)(dm_bid64_unpack_exponent(arg) + (CUTOFF - 1) - shift), coefficient);
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         uint64_t coefficient = dm_bid64_unpack_coefficient(src[i]);
+         if (dm_bid64_isspecial(src[i]) || (0U == coefficient) || (coefficient > MAX_SIGNIFICAND))
+          {
+            dest[i] = dm_double_from_bid64(src[i]);
+          }
+       }
+    }
+ }
+
+size_t dm_double_to_varint(dm_double arg, unsigned char* dest)
+ {
+   size_t length;
+   uint64_t sign = arg >> 63;
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      dest[0] = 0U;
+      length = 1U + dm_varint_put((DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg) << 1) | sign, dest + 1);
+    }
+   else
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+      int64_t zeros = dm_core_strip(&significand);
+      length = dm_varint_put((significand << 1) - sign, dest); // Zigzag
+      length += dm_varint_put(dm_zigzag_encode((int64_t)exponent - (CUTOFF - 1) + zeros), dest + length);
+    }
+   return length;
+ }
+
+size_t dm_double_from_varint(const unsigned char* src, size_t length, dm_double* result)
+ {
+   size_t read = 0U;
+   uint64_t integer = 0U;
+   uint64_t second = 0U;
+   size_t first = dm_varint_get(src, length, &integer);
+   size_t last = 0U;
+   if (0U != first)
+    {
+      last = dm_varint_get(src + first, length - first, &second);
+    }
+   if (0U != last)
+    {
+      uint64_t sign = integer & 1U;
+      if (0U == integer)
+       {
+         if ((second >> 1) <= DM_INFINITY)
+          {
+            *result = DM_DOUBLE_PACK_ALT(second & 1U, SPECIAL_EXPONENT, second >> 1);
+            read = first + last;
+          }
+       }
+      else
+       {
+         uint64_t significand = (integer + sign) >> 1;
+         if (significand <= MAX_SIGNIFICAND)
+          {
+            int64_t exponent = dm_zigzag_decode(second) + (CUTOFF - 1) - dm_bid64_normalize(&significand);
+            if ((exponent <= MAX_EXPONENT) && (exponent >= MIN_EXPONENT))
+             {
+               *result = DM_DOUBLE_PACK(sign, (int16_t)exponent, significand);
+               read = first + last;
+             }
+          }
+       }
+    }
+   return read;
+ }
+
+   // With room for the longest value, there is nothing to check. Only near the end is it written aside first.
+size_t dm_double_to_varint_array(const dm_double* src, size_t count, unsigned char* dest, size_t capacity, size_t* written)
+ {
+   unsigned char aside [DM_VARINT_MAX_BYTES];
+   size_t length = 0U;
+   size_t i = 0U;
+   int full = 0;
+   while ((i < count) && ((capacity - length) >= DM_VARINT_MAX_BYTES))
+    {
+      length += dm_double_to_varint(src[i], dest + length);
+      ++i;
+    }
+   while ((i < count) && (0 == full))
+    {
+      size_t size = dm_double_to_varint(src[i], aside);
+      if (size > (capacity - length))
+       {
+         full = 1;
+       }
+      else
+       {
+         for (size_t j = 0U; j < size; ++j)
+          {
+            dest[length + j] = aside[j];
+          }
+         length += size;
+         ++i;
+       }
+    }
+   *written = length;
+   return i;
+ }
+
+size_t dm_double_from_varint_array(const unsigned char* src, size_t length, dm_double* dest, size_t count, size_t* read)
+ {
+   size_t position = 0U;
+   size_t i = 0U;
+   size_t size = 1U;
+   while ((i < count) && (0U != size))
+    {
+      size = dm_double_from_varint(src + position, length - position, dest + i);
+      if (0U != size)
+       {
+         position += size;
+         ++i;
+       }
+    }
+   *read = position;
+   return i;
+ }
+
+   // Converts magnitude * 10 ^ -scale.
+static int dm_double_frominteger(uint64_t sign, uint64_t magnitude, int scale, int round_mode, dm_double* result)
+ {
+   int status = DM_CONVERT_EXACT;
+   if (0U == magnitude)
+    {
+      *result = DM_DOUBLE_PACK_ALT(0U, SPECIAL_EXPONENT, 0U);
+    }
+   else
+    {
+      int64_t exponent;
+      uint64_t significand = magnitude;
+      if (magnitude <= MAX_SIGNIFICAND)
+       {
+         exponent = (CUTOFF - 1) - dm_bid64_normalize(&significand);
+       }
+      else // Seventeen to twenty digits: round away those past the sixteenth.
+       {
+         int digits = dm_core_digits(magnitude);
+         uint64_t divisor = dm_core_powers[digits - CUTOFF];
+         int events = 0;
+         exponent = (int64_t)digits - 1;
+         significand = dm_core_round((int)sign, magnitude / divisor, divisor, magnitude % divisor, round_mode, &events);
+         dm_double_report(events);
+         if (significand > MAX_SIGNIFICAND)
+          {
+            significand = MIN_SIGNIFICAND;
+            ++exponent;
+          }
+         else
+          {
+            // Nothing to do
+          }
+         if (0 != (events & DM_CORE_INEXACT))
+          {
+            status = DM_CONVERT_INEXACT;
+          }
+         else
+          {
+            // Nothing to do
+          }
+       }
+      exponent -= scale;
+      if (exponent > MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         *result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, DM_INFINITY);
+         status = DM_CONVERT_SATURATED;
+       }
+      else if (exponent < MIN_EXPONENT) // Flush to zero?
+       {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         *result = DM_DOUBLE_PACK_ALT(sign, SPECIAL_EXPONENT, 0U);
+         status = DM_CONVERT_INEXACT;
+       }
+      else
+       {
+         *result = DM_DOUBLE_PACK(sign, (int16_t)exponent, significand);
+       }
+    }
+   return status;
+ }
+
+   // Rounds arg * 10 ^ scale to an integer, and gives its magnitude, saturated to the limit for the sign.
+static int dm_double_tointeger(dm_double arg, int scale, int round_mode, uint64_t positive_limit, uint64_t negative_limit, uint64_t* magnitude)
+ {
+   int status = DM_CONVERT_EXACT;
+   int sign = dm_double_signbit(arg);
+   uint64_t limit = positive_limit;
+   uint64_t value = 0U;
+   int64_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   if (!!sign)
+    {
+      limit = negative_limit;
+    }
+   else
+    {
+      // Nothing to do
+    }
+   if (SPECIAL_EXPONENT == exponent)
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_INFINITY == significand)
+       {
+         DM_FE_RAISE(DM_FE_INVALID);
+         value = limit;
+         status = DM_CONVERT_SATURATED;
+       }
+      else if (0U != significand)
+       {
+         DM_FE_RAISE(DM_FE_INVALID);
+         status = DM_CONVERT_INVALID;
+       }
+      else
+       {
+         // Zero
+       }
+    }
+   else
+    {
+      uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+      exponent += scale;
+      if (exponent < CUTOFF) // Round away the fraction digits.
+       {
+         uint64_t divisor;
+         int events = 0;
+         if (exponent < -1)
+          {
+            divisor = 10U * makeShift[CUTOFF + 1]; // Below 0.1, every digit is lost alike.
+          }
+         else
+          {
+            divisor = makeShift[CUTOFF - exponent];
+          }
+         value = dm_core_round(sign, significand / divisor, divisor, significand % divisor, round_mode, &events);
+         dm_double_report(events);
+         if (0 != (events & DM_CORE_INEXACT))
+          {
+            status = DM_CONVERT_INEXACT;
+          }
+         else
+          {
+            // Nothing to do
+          }
+       }
+      else if ((exponent > (CUTOFF + 3)) || (significand > (limit / makeShift[exponent - CUTOFF + 2]))) // Past twenty digits, nothing fits.
+       {
+         value = limit;
+         status = DM_CONVERT_SATURATED;
+       }
+      else
+       {
+         value = significand * makeShift[exponent - CUTOFF + 2];
+       }
+      if (value > limit) // Rounded up past the limit, or negative for dm_double_touint64_r.
+       {
+         value = limit;
+         status = DM_CONVERT_SATURATED;
+       }
+      else
+       {
+         // Nothing to do
+       }
+      if (DM_CONVERT_SATURATED == status)
+       {
+         DM_FE_RAISE(DM_FE_INVALID);
+       }
+      else
+       {
+         // Nothing to do
+       }
+    }
+   *magnitude = value;
+   return status;
+ }
+
+dm_double dm_double_fromint64(int64_t arg)
+ {
+   dm_double result;
+   (void) dm_double_fromint64_r(arg, dm_global_round_mode, &result);
+   return result;
+ }
+
+dm_double dm_double_fromuint64(uint64_t arg)
+ {
+   dm_double result;
+   (void) dm_double_fromuint64_r(arg, dm_global_round_mode, &result);
+   return result;
+ }
+
+int dm_double_fromint64_r(int64_t arg, int round_mode, dm_double* result)
+ {
+   return dm_double_from_scaled_r(arg, 0, round_mode, result);
+ }
+
+int dm_double_fromuint64_r(uint64_t arg, int round_mode, dm_double* result)
+ {
+   return dm_double_frominteger(0U, arg, 0, round_mode, result);
+ }
+
+int dm_double_toint64_r(dm_double arg, int round_mode, int64_t* result)
+ {
+   return dm_double_to_scaled_r(arg, 0, round_mode, result);
+ }
+
+int dm_double_touint64_r(dm_double arg, int round_mode, uint64_t* result)
+ {
+   return dm_double_tointeger(arg, 0, round_mode, UINT64_MAX, 0U, result);
+ }
+
+int dm_double_fromint64_array(const int64_t* src, dm_double* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      status |= dm_double_fromint64_r(src[i], round_mode, &dest[i]);
+    }
+   return status;
+ }
+
+int dm_double_fromuint64_array(const uint64_t* src, dm_double* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      status |= dm_double_fromuint64_r(src[i], round_mode, &dest[i]);
+    }
+   return status;
+ }
+
+int dm_double_toint64_array(const dm_double* src, int64_t* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      status |= dm_double_toint64_r(src[i], round_mode, &dest[i]);
+    }
+   return status;
+ }
+
+int dm_double_touint64_array(const dm_double* src, uint64_t* dest, size_t count, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      status |= dm_double_touint64_r(src[i], round_mode, &dest[i]);
+    }
+   return status;
+ }
+
+dm_double dm_double_from_scaled(int64_t value, int scale)
+ {
+   dm_double result;
+   (void) dm_double_from_scaled_r(value, scale, dm_global_round_mode, &result);
+   return result;
+ }
+
+int dm_double_from_scaled_r(int64_t value, int scale, int round_mode, dm_double* result)
+ {
+   int status;
+   if (value < 0)
+    {
+      status = dm_double_frominteger(1U, 0U - (uint64_t)value, scale, round_mode, result);
+    }
+   else
+    {
+      status = dm_double_frominteger(0U, (uint64_t)value, scale, round_mode, result);
+    }
+   return status;
+ }
+
+int dm_double_to_scaled_r(dm_double arg, int scale, int round_mode, int64_t* result)
+ {
+   uint64_t magnitude;
+   int status = dm_double_tointeger(arg, scale, round_mode, (uint64_t)INT64_MAX, (uint64_t)INT64_MAX + 1U, &magnitude);
+   if ((!!dm_double_signbit(arg)) && (0U != magnitude))
+    {
+      *result = -(int64_t)(magnitude - 1U) - 1; // Without overflow for INT64_MIN.
+    }
+   else
+    {
+      *result = (int64_t)magnitude;
+    }
+   return status;
+ }
+
+   // The common cases of the scaled array conversions, without branches. They return non-zero
+   // for the elements that need the scalar conversion: those that round, saturate, or are special.
+static inline uint64_t dm_double_from_scaled_fast(int64_t value, int scale, dm_double* result)
+ {
+   uint64_t sign = (uint64_t)value >> 63;
+   uint64_t magnitude = ((uint64_t)value ^ (0U - sign)) + sign;
+   uint64_t significand = magnitude;
+   int64_t shift = dm_bid64_normalize(&significand);
+   uint64_t zero = 0U - (uint64_t)(0U == magnitude);
+   *result = (zero & DM_DOUBLE_PACK_ALT(0U, SPECIAL_EXPONENT, 0U)) | (~zero & DM_DOUBLE_PACK(sign, (int16_t)((CUTOFF - 1) - shift - scale), significand));
+   return (uint64_t)(magnitude > MAX_SIGNIFICAND);
+ }
+
+static inline uint64_t dm_double_to_scaled_fast(dm_double arg, int scale, int64_t* result)
+ {
+   int16_t exponent = DM_DOUBLE_UNPACK_EXPONENT(arg);
+   int64_t digits = (int64_t)exponent + scale; // The power of ten of the leading digit, once scaled.
+   uint64_t sign = arg >> 63;
+   uint64_t significand = DM_DOUBLE_UNPACK_SIGNIFICAND(arg);
+   uint64_t special = (uint64_t)(SPECIAL_EXPONENT == exponent);
+   uint64_t zero = special & (uint64_t)(0U == DM_DOUBLE_UNPACK_SIGNIFICAND_ALT(arg));
+   uint64_t divide = (special ^ 1U) & (uint64_t)(digits >= 0) & (uint64_t)(digits < CUTOFF);
+   uint64_t multiply = (special ^ 1U) & (uint64_t)(digits >= CUTOFF) & ((uint64_t)(digits < (CUTOFF + 2)) | ((uint64_t)((CUTOFF + 2) == digits) & (uint64_t)(significand <= ((uint64_t)INT64_MAX / 1000U))));
+   uint64_t in_range = divide | multiply;
+   uint64_t divisor = makeShift[(0U != divide) ? (CUTOFF - digits) : 1];
+   uint64_t multiplier = makeShift[(0U != multiply) ? (digits - (CUTOFF - 2)) : 1];
+   uint64_t magnitude = ((significand / divisor) * multiplier) & (0U - in_range);
+   *result = (int64_t)((magnitude ^ (0U - sign)) + sign);
+   return (in_range & (uint64_t)(0U != (significand % divisor))) | ((in_range | zero) ^ 1U);
+ }
+
+static inline int dm_double_from_scaled_kernel(const int64_t* src, dm_double* dest, size_t count, int scale, int round_mode)
+ {
+   uint64_t slow = 0U;
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      slow |= dm_double_from_scaled_fast(src[i], scale, &dest[i]);
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         if (0U != dm_double_from_scaled_fast(src[i], scale, &dest[i]))
+          {
+            status |= dm_double_from_scaled_r(src[i], scale, round_mode, &dest[i]);
+          }
+       }
+    }
+   return status;
+ }
+
+static inline int dm_double_to_scaled_kernel(const dm_double* src, int64_t* dest, size_t count, int scale, int round_mode)
+ {
+   uint64_t slow = 0U;
+   int status = DM_CONVERT_EXACT;
+   for (size_t i = 0U; i < count; ++i)
+    {
+      slow |= dm_double_to_scaled_fast(src[i], scale, &dest[i]);
+    }
+   if (0U != slow)
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         if (0U != dm_double_to_scaled_fast(src[i], scale, &dest[i]))
+          {
+            status |= dm_double_to_scaled_r(src[i], scale, round_mode, &dest[i]);
+          }
+       }
+    }
+   return status;
+ }
+
+   // Cents, basis points, and satoshi-like units get kernels of their own, in which the scale is a constant.
+int dm_double_from_scaled_array(const int64_t* src, dm_double* dest, size_t count, int scale, int round_mode)
+ {
+   int status = DM_CONVERT_EXACT;
+   if (2 == scale)
+    {
+      status = dm_double_from_scaled_kernel(src, dest, count, 2, round_mode);
+    }
+   else if (4 == scale)
+    {
+      status = dm_double_from_scaled_kernel(src, dest, count, 4, round_mode);
+    }
+   else if (8 == scale)
+    {
+      status = dm_double_from_scaled_kernel(src, dest, count, 8, round_mode);
+    }
+   else if ((scale > -MIN_EXPONENT) || (scale < ((CUTOFF - 1) - MAX_EXPONENT))) // Where the common case could leave the exponent range.
+    {
+      for (size_t i = 0U; i < count; ++i)
+       {
+         status |= dm_double_from_scaled_r(src[i], scale, round_mode, &dest[i]);
+       }
+    }
+   else
+    {
+      status = dm_double_from_scaled_kernel(src, dest, count, scale, round_mode);
+    }
+   return status;
+ }
+
+int dm_double_to_scaled_array(const dm_double* src, int64_t* dest, size_t count, int scale, int round_mode)
+ {
+   int status;
+   if (2 == scale)
+    {
+      status = dm_double_to_scaled_kernel(src, dest, count, 2, round_mode);
+    }
+   else if (4 == scale)
+    {
+      status = dm_double_to_scaled_kernel(src, dest, count, 4, round_mode);
+    }
+   else if (8 == scale)
+    {
+      status = dm_double_to_scaled_kernel(src, dest, count, 8, round_mode);
+    }
+   else
+    {
+      status = dm_double_to_scaled_kernel(src, dest, count, scale, round_mode);
+    }
+   return status;
+ }
+
 #ifndef DM_NO_DOUBLE_MATH
 
 double dm_double_todouble(dm_double arg)
@@ -2272,11 +3243,15 @@ dm_double dm_double_fromlongdouble(long double arg)
 
       if (exponent > MAX_EXPONENT) // Can overflow in the dest
        {
+         DM_STATS_COUNT(flush_to_infinity);
+         DM_FE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
          significand = DM_INFINITY + MIN_SIGNIFICAND;
          exponent = SPECIAL_EXPONENT;
        }
       else if (exponent < MIN_EXPONENT)
        {
+         DM_STATS_COUNT(flush_to_zero);
+         DM_FE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
          significand = MIN_SIGNIFICAND;
          exponent = SPECIAL_EXPONENT;
        }
@@ -0,0 +1,230 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_DOUBLE_PREFIX_H
+#define DM_DOUBLE_PREFIX_H
+
+/*
+   Symbol prefixes, so that both implementations can be linked into one
+   binary.
+
+   dm_double.c and dm_double_m.c define the same functions for different bit
+   layouts. Build each of them, and the files that call them, with a
+   different DM_DOUBLE_PREFIX, such as -DDM_DOUBLE_PREFIX=legacy_ and
+   -DDM_DOUBLE_PREFIX=misra_, and every external symbol they define or use
+   gets that prefix: dm_double_add becomes legacy_dm_double_add. Code that
+   includes dm_double.h or dm_double_m.h with the same prefix defined calls
+   the prefixed functions under their usual names. Each implementation keeps
+   its own rounding mode and status flags.
+
+   dm_muldiv.c, dm_single.c, dm_quad.c, and dm_double_layout.c don't depend on
+   the layout, and are built once. dm_single.c and dm_quad.c take their
+   rounding mode and flags from the implementation whose prefix they are
+   built with. Make.sh builds such a library, libdecmath_dual.a.
+
+   Without DM_DOUBLE_PREFIX, this header does nothing. Every new external
+   symbol of the files built per implementation needs a line here.
+*/
+
+#ifdef DM_DOUBLE_PREFIX
+
+#define DM_DOUBLE_PREFIX_PASTE(prefix, name) prefix ## name
+#define DM_DOUBLE_PREFIX_JOIN(prefix, name)  DM_DOUBLE_PREFIX_PASTE(prefix, name)
+#define DM_DOUBLE_PREFIXED(name)             DM_DOUBLE_PREFIX_JOIN(DM_DOUBLE_PREFIX, name)
+
+   // dm_double.h and dm_double_m.h, and the dm_double_Zero, dm_double_NaN, and dm_double_Inf constants.
+#define dm_decideRound                 DM_DOUBLE_PREFIXED(dm_decideRound)
+#define dm_double_Inf                  DM_DOUBLE_PREFIXED(dm_double_Inf)
+#define dm_double_NaN                  DM_DOUBLE_PREFIXED(dm_double_NaN)
+#define dm_double_Zero                 DM_DOUBLE_PREFIXED(dm_double_Zero)
+#define dm_double_add                  DM_DOUBLE_PREFIXED(dm_double_add)
+#define dm_double_add_r                DM_DOUBLE_PREFIXED(dm_double_add_r)
+#define dm_double_ceil                 DM_DOUBLE_PREFIXED(dm_double_ceil)
+#define dm_double_copysign             DM_DOUBLE_PREFIXED(dm_double_copysign)
+#define dm_double_digits               DM_DOUBLE_PREFIXED(dm_double_digits)
+#define dm_double_div                  DM_DOUBLE_PREFIXED(dm_double_div)
+#define dm_double_div_r                DM_DOUBLE_PREFIXED(dm_double_div_r)
+#define dm_double_exp                  DM_DOUBLE_PREFIXED(dm_double_exp)
+#define dm_double_expm1                DM_DOUBLE_PREFIXED(dm_double_expm1)
+#define dm_double_fabs                 DM_DOUBLE_PREFIXED(dm_double_fabs)
+#define dm_double_floor                DM_DOUBLE_PREFIXED(dm_double_floor)
+#define dm_double_fma                  DM_DOUBLE_PREFIXED(dm_double_fma)
+#define dm_double_fmax                 DM_DOUBLE_PREFIXED(dm_double_fmax)
+#define dm_double_fmin                 DM_DOUBLE_PREFIXED(dm_double_fmin)
+#define dm_double_fmod                 DM_DOUBLE_PREFIXED(dm_double_fmod)
+#define dm_double_fpclassify           DM_DOUBLE_PREFIXED(dm_double_fpclassify)
+#define dm_double_frexp                DM_DOUBLE_PREFIXED(dm_double_frexp)
+#define dm_double_from_scaled          DM_DOUBLE_PREFIXED(dm_double_from_scaled)
+#define dm_double_from_scaled_array    DM_DOUBLE_PREFIXED(dm_double_from_scaled_array)
+#define dm_double_from_scaled_r        DM_DOUBLE_PREFIXED(dm_double_from_scaled_r)
+#define dm_double_fromdouble           DM_DOUBLE_PREFIXED(dm_double_fromdouble)
+#define dm_double_fromint64            DM_DOUBLE_PREFIXED(dm_double_fromint64)
+#define dm_double_fromint64_array      DM_DOUBLE_PREFIXED(dm_double_fromint64_array)
+#define dm_double_fromint64_r          DM_DOUBLE_PREFIXED(dm_double_fromint64_r)
+#define dm_double_fromlongdouble       DM_DOUBLE_PREFIXED(dm_double_fromlongdouble)
+#define dm_double_fromstring           DM_DOUBLE_PREFIXED(dm_double_fromstring)
+#define dm_double_fromuint64           DM_DOUBLE_PREFIXED(dm_double_fromuint64)
+#define dm_double_fromuint64_array     DM_DOUBLE_PREFIXED(dm_double_fromuint64_array)
+#define dm_double_fromuint64_r         DM_DOUBLE_PREFIXED(dm_double_fromuint64_r)
+#define dm_double_iscanonical          DM_DOUBLE_PREFIXED(dm_double_iscanonical)
+#define dm_double_isequal              DM_DOUBLE_PREFIXED(dm_double_isequal)
+#define dm_double_isfinite             DM_DOUBLE_PREFIXED(dm_double_isfinite)
+#define dm_double_isgreater            DM_DOUBLE_PREFIXED(dm_double_isgreater)
+#define dm_double_isgreaterequal       DM_DOUBLE_PREFIXED(dm_double_isgreaterequal)
+#define dm_double_isinf                DM_DOUBLE_PREFIXED(dm_double_isinf)
+#define dm_double_isless               DM_DOUBLE_PREFIXED(dm_double_isless)
+#define dm_double_islessequal          DM_DOUBLE_PREFIXED(dm_double_islessequal)
+#define dm_double_islessgreater        DM_DOUBLE_PREFIXED(dm_double_islessgreater)
+#define dm_double_isnan                DM_DOUBLE_PREFIXED(dm_double_isnan)
+#define dm_double_isnormal             DM_DOUBLE_PREFIXED(dm_double_isnormal)
+#define dm_double_issignaling          DM_DOUBLE_PREFIXED(dm_double_issignaling)
+#define dm_double_issubnormal          DM_DOUBLE_PREFIXED(dm_double_issubnormal)
+#define dm_double_isunequal            DM_DOUBLE_PREFIXED(dm_double_isunequal)
+#define dm_double_isunordered          DM_DOUBLE_PREFIXED(dm_double_isunordered)
+#define dm_double_iszero               DM_DOUBLE_PREFIXED(dm_double_iszero)
+#define dm_double_ldexp                DM_DOUBLE_PREFIXED(dm_double_ldexp)
+#define dm_double_log                  DM_DOUBLE_PREFIXED(dm_double_log)
+#define dm_double_log10                DM_DOUBLE_PREFIXED(dm_double_log10)
+#define dm_double_log1p                DM_DOUBLE_PREFIXED(dm_double_log1p)
+#define dm_double_modf                 DM_DOUBLE_PREFIXED(dm_double_modf)
+#define dm_double_mul                  DM_DOUBLE_PREFIXED(dm_double_mul)
+#define dm_double_mul_r                DM_DOUBLE_PREFIXED(dm_double_mul_r)
+#define dm_double_nearbyint            DM_DOUBLE_PREFIXED(dm_double_nearbyint)
+#define dm_double_neg                  DM_DOUBLE_PREFIXED(dm_double_neg)
+#define dm_double_pow                  DM_DOUBLE_PREFIXED(dm_double_pow)
+#define dm_double_powi_r               DM_DOUBLE_PREFIXED(dm_double_powi_r)
+#define dm_double_quantize_array       DM_DOUBLE_PREFIXED(dm_double_quantize_array)
+#define dm_double_quantize_r           DM_DOUBLE_PREFIXED(dm_double_quantize_r)
+#define dm_double_round                DM_DOUBLE_PREFIXED(dm_double_round)
+#define dm_double_roundeven            DM_DOUBLE_PREFIXED(dm_double_roundeven)
+#define dm_double_signbit              DM_DOUBLE_PREFIXED(dm_double_signbit)
+#define dm_double_sqrt                 DM_DOUBLE_PREFIXED(dm_double_sqrt)
+#define dm_double_sqrt_r               DM_DOUBLE_PREFIXED(dm_double_sqrt_r)
+#define dm_double_sub                  DM_DOUBLE_PREFIXED(dm_double_sub)
+#define dm_double_sub_r                DM_DOUBLE_PREFIXED(dm_double_sub_r)
+#define dm_double_to_scaled_array      DM_DOUBLE_PREFIXED(dm_double_to_scaled_array)
+#define dm_double_to_scaled_r          DM_DOUBLE_PREFIXED(dm_double_to_scaled_r)
+#define dm_double_todouble             DM_DOUBLE_PREFIXED(dm_double_todouble)
+#define dm_double_toint64_array        DM_DOUBLE_PREFIXED(dm_double_toint64_array)
+#define dm_double_toint64_r            DM_DOUBLE_PREFIXED(dm_double_toint64_r)
+#define dm_double_tolongdouble         DM_DOUBLE_PREFIXED(dm_double_tolongdouble)
+#define dm_double_tostring             DM_DOUBLE_PREFIXED(dm_double_tostring)
+#define dm_double_touint64_array       DM_DOUBLE_PREFIXED(dm_double_touint64_array)
+#define dm_double_touint64_r           DM_DOUBLE_PREFIXED(dm_double_touint64_r)
+#define dm_double_trailing_zeros       DM_DOUBLE_PREFIXED(dm_double_trailing_zeros)
+#define dm_double_trunc                DM_DOUBLE_PREFIXED(dm_double_trunc)
+#define dm_feclearexcept               DM_DOUBLE_PREFIXED(dm_feclearexcept)
+#define dm_fegetround                  DM_DOUBLE_PREFIXED(dm_fegetround)
+#define dm_feraiseexcept               DM_DOUBLE_PREFIXED(dm_feraiseexcept)
+#define dm_fesetround                  DM_DOUBLE_PREFIXED(dm_fesetround)
+#define dm_fetestexcept                DM_DOUBLE_PREFIXED(dm_fetestexcept)
+#define dm_internal_round              DM_DOUBLE_PREFIXED(dm_internal_round)
+#define dm_stats_reset                 DM_DOUBLE_PREFIXED(dm_stats_reset)
+#define dm_stats_snapshot              DM_DOUBLE_PREFIXED(dm_stats_snapshot)
+
+   // The conversions in dm_double.c and dm_double_m.c, declared in dm_single.h, dm_quad.h, dm_decimal64.h, and dm_double_codec.h.
+#define dm_double_from_bid64           DM_DOUBLE_PREFIXED(dm_double_from_bid64)
+#define dm_double_from_bid64_array     DM_DOUBLE_PREFIXED(dm_double_from_bid64_array)
+#define dm_double_from_varint          DM_DOUBLE_PREFIXED(dm_double_from_varint)
+#define dm_double_from_varint_array    DM_DOUBLE_PREFIXED(dm_double_from_varint_array)
+#define dm_double_fromquad             DM_DOUBLE_PREFIXED(dm_double_fromquad)
+#define dm_double_fromquad_r           DM_DOUBLE_PREFIXED(dm_double_fromquad_r)
+#define dm_double_fromsingle           DM_DOUBLE_PREFIXED(dm_double_fromsingle)
+#define dm_double_fromsingle_array     DM_DOUBLE_PREFIXED(dm_double_fromsingle_array)
+#define dm_double_to_bid64             DM_DOUBLE_PREFIXED(dm_double_to_bid64)
+#define dm_double_to_bid64_array       DM_DOUBLE_PREFIXED(dm_double_to_bid64_array)
+#define dm_double_to_bid64_r           DM_DOUBLE_PREFIXED(dm_double_to_bid64_r)
+#define dm_double_to_varint            DM_DOUBLE_PREFIXED(dm_double_to_varint)
+#define dm_double_to_varint_array      DM_DOUBLE_PREFIXED(dm_double_to_varint_array)
+#define dm_double_toquad               DM_DOUBLE_PREFIXED(dm_double_toquad)
+#define dm_double_tosingle             DM_DOUBLE_PREFIXED(dm_double_tosingle)
+#define dm_double_tosingle_array       DM_DOUBLE_PREFIXED(dm_double_tosingle_array)
+#define dm_double_tosingle_r           DM_DOUBLE_PREFIXED(dm_double_tosingle_r)
+
+   // The batch kernels that dm_double.c and dm_double_m.c build from dm_double_kernels.h.
+#define dm_double_batch_kernels        DM_DOUBLE_PREFIXED(dm_double_batch_kernels)
+
+   // dm_double_pretty.c
+#define dm_double_toprettystring       DM_DOUBLE_PREFIXED(dm_double_toprettystring)
+
+   // dm_double_batch.c
+#define dm_double_batch_getisa         DM_DOUBLE_PREFIXED(dm_double_batch_getisa)
+#define dm_double_batch_setisa         DM_DOUBLE_PREFIXED(dm_double_batch_setisa)
+#define dm_double_batch_getthreads     DM_DOUBLE_PREFIXED(dm_double_batch_getthreads)
+#define dm_double_batch_setthreads     DM_DOUBLE_PREFIXED(dm_double_batch_setthreads)
+#define dm_double_add_array            DM_DOUBLE_PREFIXED(dm_double_add_array)
+#define dm_double_sub_array            DM_DOUBLE_PREFIXED(dm_double_sub_array)
+#define dm_double_mul_array            DM_DOUBLE_PREFIXED(dm_double_mul_array)
+#define dm_double_div_array            DM_DOUBLE_PREFIXED(dm_double_div_array)
+#define dm_double_sqrt_array           DM_DOUBLE_PREFIXED(dm_double_sqrt_array)
+#define dm_double_fma_array            DM_DOUBLE_PREFIXED(dm_double_fma_array)
+#define dm_double_exp_array            DM_DOUBLE_PREFIXED(dm_double_exp_array)
+#define dm_double_expm1_array          DM_DOUBLE_PREFIXED(dm_double_expm1_array)
+#define dm_double_log_array            DM_DOUBLE_PREFIXED(dm_double_log_array)
+#define dm_double_log10_array          DM_DOUBLE_PREFIXED(dm_double_log10_array)
+#define dm_double_log1p_array          DM_DOUBLE_PREFIXED(dm_double_log1p_array)
+#define dm_double_pow_array            DM_DOUBLE_PREFIXED(dm_double_pow_array)
+#define dm_double_isless_array         DM_DOUBLE_PREFIXED(dm_double_isless_array)
+#define dm_double_islessequal_array    DM_DOUBLE_PREFIXED(dm_double_islessequal_array)
+#define dm_double_isgreater_array      DM_DOUBLE_PREFIXED(dm_double_isgreater_array)
+#define dm_double_isgreaterequal_array DM_DOUBLE_PREFIXED(dm_double_isgreaterequal_array)
+#define dm_double_isequal_array        DM_DOUBLE_PREFIXED(dm_double_isequal_array)
+#define dm_double_inclusive_scan       DM_DOUBLE_PREFIXED(dm_double_inclusive_scan)
+#define dm_double_exclusive_scan       DM_DOUBLE_PREFIXED(dm_double_exclusive_scan)
+#define dm_double_fromstring_array     DM_DOUBLE_PREFIXED(dm_double_fromstring_array)
+#define dm_double_todouble_array       DM_DOUBLE_PREFIXED(dm_double_todouble_array)
+#define dm_double_fromdouble_array     DM_DOUBLE_PREFIXED(dm_double_fromdouble_array)
+
+   // dm_double_column.c
+#define dm_double_column_write         DM_DOUBLE_PREFIXED(dm_double_column_write)
+#define dm_double_column_open          DM_DOUBLE_PREFIXED(dm_double_column_open)
+#define dm_double_column_close         DM_DOUBLE_PREFIXED(dm_double_column_close)
+#define dm_double_column_block         DM_DOUBLE_PREFIXED(dm_double_column_block)
+#define dm_double_column_skip          DM_DOUBLE_PREFIXED(dm_double_column_skip)
+#define dm_double_column_select        DM_DOUBLE_PREFIXED(dm_double_column_select)
+
+   // dm_double_codec.c
+#define dm_double_block_encode         DM_DOUBLE_PREFIXED(dm_double_block_encode)
+#define dm_double_block_count          DM_DOUBLE_PREFIXED(dm_double_block_count)
+#define dm_double_block_decode         DM_DOUBLE_PREFIXED(dm_double_block_decode)
+
+   // dm_decimal64.c
+#define dm_bid64_to_dpd64              DM_DOUBLE_PREFIXED(dm_bid64_to_dpd64)
+#define dm_dpd64_to_bid64              DM_DOUBLE_PREFIXED(dm_dpd64_to_bid64)
+#define dm_double_to_dpd64             DM_DOUBLE_PREFIXED(dm_double_to_dpd64)
+#define dm_double_to_dpd64_r           DM_DOUBLE_PREFIXED(dm_double_to_dpd64_r)
+#define dm_double_from_dpd64           DM_DOUBLE_PREFIXED(dm_double_from_dpd64)
+#define dm_double_to_dpd64_array       DM_DOUBLE_PREFIXED(dm_double_to_dpd64_array)
+#define dm_double_from_dpd64_array     DM_DOUBLE_PREFIXED(dm_double_from_dpd64_array)
+
+#endif /* DM_DOUBLE_PREFIX */
+
+#endif /* DM_DOUBLE_PREFIX_H */
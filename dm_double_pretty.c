@@ -33,38 +33,65 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include <string.h>
 
+#include "dm_double_prefix.h"
+
    /* ABI compatible defines. */
 typedef uint64_t dm_double;
 
-int dm_double_iscanonical (dm_double);
-int dm_double_isinf       (dm_double);
-int dm_double_isnan       (dm_double);
-int dm_double_signbit     (dm_double);
-int dm_double_iszero      (dm_double);
-dm_double dm_double_fabs  (dm_double);
-dm_double dm_double_frexp (dm_double, int*);
-void dm_double_tostring   (dm_double, char [25]);
+int dm_double_iscanonical    (dm_double);
+int dm_double_isinf          (dm_double);
+int dm_double_isnan          (dm_double);
+int dm_double_signbit        (dm_double);
+int dm_double_iszero         (dm_double);
+dm_double dm_double_fabs     (dm_double);
+dm_double dm_double_frexp    (dm_double, int*);
+int dm_double_trailing_zeros (dm_double);
+int dm_double_to_scaled_r    (dm_double, int, int, int64_t*);
+#define DM_FE_TOWARDZERO  4
+
+static const uint64_t powers [] =
+ {
+   1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+   10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL
+ };
+
+static const char pairs [] =
+   "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+   "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
 
-static void conditionResult(char result [24])
+   // Writes value as exactly count digits, with leading zeros, and returns where they end.
+static char* putDigits(char* dest, uint64_t value, int count)
  {
-   int base = 16;
-   if ('-' == result[0])
-    {
-      base = base + 1;
-    }
-   int index = base;
-   while ('0' == result[index])
+   uint64_t rest = value;
+   int index = count;
+   while (index > 1)
     {
-      --index;
+      uint64_t pair = (rest % 100U) * 2U;
+      rest /= 100U;
+      index -= 2;
+      dest[index] = pairs[pair];
+      dest[index + 1] = pairs[pair + 1U];
     }
-   if ('.' == result[index])
+   if (1 == index)
     {
-      --index;
+      dest[0] = (char)('0' + rest);
     }
-   if (index != base)
+   return dest + count;
+ }
+
+   // Writes the sixteen digits with the decimal point after the first whole + 1, less the trailing zeros.
+   // The whole part keeps its zeros, and there is no point if nothing follows it.
+static char* putFixed(char* dest, uint64_t significand, int whole, int zeros)
+ {
+   char* result = putDigits(dest, significand / powers[15 - whole], whole + 1);
+   if (zeros < (15 - whole))
     {
-      memmove(&result[index + 1], &result[base + 1], 6U);
+      *result = '.';
+      ++result;
+      result = putDigits(result, (significand % powers[15 - whole]) / powers[zeros], 15 - whole - zeros);
     }
+   return result;
  }
 
    /*
@@ -84,145 +111,65 @@ static void conditionResult(char result [24])
             Don't go all the way to 21, it would be too much.
             -9.999999999999999e-511
             -0.0000000009
+         Printing like normal is what dm_double_tostring does, less the trailing zeros, and the decimal point if they were all zeros.
+
+      Once the trailing zeros are counted, every digit is written where it goes, and the length is known.
    */
-void dm_double_toprettystring (dm_double arg, char result [24])
+int dm_double_toprettystring (dm_double arg, char result [24])
  {
-   char temp [25];
-      // Just use the output of normal tostring.
-   if (dm_double_isnan(arg) || dm_double_isinf(arg))
+   char* end = result;
+   if (!!dm_double_signbit(arg) && !!dm_double_iscanonical(arg))
     {
-      (void) memset(temp, '\0', 25U);
-      dm_double_tostring(arg, temp);
-      memmove(result, temp, 24U);
+      *end = '-';
+      ++end;
     }
+
       // Special error string. If the software emits this, we will assume that it is a bug in the software.
-   else if (!dm_double_iscanonical(arg))
+   if (!dm_double_iscanonical(arg))
+    {
+      (void) memcpy(end, "Err", 3U);
+      end += 3;
+    }
+   else if (!!dm_double_isnan(arg) || !!dm_double_isinf(arg)) // As dm_double_tostring prints them
     {
-      result[0] = 'E';
-      result[1] = 'r';
-      result[2] = 'r';
-      result[3] = '\0';
+      (void) memcpy(end, !!dm_double_isnan(arg) ? "NaN" : "Inf", 3U);
+      end += 3;
     }
    else if (!!dm_double_iszero(arg)) // Zeros need special handling.
     {
-      if (!!dm_double_signbit(arg))
-       {
-         result[0] = '-';
-         result[1] = '0';
-         result[2] = '\0';
-       }
-      else
-       {
-         result[0] = '0';
-         result[1] = '\0';
-       }
+      *end = '0';
+      ++end;
     }
    else // This is a number to print.
     {
-      int sign = dm_double_signbit(arg);
       int exponent;
+      int64_t significand = 0;
+      int zeros = dm_double_trailing_zeros(arg);
          // This function is ABI compatible, as it never involves itself with the underlying representation.
-      dm_double significand = dm_double_fabs(dm_double_frexp(arg, &exponent));
+      (void) dm_double_to_scaled_r(dm_double_fabs(dm_double_frexp(arg, &exponent)), 15, DM_FE_TOWARDZERO, &significand); // Exact: sixteen digits
 
-      if ((exponent > 15) || (exponent < -10)) // Firstly: all other cases.
+      if ((exponent >= 0) && (exponent <= 15)) // Numbers that we need to move the radix point to the right for.
        {
-         (void) memset(temp, '\0', 25U);
-         dm_double_tostring(arg, temp);
-         memmove(result, temp, 24U);
-         conditionResult(result);
+         end = putFixed(end, (uint64_t)significand, exponent, zeros);
        }
-      else if (exponent >= 0) // Numbers that we need to move the radix point to the right for.
+      else if ((exponent < 0) && (exponent >= -10) && ((exponent + zeros) >= -5)) // Do we just want to print leading zeros?
        {
-         dm_double_tostring(significand, temp); // Just the significand, always positive.
-
-         int index = 1;
-         while (exponent > 0)
-          {
-            char swap = temp[index];
-            temp[index] = temp[index + 1];
-            temp[index + 1] = swap;
-            ++index;
-            --exponent;
-          }
-
-         temp[17] = '\0'; // Don't need that 'e' anymore.
-         index = 16;
-         while ('0' == temp[index]) // Remove trailing '0's.
-          {
-            temp[index] = '\0';
-            --index;
-          }
-         if ('.' == temp[index]) // If the number is an integer, then remove the decimal point.
-          {
-            temp[index] = '\0';
-          }
-
-         // Now, recompose the result.
-         index = 0;
-         if (0 != sign)
-          {
-            result[index] = '-';
-            ++index;
-          }
-         int c = 0; // strcpy, but not because its "bad"
-         while ((c < 17) && ('\0' != temp[c]))
-          {
-            result[index] = temp[c];
-            ++index;
-            ++c;
-          }
-         result[index] = '\0'; // I'm sure some static analysis tool is now happy.
+         end[0] = '0';
+         end[1] = '.';
+         (void) memset(end + 2, '0', (size_t)(-1 - exponent));
+         end += 1 - exponent;
+         end = putDigits(end, (uint64_t)significand / powers[zeros], 16 - zeros);
        }
-      else // Exponent < 0 but > -10
+      else // All other cases.
        {
-            // First step : remove trailing zeros and count zeros removed.
-         dm_double_tostring(significand, temp); // Just the significand, always positive.
-         temp[17] = '\0'; // Don't need that 'e' anymore.
-         int index = 16;
-         int removed = 0;
-         while ('0' == temp[index]) // Remove trailing '0's.
-          {
-            temp[index] = '\0';
-            --index;
-            ++removed;
-          }
-
-         if ((exponent + removed) >= -5) // Do we just want to print leading zeros?
-          {
-            index = 0;
-            if (0 != sign)
-             {
-               result[index] = '-';
-               ++index;
-             }
-            result[index] = '0';
-            ++index;
-            result[index] = '.';
-            ++index;
-            while (exponent < -1)
-             {
-               result[index] = '0';
-               ++index;
-               ++exponent;
-             }
-            result[index] = temp[0];
-            ++index;
-            int c = 2; // strcpy, but not because its "bad"
-            while ((c < 17) && ('\0' != temp[c]))
-             {
-               result[index] = temp[c];
-               ++index;
-               ++c;
-             }
-            result[index] = '\0'; // I'm sure some static analysis tool is now happy.
-          }
-         else // This is actually a normal case. This is inefficient, but we're, like, doing things in decimal, man.
-          {
-            (void) memset(temp, '\0', 25U);
-            dm_double_tostring(arg, temp);
-            memmove(result, temp, 24U);
-            conditionResult(result);
-          }
+         int magnitude = (exponent < 0) ? -exponent : exponent;
+         end = putFixed(end, (uint64_t)significand, 0, zeros);
+         end[0] = 'e';
+         end[1] = (exponent < 0) ? '-' : '+';
+         end = putDigits(end + 2, (uint64_t)magnitude, (magnitude >= 100) ? 3 : ((magnitude >= 10) ? 2 : 1));
        }
     }
+
+   *end = '\0';
+   return (int)(end - result);
  }
@@ -36,7 +36,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 extern "C" {
 #endif
 
-void dm_double_toprettystring (dm_double, char [24]);
+int dm_double_toprettystring (dm_double, char [24]); // Returns the length, as strlen would
 
 #ifdef __cplusplus
 }
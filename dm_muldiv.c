@@ -361,3 +361,267 @@ int dm_muldiv_less(dm_muldiv_t lhs, dm_muldiv_t rhs)
    return result;
 #endif
  }
+
+
+   // The 256 bit numbers. Every destination may alias any source.
+#ifndef DM_NO_128_BIT_TYPE
+typedef __uint128_t dm_muldiv_dlimb_t;
+#else
+typedef uint64_t dm_muldiv_dlimb_t;
+#endif
+#define DM_MULDIV_LIMB_BITS (8U * sizeof(dm_muldiv_limb_t))
+
+void dm_muldiv_wide_loadFrom(dm_muldiv_wide_t dest, uint64_t high, uint64_t low)
+ {
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      dest[i] = 0U;
+    }
+#ifndef DM_NO_128_BIT_TYPE
+   dest[1] = high;
+   dest[0] = low;
+#else // DM_NO_128_BIT_TYPE
+   dest[3] = high >> 32U;
+   dest[2] = high;
+   dest[1] = low >> 32U;
+   dest[0] = low;
+#endif
+ }
+
+void dm_muldiv_wide_extract(dm_muldiv_wide_t source, uint64_t* high, uint64_t* low)
+ {
+#ifndef DM_NO_128_BIT_TYPE
+   *high = source[1];
+   *low = source[0];
+#else // DM_NO_128_BIT_TYPE
+   *high = (((uint64_t)source[3]) << 32U) | source[2];
+   *low = (((uint64_t)source[1]) << 32U) | source[0];
+#endif
+ }
+
+   // The number of limbs, ignoring leading zero limbs.
+static unsigned int dm_muldiv_wide_length(dm_muldiv_wide_t arg)
+ {
+   unsigned int result = DM_MULDIV_WIDE_LIMBS;
+   while ((0U != result) && (0U == arg[result - 1U]))
+    {
+      --result;
+    }
+   return result;
+ }
+
+void dm_muldiv_wide_mul(dm_muldiv_wide_t dest, dm_muldiv_wide_t lhs, dm_muldiv_wide_t rhs)
+ {
+   dm_muldiv_wide_t result;
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      result[i] = 0U;
+    }
+   unsigned int lLength = dm_muldiv_wide_length(lhs);
+   unsigned int rLength = dm_muldiv_wide_length(rhs);
+   for (unsigned int i = 0U; i < lLength; ++i)
+    {
+      dm_muldiv_dlimb_t carry = 0U;
+      unsigned int j;
+      for (j = 0U; (j < rLength) && ((i + j) < DM_MULDIV_WIDE_LIMBS); ++j)
+       {
+            // Can't overflow, for the same reason as dm_muldiv_mulBy.
+         carry += ((dm_muldiv_dlimb_t)lhs[i]) * rhs[j] + result[i + j];
+         result[i + j] = (dm_muldiv_limb_t)carry;
+         carry >>= DM_MULDIV_LIMB_BITS;
+       }
+      if ((i + j) < DM_MULDIV_WIDE_LIMBS)
+       {
+         result[i + j] = (dm_muldiv_limb_t)carry;
+       }
+    }
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      dest[i] = result[i];
+    }
+ }
+
+   // Knuth's algorithm D, as in Hacker's Delight's divmnu.
+void dm_muldiv_wide_divBy(dm_muldiv_wide_t lhs, dm_muldiv_wide_t rhs, dm_muldiv_wide_t quo, dm_muldiv_wide_t rem)
+ {
+   dm_muldiv_limb_t u [DM_MULDIV_WIDE_LIMBS + 1U];
+   dm_muldiv_limb_t v [DM_MULDIV_WIDE_LIMBS];
+   dm_muldiv_limb_t q [DM_MULDIV_WIDE_LIMBS];
+   unsigned int m = dm_muldiv_wide_length(lhs);
+   unsigned int n = dm_muldiv_wide_length(rhs); // Division by zero is a programming error.
+
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      q[i] = 0U;
+    }
+
+   if (m < n)
+    {
+      for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+       {
+         rem[i] = lhs[i];
+       }
+    }
+   else if (1U == n) // Short division
+    {
+      dm_muldiv_dlimb_t r = 0U;
+      for (unsigned int i = m; i > 0U; --i)
+       {
+         r = (r << DM_MULDIV_LIMB_BITS) | lhs[i - 1U];
+         q[i - 1U] = (dm_muldiv_limb_t)(r / rhs[0]);
+         r %= rhs[0];
+       }
+      dm_muldiv_wide_loadFrom(rem, 0U, 0U);
+      rem[0] = (dm_muldiv_limb_t)r;
+    }
+   else
+    {
+         // Normalize, so that the top bit of the divisor is set.
+      unsigned int s = 0U;
+      while (0U == (rhs[n - 1U] & (((dm_muldiv_limb_t)1U) << (DM_MULDIV_LIMB_BITS - 1U - s))))
+       {
+         ++s;
+       }
+      for (unsigned int i = n - 1U; i > 0U; --i)
+       {
+         v[i] = (rhs[i] << s) | ((0U == s) ? 0U : (rhs[i - 1U] >> (DM_MULDIV_LIMB_BITS - s)));
+       }
+      v[0] = rhs[0] << s;
+      u[m] = (0U == s) ? 0U : (lhs[m - 1U] >> (DM_MULDIV_LIMB_BITS - s));
+      for (unsigned int i = m - 1U; i > 0U; --i)
+       {
+         u[i] = (lhs[i] << s) | ((0U == s) ? 0U : (lhs[i - 1U] >> (DM_MULDIV_LIMB_BITS - s)));
+       }
+      u[0] = lhs[0] << s;
+
+      const dm_muldiv_dlimb_t base = ((dm_muldiv_dlimb_t)1U) << DM_MULDIV_LIMB_BITS;
+      for (unsigned int j = m - n + 1U; j > 0U; --j)
+       {
+         unsigned int k = j - 1U;
+            // Estimate the quotient digit from the top two digits; it is at most two too large.
+         dm_muldiv_dlimb_t num = (((dm_muldiv_dlimb_t)u[k + n]) << DM_MULDIV_LIMB_BITS) | u[k + n - 1U];
+         dm_muldiv_dlimb_t qhat = num / v[n - 1U];
+         dm_muldiv_dlimb_t rhat = num % v[n - 1U];
+         while ((qhat >= base) || ((qhat * v[n - 2U]) > ((rhat << DM_MULDIV_LIMB_BITS) | u[k + n - 2U])))
+          {
+            --qhat;
+            rhat += v[n - 1U];
+            if (rhat >= base)
+             {
+               break;
+             }
+          }
+
+            // Multiply and subtract.
+         dm_muldiv_dlimb_t carry = 0U;
+         dm_muldiv_limb_t borrow = 0U;
+         for (unsigned int i = 0U; i <= n; ++i)
+          {
+            dm_muldiv_limb_t sub;
+            if (i < n)
+             {
+               dm_muldiv_dlimb_t p = qhat * v[i] + carry;
+               carry = p >> DM_MULDIV_LIMB_BITS;
+               sub = (dm_muldiv_limb_t)p;
+             }
+            else
+             {
+               sub = (dm_muldiv_limb_t)carry;
+             }
+            dm_muldiv_limb_t digit = u[i + k];
+            u[i + k] = digit - sub - borrow;
+            borrow = ((digit < sub) || ((dm_muldiv_limb_t)(digit - sub) < borrow)) ? 1U : 0U;
+          }
+
+            // The estimate was one too large: add back.
+         if (0U != borrow)
+          {
+            --qhat;
+            carry = 0U;
+            for (unsigned int i = 0U; i < n; ++i)
+             {
+               carry += ((dm_muldiv_dlimb_t)u[i + k]) + v[i];
+               u[i + k] = (dm_muldiv_limb_t)carry;
+               carry >>= DM_MULDIV_LIMB_BITS;
+             }
+            u[k + n] += (dm_muldiv_limb_t)carry;
+          }
+         q[k] = (dm_muldiv_limb_t)qhat;
+       }
+
+         // Unnormalize the remainder.
+      dm_muldiv_wide_loadFrom(rem, 0U, 0U);
+      for (unsigned int i = 0U; i < n; ++i)
+       {
+         rem[i] = (u[i] >> s) | ((0U == s) ? 0U : (u[i + 1U] << (DM_MULDIV_LIMB_BITS - s)));
+       }
+    }
+
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      quo[i] = q[i];
+    }
+ }
+
+void dm_muldiv_wide_add(dm_muldiv_wide_t dest, dm_muldiv_wide_t lhs, dm_muldiv_wide_t rhs)
+ {
+   dm_muldiv_dlimb_t carry = 0U;
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      carry += ((dm_muldiv_dlimb_t)lhs[i]) + rhs[i];
+      dest[i] = (dm_muldiv_limb_t)carry;
+      carry >>= DM_MULDIV_LIMB_BITS;
+    }
+ }
+
+void dm_muldiv_wide_sub(dm_muldiv_wide_t dest, dm_muldiv_wide_t lhs, dm_muldiv_wide_t rhs)
+ {
+   dm_muldiv_limb_t borrow = 0U;
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      dm_muldiv_limb_t digit = lhs[i];
+      dm_muldiv_limb_t sub = rhs[i];
+      dest[i] = digit - sub - borrow;
+      borrow = ((digit < sub) || ((dm_muldiv_limb_t)(digit - sub) < borrow)) ? 1U : 0U;
+    }
+ }
+
+int dm_muldiv_wide_zero(dm_muldiv_wide_t arg)
+ {
+   return 0U == dm_muldiv_wide_length(arg);
+ }
+
+int dm_muldiv_wide_less(dm_muldiv_wide_t lhs, dm_muldiv_wide_t rhs)
+ {
+   int result = 0;
+   unsigned int i = DM_MULDIV_WIDE_LIMBS;
+   while ((i > 0U) && (lhs[i - 1U] == rhs[i - 1U]))
+    {
+      --i;
+    }
+   if (i > 0U)
+    {
+      result = lhs[i - 1U] < rhs[i - 1U];
+    }
+   return result;
+ }
+
+unsigned int dm_muldiv_wide_bits(dm_muldiv_wide_t arg)
+ {
+   unsigned int result = dm_muldiv_wide_length(arg);
+   if (0U != result)
+    {
+      dm_muldiv_limb_t top = arg[result - 1U];
+      result = (result - 1U) * DM_MULDIV_LIMB_BITS + 1U;
+         // Binary search for the top bit.
+      for (unsigned int step = DM_MULDIV_LIMB_BITS / 2U; step > 0U; step >>= 1U)
+       {
+         if (0U != (top >> step))
+          {
+            top >>= step;
+            result += step;
+          }
+       }
+    }
+   return result;
+ }
@@ -57,6 +57,29 @@ void dm_muldiv_sub      (dm_muldiv_t, dm_muldiv_t, dm_muldiv_t);
 int  dm_muldiv_zero     (dm_muldiv_t);
 int  dm_muldiv_less     (dm_muldiv_t, dm_muldiv_t);
 
+
+   // A 256 bit number, for the intermediate results of dm_quad.
+   // The limbs are least significant first: 64 bits each with the 128 bit type, and 32 bits each without.
+#ifndef DM_NO_128_BIT_TYPE
+typedef uint64_t dm_muldiv_limb_t;
+#else
+typedef uint32_t dm_muldiv_limb_t;
+#endif
+#define DM_MULDIV_WIDE_LIMBS (32U / sizeof(dm_muldiv_limb_t))
+typedef dm_muldiv_limb_t dm_muldiv_wide_t[DM_MULDIV_WIDE_LIMBS];
+
+void dm_muldiv_wide_loadFrom (dm_muldiv_wide_t, uint64_t, uint64_t);   // high, low
+void dm_muldiv_wide_extract  (dm_muldiv_wide_t, uint64_t*, uint64_t*); // The low 128 bits : high, low
+void dm_muldiv_wide_mul      (dm_muldiv_wide_t, dm_muldiv_wide_t, dm_muldiv_wide_t); // dest = lhs * rhs, modulo 2 ^ 256
+void dm_muldiv_wide_divBy    (dm_muldiv_wide_t, dm_muldiv_wide_t, dm_muldiv_wide_t, dm_muldiv_wide_t); // lhs / rhs : quo, rem
+
+void dm_muldiv_wide_add      (dm_muldiv_wide_t, dm_muldiv_wide_t, dm_muldiv_wide_t); // dest = lhs + rhs, modulo 2 ^ 256
+void dm_muldiv_wide_sub      (dm_muldiv_wide_t, dm_muldiv_wide_t, dm_muldiv_wide_t); // dest = lhs - rhs, modulo 2 ^ 256
+
+int          dm_muldiv_wide_zero (dm_muldiv_wide_t);
+int          dm_muldiv_wide_less (dm_muldiv_wide_t, dm_muldiv_wide_t);
+unsigned int dm_muldiv_wide_bits (dm_muldiv_wide_t); // The number of significant bits
+
 #ifdef __cplusplus
 }
 #endif
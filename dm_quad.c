@@ -0,0 +1,950 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <ctype.h>
+#include <math.h>
+
+#include "dm_double.h" // For the rounding modes and flags, which dm_double_m.h shares.
+#include "dm_double_core.h"
+#include "dm_muldiv.h"
+#include "dm_quad.h"
+
+/*
+   The arithmetic works on the significands as integers in the wide numbers
+   of dm_muldiv, each scaled by a power of ten called its unit. The products
+   are exact, the quotients keep one more digit than they need and a sticky
+   bit for the remainder, and the sums line up exactly when the operands are
+   within 74 digits of each other. Past that, the smaller operand is cut down
+   to a sticky bit, which is all that rounding needs from it. Every result
+   is rounded once, at the end.
+*/
+
+#ifdef DM_FENV_FLAGS
+#define DM_QUAD_RAISE(flags) ((void) dm_feraiseexcept(flags))
+#else
+#define DM_QUAD_RAISE(flags) ((void) 0)
+#endif /* DM_FENV_FLAGS */
+
+#define DM_QUAD_DIGITS 34
+#define DM_QUAD_SPAN 74 // The widest sum that is lined up exactly, in digits.
+
+const dm_quad dm_quad_Zero = { 0U, 0U };
+const dm_quad dm_quad_NaN  = { 0U, 255U };
+const dm_quad dm_quad_Inf  = { DM_QUAD_INFINITY_HIGH, DM_QUAD_INFINITY_LOW };
+
+   // The powers of ten that fit in 128 bits: high, low.
+static const uint64_t dm_quad_powers [39][2] =
+ {
+   { 0x0000000000000000U, 0x0000000000000001U }, // 1e0
+   { 0x0000000000000000U, 0x000000000000000AU }, // 1e1
+   { 0x0000000000000000U, 0x0000000000000064U }, // 1e2
+   { 0x0000000000000000U, 0x00000000000003E8U }, // 1e3
+   { 0x0000000000000000U, 0x0000000000002710U }, // 1e4
+   { 0x0000000000000000U, 0x00000000000186A0U }, // 1e5
+   { 0x0000000000000000U, 0x00000000000F4240U }, // 1e6
+   { 0x0000000000000000U, 0x0000000000989680U }, // 1e7
+   { 0x0000000000000000U, 0x0000000005F5E100U }, // 1e8
+   { 0x0000000000000000U, 0x000000003B9ACA00U }, // 1e9
+   { 0x0000000000000000U, 0x00000002540BE400U }, // 1e10
+   { 0x0000000000000000U, 0x000000174876E800U }, // 1e11
+   { 0x0000000000000000U, 0x000000E8D4A51000U }, // 1e12
+   { 0x0000000000000000U, 0x000009184E72A000U }, // 1e13
+   { 0x0000000000000000U, 0x00005AF3107A4000U }, // 1e14
+   { 0x0000000000000000U, 0x00038D7EA4C68000U }, // 1e15
+   { 0x0000000000000000U, 0x002386F26FC10000U }, // 1e16
+   { 0x0000000000000000U, 0x016345785D8A0000U }, // 1e17
+   { 0x0000000000000000U, 0x0DE0B6B3A7640000U }, // 1e18
+   { 0x0000000000000000U, 0x8AC7230489E80000U }, // 1e19
+   { 0x0000000000000005U, 0x6BC75E2D63100000U }, // 1e20
+   { 0x0000000000000036U, 0x35C9ADC5DEA00000U }, // 1e21
+   { 0x000000000000021EU, 0x19E0C9BAB2400000U }, // 1e22
+   { 0x000000000000152DU, 0x02C7E14AF6800000U }, // 1e23
+   { 0x000000000000D3C2U, 0x1BCECCEDA1000000U }, // 1e24
+   { 0x0000000000084595U, 0x161401484A000000U }, // 1e25
+   { 0x000000000052B7D2U, 0xDCC80CD2E4000000U }, // 1e26
+   { 0x00000000033B2E3CU, 0x9FD0803CE8000000U }, // 1e27
+   { 0x00000000204FCE5EU, 0x3E25026110000000U }, // 1e28
+   { 0x00000001431E0FAEU, 0x6D7217CAA0000000U }, // 1e29
+   { 0x0000000C9F2C9CD0U, 0x4674EDEA40000000U }, // 1e30
+   { 0x0000007E37BE2022U, 0xC0914B2680000000U }, // 1e31
+   { 0x000004EE2D6D415BU, 0x85ACEF8100000000U }, // 1e32
+   { 0x0000314DC6448D93U, 0x38C15B0A00000000U }, // 1e33
+   { 0x0001ED09BEAD87C0U, 0x378D8E6400000000U }, // 1e34
+   { 0x0013426172C74D82U, 0x2B878FE800000000U }, // 1e35
+   { 0x00C097CE7BC90715U, 0xB34B9F1000000000U }, // 1e36
+   { 0x0785EE10D5DA46D9U, 0x00F436A000000000U }, // 1e37
+   { 0x4B3B4CA85A86C47AU, 0x098A224000000000U }, // 1e38
+ };
+
+   // 10 ^ exponent, for 0 <= exponent <= 76.
+static void dm_quad_pow10(dm_muldiv_wide_t dest, int32_t exponent)
+ {
+   if (exponent <= 38)
+    {
+      dm_muldiv_wide_loadFrom(dest, dm_quad_powers[exponent][0], dm_quad_powers[exponent][1]);
+    }
+   else
+    {
+      dm_muldiv_wide_t temp;
+      dm_muldiv_wide_loadFrom(dest, dm_quad_powers[38][0], dm_quad_powers[38][1]);
+      dm_muldiv_wide_loadFrom(temp, dm_quad_powers[exponent - 38][0], dm_quad_powers[exponent - 38][1]);
+      dm_muldiv_wide_mul(dest, dest, temp);
+    }
+ }
+
+   // The number of decimal digits in a non-zero value, below 10 ^ 76.
+static int32_t dm_quad_digits(dm_muldiv_wide_t arg)
+ {
+      // 1233 / 4096 is just over log10(2), which gives the digits of the smallest number with this many bits.
+   int32_t result = (int32_t)(((dm_muldiv_wide_bits(arg) - 1U) * 1233U) >> 12U) + 1;
+   dm_muldiv_wide_t power;
+   dm_quad_pow10(power, result);
+   if (!dm_muldiv_wide_less(arg, power))
+    {
+      ++result;
+    }
+   return result;
+ }
+
+int dm_quad_fpclassify(dm_quad arg)
+ {
+   int result = FP_NORMAL;
+   if (DM_QUAD_SPECIAL_EXPONENT == dm_quad_unpack_exponent(arg))
+    {
+      uint64_t high;
+      uint64_t low;
+      dm_quad_unpack_significand_alt(arg, &high, &low);
+      if ((DM_QUAD_INFINITY_HIGH == high) && (DM_QUAD_INFINITY_LOW == low))
+       {
+         result = FP_INFINITE;
+       }
+      else if ((0U == high) && (0U == low))
+       {
+         result = FP_ZERO;
+       }
+      else
+       {
+         result = FP_NAN;
+       }
+    }
+   return result;
+ }
+
+int dm_quad_isfinite(dm_quad arg)
+ {
+   int clasS = dm_quad_fpclassify(arg);
+   return (FP_INFINITE != clasS) && (FP_NAN != clasS);
+ }
+
+int dm_quad_isinf(dm_quad arg)
+ {
+   return FP_INFINITE == dm_quad_fpclassify(arg);
+ }
+
+int dm_quad_isnan(dm_quad arg)
+ {
+   return FP_NAN == dm_quad_fpclassify(arg);
+ }
+
+int dm_quad_isnormal(dm_quad arg)
+ {
+   return FP_NORMAL == dm_quad_fpclassify(arg);
+ }
+
+int dm_quad_signbit(dm_quad arg)
+ {
+   return (arg.high & DM_QUAD_SIGN_MASK) ? 1 : 0;
+ }
+
+int dm_quad_iszero(dm_quad arg)
+ {
+   return FP_ZERO == dm_quad_fpclassify(arg);
+ }
+
+   // Compare two numbers that aren't NaN: -1, 0, or 1.
+   // The fields are in order of significance, so the magnitudes of finite numbers compare as integers.
+static int dm_quad_compare(dm_quad lhs, dm_quad rhs)
+ {
+   int result = 0;
+   uint64_t lHigh = lhs.high & ~DM_QUAD_SIGN_MASK;
+   uint64_t lLow = lhs.low;
+   uint64_t rHigh = rhs.high & ~DM_QUAD_SIGN_MASK;
+   uint64_t rLow = rhs.low;
+   if (!!dm_quad_isinf(lhs))
+    {
+      lHigh = ~DM_QUAD_SIGN_MASK;
+    }
+   if (!!dm_quad_isinf(rhs))
+    {
+      rHigh = ~DM_QUAD_SIGN_MASK;
+    }
+
+   if ((0U == (lHigh | lLow)) && (0U == (rHigh | rLow)))
+    {
+      // Both zero, of either sign.
+    }
+   else if (dm_quad_signbit(lhs) != dm_quad_signbit(rhs))
+    {
+      result = dm_quad_signbit(lhs) ? -1 : 1;
+    }
+   else
+    {
+      if ((lHigh < rHigh) || ((lHigh == rHigh) && (lLow < rLow)))
+       {
+         result = -1;
+       }
+      else if ((lHigh != rHigh) || (lLow != rLow))
+       {
+         result = 1;
+       }
+      if (!!dm_quad_signbit(lhs))
+       {
+         result = -result;
+       }
+    }
+   return result;
+ }
+
+int dm_quad_isgreater(dm_quad lhs, dm_quad rhs)
+ {
+   return !dm_quad_isunordered(lhs, rhs) && (dm_quad_compare(lhs, rhs) > 0);
+ }
+
+int dm_quad_isgreaterequal(dm_quad lhs, dm_quad rhs)
+ {
+   return !dm_quad_isunordered(lhs, rhs) && (dm_quad_compare(lhs, rhs) >= 0);
+ }
+
+int dm_quad_isless(dm_quad lhs, dm_quad rhs)
+ {
+   return !dm_quad_isunordered(lhs, rhs) && (dm_quad_compare(lhs, rhs) < 0);
+ }
+
+int dm_quad_islessequal(dm_quad lhs, dm_quad rhs)
+ {
+   return !dm_quad_isunordered(lhs, rhs) && (dm_quad_compare(lhs, rhs) <= 0);
+ }
+
+int dm_quad_isunordered(dm_quad lhs, dm_quad rhs)
+ {
+   return dm_quad_isnan(lhs) || dm_quad_isnan(rhs);
+ }
+
+int dm_quad_isequal(dm_quad lhs, dm_quad rhs)
+ {
+   return !dm_quad_isunordered(lhs, rhs) && (dm_quad_compare(lhs, rhs) == 0);
+ }
+
+dm_quad dm_quad_fabs(dm_quad arg)
+ {
+   dm_quad result = arg;
+   result.high &= ~DM_QUAD_SIGN_MASK;
+   return result;
+ }
+
+dm_quad dm_quad_neg(dm_quad arg)
+ {
+   dm_quad result = arg;
+   result.high ^= DM_QUAD_SIGN_MASK;
+   return result;
+ }
+
+dm_quad dm_quad_add(dm_quad lhs, dm_quad rhs)
+ {
+   return dm_quad_add_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_quad dm_quad_sub(dm_quad lhs, dm_quad rhs)
+ {
+   return dm_quad_sub_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_quad dm_quad_mul(dm_quad lhs, dm_quad rhs)
+ {
+   return dm_quad_mul_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_quad dm_quad_div(dm_quad lhs, dm_quad rhs)
+ {
+   return dm_quad_div_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_quad dm_quad_fma(dm_quad lhs, dm_quad rhs, dm_quad ths)
+ {
+   return dm_quad_fma_r(lhs, rhs, ths, dm_fegetround());
+ }
+
+static dm_quad dm_quad_signed(int sign, dm_quad arg)
+ {
+   dm_quad result = arg;
+   if (sign)
+    {
+      result = dm_quad_neg(arg);
+    }
+   return result;
+ }
+
+   // The significand of a finite, non-zero value, as an integer: its unit is the exponent less 33.
+static void dm_quad_toWide(dm_quad arg, dm_muldiv_wide_t dest)
+ {
+   uint64_t high;
+   uint64_t low;
+   dm_quad_unpack_significand(arg, &high, &low);
+   dm_muldiv_wide_loadFrom(dest, high, low);
+ }
+
+   // Round value * 10 ^ unit to thirty-four digits, and pack it.
+   // sticky is non-zero if the true value is a little further from zero than value, which must then have more than thirty-four digits.
+static dm_quad dm_quad_round(int sign, int32_t unit, dm_muldiv_wide_t value, int sticky, int round_mode)
+ {
+   dm_quad result;
+   if (!!dm_muldiv_wide_zero(value))
+    {
+      result = dm_quad_signed(DM_FE_DOWNWARD == round_mode, dm_quad_Zero); // An exact zero from a sum.
+    }
+   else
+    {
+      int32_t digits = dm_quad_digits(value);
+      int32_t exponent = unit + digits - 1;
+      dm_muldiv_wide_t quot;
+      dm_muldiv_wide_t power;
+      int64_t comp = 1;
+      int zero = 1;
+      if (digits > DM_QUAD_DIGITS)
+       {
+         dm_muldiv_wide_t rem;
+         dm_quad_pow10(power, digits - DM_QUAD_DIGITS);
+         dm_muldiv_wide_divBy(value, power, quot, rem);
+         zero = dm_muldiv_wide_zero(rem) && !sticky;
+         dm_muldiv_wide_add(rem, rem, rem);
+         if (!!dm_muldiv_wide_less(power, rem))
+          {
+            comp = -1;
+          }
+         else if (!dm_muldiv_wide_less(rem, power))
+          {
+            comp = sticky ? -1 : 0; // Just past the middle, or exactly on it.
+          }
+         else
+          {
+            // Below the middle
+          }
+       }
+      else
+       {
+         dm_quad_pow10(power, DM_QUAD_DIGITS - digits);
+         dm_muldiv_wide_mul(quot, value, power);
+       }
+
+      uint64_t high;
+      uint64_t low;
+      dm_muldiv_wide_extract(quot, &high, &low);
+      if (!zero)
+       {
+         DM_QUAD_RAISE(DM_FE_INEXACT);
+       }
+      if (dm_core_decideRound(sign, (int)(low & 1U), comp, zero, round_mode))
+       {
+         ++low;
+         if (0U == low)
+          {
+            ++high;
+          }
+         if ((dm_quad_powers[DM_QUAD_DIGITS][0] == high) && (dm_quad_powers[DM_QUAD_DIGITS][1] == low))
+          {
+            high = DM_QUAD_MIN_SIGNIFICAND_HIGH;
+            low = DM_QUAD_MIN_SIGNIFICAND_LOW;
+            ++exponent;
+          }
+       }
+
+      if (exponent > DM_QUAD_MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_QUAD_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         result = dm_quad_signed(sign, dm_quad_Inf);
+       }
+      else if (exponent < DM_QUAD_MIN_EXPONENT) // Flush to zero?
+       {
+         DM_QUAD_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         result = dm_quad_signed(sign, dm_quad_Zero);
+       }
+      else
+       {
+         result = dm_quad_pack(sign, exponent, high, low);
+       }
+    }
+   return result;
+ }
+
+   // Round x * 10 ^ xUnit + y * 10 ^ yUnit, for non-zero x and y of at most sixty-eight digits.
+static dm_quad dm_quad_sum(int xSign, dm_muldiv_wide_t x, int32_t xUnit, int ySign, dm_muldiv_wide_t y, int32_t yUnit, int round_mode)
+ {
+   dm_muldiv_wide_t big;
+   dm_muldiv_wide_t small;
+   dm_muldiv_wide_t power;
+   int bigSign = xSign;
+   int smallSign = ySign;
+   int32_t bigUnit = xUnit;
+   int32_t smallUnit = yUnit;
+   int sticky = 0;
+
+      // Make big the one with the larger unit.
+   for (unsigned int i = 0U; i < DM_MULDIV_WIDE_LIMBS; ++i)
+    {
+      big[i] = (xUnit >= yUnit) ? x[i] : y[i];
+      small[i] = (xUnit >= yUnit) ? y[i] : x[i];
+    }
+   if (xUnit < yUnit)
+    {
+      bigSign = ySign;
+      smallSign = xSign;
+      bigUnit = yUnit;
+      smallUnit = xUnit;
+    }
+
+      // Line them up at the smaller unit, unless that is more than DM_QUAD_SPAN digits below the top.
+      // Only small is ever cut, and then the top digit is in big: small's is at most sixty-eight digits above its unit.
+   int32_t top = bigUnit + dm_quad_digits(big);
+   if (smallUnit + dm_quad_digits(small) > top)
+    {
+      top = smallUnit + dm_quad_digits(small);
+    }
+   int32_t unit = top - DM_QUAD_SPAN;
+   if (smallUnit > unit)
+    {
+      unit = smallUnit;
+    }
+   dm_quad_pow10(power, bigUnit - unit);
+   dm_muldiv_wide_mul(big, big, power);
+   if (unit - smallUnit > 76)
+    {
+      dm_muldiv_wide_loadFrom(small, 0U, 0U); // All of it is below the unit.
+      sticky = 1;
+    }
+   else if (unit > smallUnit)
+    {
+      dm_muldiv_wide_t rem;
+      dm_quad_pow10(power, unit - smallUnit);
+      dm_muldiv_wide_divBy(small, power, small, rem);
+      sticky = !dm_muldiv_wide_zero(rem);
+    }
+   else
+    {
+      // Exact
+    }
+
+   int sign = bigSign;
+   if (bigSign == smallSign)
+    {
+      dm_muldiv_wide_add(big, big, small);
+    }
+   else if (!!sticky)
+    {
+         // big - (small + something) = (big - small - 1) + something, where big is at least 10 ^ 73 and small is below 10 ^ 68.
+      dm_muldiv_wide_sub(big, big, small);
+      dm_muldiv_wide_loadFrom(small, 0U, 1U);
+      dm_muldiv_wide_sub(big, big, small);
+    }
+   else if (!!dm_muldiv_wide_less(big, small))
+    {
+      dm_muldiv_wide_sub(big, small, big);
+      sign = smallSign;
+    }
+   else
+    {
+      dm_muldiv_wide_sub(big, big, small); // Zero if they cancel.
+    }
+   return dm_quad_round(sign, unit, big, sticky, round_mode);
+ }
+
+dm_quad dm_quad_add_r(dm_quad lhs, dm_quad rhs, int round_mode)
+ {
+   dm_quad result;
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_quad_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_quad_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, if both are infinities.
+   else if (dm_quad_isinf(lhs) && dm_quad_isinf(rhs))
+    {
+      if (dm_quad_signbit(lhs) != dm_quad_signbit(rhs))
+       {
+         DM_QUAD_RAISE(DM_FE_INVALID);
+         result = dm_quad_NaN; // Inf - Inf = NaN
+       }
+      else
+       {
+         result = lhs; // Both have the same sign, so just return lhs.
+       }
+    }
+      // Anything else with infinity is infinity
+   else if (!!dm_quad_isinf(lhs))
+    {
+      result = lhs;
+    }
+   else if (!!dm_quad_isinf(rhs))
+    {
+      result = rhs;
+    }
+
+      // Finally, zeros.
+   else if (dm_quad_iszero(lhs) && dm_quad_iszero(rhs))
+    {
+      if ((dm_quad_signbit(lhs) && dm_quad_signbit(rhs)) || ((dm_quad_signbit(lhs) != dm_quad_signbit(rhs)) && (DM_FE_DOWNWARD == round_mode)))
+       {
+         result = dm_quad_neg(dm_quad_Zero);
+       }
+      else
+       {
+         result = dm_quad_Zero; // All other cases return positive zero.
+       }
+    }
+   else if (!!dm_quad_iszero(lhs))
+    {
+      result = rhs;
+    }
+   else if (!!dm_quad_iszero(rhs))
+    {
+      result = lhs;
+    }
+
+   else
+    {
+      dm_muldiv_wide_t lhd;
+      dm_muldiv_wide_t rhd;
+      dm_quad_toWide(lhs, lhd);
+      dm_quad_toWide(rhs, rhd);
+      result = dm_quad_sum(dm_quad_signbit(lhs), lhd, dm_quad_unpack_exponent(lhs) - (DM_QUAD_DIGITS - 1),
+         dm_quad_signbit(rhs), rhd, dm_quad_unpack_exponent(rhs) - (DM_QUAD_DIGITS - 1), round_mode);
+    }
+   return result;
+ }
+
+dm_quad dm_quad_sub_r(dm_quad lhs, dm_quad rhs, int round_mode)
+ {
+   dm_quad result;
+      // Only handle NaNs, as we don't want to mutate the payload of an rhs NaN.
+   if (!!dm_quad_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_quad_isnan(rhs))
+    {
+      result = rhs;
+    }
+   else
+    {
+      result = dm_quad_add_r(lhs, dm_quad_neg(rhs), round_mode);
+    }
+   return result;
+ }
+
+dm_quad dm_quad_mul_r(dm_quad lhs, dm_quad rhs, int round_mode)
+ {
+   dm_quad result;
+   int resultSign = dm_quad_signbit(lhs) != dm_quad_signbit(rhs);
+
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_quad_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_quad_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, infinity times zero is NaN.
+   else if ((dm_quad_isinf(lhs) && dm_quad_iszero(rhs)) || (dm_quad_iszero(lhs) && dm_quad_isinf(rhs)))
+    {
+      DM_QUAD_RAISE(DM_FE_INVALID);
+      result = dm_quad_signed(resultSign, dm_quad_NaN); // Preserve the sign of NaN ...
+    }
+
+      // Next, if either are infinities.
+   else if (dm_quad_isinf(lhs) || dm_quad_isinf(rhs))
+    {
+      result = dm_quad_signed(resultSign, dm_quad_Inf);
+    }
+
+      // Finally, zeros.
+   else if (dm_quad_iszero(lhs) || dm_quad_iszero(rhs))
+    {
+      result = dm_quad_signed(resultSign, dm_quad_Zero);
+    }
+
+   else
+    {
+      dm_muldiv_wide_t lhd;
+      dm_muldiv_wide_t rhd;
+      dm_quad_toWide(lhs, lhd);
+      dm_quad_toWide(rhs, rhd);
+      dm_muldiv_wide_mul(lhd, lhd, rhd); // Exact: at most sixty-eight digits.
+      result = dm_quad_round(resultSign, dm_quad_unpack_exponent(lhs) + dm_quad_unpack_exponent(rhs) - 2 * (DM_QUAD_DIGITS - 1), lhd, 0, round_mode);
+    }
+   return result;
+ }
+
+dm_quad dm_quad_div_r(dm_quad lhs, dm_quad rhs, int round_mode)
+ {
+   dm_quad result;
+   int resultSign = dm_quad_signbit(lhs) != dm_quad_signbit(rhs);
+
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_quad_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_quad_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, zero divided by zero or infinity divided by infinity is NaN.
+   else if ((dm_quad_iszero(lhs) && dm_quad_iszero(rhs)) || (dm_quad_isinf(lhs) && dm_quad_isinf(rhs)))
+    {
+      DM_QUAD_RAISE(DM_FE_INVALID);
+      result = dm_quad_signed(resultSign, dm_quad_NaN); // Preserve the sign of NaN ...
+    }
+
+      // Next, if the result is infinity.
+   else if (dm_quad_isinf(lhs) || dm_quad_iszero(rhs))
+    {
+      if (!dm_quad_isinf(lhs))
+       {
+         DM_QUAD_RAISE(DM_FE_DIVBYZERO); // Finite divided by zero
+       }
+      result = dm_quad_signed(resultSign, dm_quad_Inf);
+    }
+
+      // Finally, if the result is zero.
+   else if (dm_quad_iszero(lhs) || dm_quad_isinf(rhs))
+    {
+      result = dm_quad_signed(resultSign, dm_quad_Zero);
+    }
+
+   else
+    {
+      dm_muldiv_wide_t lhd;
+      dm_muldiv_wide_t rhd;
+      dm_muldiv_wide_t power;
+      dm_muldiv_wide_t rem;
+      dm_quad_toWide(lhs, lhd);
+      dm_quad_toWide(rhs, rhd);
+         // Scaled so that the quotient has thirty-five digits or more: one past the last digit, with the remainder sticky.
+      dm_quad_pow10(power, DM_QUAD_DIGITS + 1);
+      dm_muldiv_wide_mul(lhd, lhd, power);
+      dm_muldiv_wide_divBy(lhd, rhd, lhd, rem);
+      result = dm_quad_round(resultSign, dm_quad_unpack_exponent(lhs) - dm_quad_unpack_exponent(rhs) - (DM_QUAD_DIGITS + 1), lhd, !dm_muldiv_wide_zero(rem), round_mode);
+    }
+   return result;
+ }
+
+dm_quad dm_quad_fma_r(dm_quad lhs, dm_quad rhs, dm_quad ths, int round_mode)
+ {
+   dm_quad result;
+      // If any argument is Nan, Zero, or Infinity: then the result is the same as the result of the base operations.
+   if (!(dm_quad_isnormal(lhs) && dm_quad_isnormal(rhs) && dm_quad_isnormal(ths)))
+    {
+      result = dm_quad_add_r(dm_quad_mul_r(lhs, rhs, round_mode), ths, round_mode);
+    }
+   else
+    {
+      dm_muldiv_wide_t lhd;
+      dm_muldiv_wide_t rhd;
+      dm_muldiv_wide_t thd;
+      dm_quad_toWide(lhs, lhd);
+      dm_quad_toWide(rhs, rhd);
+      dm_quad_toWide(ths, thd);
+      dm_muldiv_wide_mul(lhd, lhd, rhd); // The exact product
+      result = dm_quad_sum(dm_quad_signbit(lhs) != dm_quad_signbit(rhs), lhd, dm_quad_unpack_exponent(lhs) + dm_quad_unpack_exponent(rhs) - 2 * (DM_QUAD_DIGITS - 1),
+         dm_quad_signbit(ths), thd, dm_quad_unpack_exponent(ths) - (DM_QUAD_DIGITS - 1), round_mode);
+    }
+   return result;
+ }
+
+   // Write count digits of value, right to left, ending just before dest.
+static void dm_quad_writeDigits(char* dest, uint64_t value, int count)
+ {
+   uint64_t rest = value;
+   for (int i = 1; i <= count; ++i)
+    {
+      uint64_t next = rest % 10U;
+      rest = rest / 10U;
+      *(dest - i) = (char)('0' + (int)next);
+    }
+ }
+
+void dm_quad_tostring(dm_quad arg, char dest [43])
+ {
+   int sign = dm_quad_signbit(arg);
+   int32_t exponent = dm_quad_unpack_exponent(arg);
+
+   if (!!sign)
+    {
+      dest[0] = '-';
+    }
+   if (!!dm_quad_isnan(arg))
+    {
+      dest[sign + 0] = 'N';
+      dest[sign + 1] = 'a';
+      dest[sign + 2] = 'N';
+      dest[sign + 3] = '\0';
+    }
+   else if (!!dm_quad_isinf(arg))
+    {
+      dest[sign + 0] = 'I';
+      dest[sign + 1] = 'n';
+      dest[sign + 2] = 'f';
+      dest[sign + 3] = '\0';
+    }
+   else
+    {
+      uint64_t upper = 0U; // The first seventeen digits
+      uint64_t lower = 0U; // and the last seventeen.
+      if (!!dm_quad_iszero(arg))
+       {
+         exponent = 0;
+       }
+      else
+       {
+         dm_muldiv_wide_t value;
+         dm_muldiv_wide_t power;
+         uint64_t high;
+         dm_quad_toWide(arg, value);
+         dm_quad_pow10(power, 17);
+         dm_muldiv_wide_divBy(value, power, value, power);
+         dm_muldiv_wide_extract(value, &high, &upper);
+         dm_muldiv_wide_extract(power, &high, &lower);
+       }
+
+      dest[sign + 0] = (char)('0' + (int)(upper / 10000000000000000ULL));
+      dest[sign + 1] = '.';
+      dm_quad_writeDigits(dest + sign + 18, upper % 10000000000000000ULL, 16);
+      dm_quad_writeDigits(dest + sign + 35, lower, 17);
+      dest[sign + 35] = 'e';
+      if (exponent >= 0)
+       {
+         dest[sign + 36] = '+';
+       }
+      else
+       {
+         dest[sign + 36] = '-';
+         exponent = -exponent;
+       }
+      int length = 1;
+      for (int32_t rest = exponent / 10; rest > 0; rest = rest / 10)
+       {
+         ++length;
+       }
+      dm_quad_writeDigits(dest + sign + 37 + length, (uint64_t)exponent, length);
+      dest[sign + 37 + length] = '\0';
+    }
+ }
+
+   // This follows dm_double_fromstring, with thirty-four digits kept in two halves of seventeen.
+dm_quad dm_quad_fromstring(const char * arg)
+ {
+   int resultSign = 0;
+   int32_t resultExponent = -1;
+   uint64_t halves [2] = { 0U, 0U };
+   int digits = 0;
+   int hasResidue = 0;
+   int allZero = 1;
+   int realDigit = 0;
+   int residue = 0;
+   int fraction = 0;
+   const char * iter = arg;
+   int round_mode = dm_fegetround();
+
+   if ('-' == *iter)
+    {
+      resultSign = 1;
+      ++iter;
+    }
+
+   while (!!isdigit((unsigned char)*iter) || ((0 == fraction) && (('.' == *iter) || (',' == *iter))))
+    {
+      if (!isdigit((unsigned char)*iter))
+       {
+         fraction = 1;
+       }
+      else
+       {
+         if (digits < DM_QUAD_DIGITS)
+          {
+            if (!!realDigit || ('0' != *iter))
+             {
+               halves[digits / 17] = (halves[digits / 17] * 10U) + (uint64_t)(*iter - '0');
+               ++digits;
+               realDigit = 1;
+             }
+          }
+         else if (!hasResidue)
+          {
+            hasResidue = 1;
+            if ('0' != *iter)
+             {
+               allZero = 0;
+               if (*iter > '5')
+                {
+                  residue = -1;
+                }
+               else if (*iter < '5')
+                {
+                  residue = 1;
+                }
+               else
+                {
+                  residue = 0;
+                }
+             }
+          }
+         else
+          {
+            if ((0 == residue) && ('0' != *iter))
+             {
+               if (!!allZero)
+                {
+                  residue = 1;
+                }
+               else
+                {
+                  residue = -1;
+                }
+               allZero = 0;
+             }
+          }
+
+         if ((0 == fraction) && !!realDigit)
+          {
+            ++resultExponent;
+          }
+         else if ((0 != fraction) && !realDigit)
+          {
+            --resultExponent;
+          }
+         else
+          {
+            // The exponent is already past this digit.
+          }
+       }
+      ++iter;
+    }
+   while (digits < DM_QUAD_DIGITS)
+    {
+      halves[digits / 17] *= 10U;
+      ++digits;
+    }
+   if (!!allZero) // By the definition of the comp argument.
+    {
+      residue = 1;
+    }
+
+   dm_muldiv_wide_t significand;
+   dm_muldiv_wide_t temp;
+   dm_muldiv_wide_loadFrom(significand, 0U, halves[0]);
+   dm_quad_pow10(temp, 17);
+   dm_muldiv_wide_mul(significand, significand, temp);
+   dm_muldiv_wide_loadFrom(temp, 0U, halves[1]);
+   dm_muldiv_wide_add(significand, significand, temp);
+   if (!allZero)
+    {
+      DM_QUAD_RAISE(DM_FE_INEXACT);
+    }
+   if (dm_core_decideRound(resultSign, (int)(halves[1] & 1U), residue, allZero, round_mode))
+    {
+      dm_muldiv_wide_loadFrom(temp, 0U, 1U);
+      dm_muldiv_wide_add(significand, significand, temp);
+      dm_quad_pow10(temp, DM_QUAD_DIGITS);
+      if (!dm_muldiv_wide_less(significand, temp))
+       {
+         dm_quad_pow10(significand, DM_QUAD_DIGITS - 1);
+         ++resultExponent;
+       }
+    }
+
+   if ('e' == (*iter | ' '))
+    {
+      ++iter;
+      int32_t exponentSign = 1;
+      int32_t exponentValue = 0;
+      if ('-' == *iter)
+       {
+         exponentSign = -1;
+         ++iter;
+       }
+      if ('+' == *iter)
+       {
+         ++iter;
+       }
+      while (!!isdigit((unsigned char)*iter))
+       {
+         exponentValue = (exponentValue * 10) + (*iter - '0');
+         ++iter;
+         if (((exponentValue * exponentSign) > (2 * DM_QUAD_MAX_EXPONENT)) || ((exponentValue * exponentSign) < (2 * DM_QUAD_MIN_EXPONENT)))
+          {
+            break;
+          }
+       }
+      resultExponent += exponentValue * exponentSign;
+    }
+
+   dm_quad finalResult;
+   if (!!dm_muldiv_wide_zero(significand))
+    {
+      finalResult = dm_quad_signed(resultSign, dm_quad_Zero);
+    }
+   else if (resultExponent > DM_QUAD_MAX_EXPONENT) // Flush to infinity?
+    {
+      DM_QUAD_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+      finalResult = dm_quad_signed(resultSign, dm_quad_Inf);
+    }
+   else if (resultExponent < DM_QUAD_MIN_EXPONENT) // Flush to zero?
+    {
+      DM_QUAD_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+      finalResult = dm_quad_signed(resultSign, dm_quad_Zero);
+    }
+   else
+    {
+      uint64_t high;
+      uint64_t low;
+      dm_muldiv_wide_extract(significand, &high, &low);
+      finalResult = dm_quad_pack(resultSign, resultExponent, high, low);
+    }
+   return finalResult;
+ }
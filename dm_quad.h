@@ -0,0 +1,176 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_QUAD_H
+#define DM_QUAD_H
+
+/*
+   dm_quad is a decimal floating point class with thirty-four digits of
+   significand and an exponent range of -8191 to 8191, inclusive.
+
+   It is sixteen bytes (128 bits) per number, for the intermediate results of
+   interest accrual and multi-step pricing, where sixteen digits run out.
+
+   The significand is a thirty-four-digit, normalized number:
+      1000000000000000000000000000000000 - 9999999999999999999999999999999999.
+   It is biased by 10 ^ 33 in order to fit into 113 bits.
+
+   The sign is the top bit of high, followed by the exponent, biased by 8192,
+   and then the significand, which continues through all of low. An exponent
+   of -8192 (a field of zero) is reserved for special cases, indicated in the
+   significand, as in dm_double:
+      All zeros : zero
+      All ones : infinity
+      Anything else : NaN
+
+   The arithmetic rounds with the same DM_FE_* modes as dm_double, and raises
+   the same status flags when the library is built with DM_FENV_FLAGS. Its
+   intermediate results are up to 256 bits wide, and use the wide numbers of
+   dm_muldiv: two 64 bit limbs to a __uint128_t, or, under
+   DM_NO_128_BIT_TYPE, 32 bit limbs in a uint64_t.
+
+   The conversions to and from dm_double are part of dm_double.c and
+   dm_double_m.c, as they need to know the layout of a dm_double: include
+   dm_double.h or dm_double_m.h first.
+*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dm_quad
+ {
+   uint64_t high;
+   uint64_t low;
+ } dm_quad;
+
+   // Where the fields are.
+#define DM_QUAD_EXPONENT_SHIFT 49
+#define DM_QUAD_EXPONENT_BIAS  8192
+#define DM_QUAD_EXPONENT_FIELD 0x3FFFU
+#define DM_QUAD_SIGN_MASK      0x8000000000000000ULL
+#define DM_QUAD_INFINITY_HIGH  0x0001FFFFFFFFFFFFULL // Also the mask of the significand
+#define DM_QUAD_INFINITY_LOW   0xFFFFFFFFFFFFFFFFULL
+
+#define DM_QUAD_SPECIAL_EXPONENT (-8192)
+#define DM_QUAD_MAX_EXPONENT     8191
+#define DM_QUAD_MIN_EXPONENT     (-8191)
+#define DM_QUAD_MIN_SIGNIFICAND_HIGH 0x0000314DC6448D93ULL // 10 ^ 33
+#define DM_QUAD_MIN_SIGNIFICAND_LOW  0x38C15B0A00000000ULL
+#define DM_QUAD_WIDEN                1000000000000000000ULL // From sixteen digits to thirty-four
+
+   // Packing and unpacking, shared by dm_quad.c and the conversions.
+   // The significands are passed as high and low halves.
+static inline dm_quad dm_quad_pack_alt(int sign, int32_t exponent, uint64_t high, uint64_t low)
+ {
+   dm_quad result;
+   result.high = (((uint64_t)(exponent + DM_QUAD_EXPONENT_BIAS)) << DM_QUAD_EXPONENT_SHIFT) | high | (sign ? DM_QUAD_SIGN_MASK : 0U);
+   result.low = low;
+   return result;
+ }
+
+static inline dm_quad dm_quad_pack(int sign, int32_t exponent, uint64_t high, uint64_t low)
+ {
+   uint64_t borrow = (low < DM_QUAD_MIN_SIGNIFICAND_LOW) ? 1U : 0U;
+   return dm_quad_pack_alt(sign, exponent, high - DM_QUAD_MIN_SIGNIFICAND_HIGH - borrow, low - DM_QUAD_MIN_SIGNIFICAND_LOW);
+ }
+
+static inline int32_t dm_quad_unpack_exponent(dm_quad value)
+ {
+   return (int32_t)((value.high >> DM_QUAD_EXPONENT_SHIFT) & DM_QUAD_EXPONENT_FIELD) - DM_QUAD_EXPONENT_BIAS;
+ }
+
+static inline int dm_quad_unpack_sign(dm_quad value)
+ {
+   return (0U != (value.high & DM_QUAD_SIGN_MASK)) ? 1 : 0;
+ }
+
+static inline void dm_quad_unpack_significand_alt(dm_quad value, uint64_t* high, uint64_t* low)
+ {
+   *high = value.high & DM_QUAD_INFINITY_HIGH;
+   *low = value.low;
+ }
+
+static inline void dm_quad_unpack_significand(dm_quad value, uint64_t* high, uint64_t* low)
+ {
+   uint64_t carry = (value.low > ~DM_QUAD_MIN_SIGNIFICAND_LOW) ? 1U : 0U;
+   *high = (value.high & DM_QUAD_INFINITY_HIGH) + DM_QUAD_MIN_SIGNIFICAND_HIGH + carry;
+   *low = value.low + DM_QUAD_MIN_SIGNIFICAND_LOW;
+ }
+
+
+extern const dm_quad dm_quad_Zero;
+extern const dm_quad dm_quad_NaN;
+extern const dm_quad dm_quad_Inf;
+
+int dm_quad_fpclassify (dm_quad);
+int dm_quad_isfinite   (dm_quad);
+int dm_quad_isinf      (dm_quad);
+int dm_quad_isnan      (dm_quad);
+int dm_quad_isnormal   (dm_quad);
+int dm_quad_signbit    (dm_quad);
+int dm_quad_iszero     (dm_quad);
+
+int dm_quad_isgreater      (dm_quad, dm_quad);
+int dm_quad_isgreaterequal (dm_quad, dm_quad);
+int dm_quad_isless         (dm_quad, dm_quad);
+int dm_quad_islessequal    (dm_quad, dm_quad);
+int dm_quad_isunordered    (dm_quad, dm_quad);
+int dm_quad_isequal        (dm_quad, dm_quad);
+
+dm_quad dm_quad_fabs  (dm_quad);
+dm_quad dm_quad_neg   (dm_quad);          // -x
+dm_quad dm_quad_add   (dm_quad, dm_quad); // x + y
+dm_quad dm_quad_sub   (dm_quad, dm_quad); // x - y
+dm_quad dm_quad_mul   (dm_quad, dm_quad); // x * y
+dm_quad dm_quad_div   (dm_quad, dm_quad); // x / y
+dm_quad dm_quad_fma   (dm_quad, dm_quad, dm_quad); // dm_fegetround()
+dm_quad dm_quad_add_r (dm_quad, dm_quad, int);
+dm_quad dm_quad_sub_r (dm_quad, dm_quad, int);
+dm_quad dm_quad_mul_r (dm_quad, dm_quad, int);
+dm_quad dm_quad_div_r (dm_quad, dm_quad, int);
+dm_quad dm_quad_fma_r (dm_quad, dm_quad, dm_quad, int);
+
+void    dm_quad_tostring   (dm_quad, char [43]); // 43? -9.999999999999999999999999999999999e-8191\0
+dm_quad dm_quad_fromstring (const char *);       // dm_fegetround()
+
+
+dm_quad   dm_double_toquad     (dm_double);      // Always exact
+dm_double dm_double_fromquad   (dm_quad);        // dm_fegetround()
+dm_double dm_double_fromquad_r (dm_quad, int);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_QUAD_H */
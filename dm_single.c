@@ -0,0 +1,430 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include <math.h>
+
+#include "dm_double.h" // For the rounding modes and flags, which dm_double_m.h shares.
+#include "dm_double_core.h"
+#include "dm_single.h"
+
+/*
+   The arithmetic runs on the sixteen-digit core of dm_double, with the
+   significands scaled up by DM_SINGLE_WIDEN. The core truncates, and
+   reports whether it dropped anything. Rounding that to seven digits with
+   the reported sticky bit gives the correctly rounded result in every mode:
+   rounding to sixteen digits first, and then to seven, would not, as
+   1.0000005 + 1e-20 shows.
+*/
+
+#ifdef DM_FENV_FLAGS
+#define DM_SINGLE_RAISE(flags) ((void) dm_feraiseexcept(flags))
+#else
+#define DM_SINGLE_RAISE(flags) ((void) 0)
+#endif /* DM_FENV_FLAGS */
+
+const dm_single dm_single_Zero = DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, 0U);
+const dm_single dm_single_NaN  = DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, 255U);
+const dm_single dm_single_Inf  = DM_SINGLE_PACK_ALT(0, DM_SINGLE_SPECIAL_EXPONENT, DM_SINGLE_INFINITY);
+
+int dm_single_fpclassify(dm_single arg)
+ {
+   int result = FP_NORMAL;
+   if (DM_SINGLE_SPECIAL_EXPONENT == DM_SINGLE_UNPACK_EXPONENT(arg))
+    {
+      uint32_t significand = DM_SINGLE_UNPACK_SIGNIFICAND_ALT(arg);
+      if (DM_SINGLE_INFINITY == significand)
+       {
+         result = FP_INFINITE;
+       }
+      else if (0U == significand)
+       {
+         result = FP_ZERO;
+       }
+      else
+       {
+         result = FP_NAN;
+       }
+    }
+   return result;
+ }
+
+int dm_single_isfinite(dm_single arg)
+ {
+   int clasS = dm_single_fpclassify(arg);
+   return (FP_INFINITE != clasS) && (FP_NAN != clasS);
+ }
+
+int dm_single_isinf(dm_single arg)
+ {
+   return FP_INFINITE == dm_single_fpclassify(arg);
+ }
+
+int dm_single_isnan(dm_single arg)
+ {
+   return FP_NAN == dm_single_fpclassify(arg);
+ }
+
+int dm_single_isnormal(dm_single arg)
+ {
+   return FP_NORMAL == dm_single_fpclassify(arg);
+ }
+
+int dm_single_signbit(dm_single arg)
+ {
+   return (arg & DM_SINGLE_SIGN_MASK) ? 1 : 0;
+ }
+
+int dm_single_iszero(dm_single arg)
+ {
+   return FP_ZERO == dm_single_fpclassify(arg);
+ }
+
+   // Widening is exact, so the comparisons can be left to dm_double.
+int dm_single_isgreater(dm_single lhs, dm_single rhs)
+ {
+   return dm_double_isgreater(dm_double_fromsingle(lhs), dm_double_fromsingle(rhs));
+ }
+
+int dm_single_isgreaterequal(dm_single lhs, dm_single rhs)
+ {
+   return dm_double_isgreaterequal(dm_double_fromsingle(lhs), dm_double_fromsingle(rhs));
+ }
+
+int dm_single_isless(dm_single lhs, dm_single rhs)
+ {
+   return dm_double_isless(dm_double_fromsingle(lhs), dm_double_fromsingle(rhs));
+ }
+
+int dm_single_islessequal(dm_single lhs, dm_single rhs)
+ {
+   return dm_double_islessequal(dm_double_fromsingle(lhs), dm_double_fromsingle(rhs));
+ }
+
+int dm_single_isunordered(dm_single lhs, dm_single rhs)
+ {
+   return dm_single_isnan(lhs) || dm_single_isnan(rhs);
+ }
+
+int dm_single_isequal(dm_single lhs, dm_single rhs)
+ {
+   return dm_double_isequal(dm_double_fromsingle(lhs), dm_double_fromsingle(rhs));
+ }
+
+dm_single dm_single_fabs(dm_single arg)
+ {
+   return arg & ~DM_SINGLE_SIGN_MASK;
+ }
+
+dm_single dm_single_neg(dm_single arg)
+ {
+   return arg ^ DM_SINGLE_SIGN_MASK;
+ }
+
+dm_single dm_single_add(dm_single lhs, dm_single rhs)
+ {
+   return dm_single_add_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_single dm_single_sub(dm_single lhs, dm_single rhs)
+ {
+   return dm_single_sub_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_single dm_single_mul(dm_single lhs, dm_single rhs)
+ {
+   return dm_single_mul_r(lhs, rhs, dm_fegetround());
+ }
+
+dm_single dm_single_div(dm_single lhs, dm_single rhs)
+ {
+   return dm_single_div_r(lhs, rhs, dm_fegetround());
+ }
+
+static dm_single dm_single_signed(int sign, dm_single arg)
+ {
+   dm_single result = arg;
+   if (sign)
+    {
+      result = dm_single_neg(arg);
+    }
+   return result;
+ }
+
+   // Unpack a finite, non-zero value for the arithmetic core.
+static dm_core_number dm_single_toCore(dm_single arg)
+ {
+   dm_core_number result = { dm_single_signbit(arg), DM_SINGLE_UNPACK_EXPONENT(arg), (uint64_t)DM_SINGLE_UNPACK_SIGNIFICAND(arg) * DM_SINGLE_WIDEN };
+   return result;
+ }
+
+   // Round a truncated result of the arithmetic core to seven digits, and pack it.
+   // truncated is non-zero if the core dropped non-zero digits: the true value is a little further from zero.
+static dm_single dm_single_fromCore(dm_core_number arg, int truncated, int round_mode)
+ {
+   dm_single result;
+   if (0U == arg.significand)
+    {
+      result = dm_single_signed(DM_FE_DOWNWARD == round_mode, dm_single_Zero); // An exact zero: the core rounded toward zero.
+    }
+   else
+    {
+      uint64_t quot = arg.significand / DM_SINGLE_WIDEN;
+      uint64_t rem = arg.significand % DM_SINGLE_WIDEN;
+      int64_t comp = (int64_t)DM_SINGLE_WIDEN - (int64_t)(rem << 1U);
+      int zero = (0U == rem) && !truncated;
+      int32_t exponent = arg.exponent;
+      if (truncated && (0 == comp))
+       {
+         comp = -1; // Just past the middle
+       }
+      if (!zero)
+       {
+         DM_SINGLE_RAISE(DM_FE_INEXACT);
+       }
+      if (dm_core_decideRound(arg.sign, (int)(quot & 1U), comp, zero, round_mode))
+       {
+         ++quot;
+         if (quot > DM_SINGLE_MAX_SIGNIFICAND)
+          {
+            quot = DM_SINGLE_MIN_SIGNIFICAND;
+            ++exponent;
+          }
+       }
+
+      if (exponent > DM_SINGLE_MAX_EXPONENT) // Flush to infinity?
+       {
+         DM_SINGLE_RAISE(DM_FE_OVERFLOW | DM_FE_INEXACT);
+         result = dm_single_signed(arg.sign, dm_single_Inf);
+       }
+      else if (exponent < DM_SINGLE_MIN_EXPONENT) // Flush to zero?
+       {
+         DM_SINGLE_RAISE(DM_FE_UNDERFLOW | DM_FE_INEXACT);
+         result = dm_single_signed(arg.sign, dm_single_Zero);
+       }
+      else
+       {
+         result = DM_SINGLE_PACK(arg.sign, exponent, quot);
+       }
+    }
+   return result;
+ }
+
+dm_single dm_single_add_r(dm_single lhs, dm_single rhs, int round_mode)
+ {
+   dm_single result;
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_single_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_single_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, if both are infinities.
+   else if (dm_single_isinf(lhs) && dm_single_isinf(rhs))
+    {
+      if (dm_single_signbit(lhs) != dm_single_signbit(rhs))
+       {
+         DM_SINGLE_RAISE(DM_FE_INVALID);
+         result = dm_single_NaN; // Inf - Inf = NaN
+       }
+      else
+       {
+         result = lhs; // Both have the same sign, so just return lhs.
+       }
+    }
+      // Anything else with infinity is infinity
+   else if (!!dm_single_isinf(lhs))
+    {
+      result = lhs;
+    }
+   else if (!!dm_single_isinf(rhs))
+    {
+      result = rhs;
+    }
+
+      // Finally, zeros.
+   else if (dm_single_iszero(lhs) && dm_single_iszero(rhs))
+    {
+      if ((dm_single_signbit(lhs) && dm_single_signbit(rhs)) || ((dm_single_signbit(lhs) != dm_single_signbit(rhs)) && (DM_FE_DOWNWARD == round_mode)))
+       {
+         result = dm_single_neg(dm_single_Zero);
+       }
+      else
+       {
+         result = dm_single_Zero; // All other cases return positive zero.
+       }
+    }
+   else if (!!dm_single_iszero(lhs))
+    {
+      result = rhs;
+    }
+   else if (!!dm_single_iszero(rhs))
+    {
+      result = lhs;
+    }
+
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_add(dm_single_toCore(lhs), dm_single_toCore(rhs), DM_FE_TOWARDZERO, &events);
+      result = dm_single_fromCore(core, events & DM_CORE_INEXACT, round_mode);
+    }
+   return result;
+ }
+
+dm_single dm_single_sub_r(dm_single lhs, dm_single rhs, int round_mode)
+ {
+   dm_single result;
+      // Only handle NaNs, as we don't want to mutate the payload of an rhs NaN.
+   if (!!dm_single_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_single_isnan(rhs))
+    {
+      result = rhs;
+    }
+   else
+    {
+      result = dm_single_add_r(lhs, dm_single_neg(rhs), round_mode);
+    }
+   return result;
+ }
+
+dm_single dm_single_mul_r(dm_single lhs, dm_single rhs, int round_mode)
+ {
+   dm_single result;
+   int resultSign = dm_single_signbit(lhs) != dm_single_signbit(rhs);
+
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_single_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_single_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, infinity times zero is NaN.
+   else if ((dm_single_isinf(lhs) && dm_single_iszero(rhs)) || (dm_single_iszero(lhs) && dm_single_isinf(rhs)))
+    {
+      DM_SINGLE_RAISE(DM_FE_INVALID);
+      result = dm_single_signed(resultSign, dm_single_NaN); // Preserve the sign of NaN ...
+    }
+
+      // Next, if either are infinities.
+   else if (dm_single_isinf(lhs) || dm_single_isinf(rhs))
+    {
+      result = dm_single_signed(resultSign, dm_single_Inf);
+    }
+
+      // Finally, zeros.
+   else if (dm_single_iszero(lhs) || dm_single_iszero(rhs))
+    {
+      result = dm_single_signed(resultSign, dm_single_Zero);
+    }
+
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_mul(dm_single_toCore(lhs), dm_single_toCore(rhs), DM_FE_TOWARDZERO, &events);
+      result = dm_single_fromCore(core, events & DM_CORE_INEXACT, round_mode);
+    }
+   return result;
+ }
+
+dm_single dm_single_div_r(dm_single lhs, dm_single rhs, int round_mode)
+ {
+   dm_single result;
+   int resultSign = dm_single_signbit(lhs) != dm_single_signbit(rhs);
+
+      // First, handle NaNs, as they have the highest precedence.
+   if (!!dm_single_isnan(lhs))
+    {
+      result = lhs; // Prefer lhs NaN's payload.
+    }
+   else if (!!dm_single_isnan(rhs))
+    {
+      result = rhs;
+    }
+
+      // Next, zero divided by zero or infinity divided by infinity is NaN.
+   else if ((dm_single_iszero(lhs) && dm_single_iszero(rhs)) || (dm_single_isinf(lhs) && dm_single_isinf(rhs)))
+    {
+      DM_SINGLE_RAISE(DM_FE_INVALID);
+      result = dm_single_signed(resultSign, dm_single_NaN); // Preserve the sign of NaN ...
+    }
+
+      // Next, if the result is infinity.
+   else if (dm_single_isinf(lhs) || dm_single_iszero(rhs))
+    {
+      if (!dm_single_isinf(lhs))
+       {
+         DM_SINGLE_RAISE(DM_FE_DIVBYZERO); // Finite divided by zero
+       }
+      result = dm_single_signed(resultSign, dm_single_Inf);
+    }
+
+      // Finally, if the result is zero.
+   else if (dm_single_iszero(lhs) || dm_single_isinf(rhs))
+    {
+      result = dm_single_signed(resultSign, dm_single_Zero);
+    }
+
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_div(dm_single_toCore(lhs), dm_single_toCore(rhs), DM_FE_TOWARDZERO, &events);
+      result = dm_single_fromCore(core, events & DM_CORE_INEXACT, round_mode);
+    }
+   return result;
+ }
+
+dm_single dm_single_fma(dm_single lhs, dm_single rhs, dm_single ths)
+ {
+   dm_single result;
+      // If any argument is Nan, Zero, or Infinity: then the result is the same as the result of the base operations.
+   if (!(dm_single_isnormal(lhs) && dm_single_isnormal(rhs) && dm_single_isnormal(ths)))
+    {
+      result = dm_single_add(dm_single_mul(lhs, rhs), ths);
+    }
+   else
+    {
+      int events = 0;
+      dm_core_number core = dm_core_fma(dm_single_toCore(lhs), dm_single_toCore(rhs), dm_single_toCore(ths), DM_FE_TOWARDZERO, &events);
+      result = dm_single_fromCore(core, events & DM_CORE_INEXACT, dm_fegetround());
+    }
+   return result;
+ }
@@ -0,0 +1,138 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2022, Thomas DiModica
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef DM_SINGLE_H
+#define DM_SINGLE_H
+
+/*
+   dm_single is a decimal floating point class with seven digits of
+   significand and an exponent range of -63 to 63, inclusive.
+
+   It is four bytes (32 bits) per number, for columns of quantities and
+   rates that don't need sixteen digits: a scan over them moves half the
+   memory of a scan over dm_doubles.
+
+   The significand is a seven-digit, normalized number:
+      1000000 - 9999999.
+   It is biased by 1000000 in order to fit into 24 bits.
+
+   The sign is the top bit, followed by the exponent, biased by 64, and then
+   the significand. An exponent of -64 (a field of zero) is reserved for
+   special cases, indicated in the significand, as in dm_double:
+      All zeros : zero
+      All ones : infinity
+      Anything else : NaN
+   So a zero-filled column reads as positive zeros.
+
+   The arithmetic rounds with the same DM_FE_* modes as dm_double, and raises
+   the same status flags when the library is built with DM_FENV_FLAGS. The
+   statistics of DM_STATS count the conversions, but not the arithmetic.
+
+   The conversions are part of dm_double.c and dm_double_m.c, as they need to
+   know the layout of a dm_double: include dm_double.h or dm_double_m.h first.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t dm_single;
+
+   // Where the fields are.
+#define DM_SINGLE_EXPONENT_SHIFT 24
+#define DM_SINGLE_EXPONENT_BIAS  64
+#define DM_SINGLE_EXPONENT_FIELD 0x7FU
+#define DM_SINGLE_SIGN_MASK      0x80000000U
+#define DM_SINGLE_INFINITY       0xFFFFFFU // Also the mask of the significand
+
+#define DM_SINGLE_SPECIAL_EXPONENT (-64)
+#define DM_SINGLE_MAX_EXPONENT     63
+#define DM_SINGLE_MIN_EXPONENT     (-63)
+#define DM_SINGLE_MAX_SIGNIFICAND  9999999U
+#define DM_SINGLE_MIN_SIGNIFICAND  1000000U
+#define DM_SINGLE_WIDEN            1000000000U // From seven digits to sixteen
+
+   // Packing and unpacking, shared by dm_single.c and the conversions.
+#define DM_SINGLE_PACK(sign, exponent, significand) ((dm_single)((((uint32_t)((exponent) + DM_SINGLE_EXPONENT_BIAS)) << DM_SINGLE_EXPONENT_SHIFT) | ((uint32_t)(significand) - DM_SINGLE_MIN_SIGNIFICAND) | ((sign) ? DM_SINGLE_SIGN_MASK : 0U)))
+#define DM_SINGLE_PACK_ALT(sign, exponent, significand) ((dm_single)((((uint32_t)((exponent) + DM_SINGLE_EXPONENT_BIAS)) << DM_SINGLE_EXPONENT_SHIFT) | (uint32_t)(significand) | ((sign) ? DM_SINGLE_SIGN_MASK : 0U)))
+
+#define DM_SINGLE_UNPACK_EXPONENT(value) ((int32_t)(((value) >> DM_SINGLE_EXPONENT_SHIFT) & DM_SINGLE_EXPONENT_FIELD) - DM_SINGLE_EXPONENT_BIAS)
+#define DM_SINGLE_UNPACK_SIGNIFICAND(value) (((value) & DM_SINGLE_INFINITY) + DM_SINGLE_MIN_SIGNIFICAND)
+#define DM_SINGLE_UNPACK_SIGNIFICAND_ALT(value) ((value) & DM_SINGLE_INFINITY)
+
+
+extern const dm_single dm_single_Zero;
+extern const dm_single dm_single_NaN;
+extern const dm_single dm_single_Inf;
+
+int dm_single_fpclassify (dm_single);
+int dm_single_isfinite   (dm_single);
+int dm_single_isinf      (dm_single);
+int dm_single_isnan      (dm_single);
+int dm_single_isnormal   (dm_single);
+int dm_single_signbit    (dm_single);
+int dm_single_iszero     (dm_single);
+
+int dm_single_isgreater      (dm_single, dm_single);
+int dm_single_isgreaterequal (dm_single, dm_single);
+int dm_single_isless         (dm_single, dm_single);
+int dm_single_islessequal    (dm_single, dm_single);
+int dm_single_isunordered    (dm_single, dm_single);
+int dm_single_isequal        (dm_single, dm_single);
+
+dm_single dm_single_fabs  (dm_single);
+dm_single dm_single_neg   (dm_single);            // -x
+dm_single dm_single_add   (dm_single, dm_single); // x + y
+dm_single dm_single_sub   (dm_single, dm_single); // x - y
+dm_single dm_single_mul   (dm_single, dm_single); // x * y
+dm_single dm_single_div   (dm_single, dm_single); // x / y
+dm_single dm_single_fma   (dm_single, dm_single, dm_single); // dm_fegetround()
+dm_single dm_single_add_r (dm_single, dm_single, int);
+dm_single dm_single_sub_r (dm_single, dm_single, int);
+dm_single dm_single_mul_r (dm_single, dm_single, int);
+dm_single dm_single_div_r (dm_single, dm_single, int);
+
+
+dm_double dm_double_fromsingle  (dm_single);      // Always exact
+dm_single dm_double_tosingle    (dm_double);      // dm_fegetround()
+dm_single dm_double_tosingle_r  (dm_double, int);
+
+void dm_double_fromsingle_array (const dm_single*, dm_double*, size_t);
+void dm_double_tosingle_array   (const dm_double*, dm_single*, size_t, int);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DM_SINGLE_H */